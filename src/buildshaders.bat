@@ -31,8 +31,30 @@ if exist "%GAMEDIR%" (
     )
 )
 
+::Optional: only compile the Static Combos used by the Materials under LUX_WHITELIST_MATERIALS
+::and / or drawn in the merged lux_combousage Manifest LUX_WHITELIST_USAGE
+::Needs devtools\luxtools\lux_combo_whitelist.exe. The Whitelist goes into a Copy of shaders\fxc under %TEMP%
+::and the Build runs there, so the checked-in .fxc Files are never touched, even when the Build is interrupted
+set "WhitelistTool=%SrcDirBase%devtools\luxtools\lux_combo_whitelist.exe"
+set "WhitelistArgs="
+if defined LUX_WHITELIST_MATERIALS set "WhitelistArgs=-materials "%LUX_WHITELIST_MATERIALS%""
+if defined LUX_WHITELIST_USAGE set "WhitelistArgs=%WhitelistArgs% -usage "%LUX_WHITELIST_USAGE%""
+set "UseWhitelist=0"
+if defined WhitelistArgs if exist "%WhitelistTool%" set "UseWhitelist=1"
+set "buildDir=%shaderDir%"
+if "%UseWhitelist%"=="1" (
+    set "buildDir=%TEMP%\lux_whitelist_fxc"
+    if exist "!buildDir!" rmdir /s /q "!buildDir!"
+    xcopy "%shaderDir%" "!buildDir!" /E /I /Y /Q >nul
+    rem Older Builds wrote the Whitelist into shaders\fxc itself, take any leftover out
+    "%WhitelistTool%" -fxc "%shaderDir%" -clear
+    echo [Whitelisting Static Combos in !buildDir! : %WhitelistArgs%]
+    "%WhitelistTool%" %WhitelistArgs% -fxc "!buildDir!" -apply
+    echo.
+)
+
 ::Run shader processing
-set "Command=-ver 30 -threads %NUMBER_OF_PROCESSORS% -shaderpath %shaderDir%"
+set "Command=-ver 30 -threads %NUMBER_OF_PROCESSORS% -shaderpath %buildDir%"
 echo [Building .fxc files and worklist for %inputbase%.txt]
 echo Command: %Command%
 echo.
@@ -45,22 +67,43 @@ for /f "usebackq delims=" %%F in ("%inputbase%.txt") do (
         "%SrcDirBase%\devtools\ShaderCompile2" ^
             -ver 30 ^
             -threads %NUMBER_OF_PROCESSORS% ^
-            -shaderpath "%shaderDir%" ^
+            -shaderpath "%buildDir%" ^
             "!FileName!"
         echo.
     )
 )
 
+::Optional: with LUX_SHADERCOST set, check every Combo's Instruction Count against the checked-in fxc Baseline
+::The Baseline records the Compiler, lux_shadercost refuses one made by anything else
+set "ShaderCostTool=%SrcDirBase%devtools\luxtools\lux_shadercost.exe"
+set "ShaderCostBaseline=%shaderDir%\lux_shadercost_baseline.txt"
+if defined LUX_SHADERCOST if exist "%ShaderCostTool%" (
+    "%ShaderCostTool%" -selftest "%SrcDirBase%devtools\luxtools\lux_shadercost_selftest.asm" >nul
+    if errorlevel 1 echo [lux_shadercost -selftest failed, the Listing Parser miscounts. Run it by Hand to see which Count]
+    set "ShaderCostArgs="
+    if not exist "%ShaderCostBaseline%" (
+        echo [No %ShaderCostBaseline% yet, writing it. Check it in]
+        set "ShaderCostArgs=-update"
+    )
+    "%ShaderCostTool%" -fxc "%shaderDir%" -list "%inputbase%.txt" -baseline "%ShaderCostBaseline%" -temp "%TEMP%" !ShaderCostArgs!
+    if errorlevel 1 echo [lux_shadercost failed, see above]
+    echo.
+)
+
 ::Copy the shader stuff to the gamedir
-set "SrcCompiledShaderPath=%shaderDir%\shaders\fxc"
+set "SrcCompiledShaderPath=%buildDir%\shaders\fxc"
 echo [Copy %SrcCompiledShaderPath% folder to %targetdir%]
-xcopy %SrcCompiledShaderPath%  %targetdir% /E /I /Y
+xcopy "%SrcCompiledShaderPath%" "%targetdir%" /E /I /Y
 
 ::Delete .inc files and the shaders/fxc/shaders/fxc folder
 echo [Deleting %SrcCompiledShaderPath% folder]
-rmdir /s /q %SrcCompiledShaderPath%
+rmdir /s /q "%SrcCompiledShaderPath%"
 set "IncPath=%shaderDir%\include"
-rmdir /s /q %IncPath%
+::Only the .inc files, the *_combokey.h next to them are generated by lux_combokey_gen and checked in
+del /q "%IncPath%\*.inc"
+
+::The whitelisted Copy
+if "%UseWhitelist%"=="1" rmdir /s /q "%buildDir%"
 
 :end
 endlocal
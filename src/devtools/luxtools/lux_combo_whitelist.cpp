@@ -0,0 +1,777 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Scans Materials for the Static Combos they use and writes a Whitelist per Shader
+//
+//	Most of the Static Combo Space is never used by a shipped Material. Every .vmt under the -materials Trees
+//	is read on -threads Threads, its $Params go through the Combo Maps ( <fxc>/*.combomap, what the C++ Side
+//	selects from the Vars_* Members ) and every Static Combo a Material can end up in is counted.
+//	Combos a Map leaves to Draw Time ( * ) are kept whole, Combos the .fxc SKIPs for every Dynamic Combo are dropped.
+//	patch Materials are resolved through their include, relative to the Tree the Material is in.
+//
+//	Writes <out>/<shader>.whitelist, one used Static Index per Line with its Material Count.
+//	-apply puts the Whitelist into each .fxc as a SKIP Line between LUX_WHITELIST Markers, so ShaderCompile2
+//	only compiles what's on it. -clear takes them out again. buildshaders.bat applies it to a Copy of shaders/fxc
+//	and builds there, so an interrupted Build never leaves a Whitelist in the checked-in .fxc Files.
+//	Materials that aren't scanned ( per-Map Materials, Workshop Content ) won't find their Combos, scan every Tree that ships.
+//
+//	-usage adds what Playtests actually drew ( cpp_lux_combousage.h Manifests, lux_combousage merges them ) :
+//	a Static Combo drawn at Runtime is kept even when no scanned Material selects it. With -usage alone,
+//	only drawn Static Combos are kept, that's Pruning by Usage, so only use Manifests that cover the whole Game.
+//
+//	Usage :	lux_combo_whitelist -materials <dir> [-materials <dir> ..] [-usage <manifest> ..] [-fxc ../../shaders/fxc] [-out <fxc>]
+//			[-threads N] [-apply] [-clear] [-verbose]
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+#include "../../shaders/fxc/cpp_lux_combousage.h"
+
+#include <thread>
+#include <atomic>
+
+static const char *s_pWhitelistBegin = "// LUX_WHITELIST_BEGIN - Written by lux_combo_whitelist, -clear removes it";
+static const char *s_pWhitelistEnd = "// LUX_WHITELIST_END";
+
+static std::string ToLower(std::string s)
+{
+	for (size_t n = 0; n < s.size(); n++)
+		s[n] = (char)tolower((unsigned char)s[n]);
+	return s;
+}
+
+static bool IsPathSeparator(char c) { return c == '/' || c == '\\'; }
+
+//==========================================================================//
+// Combo Maps
+//==========================================================================//
+struct Section_t
+{
+	std::string Name;					// .fxc without Extension
+	CLuxComboSet Combos;
+	std::vector<std::string> Expressions;	// Per Static Combo, empty keeps every Value
+	std::vector<bool> Dead;				// Per Static Index, every Dynamic Combo is SKIPped
+};
+
+struct Map_t
+{
+	std::string Path;
+	std::vector<std::string> Materials;	// Lowercase VMT Shader Names
+	std::vector<Section_t> Sections;
+};
+
+// The .fxc Source without an old Whitelist, so -apply never stacks them and Parsing never sees one
+static std::string StripWhitelist(const std::string &Source, bool *pStripped = NULL)
+{
+	size_t nBegin = Source.find(s_pWhitelistBegin);
+	size_t nEnd = nBegin == std::string::npos ? nBegin : Source.find(s_pWhitelistEnd, nBegin);
+	if (pStripped)
+		*pStripped = nEnd != std::string::npos;
+	if (nEnd == std::string::npos)
+		return Source;
+
+	nEnd = Source.find('\n', nEnd);
+	nEnd = nEnd == std::string::npos ? Source.size() : nEnd + 1;
+	return Source.substr(0, nBegin) + Source.substr(nEnd);
+}
+
+static bool LoadSection(const std::string &FxcDir, Section_t &Section)
+{
+	std::string Path = FxcDir + Section.Name + ".fxc";
+	std::string Source;
+	if (!LuxReadFile(Path.c_str(), Source) || !Section.Combos.Parse(StripWhitelist(Source)))
+	{
+		fprintf(stderr, "Can't read the Combos of %s\n", Path.c_str());
+		return false;
+	}
+	Section.Expressions.resize(Section.Combos.Static().size());
+	return true;
+}
+
+// Static Indices that no Dynamic Combo survives the SKIPs in
+static void FindDead(Section_t &Section)
+{
+	const CLuxComboSet &Combos = Section.Combos;
+	int64_t nDynamic = Combos.NumDynamicIndices();
+	std::vector<int> Values;
+	Section.Dead.assign((size_t)Combos.NumStaticIndices(), true);
+	for (int64_t nStatic = 0; nStatic < Combos.NumStaticIndices(); nStatic++)
+	{
+		for (int64_t nIndex = nStatic * nDynamic; nIndex < (nStatic + 1) * nDynamic; nIndex++)
+		{
+			Combos.Decode(nIndex, Values);
+			if (!Combos.IsSkipped(Values))
+			{
+				Section.Dead[nStatic] = false;
+				break;
+			}
+		}
+	}
+}
+
+static bool LoadMap(const std::string &Path, const std::string &FxcDir, Map_t &Map)
+{
+	std::string Data;
+	if (!LuxReadFile(Path.c_str(), Data))
+	{
+		fprintf(stderr, "Can't read %s\n", Path.c_str());
+		return false;
+	}
+	Map.Path = Path;
+
+	size_t nStart = 0;
+	int nLine = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = Data.substr(nStart, nEnd - nStart);
+		nStart = nEnd + 1;
+		nLine++;
+
+		size_t nComment = Line.find("//");
+		if (nComment != std::string::npos)
+			Line.resize(nComment);
+		Line = LuxTrim(Line);
+		if (Line.empty())
+			continue;
+
+		size_t nSpace = Line.find_first_of(" \t");
+		std::string Directive = Line.substr(0, nSpace);
+		std::string Rest = nSpace == std::string::npos ? "" : LuxTrim(Line.substr(nSpace));
+
+		if (Directive == "material" && !Rest.empty())
+			Map.Materials.push_back(ToLower(Rest));
+		else if (Directive == "fxc" && !Rest.empty())
+		{
+			Map.Sections.push_back(Section_t());
+			Map.Sections.back().Name = Rest;
+			if (!LoadSection(FxcDir, Map.Sections.back()))
+				return false;
+		}
+		else if (Directive == "combo" && !Map.Sections.empty())
+		{
+			Section_t &Section = Map.Sections.back();
+			nSpace = Rest.find_first_of(" \t");
+			std::string Name = Rest.substr(0, nSpace);
+			std::string Expression = nSpace == std::string::npos ? "" : LuxTrim(Rest.substr(nSpace));
+
+			int nCombo = -1;
+			for (size_t n = 0; n < Section.Combos.Static().size(); n++)
+			{
+				if (Section.Combos.Static()[n].Name == Name)
+					nCombo = (int)n;
+			}
+			if (nCombo < 0 || Expression.empty())
+			{
+				fprintf(stderr, "%s(%d) : %s isn't a Static Combo of %s, or has no Expression\n", Path.c_str(), nLine, Name.c_str(), Section.Name.c_str());
+				return false;
+			}
+			Section.Expressions[nCombo] = Expression == "*" ? "" : Expression;
+		}
+		else
+		{
+			fprintf(stderr, "%s(%d) : Can't parse '%s'\n", Path.c_str(), nLine, Line.c_str());
+			return false;
+		}
+	}
+
+	for (size_t n = 0; n < Map.Sections.size(); n++)
+		FindDead(Map.Sections[n]);
+	return true;
+}
+
+//==========================================================================//
+// VMTs. Only the Root Block matters, Fallback and Proxy Blocks are skipped
+//==========================================================================//
+struct Material_t
+{
+	std::string Shader;							// Lowercase
+	std::vector<std::pair<std::string, std::string> > Params;	// Lowercase Keys
+
+	void Set(const std::string &Key, const std::string &Value)
+	{
+		std::string Lower = ToLower(Key);
+		for (size_t n = 0; n < Params.size(); n++)
+		{
+			if (Params[n].first == Lower)
+			{
+				Params[n].second = Value;
+				return;
+			}
+		}
+		Params.push_back(std::make_pair(Lower, Value));
+	}
+
+	const std::string *Find(const std::string &Key) const
+	{
+		for (size_t n = 0; n < Params.size(); n++)
+		{
+			if (Params[n].first == Key)
+				return &Params[n].second;
+		}
+		return NULL;
+	}
+};
+
+static void Tokenize(const std::string &Data, std::vector<std::string> &Tokens)
+{
+	size_t nPos = 0;
+	while (nPos < Data.size())
+	{
+		char c = Data[nPos];
+		if (isspace((unsigned char)c))
+			nPos++;
+		else if (!Data.compare(nPos, 2, "//"))
+		{
+			nPos = Data.find('\n', nPos);
+			if (nPos == std::string::npos)
+				nPos = Data.size();
+		}
+		else if (c == '"')
+		{
+			size_t nEnd = Data.find('"', nPos + 1);
+			if (nEnd == std::string::npos)
+				nEnd = Data.size();
+			Tokens.push_back(Data.substr(nPos + 1, nEnd - nPos - 1));
+			nPos = nEnd + 1;
+		}
+		else if (c == '{' || c == '}')
+		{
+			Tokens.push_back(std::string(1, c));
+			nPos++;
+		}
+		else
+		{
+			size_t nEnd = nPos;
+			while (nEnd < Data.size() && !isspace((unsigned char)Data[nEnd]) && !strchr("\"{}", Data[nEnd]))
+				nEnd++;
+			Tokens.push_back(Data.substr(nPos, nEnd - nPos));
+			nPos = nEnd;
+		}
+	}
+}
+
+// Key Value Pairs of the Block starting after Tokens[nPos] == "{". Sub-Blocks go to pBlocks by lowercase Name, or are skipped
+static bool ParseBlock(const std::vector<std::string> &Tokens, size_t &nPos, Material_t &Material, std::vector<std::pair<std::string, Material_t> > *pBlocks)
+{
+	while (nPos < Tokens.size())
+	{
+		if (Tokens[nPos] == "}")
+		{
+			nPos++;
+			return true;
+		}
+		if (nPos + 1 >= Tokens.size())
+			return false;
+
+		const std::string &Key = Tokens[nPos];
+		if (Tokens[nPos + 1] == "{")
+		{
+			nPos += 2;
+			Material_t Block;
+			if (!ParseBlock(Tokens, nPos, Block, NULL))
+				return false;
+			if (pBlocks)
+				pBlocks->push_back(std::make_pair(ToLower(Key), Block));
+			continue;
+		}
+
+		Material.Set(Key, Tokens[nPos + 1]);
+		nPos += 2;
+	}
+	return false;
+}
+
+// Trees are the -materials Roots, a patch's "materials/x.vmt" include is looked up in each of their Parents
+static bool LoadVMT(const std::string &Path, const std::vector<std::string> &Trees, Material_t &Material, int nDepth = 0)
+{
+	std::string Data;
+	if (nDepth > 8 || !LuxReadFile(Path.c_str(), Data))
+		return false;
+
+	std::vector<std::string> Tokens;
+	Tokenize(Data, Tokens);
+	if (Tokens.size() < 2 || Tokens[1] != "{")
+		return false;
+
+	Material_t Root;
+	std::vector<std::pair<std::string, Material_t> > Blocks;
+	size_t nPos = 2;
+	if (!ParseBlock(Tokens, nPos, Root, &Blocks))
+		return false;
+
+	if (ToLower(Tokens[0]) != "patch")
+	{
+		Material = Root;
+		Material.Shader = ToLower(Tokens[0]);
+		return true;
+	}
+
+	const std::string *pInclude = Root.Find("include");
+	if (!pInclude)
+		return false;
+
+	bool bLoaded = false;
+	for (size_t n = 0; n < Trees.size() && !bLoaded; n++)
+	{
+		// <Game>/materials/ + materials/x.vmt -> <Game>/materials/x.vmt
+		std::string Tree = Trees[n];
+		while (!Tree.empty() && IsPathSeparator(Tree[Tree.size() - 1]))
+			Tree.resize(Tree.size() - 1);
+		std::string Game = LuxDirectoryOf(Tree);
+		bLoaded = LoadVMT(Game + *pInclude, Trees, Material, nDepth + 1);
+	}
+	if (!bLoaded)
+		return false;
+
+	for (size_t n = 0; n < Blocks.size(); n++)
+	{
+		if (Blocks[n].first != "replace" && Blocks[n].first != "insert")
+			continue;
+		const Material_t &Block = Blocks[n].second;
+		for (size_t i = 0; i < Block.Params.size(); i++)
+			Material.Set(Block.Params[i].first, Block.Params[i].second);
+	}
+	return true;
+}
+
+// A String ( Texture Name ) is 1, a Number its Value, missing is 0
+static int ParamValue(const Material_t &Material, const std::string &Key)
+{
+	const std::string *pValue = Material.Find(Key);
+	if (!pValue)
+		return 0;
+
+	std::string Value = LuxTrim(*pValue);
+	if (Value.empty())
+		return 0;
+
+	char *pEnd;
+	double flValue = strtod(Value.c_str(), &pEnd);
+	if (pEnd != Value.c_str() && *pEnd == 0)
+		return (int)flValue || flValue == 0.0 ? (int)flValue : 1;	// 0.5 is still set
+	return 1;
+}
+
+static bool Evaluate(const std::string &Expression, const Material_t &Material, int &nValue)
+{
+	std::string Text;
+	for (size_t n = 0; n < Expression.size(); n++)
+	{
+		if (Expression[n] != '$')
+		{
+			Text += Expression[n];
+			continue;
+		}
+
+		size_t nEnd = n + 1;
+		while (nEnd < Expression.size() && LuxIsIdentChar(Expression[nEnd]))
+			nEnd++;
+
+		char szValue[16];
+		snprintf(szValue, sizeof(szValue), "%d", ParamValue(Material, ToLower(Expression.substr(n, nEnd - n))));
+		Text += szValue;
+		n = nEnd - 1;
+	}
+
+	int64_t nResult;
+	if (!CLuxExpression::Evaluate(Text, nResult))
+		return false;
+	nValue = (int)nResult;
+	return true;
+}
+
+//==========================================================================//
+// Scan
+//==========================================================================//
+struct Usage_t
+{
+	std::vector<std::vector<int64_t> > Materials;	// [Map Section][Static Index]
+	std::vector<std::pair<std::string, int> > Unmapped;	// VMT Shader, Count
+	std::vector<std::string> Errors;
+	int nParsed;
+	int nMapped;
+};
+
+struct Scan_t
+{
+	const std::vector<std::string> *pFiles;
+	const std::vector<std::string> *pTrees;
+	const std::vector<Map_t> *pMaps;
+	std::vector<const Section_t *> Sections;	// Flattened, Usage_t::Materials Order
+	std::vector<int> FirstSection;			// Per Map
+	std::atomic<size_t> nNext;
+};
+
+// Every Static Index the Material can end up in, Draw Time Combos expanded
+static void UseMaterial(const Section_t &Section, const Material_t &Material, const std::string &Path, std::vector<int64_t> &Counts, std::vector<std::string> &Errors)
+{
+	const std::vector<LuxCombo_t> &Static = Section.Combos.Static();
+	std::vector<int> First(Static.size()), Last(Static.size());
+	for (size_t n = 0; n < Static.size(); n++)
+	{
+		First[n] = Static[n].nMin;
+		Last[n] = Static[n].nMax;
+		if (Section.Expressions[n].empty())
+			continue;
+
+		int nValue;
+		if (!Evaluate(Section.Expressions[n], Material, nValue) || nValue < Static[n].nMin || nValue > Static[n].nMax)
+		{
+			Errors.push_back(Path + " : " + Static[n].Name + " = " + Section.Expressions[n] + " is out of Range in " + Section.Name + ", keeping every Value");
+			continue;
+		}
+		First[n] = Last[n] = nValue;
+	}
+
+	std::vector<int> Values = First;
+	while (true)
+	{
+		int64_t nIndex = 0, nScale = 1;
+		for (size_t n = 0; n < Static.size(); n++)
+		{
+			nIndex += (Values[n] - Static[n].nMin) * nScale;
+			nScale *= Static[n].Count();
+		}
+		if (!Section.Dead[nIndex])
+			Counts[nIndex]++;
+
+		size_t n = 0;
+		for (; n < Static.size(); n++)
+		{
+			if (++Values[n] <= Last[n])
+				break;
+			Values[n] = First[n];
+		}
+		if (n == Static.size())
+			break;
+	}
+}
+
+static void ScanThread(Scan_t *pScan, Usage_t *pUsage)
+{
+	const std::vector<Map_t> &Maps = *pScan->pMaps;
+	pUsage->nParsed = pUsage->nMapped = 0;
+	pUsage->Materials.resize(pScan->Sections.size());
+	for (size_t n = 0; n < pScan->Sections.size(); n++)
+		pUsage->Materials[n].assign(pScan->Sections[n]->Dead.size(), 0);
+
+	for (size_t nFile = pScan->nNext++; nFile < pScan->pFiles->size(); nFile = pScan->nNext++)
+	{
+		const std::string &Path = (*pScan->pFiles)[nFile];
+		Material_t Material;
+		if (!LoadVMT(Path, *pScan->pTrees, Material))
+		{
+			pUsage->Errors.push_back(Path + " : Can't parse");
+			continue;
+		}
+		pUsage->nParsed++;
+
+		int nMap = -1;
+		for (size_t n = 0; n < Maps.size() && nMap < 0; n++)
+		{
+			if (std::find(Maps[n].Materials.begin(), Maps[n].Materials.end(), Material.Shader) != Maps[n].Materials.end())
+				nMap = (int)n;
+		}
+
+		if (nMap < 0)
+		{
+			size_t n = 0;
+			while (n < pUsage->Unmapped.size() && pUsage->Unmapped[n].first != Material.Shader)
+				n++;
+			if (n == pUsage->Unmapped.size())
+				pUsage->Unmapped.push_back(std::make_pair(Material.Shader, 0));
+			pUsage->Unmapped[n].second++;
+			continue;
+		}
+
+		pUsage->nMapped++;
+		for (size_t n = 0; n < Maps[nMap].Sections.size(); n++)
+		{
+			int nSection = pScan->FirstSection[nMap] + (int)n;
+			UseMaterial(Maps[nMap].Sections[n], Material, Path, pUsage->Materials[nSection], pUsage->Errors);
+		}
+	}
+}
+
+//==========================================================================//
+// Output
+//==========================================================================//
+// Counts are Materials, Drawn are Draws from -usage. Either keeps a Static Combo
+static bool WriteWhitelist(const std::string &Path, const Section_t &Section, const std::vector<int64_t> &Counts, const std::vector<int64_t> &Drawn, int nMaterials)
+{
+	int64_t nUsed = 0, nLive = 0;
+	for (size_t n = 0; n < Counts.size(); n++)
+	{
+		nUsed += Counts[n] || Drawn[n] ? 1 : 0;
+		nLive += Section.Dead[n] ? 0 : 1;
+	}
+
+	std::string Out;
+	char szLine[256];
+	snprintf(szLine, sizeof(szLine), "// Written by lux_combo_whitelist from %d Materials, don't edit\n// %lld of %lld live Static Combos\n// Index	Materials	Draws	Combos\n",
+		nMaterials, (long long)nUsed, (long long)nLive);
+	Out += szLine;
+
+	const std::vector<LuxCombo_t> &Static = Section.Combos.Static();
+	for (size_t nIndex = 0; nIndex < Counts.size(); nIndex++)
+	{
+		if (!Counts[nIndex] && !Drawn[nIndex])
+			continue;
+
+		snprintf(szLine, sizeof(szLine), "%lld\t%lld\t%lld\t", (long long)nIndex, (long long)Counts[nIndex], (long long)Drawn[nIndex]);
+		Out += szLine;
+		int64_t nRest = (int64_t)nIndex;
+		for (size_t n = 0; n < Static.size(); n++)
+		{
+			snprintf(szLine, sizeof(szLine), "%s%s=%d", n ? " " : "", Static[n].Name.c_str(), Static[n].nMin + (int)(nRest % Static[n].Count()));
+			nRest /= Static[n].Count();
+			Out += szLine;
+		}
+		Out += "\n";
+	}
+	return LuxWriteFile(Path.c_str(), Out);
+}
+
+// SKIP: !(($A == 0 && $B == 1) || ..), after the last Combo Declaration
+static bool ApplyWhitelist(const std::string &Path, const Section_t &Section, const std::vector<int64_t> &Counts)
+{
+	std::string Source;
+	if (!LuxReadFile(Path.c_str(), Source))
+		return false;
+	Source = StripWhitelist(Source);
+
+	const std::vector<LuxCombo_t> &Static = Section.Combos.Static();
+	std::string Expression;
+	for (size_t nIndex = 0; nIndex < Counts.size(); nIndex++)
+	{
+		if (!Counts[nIndex])
+			continue;
+
+		Expression += Expression.empty() ? "(" : " || (";
+		int64_t nRest = (int64_t)nIndex;
+		for (size_t n = 0; n < Static.size(); n++)
+		{
+			char szTerm[128];
+			snprintf(szTerm, sizeof(szTerm), "%s$%s == %d", n ? " && " : "", Static[n].Name.c_str(), Static[n].nMin + (int)(nRest % Static[n].Count()));
+			nRest /= Static[n].Count();
+			Expression += szTerm;
+		}
+		Expression += ")";
+	}
+
+	// Nothing uses the Shader. Compile it whole rather than shipping an empty one
+	if (Expression.empty())
+		return true;
+
+	size_t nInsert = 0;
+	const char *pDeclarations[] = { "STATIC:", "DYNAMIC:", "SKIP:" };
+	for (int n = 0; n < 3; n++)
+	{
+		for (size_t nPos = Source.find(pDeclarations[n]); nPos != std::string::npos; nPos = Source.find(pDeclarations[n], nPos + 1))
+		{
+			size_t nEnd = Source.find('\n', nPos);
+			nInsert = std::max(nInsert, nEnd == std::string::npos ? Source.size() : nEnd + 1);
+		}
+	}
+
+	std::string Block = std::string(s_pWhitelistBegin) + "\n// SKIP: !(" + Expression + ")\n" + s_pWhitelistEnd + "\n";
+	Source.insert(nInsert, Block);
+	return LuxWriteFile(Path.c_str(), Source);
+}
+
+static bool ClearWhitelist(const std::string &Path)
+{
+	std::string Source;
+	if (!LuxReadFile(Path.c_str(), Source))
+		return false;
+
+	bool bStripped;
+	Source = StripWhitelist(Source, &bStripped);
+	return !bStripped || LuxWriteFile(Path.c_str(), Source);
+}
+
+static std::string WithSeparator(std::string Dir)
+{
+	if (!Dir.empty() && !IsPathSeparator(Dir[Dir.size() - 1]))
+		Dir += '/';
+	return Dir;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	std::string FxcDir = WithSeparator(CommandLine.ParmValue("-fxc", "../../shaders/fxc"));
+	std::string OutDir = WithSeparator(CommandLine.ParmValue("-out", FxcDir.c_str()));
+	int nThreads = std::max(1, CommandLine.ParmValue("-threads", (int)std::thread::hardware_concurrency()));
+	bool bApply = CommandLine.HasParm("-apply");
+	bool bVerbose = CommandLine.HasParm("-verbose");
+
+	std::vector<std::string> MapFiles;
+	LuxFindFiles(FxcDir, ".combomap", MapFiles);
+
+	if (CommandLine.HasParm("-clear"))
+	{
+		int nFailed = 0;
+		std::vector<std::string> FxcFiles;
+		LuxFindFiles(FxcDir, ".fxc", FxcFiles);
+		for (size_t n = 0; n < FxcFiles.size(); n++)
+		{
+			if (!ClearWhitelist(FxcFiles[n]))
+			{
+				fprintf(stderr, "Can't clear %s\n", FxcFiles[n].c_str());
+				nFailed++;
+			}
+		}
+		return nFailed ? 1 : 0;
+	}
+
+	std::vector<std::string> Trees;
+	std::vector<LuxComboUsage_t> Drawn;
+	for (int n = 1; n + 1 < argc; n++)
+	{
+		if (!strcmp(argv[n], "-materials"))
+			Trees.push_back(argv[++n]);
+		else if (!strcmp(argv[n], "-usage"))
+		{
+			std::vector<LuxComboUsage_t> Manifest;
+			if (!LuxReadComboUsage(argv[++n], Manifest))
+			{
+				fprintf(stderr, "Can't read %s\n", argv[n]);
+				return 1;
+			}
+			LuxMergeComboUsage(Drawn, Manifest);
+		}
+	}
+
+	if (Trees.empty() && Drawn.empty())
+	{
+		fprintf(stderr, "Usage: lux_combo_whitelist -materials <dir> [-materials <dir> ..] [-usage <manifest> ..] [-fxc dir] [-out dir] [-threads N] [-apply] [-clear] [-verbose]\n");
+		return 1;
+	}
+
+	std::vector<Map_t> Maps(MapFiles.size());
+	for (size_t n = 0; n < MapFiles.size(); n++)
+	{
+		if (!LoadMap(MapFiles[n], FxcDir, Maps[n]))
+			return 1;
+	}
+
+	Scan_t Scan;
+	for (size_t n = 0; n < Maps.size(); n++)
+	{
+		Scan.FirstSection.push_back((int)Scan.Sections.size());
+		for (size_t i = 0; i < Maps[n].Sections.size(); i++)
+		{
+			const Section_t &Section = Maps[n].Sections[i];
+			Scan.Sections.push_back(&Section);
+			for (size_t nCombo = 0; nCombo < Section.Expressions.size(); nCombo++)
+			{
+				if (Section.Expressions[nCombo].empty() && bVerbose)
+					printf("%s : %s is kept whole\n", Section.Name.c_str(), Section.Combos.Static()[nCombo].Name.c_str());
+			}
+		}
+	}
+
+	std::vector<std::string> Files;
+	double flStart = LuxTimeSeconds();
+	for (size_t n = 0; n < Trees.size(); n++)
+		LuxFindFiles(Trees[n], ".vmt", Files);
+
+	Scan.pFiles = &Files;
+	Scan.pTrees = &Trees;
+	Scan.pMaps = &Maps;
+	Scan.nNext = 0;
+
+	std::vector<Usage_t> Usages(nThreads);
+	std::vector<std::thread> Threads;
+	for (int n = 0; n < nThreads; n++)
+		Threads.push_back(std::thread(ScanThread, &Scan, &Usages[n]));
+	for (int n = 0; n < nThreads; n++)
+		Threads[n].join();
+	double flScan = LuxTimeSeconds() - flStart;
+
+	// Merge
+	Usage_t Total = Usages[0];
+	for (int nThread = 1; nThread < nThreads; nThread++)
+	{
+		const Usage_t &Usage = Usages[nThread];
+		Total.nParsed += Usage.nParsed;
+		Total.nMapped += Usage.nMapped;
+		Total.Errors.insert(Total.Errors.end(), Usage.Errors.begin(), Usage.Errors.end());
+		for (size_t n = 0; n < Usage.Materials.size(); n++)
+		{
+			for (size_t nIndex = 0; nIndex < Usage.Materials[n].size(); nIndex++)
+				Total.Materials[n][nIndex] += Usage.Materials[n][nIndex];
+		}
+		for (size_t n = 0; n < Usage.Unmapped.size(); n++)
+		{
+			size_t i = 0;
+			while (i < Total.Unmapped.size() && Total.Unmapped[i].first != Usage.Unmapped[n].first)
+				i++;
+			if (i == Total.Unmapped.size())
+				Total.Unmapped.push_back(std::make_pair(Usage.Unmapped[n].first, 0));
+			Total.Unmapped[i].second += Usage.Unmapped[n].second;
+		}
+	}
+
+	std::sort(Total.Errors.begin(), Total.Errors.end());
+	for (size_t n = 0; n < Total.Errors.size(); n++)
+		fprintf(stderr, "%s\n", Total.Errors[n].c_str());
+	if (bVerbose)
+	{
+		for (size_t n = 0; n < Total.Unmapped.size(); n++)
+			printf("No Combo Map for %s ( %d Materials )\n", Total.Unmapped[n].first.c_str(), Total.Unmapped[n].second);
+	}
+
+	printf("%d Materials in %.2f s on %d Threads, %d parsed, %d use a mapped Shader\n\n", (int)Files.size(), flScan, nThreads, Total.nParsed, Total.nMapped);
+	printf("%-32s %10s %10s %10s %8s %10s\n", "Shader", "Static", "Live", "Used", "Used %", "Only drawn");
+
+	int nFailed = 0;
+	for (size_t nSection = 0; nSection < Scan.Sections.size(); nSection++)
+	{
+		const Section_t &Section = *Scan.Sections[nSection];
+		const std::vector<int64_t> &Counts = Total.Materials[nSection];
+
+		// -usage Draws by Static Index
+		std::vector<int64_t> Draws(Counts.size(), 0);
+		int64_t nDynamic = Section.Combos.NumDynamicIndices();
+		for (size_t n = 0; n < Drawn.size(); n++)
+		{
+			int64_t nStatic = Drawn[n].nCombo / nDynamic;
+			if (Drawn[n].Shader == Section.Name && nStatic < (int64_t)Draws.size())
+				Draws[nStatic] += (int64_t)Drawn[n].nDraws;
+		}
+
+		std::vector<int64_t> Kept(Counts.size());
+		int64_t nUsed = 0, nLive = 0, nOnlyDrawn = 0;
+		for (size_t n = 0; n < Counts.size(); n++)
+		{
+			Kept[n] = Counts[n] || Draws[n] ? 1 : 0;
+			nUsed += Kept[n];
+			nOnlyDrawn += !Counts[n] && Draws[n] ? 1 : 0;
+			nLive += Section.Dead[n] ? 0 : 1;
+		}
+		printf("%-32s %10lld %10lld %10lld %7.1f%% %10lld\n", Section.Name.c_str(), (long long)Counts.size(), (long long)nLive, (long long)nUsed,
+			nLive ? 100.0 * nUsed / nLive : 0.0, (long long)nOnlyDrawn);
+
+		std::string WhitelistPath = OutDir + Section.Name + ".whitelist";
+		if (!WriteWhitelist(WhitelistPath, Section, Counts, Draws, Total.nMapped))
+		{
+			fprintf(stderr, "Can't write %s\n", WhitelistPath.c_str());
+			nFailed++;
+		}
+
+		if (bApply && !ApplyWhitelist(FxcDir + Section.Name + ".fxc", Section, Kept))
+		{
+			fprintf(stderr, "Can't apply the Whitelist to %s.fxc\n", Section.Name.c_str());
+			nFailed++;
+		}
+	}
+
+	return nFailed ? 1 : 0;
+}
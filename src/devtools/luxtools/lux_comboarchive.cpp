@@ -0,0 +1,312 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Packs Combo Blobs into cpp_lux_comboarchive.h Archives, in Startup Order
+//
+//	Takes the Blobs lux_shaderwatch publishes ( <blobs>/<shader>/<combo index>.bin ) and writes one
+//	<out>/<shader>.luxarc per Shader. With -trace ( a cpp_lux_combousage.h Manifest, lux_combousage merges them )
+//	the Combos drawn at Startup go first, in First Use Order, and become the Preload Span. -layout index
+//	writes plain Combo Index Order, for comparing.
+//	A Manifest holds the whole Session, so -startup says where Startup ends : Combos whose First Use is below it.
+//	First Use counts distinct Combos in the Order they were first drawn, over all Shaders of a Session,
+//	so -startup 2000 is the first 2000 Combos the Game bound. Merged Manifests keep the earliest Session's.
+//
+//	-bench writes a synthetic Shader both Ways and times loading its Startup Combos from a cold Page Cache :
+//	Index Order reads each Combo where it is, Startup Order reads the Preload Span once. Linux only,
+//	the Cache is dropped per File with posix_fadvise(), which needs no Root. mincore() checks it really was,
+//	the Residency after Eviction is printed, with 0% the Times are cold.
+//
+//	Usage :	lux_comboarchive -blobs <dir> [-trace lux_combousage.txt -startup N] [-layout usage|index] [-out .]
+//			lux_comboarchive -bench [-combos 20000] [-bytes 4096] [-trace 800] [-runs 5] [-dir .]
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+#include "../../shaders/fxc/cpp_lux_combousage.h"
+#include "../../shaders/fxc/cpp_lux_comboarchive.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+//==========================================================================//
+// -bench
+//==========================================================================//
+#ifdef __linux__
+// Drops the File's Pages. Returns the Fraction still resident afterwards
+static double EvictFile(const char *pPath)
+{
+	int nFD = open(pPath, O_RDONLY);
+	if (nFD < 0)
+		return 1.0;
+	fdatasync(nFD);
+	posix_fadvise(nFD, 0, 0, POSIX_FADV_DONTNEED);
+
+	struct stat Info;
+	double flResident = 1.0;
+	if (fstat(nFD, &Info) == 0 && Info.st_size > 0)
+	{
+		void *pMap = mmap(NULL, Info.st_size, PROT_READ, MAP_SHARED, nFD, 0);
+		if (pMap != MAP_FAILED)
+		{
+			size_t nPage = sysconf(_SC_PAGESIZE);
+			std::vector<unsigned char> Resident((Info.st_size + nPage - 1) / nPage);
+			if (mincore(pMap, Info.st_size, &Resident[0]) == 0)
+			{
+				size_t nResident = 0;
+				for (size_t n = 0; n < Resident.size(); n++)
+					nResident += Resident[n] & 1;
+				flResident = (double)nResident / Resident.size();
+			}
+			munmap(pMap, Info.st_size);
+		}
+	}
+	close(nFD);
+	return flResident;
+}
+
+// Startup : every traced Combo, in Trace Order. Returns Seconds, 0 on a wrong Blob
+static double LoadStartup(const char *pPath, const std::vector<uint32_t> &Trace, uint64_t nExpected, bool bPreload)
+{
+	double flStart = LuxTimeSeconds();
+	CLuxComboArchive Archive;
+	if (!Archive.Open(pPath) || (bPreload && !Archive.Preload()))
+		return 0.0;
+
+	uint64_t nHash = 0;
+	std::vector<unsigned char> Blob;
+	for (size_t n = 0; n < Trace.size(); n++)
+	{
+		uint32_t nSize;
+		const unsigned char *pBlob = Archive.Find(Trace[n], nSize);
+		if (!pBlob)
+		{
+			if (!Archive.Read(Trace[n], Blob))
+				return 0.0;
+			pBlob = &Blob[0];
+			nSize = (uint32_t)Blob.size();
+		}
+		nHash += LuxHashBytes(pBlob, nSize);
+	}
+	double flSeconds = LuxTimeSeconds() - flStart;
+	return nHash == nExpected ? flSeconds : 0.0;
+}
+
+static double Median(std::vector<double> Values)
+{
+	std::sort(Values.begin(), Values.end());
+	return Values.empty() ? 0.0 : Values[Values.size() / 2];
+}
+
+static int Bench(const CLuxCommandLine &CommandLine)
+{
+	int nCombos = std::max(1, CommandLine.ParmValue("-combos", 20000));
+	int nBytes = std::max(16, CommandLine.ParmValue("-bytes", 4096));
+	int nTrace = std::max(1, std::min(nCombos, CommandLine.ParmValue("-trace", 800)));
+	int nRuns = std::max(1, CommandLine.ParmValue("-runs", 5));
+	std::string Dir = CommandLine.ParmValue("-dir", ".");
+	if (!Dir.empty() && Dir[Dir.size() - 1] != '/')
+		Dir += '/';
+	std::string IndexPath = Dir + "lux_comboarchive_bench_index.luxarc";
+	std::string StartupPath = Dir + "lux_comboarchive_bench_startup.luxarc";
+
+	// Blobs between half and one and a half Times -bytes. The Trace is spread over the whole Index Range,
+	// like a Level's Materials are over the Static Combos
+	std::vector<std::vector<unsigned char> > Blobs(nCombos);
+	for (int n = 0; n < nCombos; n++)
+	{
+		Blobs[n].resize(nBytes / 2 + LuxHash(n) % nBytes);
+		for (size_t i = 0; i < Blobs[n].size(); i++)
+			Blobs[n][i] = (unsigned char)LuxHash((uint32_t)(n * 7919 + i));
+	}
+
+	std::vector<uint32_t> Shuffled(nCombos);
+	for (int n = 0; n < nCombos; n++)
+		Shuffled[n] = n;
+	for (int n = nCombos - 1; n > 0; n--)
+		std::swap(Shuffled[n], Shuffled[LuxHash(n + 12345) % (n + 1)]);
+	std::vector<uint32_t> Trace(Shuffled.begin(), Shuffled.begin() + nTrace);
+
+	uint64_t nExpected = 0;
+	std::vector<bool> Traced(nCombos, false);
+	for (size_t n = 0; n < Trace.size(); n++)
+	{
+		nExpected += LuxHashBytes(&Blobs[Trace[n]][0], Blobs[Trace[n]].size());
+		Traced[Trace[n]] = true;
+	}
+
+	CLuxComboArchiveWriter IndexOrder, StartupOrder;
+	for (int n = 0; n < nCombos; n++)
+		IndexOrder.Add(n, &Blobs[n][0], (uint32_t)Blobs[n].size(), false);
+	for (size_t n = 0; n < Trace.size(); n++)
+		StartupOrder.Add(Trace[n], &Blobs[Trace[n]][0], (uint32_t)Blobs[Trace[n]].size(), true);
+	for (int n = 0; n < nCombos; n++)
+	{
+		if (!Traced[n])
+			StartupOrder.Add(n, &Blobs[n][0], (uint32_t)Blobs[n].size(), false);
+	}
+	if (!IndexOrder.Write(IndexPath.c_str()) || !StartupOrder.Write(StartupPath.c_str()))
+	{
+		fprintf(stderr, "Can't write the Archives to %s\n", Dir.c_str());
+		return 1;
+	}
+
+	CLuxComboArchive Archive;
+	Archive.Open(StartupPath.c_str());
+	double flPreloadMB = Archive.Header().nPreloadSize / (1024.0 * 1024.0);
+	Archive.Close();
+
+	// Alternating, so neither Layout always runs second
+	std::vector<double> IndexTimes, StartupTimes;
+	double flResident = 0.0;
+	bool bWrong = false;
+	for (int nRun = 0; nRun < nRuns; nRun++)
+	{
+		for (int nPass = 0; nPass < 2; nPass++)
+		{
+			bool bStartup = (nPass ^ nRun) & 1;
+			const std::string &Path = bStartup ? StartupPath : IndexPath;
+			flResident = std::max(flResident, EvictFile(Path.c_str()));
+			double flSeconds = LoadStartup(Path.c_str(), Trace, nExpected, bStartup);
+			bWrong |= flSeconds == 0.0;
+			(bStartup ? StartupTimes : IndexTimes).push_back(flSeconds);
+		}
+	}
+	remove(IndexPath.c_str());
+	remove(StartupPath.c_str());
+
+	double flIndex = Median(IndexTimes), flStartup = Median(StartupTimes);
+	printf("%d Combos, %d at Startup ( %.1f MB ), %d Runs, at most %.1f%% of a File resident after Eviction\n\n", nCombos, nTrace, flPreloadMB, nRuns, flResident * 100.0);
+	printf("                   cold Startup Load ( Median )\n");
+	printf("Index Order        %8.2f ms   %d Reads\n", flIndex * 1e3, nTrace);
+	printf("Startup Order      %8.2f ms   1 Read\n", flStartup * 1e3);
+	printf("Speedup            %8.1fx\n", flStartup > 0.0 ? flIndex / flStartup : 0.0);
+	if (bWrong)
+		printf("Wrong Blobs read back\n");
+	return bWrong ? 1 : 0;
+}
+#endif
+
+//==========================================================================//
+// Packing
+//==========================================================================//
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	if (CommandLine.HasParm("-bench"))
+	{
+#ifdef __linux__
+		return Bench(CommandLine);
+#else
+		fprintf(stderr, "-bench needs posix_fadvise() and mincore(), it's Linux only\n");
+		return 1;
+#endif
+	}
+
+	const char *pBlobs = CommandLine.ParmValue("-blobs", (const char *)NULL);
+	const char *pTrace = CommandLine.ParmValue("-trace", (const char *)NULL);
+	int nStartup = CommandLine.ParmValue("-startup", 0);
+	bool bIndexLayout = !strcmp(CommandLine.ParmValue("-layout", "usage"), "index");
+	std::string OutDir = CommandLine.ParmValue("-out", ".");
+	if (!OutDir.empty() && OutDir[OutDir.size() - 1] != '/' && OutDir[OutDir.size() - 1] != '\\')
+		OutDir += '/';
+
+	// Without a Window the Preload would be every Combo the Session ever drew
+	if (!pBlobs || (pTrace && !bIndexLayout && nStartup <= 0))
+	{
+		fprintf(stderr, "Usage: lux_comboarchive -blobs <dir> [-trace manifest -startup N] [-layout usage|index] [-out dir]\n       lux_comboarchive -bench [-combos N] [-bytes N] [-trace N] [-runs N] [-dir dir]\n");
+		return 1;
+	}
+
+	// First Use per Shader and Combo
+	std::map<std::string, std::map<uint32_t, uint32_t> > FirstUse;
+	if (pTrace && !bIndexLayout)
+	{
+		std::vector<LuxComboUsage_t> Usage;
+		if (!LuxReadComboUsage(pTrace, Usage))
+		{
+			fprintf(stderr, "Can't read %s\n", pTrace);
+			return 1;
+		}
+		int nLate = 0;
+		for (size_t n = 0; n < Usage.size(); n++)
+		{
+			if (Usage[n].nFirstUse < (uint32_t)nStartup)
+				FirstUse[Usage[n].Shader][Usage[n].nCombo] = Usage[n].nFirstUse;
+			else
+				nLate++;
+		}
+		printf("%d of %d traced Combos are in the Startup Window ( First Use < %d )\n\n", (int)Usage.size() - nLate, (int)Usage.size(), nStartup);
+	}
+
+	// <blobs>/<shader>/<combo index>.bin, sorted, so each Shader's Files are together
+	std::vector<std::string> Files;
+	LuxFindFiles(pBlobs, ".bin", Files);
+	std::map<std::string, std::vector<std::pair<uint32_t, std::string> > > Shaders;
+	for (size_t n = 0; n < Files.size(); n++)
+	{
+		std::string Dir = LuxDirectoryOf(Files[n]);
+		std::string Shader = LuxFileNameOf(Dir.substr(0, Dir.empty() ? 0 : Dir.size() - 1));
+		Shaders[Shader].push_back(std::make_pair((uint32_t)strtoul(LuxFileNameOf(Files[n]).c_str(), NULL, 10), Files[n]));
+	}
+	if (Shaders.empty())
+	{
+		fprintf(stderr, "No Blobs under %s\n", pBlobs);
+		return 1;
+	}
+
+	int nFailed = 0;
+	printf("%-32s %8s %8s %10s %10s\n", "Shader", "Combos", "Preload", "Preload KB", "Total KB");
+	for (std::map<std::string, std::vector<std::pair<uint32_t, std::string> > >::iterator It = Shaders.begin(); It != Shaders.end(); ++It)
+	{
+		std::vector<std::pair<uint32_t, std::string> > &Combos = It->second;
+		std::sort(Combos.begin(), Combos.end());
+
+		// Traced first, in First Use Order, then the Rest in Index Order
+		const std::map<uint32_t, uint32_t> &Trace = FirstUse[It->first];
+		std::vector<std::pair<uint32_t, size_t> > Preload;
+		for (size_t n = 0; n < Combos.size(); n++)
+		{
+			std::map<uint32_t, uint32_t>::const_iterator Use = Trace.find(Combos[n].first);
+			if (Use != Trace.end())
+				Preload.push_back(std::make_pair(Use->second, n));
+		}
+		std::sort(Preload.begin(), Preload.end());
+
+		CLuxComboArchiveWriter Writer;
+		std::vector<bool> Written(Combos.size(), false);
+		uint64_t nPreloadBytes = 0, nTotalBytes = 0;
+		std::string Data;
+		for (size_t nPass = 0; nPass < 2; nPass++)
+		{
+			for (size_t i = 0; i < (nPass ? Combos.size() : Preload.size()); i++)
+			{
+				size_t n = nPass ? i : Preload[i].second;
+				if (Written[n])
+					continue;
+				if (!LuxReadFile(Combos[n].second.c_str(), Data))
+				{
+					fprintf(stderr, "Can't read %s\n", Combos[n].second.c_str());
+					nFailed++;
+					continue;
+				}
+				Writer.Add(Combos[n].first, Data.data(), (uint32_t)Data.size(), !nPass);
+				Written[n] = true;
+				(nPass ? nTotalBytes : nPreloadBytes) += Data.size();
+			}
+		}
+
+		std::string Path = OutDir + It->first + ".luxarc";
+		if (!Writer.Write(Path.c_str()))
+		{
+			fprintf(stderr, "Can't write %s\n", Path.c_str());
+			nFailed++;
+		}
+		printf("%-32s %8d %8d %10.1f %10.1f\n", It->first.c_str(), (int)Combos.size(), (int)Preload.size(), nPreloadBytes / 1024.0, (nPreloadBytes + nTotalBytes) / 1024.0);
+	}
+	return nFailed ? 1 : 0;
+}
@@ -0,0 +1,254 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Writes the packed Combo Key Headers for cpp_lux_combokey.h
+//
+//	Reads the // STATIC:, // DYNAMIC: and // SKIP: Lines of each .fxc and writes <out>/<shader>_combokey.h with
+//	a Static and a Dynamic Key Struct ( Bit Field per Combo, Index() in .inc Order ) and <shader>_IsSkipped().
+//	The Declarations Hash goes into the Header, -check regenerates in Memory and fails on any Difference.
+//
+//	Usage :	lux_combokey_gen [-fxc ../../shaders/fxc] [-out <fxc>/include] [-check] <shader.fxc> ..
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+
+#include <stdarg.h>
+
+struct Shader_t
+{
+	std::string Name;
+	CLuxComboSet Combos;
+	uint64_t nHash;
+};
+
+static std::string Format(const char *pFormat, ...)
+{
+	char szBuffer[1024];
+	va_list Args;
+	va_start(Args, pFormat);
+	vsnprintf(szBuffer, sizeof(szBuffer), pFormat, Args);
+	va_end(Args);
+	return szBuffer;
+}
+
+static int BitsFor(int nCount)
+{
+	int nBits = 0;
+	while ((1 << nBits) < nCount)
+		nBits++;
+	return nBits;
+}
+
+// $NAME -> Static.Get_NAME() or Dynamic.Get_NAME(). False if a Name isn't a Combo
+static bool TranslateSkip(const std::string &Skip, const CLuxComboSet &Combos, std::string &Out)
+{
+	Out.clear();
+	for (size_t n = 0; n < Skip.size(); n++)
+	{
+		if (Skip[n] != '$')
+		{
+			Out += Skip[n];
+			continue;
+		}
+
+		size_t nEnd = n + 1;
+		while (nEnd < Skip.size() && LuxIsIdentChar(Skip[nEnd]))
+			nEnd++;
+		std::string Name = Skip.substr(n + 1, nEnd - n - 1);
+
+		const LuxCombo_t *pCombo = NULL;
+		for (int i = 0; i < Combos.NumCombos() && !pCombo; i++)
+		{
+			if (Combos.Combo(i).Name == Name)
+				pCombo = &Combos.Combo(i);
+		}
+		if (!pCombo)
+		{
+			Out = Name;
+			return false;
+		}
+
+		Out += (pCombo->bStatic ? "Static.Get_" : "Dynamic.Get_") + Name + "()";
+		n = nEnd - 1;
+	}
+	Out = LuxTrim(Out);
+	return true;
+}
+
+// Whole Expression in one Pair of Parentheses, ( a ) && ( b ) isn't
+static bool IsParenthesised(const std::string &Expression)
+{
+	if (Expression.size() < 2 || Expression[0] != '(' || Expression[Expression.size() - 1] != ')')
+		return false;
+
+	int nDepth = 0;
+	for (size_t n = 0; n + 1 < Expression.size(); n++)
+	{
+		nDepth += Expression[n] == '(' ? 1 : (Expression[n] == ')' ? -1 : 0);
+		if (nDepth == 0)
+			return false;
+	}
+	return true;
+}
+
+static void WriteKey(std::string &Out, const std::string &KeyName, const std::vector<LuxCombo_t> &Combos, int64_t nFirstScale)
+{
+	Out += "struct " + KeyName + "\n{\n";
+	Out += "\tLUX_COMBOKEY_BEGIN(" + KeyName + ")\n";
+
+	int nShift = 0;
+	int64_t nScale = nFirstScale;
+	std::string Index;
+	for (size_t n = 0; n < Combos.size(); n++)
+	{
+		const LuxCombo_t &Combo = Combos[n];
+		Out += Format("\tLUX_COMBOKEY_FIELD(%s, %s, %d, %d, %d, %lld)\n", KeyName.c_str(), Combo.Name.c_str(), Combo.nMin, Combo.nMax, nShift, (long long)nScale);
+
+		int nBits = BitsFor(Combo.Count());
+		if (nBits)
+			Index += Format("%s(int)((m_nKey >> %d) & 0x%x) * %lld", Index.empty() ? "" : " + ", nShift, (1 << nBits) - 1, (long long)nScale);
+
+		nShift += nBits;
+		nScale *= Combo.Count();
+	}
+
+	Out += Format("\n\tenum { KEY_BITS = %d, NUM_COMBOS = %lld };\n", nShift, (long long)(nScale / nFirstScale));
+	Out += "\tconstexpr int Index() const { return " + (Index.empty() ? std::string("0") : Index) + "; }\n";
+	Out += "};\n\n";
+	Out += "static_assert(" + KeyName + "::KEY_BITS <= 32, \"" + KeyName + " doesn't fit 32 Bits\");\n\n";
+}
+
+static bool Generate(const Shader_t &Shader, std::string &Out)
+{
+	const CLuxComboSet &Combos = Shader.Combos;
+	std::string Guard = Shader.Name + "_COMBOKEY_H";
+	for (size_t n = 0; n < Guard.size(); n++)
+		Guard[n] = (char)toupper((unsigned char)Guard[n]);
+
+	Out = "//===================== File of the LUX Shader Project =====================//\n";
+	Out += "//\n";
+	Out += "//\tGenerated by lux_combokey_gen from " + Shader.Name + ".fxc, don't edit.\n";
+	Out += Format("//\tDeclarations Hash : 0x%016llx\n", (unsigned long long)Shader.nHash);
+	Out += "//\n";
+	Out += "//==========================================================================//\n\n";
+	Out += "#ifndef " + Guard + "\n#define " + Guard + "\n\n";
+	Out += "#ifdef _WIN32\n#pragma once\n#endif\n\n";
+	Out += "#include \"../cpp_lux_combokey.h\"\n\n";
+
+	std::string StaticKey = Shader.Name + "_StaticKey";
+	std::string DynamicKey = Shader.Name + "_DynamicKey";
+	WriteKey(Out, StaticKey, Combos.Static(), Combos.NumDynamicIndices());
+	WriteKey(Out, DynamicKey, Combos.Dynamic(), 1);
+
+	std::string Condition;
+	for (size_t n = 0; n < Combos.Skips().size(); n++)
+	{
+		std::string Skip;
+		if (!TranslateSkip(Combos.Skips()[n], Combos, Skip))
+		{
+			fprintf(stderr, "%s : SKIP uses $%s, which isn't a Combo\n", Shader.Name.c_str(), Skip.c_str());
+			return false;
+		}
+		if (!IsParenthesised(Skip))
+			Skip = "(" + Skip + ")";
+		Condition += (Condition.empty() ? "" : " ||\n\t\t") + Skip;
+	}
+
+	Out += "// True for Combos the Shader Compiler skipped, there is no Shader for them\n";
+	Out += "constexpr bool " + Shader.Name + "_IsSkipped(" + StaticKey + " Static, " + DynamicKey + " Dynamic)\n{\n";
+	Out += "\treturn " + (Condition.empty() ? std::string("((void)Static, (void)Dynamic, false)") : Condition) + ";\n}\n\n";
+	Out += "#endif // " + Guard + "\n";
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	std::string FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!FxcDir.empty() && FxcDir[FxcDir.size() - 1] != '/' && FxcDir[FxcDir.size() - 1] != '\\')
+		FxcDir += '/';
+	std::string OutDir = CommandLine.ParmValue("-out", (FxcDir + "include").c_str());
+	if (!OutDir.empty() && OutDir[OutDir.size() - 1] != '/' && OutDir[OutDir.size() - 1] != '\\')
+		OutDir += '/';
+	bool bCheck = CommandLine.HasParm("-check");
+
+	std::vector<std::string> Files;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-out") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+			Files.push_back(Arg);
+	}
+
+	if (Files.empty())
+	{
+		fprintf(stderr, "Usage: lux_combokey_gen [-fxc dir] [-out dir] [-check] <shader.fxc> ..\n");
+		return 1;
+	}
+
+	int nFailed = 0;
+	for (size_t n = 0; n < Files.size(); n++)
+	{
+		std::string Path = Files[n].find('/') == std::string::npos && Files[n].find('\\') == std::string::npos ? FxcDir + Files[n] : Files[n];
+		std::string Source;
+		if (!LuxReadFile(Path.c_str(), Source))
+		{
+			fprintf(stderr, "Can't read %s\n", Path.c_str());
+			nFailed++;
+			continue;
+		}
+
+		Shader_t Shader;
+		Shader.Name = LuxFileNameOf(Path);
+		if (Shader.Name.size() > 4 && Shader.Name.compare(Shader.Name.size() - 4, 4, ".fxc") == 0)
+			Shader.Name.resize(Shader.Name.size() - 4);
+		Shader.Combos.Parse(Source);
+
+		// Everything the Layout depends on, in Declaration Order
+		std::string Declarations;
+		for (int i = 0; i < Shader.Combos.NumCombos(); i++)
+		{
+			const LuxCombo_t &Combo = Shader.Combos.Combo(i);
+			Declarations += Format("%s %s %d %d\n", Combo.bStatic ? "STATIC" : "DYNAMIC", Combo.Name.c_str(), Combo.nMin, Combo.nMax);
+		}
+		for (size_t i = 0; i < Shader.Combos.Skips().size(); i++)
+			Declarations += "SKIP " + Shader.Combos.Skips()[i] + "\n";
+		Shader.nHash = LuxHashBytes(Declarations.data(), Declarations.size());
+
+		std::string Header;
+		if (!Generate(Shader, Header))
+		{
+			nFailed++;
+			continue;
+		}
+
+		std::string OutPath = OutDir + Shader.Name + "_combokey.h";
+		if (bCheck)
+		{
+			std::string Existing;
+			bool bMatch = LuxReadFile(OutPath.c_str(), Existing) && Existing == Header;
+			printf("%-32s %s\n", Shader.Name.c_str(), bMatch ? "up to date" : "STALE, rerun lux_combokey_gen");
+			nFailed += bMatch ? 0 : 1;
+			continue;
+		}
+
+		if (!LuxWriteFile(OutPath.c_str(), Header))
+		{
+			fprintf(stderr, "Can't write %s\n", OutPath.c_str());
+			nFailed++;
+			continue;
+		}
+
+		printf("%-32s %d Static ( %lld ), %d Dynamic ( %lld ), %d Skips -> %s\n", Shader.Name.c_str(),
+			(int)Shader.Combos.Static().size(), (long long)Shader.Combos.NumStaticIndices(),
+			(int)Shader.Combos.Dynamic().size(), (long long)Shader.Combos.NumDynamicIndices(),
+			(int)Shader.Combos.Skips().size(), OutPath.c_str());
+	}
+
+	return nFailed ? 1 : 0;
+}
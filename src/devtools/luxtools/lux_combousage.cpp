@@ -0,0 +1,229 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Merges and reports the Combo Usage Manifests cpp_lux_combousage.h writes
+//
+//	Every Playtest with LUX_COMBOUSAGE leaves a lux_combousage.txt. This sums any Number of them into -out
+//	( same Format, most drawn first ) and reports per Shader how many of its live Combos were drawn at all,
+//	and how few Combos take 90% and 99% of the Draws, the Set worth preloading at Startup.
+//	The merged Manifest feeds lux_combo_whitelist -usage ( Pruning ) and lux_shaderwatch -mru.
+//
+//	-bench records on -threads Threads through the Recorder itself, by Name like LUX_COMBOUSAGE_RECORD does.
+//	Names are per-Thread Copies, not Literals, and each of the two Call Sites sees two Shaders.
+//	One Buffer overwritten with another Name has to give the other Shader.
+//	Checks that no Draw was lost or counted twice and that writing twice into the same Manifest doubles it,
+//	Dropped Draws included. Reports ns per Record.
+//
+//	Usage :	lux_combousage [-fxc ../../shaders/fxc] [-out lux_combousage_merged.txt] <manifest> ..
+//			lux_combousage -bench [-threads N] [-draws 2000000] [-combos 5000]
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+
+#define LUX_COMBOUSAGE_CORE_ONLY
+#include "../../shaders/fxc/cpp_lux_combousage.h"
+
+#include <thread>
+
+//==========================================================================//
+// -bench
+//==========================================================================//
+static const char *s_pBenchShaders[] = { "lux_modelshadertest_ps30", "lux_modelshadertest_vs30", "lux_lightmappedgeneric_ps30", "lux_vertexlitgeneric_ps30" };
+
+static void BenchThread(CLuxComboUsage *pUsage, std::atomic<int> *pCallSites, int nThread, int nDraws, int nCombos, std::vector<uint64_t> *pIssued)
+{
+	// Copies, the Way a Shader building its Name would
+	char szNames[4][64];
+	for (int n = 0; n < 4; n++)
+		strcpy(szNames[n], s_pBenchShaders[n]);
+
+	// Skewed like real Scenes, a few Combos take most Draws
+	uint32_t nSeed = 0x9E3779B9u * (nThread + 1);
+	for (int n = 0; n < nDraws; n++)
+	{
+		nSeed = LuxHash(nSeed);
+		float flRandom = (nSeed & 0xFFFFFF) / 16777216.0f;
+		int nCombo = (int)(flRandom * flRandom * flRandom * nCombos);
+		pUsage->Record(pCallSites[nCombo & 1], szNames[nCombo % 4], nCombo & ~63, nCombo & 63);
+		(*pIssued)[nCombo]++;
+	}
+}
+
+static int Bench(const CLuxCommandLine &CommandLine)
+{
+	int nThreads = std::max(1, CommandLine.ParmValue("-threads", (int)std::thread::hardware_concurrency()));
+	int nDraws = std::max(1, CommandLine.ParmValue("-draws", 2000000));
+	int nCombos = std::max(1, std::min(LUX_COMBOUSAGE_SLOTS / 2, CommandLine.ParmValue("-combos", 5000)));
+
+	CLuxComboUsage *pUsage = new CLuxComboUsage;
+	const char **pNames = s_pBenchShaders;
+	bool bOk = pUsage->ShaderID(pNames[1]) == pUsage->RegisterShader(pNames[1]);
+
+	// Same Address, different Name
+	char szName[64];
+	std::atomic<int> CallSite(-1);
+	strcpy(szName, pNames[2]);
+	pUsage->Record(CallSite, szName, 0, 0);
+	bOk &= CallSite == pUsage->RegisterShader(pNames[2]);
+	strcpy(szName, pNames[3]);
+	pUsage->Record(CallSite, szName, 0, 0);
+	bOk &= CallSite == pUsage->RegisterShader(pNames[3]);
+	delete pUsage;
+	pUsage = new CLuxComboUsage;
+
+	std::vector<std::vector<uint64_t> > Issued(nThreads, std::vector<uint64_t>(nCombos, 0));
+	std::atomic<int> CallSites[2];
+	CallSites[0] = CallSites[1] = -1;
+	double flStart = LuxTimeSeconds();
+	std::vector<std::thread> Threads;
+	for (int n = 0; n < nThreads; n++)
+		Threads.push_back(std::thread(BenchThread, pUsage, CallSites, n, nDraws / nThreads, nCombos, &Issued[n]));
+	for (int n = 0; n < nThreads; n++)
+		Threads[n].join();
+	double flSeconds = LuxTimeSeconds() - flStart;
+	int nRecorded = nDraws / nThreads * nThreads;
+
+	// Every Combo counted exactly as often as it was issued
+	std::vector<uint64_t> Expected(nCombos, 0);
+	for (int n = 0; n < nThreads; n++)
+	{
+		for (int i = 0; i < nCombos; i++)
+			Expected[i] += Issued[n][i];
+	}
+	std::vector<LuxComboUsage_t> Usage;
+	pUsage->Get(Usage);
+	int nWrong = 0, nUsed = 0;
+	for (int i = 0; i < nCombos; i++)
+		nUsed += Expected[i] ? 1 : 0;
+	for (size_t n = 0; n < Usage.size(); n++)
+	{
+		const LuxComboUsage_t &Combo = Usage[n];
+		bool bRight = Combo.nCombo < (uint32_t)nCombos && Combo.Shader == pNames[Combo.nCombo % 4] && Combo.nDraws == Expected[Combo.nCombo];
+		nWrong += bRight ? 0 : 1;
+	}
+	nWrong += (int)std::abs((int)Usage.size() - nUsed);
+
+	// Twice into the same File doubles every Count
+	const char *pManifest = "lux_combousage_bench.txt";
+	remove(pManifest);
+	std::vector<LuxComboUsage_t> Written;
+	uint64_t nDropped = 0;
+	bOk &= pUsage->WriteManifest(pManifest) && pUsage->WriteManifest(pManifest) && LuxReadComboUsage(pManifest, Written, &nDropped);
+	bOk &= Written.size() == Usage.size() && nDropped == pUsage->Dropped() * 2;
+	for (size_t n = 0; n < Written.size() && bOk; n++)
+		bOk &= Written[n].nDraws == Expected[Written[n].nCombo] * 2 && (!n || Written[n].nDraws <= Written[n - 1].nDraws);
+	remove(pManifest);
+
+	printf("%d Draws on %d Threads, %d Combos drawn, %llu dropped\n", nRecorded, nThreads, (int)Usage.size(), (unsigned long long)pUsage->Dropped());
+	printf("Record             %8.1f ns per Draw\n", flSeconds / nRecorded * 1e9 * nThreads);
+	printf("%d wrong Counts, Manifest Merge %s\n", nWrong, bOk ? "ok" : "FAILED");
+	delete pUsage;
+	return nWrong || !bOk ? 1 : 0;
+}
+
+//==========================================================================//
+// Merge and Report
+//==========================================================================//
+// Combos that take flShare of the Draws, most drawn first
+static int HotSet(std::vector<uint64_t> Draws, double flShare)
+{
+	std::sort(Draws.begin(), Draws.end(), std::greater<uint64_t>());
+	uint64_t nTotal = 0, nSum = 0;
+	for (size_t n = 0; n < Draws.size(); n++)
+		nTotal += Draws[n];
+	for (size_t n = 0; n < Draws.size(); n++)
+	{
+		nSum += Draws[n];
+		if (nSum >= flShare * nTotal)
+			return (int)n + 1;
+	}
+	return (int)Draws.size();
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	if (CommandLine.HasParm("-bench"))
+		return Bench(CommandLine);
+
+	std::string FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!FxcDir.empty() && FxcDir[FxcDir.size() - 1] != '/' && FxcDir[FxcDir.size() - 1] != '\\')
+		FxcDir += '/';
+	const char *pOut = CommandLine.ParmValue("-out", "lux_combousage_merged.txt");
+
+	std::vector<LuxComboUsage_t> Usage;
+	uint64_t nDropped = 0;
+	int nManifests = 0;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-out") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+		{
+			std::vector<LuxComboUsage_t> Manifest;
+			if (!LuxReadComboUsage(argv[n], Manifest, &nDropped))
+			{
+				fprintf(stderr, "Can't read %s\n", argv[n]);
+				return 1;
+			}
+			LuxMergeComboUsage(Usage, Manifest);
+			nManifests++;
+		}
+	}
+	if (!nManifests)
+	{
+		fprintf(stderr, "Usage: lux_combousage [-fxc dir] [-out file] <manifest> ..\n       lux_combousage -bench [-threads N] [-draws N] [-combos N]\n");
+		return 1;
+	}
+
+	std::map<std::string, std::vector<uint64_t> > Shaders;
+	for (size_t n = 0; n < Usage.size(); n++)
+		Shaders[Usage[n].Shader].push_back(Usage[n].nDraws);
+
+	printf("%d Manifests, %d Combos drawn in %d Shaders\n", nManifests, (int)Usage.size(), (int)Shaders.size());
+	if (nDropped)
+		printf("%llu Draws were dropped by a full Recorder Table, their Combos are missing. Raise LUX_COMBOUSAGE_SLOTS\n", (unsigned long long)nDropped);
+	printf("\n");
+	printf("%-32s %8s %8s %8s %12s %8s %8s\n", "Shader", "Live", "Drawn", "Drawn %", "Draws", "90%", "99%");
+	for (std::map<std::string, std::vector<uint64_t> >::const_iterator It = Shaders.begin(); It != Shaders.end(); ++It)
+	{
+		// Live Combos, when the .fxc is there
+		int64_t nLive = -1;
+		std::string Source;
+		CLuxComboSet Combos;
+		if (LuxReadFile((FxcDir + It->first + ".fxc").c_str(), Source) && Combos.Parse(Source))
+		{
+			nLive = 0;
+			std::vector<int> Values;
+			for (int64_t nIndex = 0; nIndex < Combos.NumIndices(); nIndex++)
+			{
+				Combos.Decode(nIndex, Values);
+				nLive += Combos.IsSkipped(Values) ? 0 : 1;
+			}
+		}
+
+		uint64_t nDraws = 0;
+		for (size_t n = 0; n < It->second.size(); n++)
+			nDraws += It->second[n];
+
+		char szLive[32] = "?", szShare[32] = "?";
+		if (nLive >= 0)
+			snprintf(szLive, sizeof(szLive), "%lld", (long long)nLive);
+		if (nLive > 0)
+			snprintf(szShare, sizeof(szShare), "%.1f%%", 100.0 * It->second.size() / nLive);
+		printf("%-32s %8s %8d %8s %12llu %8d %8d\n", It->first.c_str(), szLive, (int)It->second.size(), szShare, (unsigned long long)nDraws,
+			HotSet(It->second, 0.9), HotSet(It->second, 0.99));
+	}
+
+	if (!LuxWriteComboUsage(pOut, Usage, nDropped))
+	{
+		fprintf(stderr, "Can't write %s\n", pOut);
+		return 1;
+	}
+	printf("\nMerged Manifest written to %s\n", pOut);
+	return 0;
+}
@@ -0,0 +1,273 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Stress Test and Throughput of cpp_lux_commandrecord.h
+//
+//	Stress :	Every Frame the Draws are dealt out to a random Number of Threads in random Order,
+//				recorded, spliced and replayed into a Hash. That has to match recording the same Draws
+//				on one Thread in Order. Draw Contents vary in Size, some span several Recorder Blocks.
+//				A Command bigger than a Block has to leave the Recorder overflowed and the Frame refused.
+//	Throughput :	Draws and MB recorded per Second for 1 .. -threads Threads, and the single-threaded Replay.
+//
+//	Usage :	lux_commandrecord_bench [-frames 200] [-draws 4000] [-threads 8] [-arena 4] [-seed 1]
+//			-arena		Arena Size in MB, small Values exercise the Overflow Path
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include "../../shaders/fxc/cpp_lux_commandrecord.h"
+
+#include <thread>
+#include <algorithm>
+
+//==========================================================================//
+// Deterministic Contents per Draw, the same no matter which Thread records it
+//==========================================================================//
+template <class T>
+static void RecordDraw(T &Builder, int nDraw, uint32_t nSeed)
+{
+	uint32_t h = LuxHash(nDraw ^ nSeed);
+	Builder.SetVertexShaderIndex((int)(h & 63));
+	Builder.SetPixelShaderIndex((int)((h >> 6) & 1023));
+
+	float fl4Data[64 * 4];
+	int nUploads = 1 + (int)((h >> 16) & 7);
+	for (int n = 0; n < nUploads; n++)
+	{
+		uint32_t hUpload = LuxHash(h + n);
+
+		// Mostly small Runs, sometimes a Bone Palette sized one
+		int nCount = (hUpload & 15) == 0 ? 48 + (int)((hUpload >> 4) & 15) : 1 + (int)((hUpload >> 4) & 3);
+		for (int i = 0; i < nCount * 4; i++)
+			fl4Data[i] = LuxHashFloat(hUpload + i);
+
+		if (hUpload & 0x100)
+			Builder.SetPixelShaderConstant((int)((hUpload >> 12) & 127), fl4Data, nCount);
+		else
+			Builder.SetVertexShaderConstant((int)((hUpload >> 12) & 127), fl4Data, nCount);
+	}
+
+	int nBools[4] = { (int)(h & 1), (int)((h >> 1) & 1), (int)((h >> 2) & 1), (int)((h >> 3) & 1) };
+	Builder.SetBooleanPixelShaderConstant(0, nBools, 1 + (int)((h >> 20) & 3));
+	Builder.SetBooleanVertexShaderConstant(1, nBools, 2);
+
+	int nInts[4] = { (int)(h & 255), 0, 1, 0 };
+	if (h & 0x200000)
+		Builder.SetIntegerPixelShaderConstant(0, nInts, 1);
+
+	int nTextures = (int)((h >> 24) & 7);
+	for (int n = 0; n < nTextures; n++)
+		Builder.BindTextureHandle(n, ((uint64_t)LuxHash(h + 100 + n) << 32) | (uint64_t)n);
+}
+
+//==========================================================================//
+// Stands in for the CommandBuilder. Hashes every Call in Order
+//==========================================================================//
+class CHashBuilder
+{
+public:
+	CHashBuilder() : m_nHash(14695981039346656037ULL), m_nCalls(0) {}
+
+	void SetPixelShaderConstant(int nFirst, const float *pData, int nCount) { Add(1, nFirst, pData, nCount * 4 * sizeof(float)); }
+	void SetVertexShaderConstant(int nFirst, const float *pData, int nCount) { Add(2, nFirst, pData, nCount * 4 * sizeof(float)); }
+	void SetBooleanPixelShaderConstant(int nFirst, const int *pData, int nCount) { Add(3, nFirst, pData, nCount * sizeof(int)); }
+	void SetBooleanVertexShaderConstant(int nFirst, const int *pData, int nCount) { Add(4, nFirst, pData, nCount * sizeof(int)); }
+	void SetIntegerPixelShaderConstant(int nFirst, const int *pData, int nCount) { Add(5, nFirst, pData, nCount * 4 * sizeof(int)); }
+	void BindTextureHandle(int nSampler, uint64_t hTexture) { Add(6, nSampler, &hTexture, sizeof(hTexture)); }
+	void SetPixelShaderIndex(int nIndex) { Add(7, nIndex, NULL, 0); }
+	void SetVertexShaderIndex(int nIndex) { Add(8, nIndex, NULL, 0); }
+
+	uint64_t Hash() const { return m_nHash; }
+	int Calls() const { return m_nCalls; }
+
+private:
+	void Add(int nCommand, int nFirst, const void *pData, size_t nBytes)
+	{
+		int nHeader[2] = { nCommand, nFirst };
+		m_nHash = LuxHashBytes(nHeader, sizeof(nHeader), m_nHash);
+		m_nHash = LuxHashBytes(pData, nBytes, m_nHash);
+		m_nCalls++;
+	}
+
+	uint64_t m_nHash;
+	int m_nCalls;
+};
+
+static void RecordList(CLuxCommandRecorder *pRecorder, const std::vector<int> *pDraws, uint32_t nSeed)
+{
+	for (size_t n = 0; n < pDraws->size(); n++)
+	{
+		pRecorder->BeginDraw((*pDraws)[n]);
+		RecordDraw(*pRecorder, (*pDraws)[n], nSeed);
+		pRecorder->EndDraw();
+	}
+}
+
+// Records every List on its own Thread, the first one on the calling Thread
+static void RecordThreaded(std::vector<CLuxCommandRecorder *> &Recorders, std::vector<std::vector<int>> &Lists, int nThreads, uint32_t nSeed)
+{
+	std::vector<std::thread> Threads;
+	for (int n = 1; n < nThreads; n++)
+		Threads.push_back(std::thread(RecordList, Recorders[n], &Lists[n], nSeed));
+	RecordList(Recorders[0], &Lists[0], nSeed);
+	for (size_t n = 0; n < Threads.size(); n++)
+		Threads[n].join();
+}
+
+//==========================================================================//
+// Stress Test
+//==========================================================================//
+static int Stress(CLuxFrameArena &Arena, std::vector<CLuxCommandRecorder *> &Recorders, int nFrames, int nDraws, int nMaxThreads, uint32_t nSeed)
+{
+	int nFailed = 0;
+	size_t nMaxOverflow = 0;
+	std::vector<std::vector<int>> Lists(nMaxThreads);
+	CLuxCommandMerge Merge;
+
+	for (int nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		uint32_t nFrameSeed = LuxHash(nSeed * 7919 + nFrame);
+		int nFrameDraws = 1 + (int)(LuxHash(nFrameSeed) % (uint32_t)nDraws);
+		int nThreads = 1 + (int)(LuxHash(nFrameSeed + 1) % (uint32_t)nMaxThreads);
+
+		CHashBuilder Reference;
+		for (int n = 0; n < nFrameDraws; n++)
+			RecordDraw(Reference, n, nFrameSeed);
+
+		// Random Thread per Draw, and each Thread's List shuffled
+		for (int n = 0; n < nThreads; n++)
+			Lists[n].clear();
+		for (int n = 0; n < nFrameDraws; n++)
+			Lists[LuxHash(nFrameSeed + 2 + n) % (uint32_t)nThreads].push_back(n);
+		for (int n = 0; n < nThreads; n++)
+		{
+			for (int i = (int)Lists[n].size() - 1; i > 0; i--)
+				std::swap(Lists[n][i], Lists[n][LuxHash(nFrameSeed ^ (n * 131 + i)) % (uint32_t)(i + 1)]);
+		}
+
+		Arena.Reset();
+		for (int n = 0; n < nMaxThreads; n++)
+			Recorders[n]->Reset();
+
+		RecordThreaded(Recorders, Lists, nThreads, nFrameSeed);
+		nMaxOverflow = std::max(nMaxOverflow, Arena.OverflowBytes());
+
+		CHashBuilder Replayed;
+		const uint8_t *pStream = Merge.Splice(&Recorders[0], nThreads);
+		int nCommands = LuxReplayCommands(pStream, Replayed);
+
+		if (!pStream || Merge.NumDraws() != nFrameDraws || nCommands != Reference.Calls() || Replayed.Hash() != Reference.Hash())
+		{
+			printf("Frame %d FAILED : %d Draws on %d Threads, %d of %d Commands replayed\n", nFrame, nFrameDraws, nThreads, nCommands, Reference.Calls());
+			nFailed++;
+		}
+	}
+
+	printf("Stress : %d Frames, %d failed, Arena Overflow up to %.1f KB\n", nFrames, nFailed, nMaxOverflow / 1024.0);
+
+	// Duplicate Draw Indices have to be refused
+	Arena.Reset();
+	for (int n = 0; n < nMaxThreads; n++)
+		Recorders[n]->Reset();
+	for (int n = 0; n < 2 && n < nMaxThreads; n++)
+	{
+		Recorders[n]->BeginDraw(0);
+		RecordDraw(*Recorders[n], 0, nSeed);
+		Recorders[n]->EndDraw();
+	}
+	if (nMaxThreads >= 2 && Merge.Splice(&Recorders[0], 2))
+	{
+		printf("Duplicate Draw Indices were not refused\n");
+		nFailed++;
+	}
+
+	// Overflow in the middle of a Draw, then more Draws. Nothing may be written past the Block
+	Arena.Reset();
+	Recorders[0]->Reset();
+	std::vector<float> Huge(LUX_COMMANDRECORD_BLOCK_SIZE / sizeof(float));
+	for (int n = 0; n < 3; n++)
+	{
+		Recorders[0]->BeginDraw(n);
+		RecordDraw(*Recorders[0], n, nSeed);
+		if (n == 1)
+			Recorders[0]->SetPixelShaderConstant(0, &Huge[0], (int)Huge.size() / 4);
+		Recorders[0]->EndDraw();
+	}
+	if (!Recorders[0]->Overflowed() || Merge.Splice(&Recorders[0], 1))
+	{
+		printf("An overflowed Recorder was not refused\n");
+		nFailed++;
+	}
+	return nFailed;
+}
+
+//==========================================================================//
+// Throughput
+//==========================================================================//
+static void Throughput(CLuxFrameArena &Arena, std::vector<CLuxCommandRecorder *> &Recorders, int nDraws, int nMaxThreads, uint32_t nSeed)
+{
+	const int nRepeats = 20;
+	std::vector<std::vector<int>> Lists(nMaxThreads);
+	CLuxCommandMerge Merge;
+
+	printf("\nThreads  Draws/s      MB/s     Splice+Replay ms\n");
+	for (int nThreads = 1; nThreads <= nMaxThreads; nThreads++)
+	{
+		// Contiguous Ranges, how a Renderer would split a sorted Draw List
+		for (int n = 0; n < nThreads; n++)
+		{
+			Lists[n].clear();
+			for (int i = n * nDraws / nThreads; i < (n + 1) * nDraws / nThreads; i++)
+				Lists[n].push_back(i);
+		}
+
+		double flRecord = 0.0, flReplay = 0.0;
+		size_t nBytes = 0;
+		for (int nRepeat = 0; nRepeat < nRepeats; nRepeat++)
+		{
+			Arena.Reset();
+			for (int n = 0; n < nMaxThreads; n++)
+				Recorders[n]->Reset();
+
+			double flStart = LuxTimeSeconds();
+			RecordThreaded(Recorders, Lists, nThreads, nSeed);
+			flRecord += LuxTimeSeconds() - flStart;
+
+			for (int n = 0; n < nThreads; n++)
+				nBytes += Recorders[n]->Bytes();
+
+			CHashBuilder Replayed;
+			flStart = LuxTimeSeconds();
+			LuxReplayCommands(Merge.Splice(&Recorders[0], nThreads), Replayed);
+			flReplay += LuxTimeSeconds() - flStart;
+		}
+
+		printf("%7d  %-11.0f  %-7.0f  %.3f\n", nThreads, nDraws * nRepeats / flRecord, nBytes / (1024.0 * 1024.0) / flRecord, flReplay * 1000.0 / nRepeats);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nFrames = CommandLine.ParmValue("-frames", 200);
+	int nDraws = std::max(1, CommandLine.ParmValue("-draws", 4000));
+	int nThreads = std::max(1, CommandLine.ParmValue("-threads", 8));
+	int nArenaMB = std::max(1, CommandLine.ParmValue("-arena", 4));
+	uint32_t nSeed = (uint32_t)CommandLine.ParmValue("-seed", 1);
+
+	CLuxFrameArena Arena((size_t)nArenaMB * 1024 * 1024);
+	std::vector<CLuxCommandRecorder *> Recorders;
+	for (int n = 0; n < nThreads; n++)
+		Recorders.push_back(new CLuxCommandRecorder(Arena));
+
+	int nFailed = Stress(Arena, Recorders, nFrames, nDraws, nThreads, nSeed);
+	Throughput(Arena, Recorders, nDraws, nThreads, nSeed);
+
+	for (int n = 0; n < nThreads; n++)
+		delete Recorders[n];
+
+	return nFailed ? 1 : 0;
+}
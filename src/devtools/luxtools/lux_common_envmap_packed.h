@@ -0,0 +1,76 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Generated by lux_registermap_pack from lux_common_envmap.lrp
+//	Don't edit this, edit the Layout and run the Tool again
+//
+//	Include after lux_registermap_hlsl.h ( Shaders ) or lux_registermap_cpp.h ( C++ ),
+//	REGISTER_FLOAT_xxx is the CIB Index for one and the raw Index for the other
+//
+//==========================================================================//
+
+#ifndef LUX_COMMON_ENVMAP_PACKED_H_
+#define LUX_COMMON_ENVMAP_PACKED_H_
+
+// 8 Registers. One Upload of LUX_COMMON_ENVMAP_PACKED_COUNT from LUX_COMMON_ENVMAP_PACKED_FIRST covers all of them
+#define LUX_COMMON_ENVMAP_PACKED_FIRST			REGISTER_FLOAT_032
+#define LUX_COMMON_ENVMAP_PACKED_COUNT			8
+
+#define LUX_COMMON_ENVMAP_PACKED_0			REGISTER_FLOAT_032
+#define LUX_COMMON_ENVMAP_PACKED_1			REGISTER_FLOAT_033
+#define LUX_COMMON_ENVMAP_PACKED_2			REGISTER_FLOAT_034
+#define LUX_COMMON_ENVMAP_PACKED_3			REGISTER_FLOAT_035
+#define LUX_COMMON_ENVMAP_PACKED_4			REGISTER_FLOAT_036
+#define LUX_COMMON_ENVMAP_PACKED_5			REGISTER_FLOAT_037
+#define LUX_COMMON_ENVMAP_PACKED_6			REGISTER_FLOAT_038
+#define LUX_COMMON_ENVMAP_PACKED_7			REGISTER_FLOAT_039
+
+// Register, first Component and Width of each Constant
+// _OFFSET is the Float Index into a Block that starts at _FIRST, for filling it on the C++ Side
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPTINT_LIGHTSCALE_REGISTER	LUX_COMMON_ENVMAP_PACKED_4
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPTINT_LIGHTSCALE_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPTINT_LIGHTSCALE_WIDTH		4
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPTINT_LIGHTSCALE_OFFSET		16
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPSATURATION_CONTRAST_REGISTER	LUX_COMMON_ENVMAP_PACKED_5
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPSATURATION_CONTRAST_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPSATURATION_CONTRAST_WIDTH		4
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPSATURATION_CONTRAST_OFFSET		20
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPMASKCONTROLS_REGISTER	LUX_COMMON_ENVMAP_PACKED_6
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPMASKCONTROLS_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPMASKCONTROLS_WIDTH		3
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPMASKCONTROLS_OFFSET		24
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPFRESNEL_REGISTER	LUX_COMMON_ENVMAP_PACKED_7
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPFRESNEL_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPFRESNEL_WIDTH		3
+#define LUX_COMMON_ENVMAP_PACKED_CENVMAPFRESNEL_OFFSET		28
+#define LUX_COMMON_ENVMAP_PACKED_G_F3CUBEMAPPOS_REGISTER	LUX_COMMON_ENVMAP_PACKED_3
+#define LUX_COMMON_ENVMAP_PACKED_G_F3CUBEMAPPOS_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_G_F3CUBEMAPPOS_WIDTH		4
+#define LUX_COMMON_ENVMAP_PACKED_G_F3CUBEMAPPOS_OFFSET		12
+#define LUX_COMMON_ENVMAP_PACKED_G_F4X3CORRECTIONMATRIX_REGISTER	LUX_COMMON_ENVMAP_PACKED_0
+#define LUX_COMMON_ENVMAP_PACKED_G_F4X3CORRECTIONMATRIX_COMPONENT	0
+#define LUX_COMMON_ENVMAP_PACKED_G_F4X3CORRECTIONMATRIX_WIDTH		12
+#define LUX_COMMON_ENVMAP_PACKED_G_F4X3CORRECTIONMATRIX_OFFSET		0
+
+#if defined(LUX_REGISTERMAP_HLSL_H_)
+const float4	g_f4x3CorrectionMatrix[3]	: register(LUX_COMMON_ENVMAP_PACKED_0);
+const float4	cPacked_3	: register(LUX_COMMON_ENVMAP_PACKED_3);
+#define	g_f3CubeMapPos	(cPacked_3.xyzw)
+const float4	cPacked_4	: register(LUX_COMMON_ENVMAP_PACKED_4);
+#if ((ENVMAPMODE == 1 && PROJTEX == 0) || (ENVMAPMODE == 2 && PROJTEX == 0) || (ENVMAPMODE == 3 && PROJTEX == 0) || (ENVMAPMODE == 4 && PROJTEX == 0))
+#define	cEnvMapTint_LightScale	(cPacked_4.xyzw)
+#endif
+const float4	cPacked_5	: register(LUX_COMMON_ENVMAP_PACKED_5);
+#if ((ENVMAPMODE == 1 && PROJTEX == 0) || (ENVMAPMODE == 2 && PROJTEX == 0) || (ENVMAPMODE == 3 && PROJTEX == 0) || (ENVMAPMODE == 4 && PROJTEX == 0))
+#define	cEnvMapSaturation_Contrast	(cPacked_5.xyzw)
+#endif
+const float4	cPacked_6	: register(LUX_COMMON_ENVMAP_PACKED_6);
+#if ((ENVMAPMODE == 1 && PROJTEX == 0) || (ENVMAPMODE == 2 && PROJTEX == 0) || (ENVMAPMODE == 3 && PROJTEX == 0) || (ENVMAPMODE == 4 && PROJTEX == 0))
+#define	cEnvMapMaskControls	(cPacked_6.xyz)
+#endif
+const float4	cPacked_7	: register(LUX_COMMON_ENVMAP_PACKED_7);
+#if ((ENVMAPMODE == 1 && PROJTEX == 0) || (ENVMAPMODE == 2 && PROJTEX == 0) || (ENVMAPMODE == 3 && PROJTEX == 0) || (ENVMAPMODE == 4 && PROJTEX == 0))
+#define	cEnvMapFresnel	(cPacked_7.xyz)
+#endif
+#endif // LUX_REGISTERMAP_HLSL_H_
+
+#endif // LUX_COMMON_ENVMAP_PACKED_H_
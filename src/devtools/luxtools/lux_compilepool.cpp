@@ -0,0 +1,637 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Compiles Shader Combos on a Pool of long-lived Worker Processes
+//
+//	ShaderCompile2 is started per .fxc and its Compiler Instances per Job, so every Combo pays for Process Startup
+//	and loading d3dcompiler_47.dll. Here each Worker ( this Tool with -worker ) loads its Backend once and then
+//	takes Combos over a Pipe ( luxtools_workerpool.h has the Protocol ).
+//
+//	Compile Mode runs every Combo the SKIPs leave of each .fxc through D3DCompile() on the Workers and reports
+//	Failures, Bytecode Size and Time. It checks that everything compiles, it doesn't write .vcs Files, that's still ShaderCompile2.
+//
+//	All Combos of all Shaders ( the Arguments and the -list ) go into one Schedule, longest predicted first.
+//	Predictions come from -times, the Compile Time of every Combo from earlier Runs ( luxtools_compiletimes.h, <fxc>/lux_compiletimes.txt by Default ),
+//	so the expensive Combos don't end up as a long Tail on the last Workers. Reports the Makespan against
+//	the Ideal ( average Load per Worker, or the longest Combo ) and simulates File Order against it.
+//
+//	-sample only compiles a pairwise Sample ( luxtools_combosample.h ) : every Value of every Combo and every Pair of
+//	Values some live Combo has, at least once. Catches nearly every Compile Error in a Fraction of the Time, for CI.
+//
+//	Combos that preprocess to the same Source ( luxtools_combodedup.h ) are compiled once, the others get a Copy of
+//	its Result. -nodedup compiles every Combo, -dedup_check does too and fails on an Alias whose Bytecode differs
+//	( d3d Backend, the stub's Output depends on the Combo Values ).
+//
+//	-bench runs the same Jobs on the stub Backend twice : a Worker started per Job, like now, and the Pool.
+//	The stub's Load Time stands in for the DLL, its Compile Time for the Compiler. Works on Linux.
+//	-crash N has every stub Worker exit on its Nth Job, the Pool has to start it again and requeue the Job.
+//
+//	Usage :	lux_compilepool [-fxc ../../shaders/fxc] [-workers N] [-backend d3d|stub] [-list ../../compile_all_shaders.txt]
+//			[-times <fxc>/lux_compiletimes.txt] [-order predicted|file] [-sample] [-nodedup|-dedup_check] <shader.fxc> ..
+//			lux_compilepool -bench [-jobs 2000] [-workers N] [-load_ms 40] [-compile_us 2000] [-bytes 4096] [-crash N]
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+#include "luxtools_workerpool.h"
+#include "luxtools_compiletimes.h"
+#include "luxtools_combosample.h"
+#include "luxtools_combodedup.h"
+
+#include <functional>
+
+#ifdef _WIN32
+#include <d3dcompiler.h>
+#endif
+
+//==========================================================================//
+// Stub Backend. Deterministic Output, so the Tool can check what came back over the Pipe
+//==========================================================================//
+static std::string StubBytecode(const std::vector<int> &Values, int nBytes)
+{
+	uint32_t nSeed = (uint32_t)LuxHashBytes(Values.empty() ? NULL : &Values[0], Values.size() * sizeof(int));
+	std::string Out((size_t)nBytes, '\0');
+	for (int n = 0; n < nBytes; n++)
+		Out[n] = (char)(LuxHash(nSeed + n) & 0xFF);
+	return Out;
+}
+
+// Combos cost 0.2 .. 4.2x -compile_us, a few of them a lot more than the Rest, the same every Run
+static float StubCostScale(const std::vector<int> &Values)
+{
+	float h = LuxHashFloat((uint32_t)LuxHashBytes(Values.empty() ? NULL : &Values[0], Values.size() * sizeof(int), 1));
+	return 0.2f + 4.0f * h * h * h * h;
+}
+
+class CStubBackend : public ILuxCompilerBackend
+{
+public:
+	CStubBackend(int nLoadMs, int nCompileUs, int nBytes, int nCrash) : m_nLoadMs(nLoadMs), m_nCompileUs(nCompileUs), m_nBytes(nBytes), m_nCrash(nCrash), m_nJobs(0) {}
+
+	virtual bool Load(std::string &Error)
+	{
+		(void)Error;
+		std::this_thread::sleep_for(std::chrono::milliseconds(m_nLoadMs));
+		return true;
+	}
+
+	// Busy, a Compiler keeps its Core busy too
+	virtual bool Compile(const LuxWorkerShader_t &Shader, const std::vector<int> &Values, std::string &Out)
+	{
+		(void)Shader;
+		if (m_nCrash && ++m_nJobs == m_nCrash)
+			_Exit(3);
+		double flEnd = LuxTimeSeconds() + m_nCompileUs * 1e-6 * StubCostScale(Values);
+		while (LuxTimeSeconds() < flEnd)
+			;
+		Out = StubBytecode(Values, m_nBytes);
+		return true;
+	}
+
+private:
+	int m_nLoadMs;
+	int m_nCompileUs;
+	int m_nBytes;
+	int m_nCrash;
+	int m_nJobs;
+};
+
+//==========================================================================//
+// D3DCompile() out of d3dcompiler_47.dll, loaded once per Worker
+//==========================================================================//
+#ifdef _WIN32
+typedef HRESULT (WINAPI *D3DCompileFn_t)(LPCVOID, SIZE_T, LPCSTR, const D3D_SHADER_MACRO *, ID3DInclude *, LPCSTR, LPCSTR, UINT, UINT, ID3DBlob **, ID3DBlob **);
+
+// #include "x.h" next to the .fxc, Sources cached for the Worker's Lifetime
+class CIncludeHandler : public ID3DInclude
+{
+public:
+	std::string m_Dir;
+
+	STDMETHOD(Open)(D3D_INCLUDE_TYPE Type, LPCSTR pFileName, LPCVOID pParentData, LPCVOID *ppData, UINT *pBytes)
+	{
+		(void)Type;
+		(void)pParentData;
+		const std::string *pSource = Load(m_Dir + pFileName);
+		if (!pSource)
+			return E_FAIL;
+		*ppData = pSource->data();
+		*pBytes = (UINT)pSource->size();
+		return S_OK;
+	}
+
+	STDMETHOD(Close)(LPCVOID pData)
+	{
+		(void)pData;
+		return S_OK;
+	}
+
+	const std::string *Load(const std::string &Path)
+	{
+		std::map<std::string, std::string>::iterator It = m_Sources.find(Path);
+		if (It != m_Sources.end())
+			return &It->second;
+
+		std::string Source;
+		if (!LuxReadFile(Path.c_str(), Source))
+			return NULL;
+		return &(m_Sources[Path] = Source);
+	}
+
+private:
+	std::map<std::string, std::string> m_Sources;
+};
+
+class CD3DBackend : public ILuxCompilerBackend
+{
+public:
+	CD3DBackend() : m_pD3DCompile(NULL) {}
+
+	virtual bool Load(std::string &Error)
+	{
+		HMODULE hModule = LoadLibraryA("d3dcompiler_47.dll");
+		m_pD3DCompile = hModule ? (D3DCompileFn_t)GetProcAddress(hModule, "D3DCompile") : NULL;
+		if (!m_pD3DCompile)
+			Error = "Can't load D3DCompile() from d3dcompiler_47.dll";
+		return m_pD3DCompile != NULL;
+	}
+
+	virtual bool Compile(const LuxWorkerShader_t &Shader, const std::vector<int> &Values, std::string &Out)
+	{
+		m_Includes.m_Dir = LuxDirectoryOf(Shader.Path);
+		const std::string *pSource = m_Includes.Load(Shader.Path);
+		if (!pSource)
+		{
+			Out = "Can't read " + Shader.Path;
+			return false;
+		}
+
+		// Same Defines ShaderCompile2 sets
+		std::vector<std::string> Strings;
+		for (size_t n = 0; n < Values.size(); n++)
+		{
+			Strings.push_back(Shader.Combos[n]);
+			char szValue[16];
+			snprintf(szValue, sizeof(szValue), "%d", Values[n]);
+			Strings.push_back(szValue);
+		}
+		Strings.push_back(Shader.Target == "vs_3_0" ? "SHADER_MODEL_VS_3_0" : "SHADER_MODEL_PS_3_0");
+		Strings.push_back("1");
+
+		std::vector<D3D_SHADER_MACRO> Macros;
+		for (size_t n = 0; n < Strings.size(); n += 2)
+		{
+			D3D_SHADER_MACRO Macro = { Strings[n].c_str(), Strings[n + 1].c_str() };
+			Macros.push_back(Macro);
+		}
+		D3D_SHADER_MACRO End = { NULL, NULL };
+		Macros.push_back(End);
+
+		ID3DBlob *pCode = NULL, *pErrors = NULL;
+		HRESULT hResult = m_pD3DCompile(pSource->data(), pSource->size(), Shader.Path.c_str(), &Macros[0], &m_Includes,
+			"main", Shader.Target.c_str(), D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &pCode, &pErrors);
+
+		if (SUCCEEDED(hResult) && pCode)
+			Out.assign((const char *)pCode->GetBufferPointer(), pCode->GetBufferSize());
+		else if (pErrors)
+			Out.assign((const char *)pErrors->GetBufferPointer(), pErrors->GetBufferSize());
+
+		if (pCode)
+			pCode->Release();
+		if (pErrors)
+			pErrors->Release();
+		return SUCCEEDED(hResult);
+	}
+
+private:
+	D3DCompileFn_t m_pD3DCompile;
+	CIncludeHandler m_Includes;
+};
+#else
+// So the Tool gets told why instead of a missing Hello
+class CD3DBackend : public ILuxCompilerBackend
+{
+public:
+	virtual bool Load(std::string &Error)
+	{
+		Error = "The d3d Backend is Windows only, use -backend stub";
+		return false;
+	}
+
+	virtual bool Compile(const LuxWorkerShader_t &, const std::vector<int> &, std::string &) { return false; }
+};
+#endif
+
+//==========================================================================//
+// -bench
+//==========================================================================//
+static int Bench(const CLuxCommandLine &CommandLine, const std::string &Executable)
+{
+	int nJobs = std::max(1, CommandLine.ParmValue("-jobs", 2000));
+	int nWorkers = std::max(1, CommandLine.ParmValue("-workers", (int)std::thread::hardware_concurrency()));
+	int nLoadMs = std::max(0, CommandLine.ParmValue("-load_ms", 40));
+	int nCompileUs = std::max(0, CommandLine.ParmValue("-compile_us", 2000));
+	int nBytes = std::max(0, CommandLine.ParmValue("-bytes", 4096));
+	// A Worker per Job only ever sees its first Job
+	int nCrash = CommandLine.HasParm("-crash") ? std::max(2, CommandLine.ParmValue("-crash", 2)) : 0;
+
+	char szArgs[4][16];
+	snprintf(szArgs[0], sizeof(szArgs[0]), "%d", nLoadMs);
+	snprintf(szArgs[1], sizeof(szArgs[1]), "%d", nCompileUs);
+	snprintf(szArgs[2], sizeof(szArgs[2]), "%d", nBytes);
+	snprintf(szArgs[3], sizeof(szArgs[3]), "%d", nCrash);
+	std::vector<std::string> Args;
+	Args.push_back("-worker");
+	Args.push_back("-backend");
+	Args.push_back("stub");
+	Args.push_back("-load_ms");
+	Args.push_back(szArgs[0]);
+	Args.push_back("-compile_us");
+	Args.push_back(szArgs[1]);
+	Args.push_back("-bytes");
+	Args.push_back(szArgs[2]);
+	Args.push_back("-crash");
+	Args.push_back(szArgs[3]);
+
+	// A Shader with 4 Combos, the Jobs walk its Index
+	LuxWorkerShader_t Shader;
+	Shader.Path = "stub.fxc";
+	Shader.Target = "ps_3_0";
+	Shader.Combos.push_back("A");
+	Shader.Combos.push_back("B");
+	Shader.Combos.push_back("C");
+	Shader.Combos.push_back("D");
+
+	std::vector<LuxWorkerJob_t> Jobs(nJobs);
+	for (int n = 0; n < nJobs; n++)
+	{
+		Jobs[n].nShader = 0;
+		for (int i = 0; i < 4; i++)
+			Jobs[n].Values.push_back((n >> (i * 4)) & 0xF);
+	}
+
+	// A Worker per Job is slow, a Sample of them is enough
+	int nSpawnJobs = std::min(nJobs, std::max(nWorkers * 4, 64));
+	std::atomic<int> nNext(0);
+	std::atomic<int> nSpawnFailed(0);
+	double flStart = LuxTimeSeconds();
+	std::vector<std::thread> Threads;
+	for (int nThread = 0; nThread < nWorkers; nThread++)
+	{
+		Threads.push_back(std::thread([&]()
+		{
+			for (int nJob = nNext++; nJob < nSpawnJobs; nJob = nNext++)
+			{
+				CLuxWorkerProcess Worker;
+				std::string Error;
+				LuxWorkerJob_t Job = Jobs[nJob];
+				if (!Worker.Start(Executable, Args, Error) || !Worker.SendShader(0, Shader) || !Worker.Run(nJob, Job) || Job.Out != StubBytecode(Job.Values, nBytes))
+					nSpawnFailed++;
+			}
+		}));
+	}
+	for (int n = 0; n < nWorkers; n++)
+		Threads[n].join();
+	double flSpawn = (LuxTimeSeconds() - flStart) / nSpawnJobs;
+
+	// Pool, Startup included
+	flStart = LuxTimeSeconds();
+	CLuxWorkerPool Pool;
+	std::string Error;
+	if (!Pool.Start(nWorkers, Executable, Args, Error) || !Pool.AddShader(0, Shader))
+	{
+		fprintf(stderr, "Can't start the Pool : %s\n", Error.c_str());
+		return 1;
+	}
+	double flStartup = LuxTimeSeconds() - flStart;
+	bool bRan = Pool.Run(Jobs);
+	double flPool = LuxTimeSeconds() - flStart;
+	Pool.Stop();
+
+	int nWrong = 0;
+	for (int n = 0; n < nJobs; n++)
+		nWrong += !Jobs[n].bOk || Jobs[n].Out != StubBytecode(Jobs[n].Values, nBytes);
+
+	// What the Workers would take if nothing but Compiling cost anything
+	double flScale = 0.0;
+	for (int n = 0; n < nJobs; n++)
+		flScale += StubCostScale(Jobs[n].Values);
+	double flIdeal = nCompileUs * 1e-6 * flScale / nJobs / nWorkers;
+
+	printf("%d Jobs on %d Workers, stub Backend : %d ms Load, %d us Compile, %d Bytes per Result\n\n", nJobs, nWorkers, nLoadMs, nCompileUs, nBytes);
+	printf("                   per Job      Overhead per Job\n");
+	printf("Worker per Job     %8.1f us  %8.1f us   ( %d Jobs sampled )\n", flSpawn * 1e6, (flSpawn - flIdeal) * 1e6, nSpawnJobs);
+	printf("Pool               %8.1f us  %8.1f us   ( %.1f ms Startup )\n", flPool / nJobs * 1e6, (flPool / nJobs - flIdeal) * 1e6, flStartup * 1e3);
+	printf("Speedup            %8.1fx\n", flSpawn / (flPool / nJobs));
+	printf("%d wrong Results, %d failed Spawns, %d Workers started again\n", nWrong, (int)nSpawnFailed, Pool.NumRespawns());
+
+	return nWrong || nSpawnFailed || !bRan ? 1 : 0;
+}
+
+//==========================================================================//
+// Compile Mode
+//==========================================================================//
+struct Shader_t
+{
+	std::string Name;
+	std::string Path;
+	std::string Target;
+	CLuxComboSet Combos;
+};
+
+// compile_all_shaders.txt, same Rules as buildshaders.bat : empty Lines and // Lines are skipped
+static bool ReadList(const char *pPath, std::vector<std::string> &Files)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = LuxTrim(Data.substr(nStart, nEnd - nStart));
+		nStart = nEnd + 1;
+		if (!Line.empty() && Line.compare(0, 2, "//"))
+			Files.push_back(Line);
+	}
+	return true;
+}
+
+static int CompileShaders(const CLuxCommandLine &CommandLine, const std::string &Executable, int argc, char **argv)
+{
+	std::string FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!FxcDir.empty() && FxcDir[FxcDir.size() - 1] != '/' && FxcDir[FxcDir.size() - 1] != '\\')
+		FxcDir += '/';
+	int nWorkers = std::max(1, CommandLine.ParmValue("-workers", (int)std::thread::hardware_concurrency()));
+	std::string Backend = CommandLine.ParmValue("-backend", "d3d");
+	const char *pList = CommandLine.ParmValue("-list", (const char *)NULL);
+	std::string TimesPath = CommandLine.ParmValue("-times", (FxcDir + "lux_compiletimes.txt").c_str());
+	const char *pTimes = TimesPath.c_str();
+	bool bFileOrder = !strcmp(CommandLine.ParmValue("-order", "predicted"), "file");
+	bool bSample = CommandLine.HasParm("-sample");
+	bool bDedupCheck = CommandLine.HasParm("-dedup_check");
+	bool bDedup = !CommandLine.HasParm("-nodedup") || bDedupCheck;
+
+	std::vector<std::string> Files;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-workers" || Arg == "-backend" || Arg == "-list" || Arg == "-times" || Arg == "-order" ||
+			Arg == "-load_ms" || Arg == "-compile_us" || Arg == "-bytes") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+			Files.push_back(Arg);
+	}
+
+	if (pList && !ReadList(pList, Files))
+	{
+		fprintf(stderr, "Can't read %s\n", pList);
+		return 1;
+	}
+
+	if (Files.empty())
+	{
+		fprintf(stderr, "Usage: lux_compilepool [-fxc dir] [-workers N] [-backend d3d|stub] [-list compile_all_shaders.txt] [-times file] [-order predicted|file] [-sample] [-nodedup|-dedup_check] <shader.fxc> ..\n");
+		fprintf(stderr, "       lux_compilepool -bench [-jobs N] [-workers N] [-load_ms N] [-compile_us N] [-bytes N] [-crash N]\n");
+		return 1;
+	}
+
+	std::vector<std::string> Args;
+	Args.push_back("-worker");
+	Args.push_back("-backend");
+	Args.push_back(Backend);
+	const char *pStubParms[] = { "-load_ms", "-compile_us", "-bytes" };
+	for (int n = 0; n < 3; n++)
+	{
+		if (CommandLine.HasParm(pStubParms[n]))
+		{
+			Args.push_back(pStubParms[n]);
+			Args.push_back(CommandLine.ParmValue(pStubParms[n], ""));
+		}
+	}
+
+	double flStart = LuxTimeSeconds();
+	CLuxWorkerPool Pool;
+	std::string Error;
+	if (!Pool.Start(nWorkers, Executable, Args, Error))
+	{
+		fprintf(stderr, "Can't start the Pool : %s\n", Error.c_str());
+		return 1;
+	}
+
+	CLuxCompileTimes Times;
+	Times.Load(pTimes);
+
+	// Every Combo of every Shader in one List, File and Combo Order
+	std::vector<Shader_t> Shaders;
+	std::vector<LuxWorkerJob_t> Jobs;
+	std::vector<int64_t> Indices;
+	int nFailed = 0;
+	for (size_t nFile = 0; nFile < Files.size(); nFile++)
+	{
+		std::string Path = Files[nFile].find('/') == std::string::npos && Files[nFile].find('\\') == std::string::npos ? FxcDir + Files[nFile] : Files[nFile];
+		std::string Source;
+		Shader_t Shader;
+		if (!LuxReadFile(Path.c_str(), Source) || !Shader.Combos.Parse(Source))
+		{
+			fprintf(stderr, "Can't read the Combos of %s\n", Path.c_str());
+			nFailed++;
+			continue;
+		}
+		Shader.Name = LuxFileNameOf(Path);
+		if (Shader.Name.size() > 4 && Shader.Name.compare(Shader.Name.size() - 4, 4, ".fxc") == 0)
+			Shader.Name.resize(Shader.Name.size() - 4);
+		Shader.Path = Path;
+		Shader.Target = Path.find("_vs") != std::string::npos ? "vs_3_0" : "ps_3_0";
+		if (Times.SetLayout(Shader.Name, Shader.Combos.NumDynamicIndices(), Shader.Combos.LayoutHash()))
+			printf("%s : Combo Declarations changed, dropped its Compile Time History\n", Shader.Name.c_str());
+
+		LuxWorkerShader_t WorkerShader;
+		WorkerShader.Path = Shader.Path;
+		WorkerShader.Target = Shader.Target;
+		for (int n = 0; n < Shader.Combos.NumCombos(); n++)
+			WorkerShader.Combos.push_back(Shader.Combos.Combo(n).Name);
+		if (!Pool.AddShader((uint32_t)Shaders.size(), WorkerShader))
+		{
+			fprintf(stderr, "Lost a Worker\n");
+			return 1;
+		}
+
+		LuxWorkerJob_t Job;
+		Job.nShader = (uint32_t)Shaders.size();
+		if (bSample)
+		{
+			std::vector<int64_t> Sample;
+			LuxComboCoverage_t Coverage;
+			CLuxComboSampler(Shader.Combos).Sample(Sample, Coverage);
+			for (size_t n = 0; n < Sample.size(); n++)
+			{
+				Shader.Combos.Decode(Sample[n], Job.Values);
+				Jobs.push_back(Job);
+				Indices.push_back(Sample[n]);
+			}
+			printf("%-32s %6d of %6lld Combos ( %5.1f%% ), Values %lld / %lld, Pairs %lld / %lld, %lld Pairs only in SKIPped Combos\n", Shader.Name.c_str(),
+				(int)Sample.size(), (long long)Coverage.nLive, Coverage.nLive ? 100.0 * Sample.size() / Coverage.nLive : 0.0,
+				(long long)Coverage.nValuesCovered, (long long)Coverage.nValues, (long long)Coverage.nPairsCovered, (long long)Coverage.nPairs, (long long)Coverage.nPairsSkipped);
+		}
+		else
+		{
+			for (int64_t nIndex = 0; nIndex < Shader.Combos.NumIndices(); nIndex++)
+			{
+				Shader.Combos.Decode(nIndex, Job.Values);
+				if (Shader.Combos.IsSkipped(Job.Values))
+					continue;
+				Jobs.push_back(Job);
+				Indices.push_back(nIndex);
+			}
+		}
+		Shaders.push_back(Shader);
+	}
+
+	// Only the first Combo of each Source is compiled, unless -dedup_check compiles all of them to compare
+	CLuxComboDedup Dedup(FxcDir);
+	std::vector<size_t> AliasOf(Jobs.size()), FileOrder;
+	double flDedup = LuxTimeSeconds();
+	for (size_t n = 0; n < Jobs.size(); n++)
+	{
+		const Shader_t &Shader = Shaders[Jobs[n].nShader];
+		AliasOf[n] = bDedup ? Dedup.Add(n, Shader.Path, Shader.Target, Shader.Combos, Jobs[n].Values) : n;
+		if (AliasOf[n] == n || bDedupCheck)
+			FileOrder.push_back(n);
+	}
+	flDedup = LuxTimeSeconds() - flDedup;
+
+	// Longest predicted first, across all Shaders. Stable, so equal Guesses keep File Order
+	std::vector<float> Predicted(Jobs.size());
+	std::vector<size_t> PredictedOrder = FileOrder;
+	int nKnown = 0;
+	for (size_t n = 0; n < FileOrder.size(); n++)
+	{
+		bool bKnown;
+		Predicted[FileOrder[n]] = Times.Predict(Shaders[Jobs[FileOrder[n]].nShader].Name, Indices[FileOrder[n]], &bKnown);
+		nKnown += bKnown;
+	}
+	std::stable_sort(PredictedOrder.begin(), PredictedOrder.end(), [&](size_t a, size_t b) { return Predicted[a] > Predicted[b]; });
+	const std::vector<size_t> &Order = bFileOrder ? FileOrder : PredictedOrder;
+
+	std::vector<LuxWorkerJob_t> Scheduled(Order.size());
+	for (size_t n = 0; n < Order.size(); n++)
+		Scheduled[n] = Jobs[Order[n]];
+
+	double flRun = LuxTimeSeconds();
+	Pool.Run(Scheduled);
+	flRun = LuxTimeSeconds() - flRun;
+
+	for (size_t n = 0; n < Order.size(); n++)
+		Jobs[Order[n]] = Scheduled[n];
+
+	int nDifferent = 0;
+	for (size_t n = 0; n < Jobs.size(); n++)
+	{
+		const LuxWorkerJob_t &First = Jobs[AliasOf[n]];
+		if (AliasOf[n] == n)
+			continue;
+		if (!bDedupCheck)
+		{
+			Jobs[n].bOk = First.bOk;
+			Jobs[n].Out = First.Out;
+			Jobs[n].flSeconds = 0.0f;
+		}
+		else if (Jobs[n].bOk != First.bOk || Jobs[n].Out != First.Out)
+		{
+			if (!nDifferent)
+				printf("%s : Combo %lld compiled different from Combo %lld, same Source\n", Shaders[Jobs[n].nShader].Name.c_str(), (long long)Indices[n], (long long)Indices[AliasOf[n]]);
+			nDifferent++;
+		}
+	}
+
+	// Per Shader
+	for (size_t nShader = 0; nShader < Shaders.size(); nShader++)
+	{
+		const Shader_t &Shader = Shaders[nShader];
+		int nCombos = 0, nCompiled = 0, nErrors = 0;
+		int64_t nBytes = 0;
+		double flSeconds = 0.0;
+		for (size_t n = 0; n < Jobs.size(); n++)
+		{
+			if (Jobs[n].nShader != nShader)
+				continue;
+			bool bCompiled = AliasOf[n] == n || bDedupCheck;
+			nCombos++;
+			nCompiled += bCompiled;
+			flSeconds += Jobs[n].flSeconds;
+			if (Jobs[n].bOk)
+			{
+				nBytes += Jobs[n].Out.size();
+				if (bCompiled)
+					Times.Record(Shader.Name, Indices[n], Jobs[n].flSeconds);
+				continue;
+			}
+			if (!nErrors)
+				printf("%s : Combo %lld ( %s ) failed :\n%s\n", Shader.Name.c_str(), (long long)Indices[n], Shader.Combos.Describe(Jobs[n].Values).c_str(), Jobs[n].Out.c_str());
+			nErrors++;
+		}
+
+		printf("%-32s %6d Combos, %6d compiled, %8.2f s Compiler Time, %5d failed, %8.1f KB Bytecode\n", Shader.Name.c_str(), nCombos, nCompiled, flSeconds, nErrors, nBytes / 1024.0);
+		nFailed += nErrors;
+	}
+
+	// Schedule, against what's possible with the Times this Run measured
+	std::vector<float> Measured(Order.size()), InFileOrder(Order.size()), InPredictedOrder(Order.size());
+	for (size_t n = 0; n < Order.size(); n++)
+	{
+		Measured[n] = InFileOrder[n] = Jobs[FileOrder[n]].flSeconds;
+		InPredictedOrder[n] = Jobs[PredictedOrder[n]].flSeconds;
+	}
+	std::vector<float> Sorted = Measured;
+	std::sort(Sorted.begin(), Sorted.end(), std::greater<float>());
+
+	double flIdeal = LuxIdealMakespan(Measured, nWorkers);
+	if (bDedup)
+	{
+		printf("\nDedup              %d of %d Combos have a Source of their own, %d not compared ( %.2f s Preprocessing )\n", Dedup.NumUnique(), Dedup.NumCombos(),
+			Dedup.NumUncertain(), flDedup);
+		if (bDedupCheck)
+			printf("                   %d Aliases compiled different from their first Combo\n", nDifferent);
+	}
+	printf("\n%d Jobs on %d Workers, %d with a Time History ( %s )\n", (int)Order.size(), nWorkers, nKnown, pTimes);
+	printf("Makespan           %8.2f s, %.1f%% over the Ideal %.2f s ( %s Order )\n", flRun, flIdeal > 0.0 ? (flRun / flIdeal - 1.0) * 100.0 : 0.0, flIdeal,
+		bFileOrder ? "File" : "predicted");
+	printf("Simulated          %8.2f s in File Order, %.2f s predicted, %.2f s with perfect Predictions\n",
+		LuxSimulateMakespan(InFileOrder, nWorkers), LuxSimulateMakespan(InPredictedOrder, nWorkers), LuxSimulateMakespan(Sorted, nWorkers));
+	printf("%.2f s in total\n", LuxTimeSeconds() - flStart);
+
+	Times.Rebuild();
+	if (!Times.Save(pTimes))
+		fprintf(stderr, "Can't write %s\n", pTimes);
+
+	return nFailed || nDifferent ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+
+	if (CommandLine.HasParm("-worker"))
+	{
+		std::string Backend = CommandLine.ParmValue("-backend", "d3d");
+		if (Backend == "stub")
+		{
+			CStubBackend Stub(CommandLine.ParmValue("-load_ms", 40), CommandLine.ParmValue("-compile_us", 2000), CommandLine.ParmValue("-bytes", 4096),
+				CommandLine.ParmValue("-crash", 0));
+			return LuxWorkerMain(Stub);
+		}
+		CD3DBackend D3D;
+		return LuxWorkerMain(D3D);
+	}
+
+	std::string Executable = LuxExecutablePath(argv[0]);
+	if (CommandLine.HasParm("-bench"))
+		return Bench(CommandLine, Executable);
+	return CompileShaders(CommandLine, Executable, argc, argv);
+}
@@ -0,0 +1,369 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Replays Constant Streams through cpp_lux_constantshadow.h
+//							Checks that the GPU ends up with the same Registers as without it,
+//							and reports Upload Bytes, Calls and the CPU Cost of the Shadow.
+//
+//	Usage :	lux_constantshadow_bench [-stream ps.txt] [-draws 20000] [-materials 64] [-shuffle] [-record out.txt]
+//			-stream		Recorded with CLuxConstantShadow::SetRecordFile(). Without it a synthetic
+//						Prop Scene is generated, using the Registers from lux_registermap_ps.h
+//			-shuffle	Synthetic Draws in random Order instead of sorted by Material
+//			-record		Writes the synthetic Stream, to have something to -stream back in
+//
+//	Stream Format, one Command per Line :
+//			f <register> <x> <y> <z> <w>	Float4, printf %a or plain Decimals
+//			b <register> <0|1>
+//			draw
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include "../../shaders/fxc/lux_registermap_cpp.h"
+#include "../../shaders/fxc/cpp_lux_constantshadow.h"
+
+//==========================================================================//
+// Recorded Commands
+//==========================================================================//
+enum CommandType_t
+{
+	COMMAND_FLOAT = 0,
+	COMMAND_BOOL,
+	COMMAND_DRAW,
+};
+
+struct Command_t
+{
+	int nType;
+	int nRegister;
+	float fl4[4];
+};
+
+static bool LoadStream(const char *pPath, std::vector<Command_t> &Commands)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	int nLine = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = Data.substr(nStart, nEnd - nStart);
+		nStart = nEnd + 1;
+		nLine++;
+
+		Command_t Command;
+		memset(&Command, 0, sizeof(Command));
+		const char *p = Line.c_str();
+		char *pEnd;
+		if (p[0] == 'f' && p[1] == ' ')
+		{
+			Command.nType = COMMAND_FLOAT;
+			Command.nRegister = (int)strtol(p + 2, &pEnd, 10);
+			for (int n = 0; n < 4; n++)
+				Command.fl4[n] = strtof(pEnd, &pEnd);
+		}
+		else if (p[0] == 'b' && p[1] == ' ')
+		{
+			Command.nType = COMMAND_BOOL;
+			Command.nRegister = (int)strtol(p + 2, &pEnd, 10);
+			Command.fl4[0] = (float)strtol(pEnd, &pEnd, 10);
+		}
+		else if (!strncmp(p, "draw", 4))
+			Command.nType = COMMAND_DRAW;
+		else if (Line.empty() || Line[0] == '/')
+			continue;
+		else
+		{
+			fprintf(stderr, "%s(%d) : Unknown Command '%s'\n", pPath, nLine, Line.c_str());
+			return false;
+		}
+
+		if (Command.nType != COMMAND_DRAW && (Command.nRegister < 0 || Command.nRegister >= (Command.nType == COMMAND_FLOAT ? 224 : 16)))
+		{
+			fprintf(stderr, "%s(%d) : Register %d out of Range\n", pPath, nLine, Command.nRegister);
+			return false;
+		}
+		Commands.push_back(Command);
+	}
+	return true;
+}
+
+//==========================================================================//
+// Synthetic Prop Scene. What a Model Shader sets per Draw today
+//==========================================================================//
+static void AddFloat(std::vector<Command_t> &Commands, int nRegister, float x, float y, float z, float w)
+{
+	Command_t Command = { COMMAND_FLOAT, nRegister, { x, y, z, w } };
+	Commands.push_back(Command);
+}
+
+static void AddBool(std::vector<Command_t> &Commands, int nRegister, bool bValue)
+{
+	Command_t Command = { COMMAND_BOOL, nRegister, { bValue ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f } };
+	Commands.push_back(Command);
+}
+
+static void MakeSynthetic(std::vector<Command_t> &Commands, int nDraws, int nMaterials, bool bShuffle)
+{
+	for (int nDraw = 0; nDraw < nDraws; nDraw++)
+	{
+		// Sorted : Runs of the same Material, like the Engine does for Props
+		int nMaterial = bShuffle ? (int)(LuxHash(nDraw) % nMaterials) : (int)((int64_t)nDraw * nMaterials / nDraws);
+		uint32_t nSeed = (uint32_t)nMaterial * 977;
+		float flMaterial = (float)nMaterial;
+
+		// Per Frame, the same on every Draw
+		AddFloat(Commands, LUX_PS_FLOAT_LUMINANCE_GAMMA, 0.2126f, 0.7152f, 0.0722f, 2.2f);
+		AddFloat(Commands, LUX_PS_FLOAT_CAMERAPOSITION, 128.0f, -512.0f, 64.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_FOGPARAMETERS, 0.5f, 1.0f, 0.0f, 1.0f / 4096.0f);
+		AddFloat(Commands, STOCK_PS_FLOAT_LINEARFOGCOLOR, 0.3f, 0.35f, 0.4f, 1.0f);
+		AddFloat(Commands, STOCK_PS_FLOAT_LIGHTSCALE, 1.0f, 1.0f, 1.0f, 1.0f);
+
+		// Per Instance, Lighting changes with every Prop
+		for (int n = 0; n < 6; n++)
+			AddFloat(Commands, LUX_PS_FLOAT_AMBIENTCUBE + n, LuxHashFloat(nDraw * 8 + n), 0.5f, 0.5f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_MODULATIONCONSTANTS, 1.0f, 1.0f, 1.0f, LuxHashFloat(nDraw) < 0.1f ? 0.5f : 1.0f);
+
+		// Per Material
+		AddFloat(Commands, LUX_PS_FLOAT_COLOR_FACTORS, 1.0f, 1.0f, 1.0f, 1.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_DETAIL_FACTORS, LuxHashFloat(nSeed + 1), 1.0f, 1.0f, 1.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_DETAIL_BLENDMODE, flMaterial, 0.0f, 0.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_SELFILLUM_FACTORS, 1.0f, 1.0f, 1.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_SELFILLUM_FRESNEL, 0.0f, 1.0f, 1.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_ENVMAP_TINT, LuxHashFloat(nSeed + 2), LuxHashFloat(nSeed + 3), 1.0f, 1.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_ENVMAP_FACTORS, 0.0f, 0.0f, 1.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_ENVMAP_CONTROLS, 0.0f, 0.0f, 0.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_ENVMAP_FRESNEL, 0.0f, 0.5f, 1.0f, 2.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_PHONG_TINT, 1.0f, 1.0f, 1.0f, LuxHashFloat(nSeed + 4) * 10.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_PHONG_FRESNEL, 0.0f, 0.5f, 1.0f, 0.0f);
+		AddFloat(Commands, LUX_PS_FLOAT_PHONG_CONTROLS, 5.0f + flMaterial, 1.0f, 0.0f, 1.0f);
+
+		AddBool(Commands, LUX_PS_BOOL_HALFLAMBERT, (nMaterial & 1) != 0);
+		AddBool(Commands, LUX_PS_BOOL_LIGHTWARPTEXTURE, false);
+		for (int n = LUX_PS_BOOL_PHONG_BASEMAPALPHAMASK; n <= LUX_PS_BOOL_PHONG_WARPTEXTURE; n++)
+			AddBool(Commands, n, ((nSeed >> n) & 1) != 0);
+		AddBool(Commands, LUX_PS_BOOL_VERTEXCOLOR, false);
+		AddBool(Commands, LUX_PS_BOOL_HEIGHTFOG, false);
+		AddBool(Commands, LUX_PS_BOOL_RADIALFOG, true);
+		AddBool(Commands, LUX_PS_BOOL_DEPTHTODESTALPHA, false);
+
+		Command_t Draw = { COMMAND_DRAW, 0, { 0.0f, 0.0f, 0.0f, 0.0f } };
+		Commands.push_back(Draw);
+	}
+}
+
+//==========================================================================//
+// Fake GPU. Keeps the Registers so we can check the Shadow didn't lose anything
+//==========================================================================//
+class CRecordingAPI
+{
+public:
+	CRecordingAPI() : m_nBytes(0), m_nCalls(0)
+	{
+		memset(m_flFloats, 0, sizeof(m_flFloats));
+		memset(m_nBools, 0, sizeof(m_nBools));
+	}
+
+	void SetPixelShaderConstant(int nFirst, const float *pData, int nCount)
+	{
+		memcpy(m_flFloats[nFirst], pData, nCount * sizeof(float) * 4);
+		m_nBytes += nCount * sizeof(float) * 4;
+		m_nCalls++;
+	}
+
+	void SetBooleanPixelShaderConstant(int nFirst, const int *pData, int nCount)
+	{
+		memcpy(&m_nBools[nFirst], pData, nCount * sizeof(int));
+		m_nBytes += nCount * sizeof(int);
+		m_nCalls++;
+	}
+
+	// Not used, FlushVS() needs them to compile
+	void SetVertexShaderConstant(int, const float *, int) {}
+	void SetBooleanVertexShaderConstant(int, const int *, int) {}
+
+	bool SameRegisters(const CRecordingAPI &Other) const
+	{
+		return !memcmp(m_flFloats, Other.m_flFloats, sizeof(m_flFloats)) && !memcmp(m_nBools, Other.m_nBools, sizeof(m_nBools));
+	}
+
+	float m_flFloats[224][4];
+	int m_nBools[16];
+	int64_t m_nBytes;
+	int64_t m_nCalls;
+};
+
+// Today, every Set goes straight to the API
+static int ReplayDirect(const std::vector<Command_t> &Commands, CRecordingAPI &API)
+{
+	int nDraws = 0;
+	for (size_t n = 0; n < Commands.size(); n++)
+	{
+		const Command_t &Command = Commands[n];
+		if (Command.nType == COMMAND_FLOAT)
+			API.SetPixelShaderConstant(Command.nRegister, Command.fl4, 1);
+		else if (Command.nType == COMMAND_BOOL)
+		{
+			int nValue = Command.fl4[0] != 0.0f;
+			API.SetBooleanPixelShaderConstant(Command.nRegister, &nValue, 1);
+		}
+		else
+			nDraws++;
+	}
+	return nDraws;
+}
+
+static bool ReplayShadow(const std::vector<Command_t> &Commands, CRecordingAPI &API, const CRecordingAPI &Direct, CLuxPixelConstantShadow &Shadow)
+{
+	// Per Draw Check against the direct Path, needs a second Fake GPU replaying alongside
+	CRecordingAPI Reference;
+	for (size_t n = 0; n < Commands.size(); n++)
+	{
+		const Command_t &Command = Commands[n];
+		if (Command.nType == COMMAND_FLOAT)
+		{
+			Shadow.SetFloats(Command.nRegister, Command.fl4, 1);
+			Reference.SetPixelShaderConstant(Command.nRegister, Command.fl4, 1);
+		}
+		else if (Command.nType == COMMAND_BOOL)
+		{
+			int nValue = Command.fl4[0] != 0.0f;
+			Shadow.SetBools(Command.nRegister, &nValue, 1);
+			Reference.SetBooleanPixelShaderConstant(Command.nRegister, &nValue, 1);
+		}
+		else
+		{
+			Shadow.FlushPS(API);
+			if (!API.SameRegisters(Reference))
+			{
+				fprintf(stderr, "Register Mismatch after Command %d\n", (int)n);
+				return false;
+			}
+		}
+	}
+	return API.SameRegisters(Direct);
+}
+
+// Timing only, no Checks. Null API so we measure the Shadow and not the memcpy
+class CNullAPI
+{
+public:
+	CNullAPI() : m_nCalls(0) {}
+	void SetPixelShaderConstant(int, const float *, int) { m_nCalls++; }
+	void SetBooleanPixelShaderConstant(int, const int *, int) { m_nCalls++; }
+	void SetVertexShaderConstant(int, const float *, int) {}
+	void SetBooleanVertexShaderConstant(int, const int *, int) {}
+	int64_t m_nCalls;
+};
+
+static volatile int64_t s_nSink;
+
+static double TimeShadow(const std::vector<Command_t> &Commands, int nRepeats)
+{
+	CLuxPixelConstantShadow Shadow;
+	CNullAPI API;
+	double flStart = LuxTimeSeconds();
+	for (int nRepeat = 0; nRepeat < nRepeats; nRepeat++)
+	{
+		for (size_t n = 0; n < Commands.size(); n++)
+		{
+			const Command_t &Command = Commands[n];
+			if (Command.nType == COMMAND_FLOAT)
+				Shadow.SetFloats(Command.nRegister, Command.fl4, 1);
+			else if (Command.nType == COMMAND_BOOL)
+			{
+				int nValue = Command.fl4[0] != 0.0f;
+				Shadow.SetBools(Command.nRegister, &nValue, 1);
+			}
+			else
+				Shadow.FlushPS(API);
+		}
+	}
+	double flTime = LuxTimeSeconds() - flStart;
+
+	// Keeps the Compiler from throwing the Loop away
+	s_nSink += API.m_nCalls + (int64_t)Shadow.GetHash();
+	return flTime;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	const char *pStream = CommandLine.ParmValue("-stream", (const char *)0);
+	const char *pRecord = CommandLine.ParmValue("-record", (const char *)0);
+	int nDraws = CommandLine.ParmValue("-draws", 20000);
+	int nMaterials = CommandLine.ParmValue("-materials", 64);
+
+	std::vector<Command_t> Commands;
+	if (pStream)
+	{
+		if (!LoadStream(pStream, Commands))
+			return fprintf(stderr, "Failed to load %s\n", pStream), 1;
+	}
+	else
+	{
+		if (nDraws <= 0 || nMaterials <= 0)
+			return fprintf(stderr, "Usage: lux_constantshadow_bench [-stream file] [-draws N] [-materials N] [-shuffle] [-record file]\n"), 1;
+		MakeSynthetic(Commands, nDraws, nMaterials, CommandLine.HasParm("-shuffle"));
+	}
+
+	if (pRecord)
+	{
+		// Goes through the Shadow's own Recorder, so the Format can't drift
+		FILE *pFile = fopen(pRecord, "w");
+		if (!pFile)
+			return fprintf(stderr, "Failed to write %s\n", pRecord), 1;
+
+		CLuxPixelConstantShadow Shadow;
+		CNullAPI API;
+		Shadow.SetRecordFile(pFile);
+		for (size_t n = 0; n < Commands.size(); n++)
+		{
+			if (Commands[n].nType == COMMAND_FLOAT)
+				Shadow.SetFloats(Commands[n].nRegister, Commands[n].fl4, 1);
+			else if (Commands[n].nType == COMMAND_BOOL)
+				Shadow.SetBool(Commands[n].nRegister, Commands[n].fl4[0] != 0.0f);
+			else
+				Shadow.FlushPS(API);
+		}
+		fclose(pFile);
+		printf("Wrote %s\n", pRecord);
+	}
+
+	CRecordingAPI Direct, Shadowed;
+	CLuxPixelConstantShadow Shadow;
+	int nStreamDraws = ReplayDirect(Commands, Direct);
+	if (!ReplayShadow(Commands, Shadowed, Direct, Shadow))
+	{
+		fprintf(stderr, "FAILED : The Shadow left different Registers than the direct Path\n");
+		return 1;
+	}
+
+	const LuxConstantShadowStats_t &Stats = Shadow.GetStats();
+	printf("%s : %d Draws, %d Commands. Registers match the direct Path\n\n",
+		pStream ? pStream : "Synthetic", nStreamDraws, (int)Commands.size());
+
+	double flDraws = nStreamDraws > 0 ? (double)nStreamDraws : 1.0;
+	printf("%-8s %14s %14s %12s %12s\n", "Path", "Bytes", "Bytes/Draw", "Calls", "Calls/Draw");
+	printf("%-8s %14lld %14.1f %12lld %12.2f\n", "Direct", (long long)Direct.m_nBytes, Direct.m_nBytes / flDraws, (long long)Direct.m_nCalls, Direct.m_nCalls / flDraws);
+	printf("%-8s %14lld %14.1f %12lld %12.2f\n", "Shadow", (long long)Shadowed.m_nBytes, Shadowed.m_nBytes / flDraws, (long long)Shadowed.m_nCalls, Shadowed.m_nCalls / flDraws);
+	printf("\nSaved %.1f%% of the Bytes and %.1f%% of the Calls\n",
+		100.0 * (1.0 - (double)Shadowed.m_nBytes / (Direct.m_nBytes ? Direct.m_nBytes : 1)),
+		100.0 * (1.0 - (double)Shadowed.m_nCalls / (Direct.m_nCalls ? Direct.m_nCalls : 1)));
+	printf("Floats : %lld set, %lld uploaded in %lld Runs. Bools : %lld set, %lld uploaded in %lld Runs\n",
+		(long long)Stats.m_nFloatSets, (long long)Stats.m_nFloatUploads, (long long)Stats.m_nFloatRuns,
+		(long long)Stats.m_nBoolSets, (long long)Stats.m_nBoolUploads, (long long)Stats.m_nBoolRuns);
+
+	const int nRepeats = 20;
+	double flTime = TimeShadow(Commands, nRepeats);
+	printf("Shadow CPU Cost : %.1f ns per Draw\n", flTime * 1e9 / (flDraws * nRepeats));
+	return 0;
+}
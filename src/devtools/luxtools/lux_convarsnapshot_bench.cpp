@@ -0,0 +1,270 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Per-Draw Cost of ConVar Reads, with and without cpp_lux_convarsnapshot.h
+//
+//	The ConVars here are a Stand-in for tier1's : a Value behind a Parent Pointer, read through a virtual
+//	Getter like ConVarRef across the DLL Boundary, and a Name Lookup for Code that calls FindVar() per Draw.
+//	Each Draw reads every Snapshot Field once. Reports ns per Draw for
+//		FindVar per Read, cached ConVar Pointers, and the Snapshot ( its once-per-Frame Refresh included ).
+//	Also checks that m_nVersion only moves when a Value changed, and that Changes show up the next Frame.
+//
+//	Usage :	lux_convarsnapshot_bench [-frames 500] [-draws 3000]
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#define LUX_CONVARSNAPSHOT_CORE_ONLY
+#include "../../shaders/fxc/cpp_lux_convarsnapshot.h"
+
+#include <map>
+#include <algorithm>
+
+//==========================================================================//
+// Fake ConVars
+//==========================================================================//
+class IFakeConVar
+{
+public:
+	virtual ~IFakeConVar() {}
+	virtual int GetInt() const = 0;
+	virtual float GetFloat() const = 0;
+};
+
+class CFakeConVar : public IFakeConVar
+{
+public:
+	CFakeConVar(const char *pName, float flValue) : m_pParent(this), m_pName(pName) { SetValue(flValue); }
+
+	virtual int GetInt() const { return m_pParent->m_nValue; }
+	virtual float GetFloat() const { return m_pParent->m_flValue; }
+
+	void SetValue(float flValue)
+	{
+		m_flValue = flValue;
+		m_nValue = (int)flValue;
+	}
+
+	const char *GetName() const { return m_pName; }
+
+private:
+	CFakeConVar *m_pParent;
+	const char *m_pName;
+	float m_flValue;
+	int m_nValue;
+};
+
+struct NameLess_t
+{
+	bool operator()(const char *a, const char *b) const { return strcmp(a, b) < 0; }
+};
+
+class CFakeCVar
+{
+public:
+	~CFakeCVar()
+	{
+		for (size_t n = 0; n < m_ConVars.size(); n++)
+			delete m_ConVars[n];
+	}
+
+	CFakeConVar *Register(const char *pName, float flValue)
+	{
+		CFakeConVar *pConVar = new CFakeConVar(pName, flValue);
+		m_ConVars.push_back(pConVar);
+		m_ByName[pName] = pConVar;
+		return pConVar;
+	}
+
+	IFakeConVar *FindVar(const char *pName) const
+	{
+		std::map<const char *, CFakeConVar *, NameLess_t>::const_iterator It = m_ByName.find(pName);
+		return It == m_ByName.end() ? NULL : It->second;
+	}
+
+private:
+	std::vector<CFakeConVar *> m_ConVars;
+	std::map<const char *, CFakeConVar *, NameLess_t> m_ByName;
+};
+
+// CLuxConVarReader, on the Fakes
+class CFakeReader
+{
+public:
+	CFakeReader(const CFakeCVar &CVar)
+	{
+		for (int n = 0; n < NUM_LUXCONVARS; n++)
+			m_pConVars[n] = CVar.FindVar(LuxConVar_Name(n));
+	}
+
+	int GetInt(int nIndex, int nDefault) const { return m_pConVars[nIndex] ? m_pConVars[nIndex]->GetInt() : nDefault; }
+	float GetFloat(int nIndex, float flDefault) const { return m_pConVars[nIndex] ? m_pConVars[nIndex]->GetFloat() : flDefault; }
+
+	IFakeConVar *m_pConVars[NUM_LUXCONVARS];
+};
+
+//==========================================================================//
+// What a Draw does with the Values. Enough Work that the Reads can't be thrown away
+//==========================================================================//
+static inline float UseValues(const LuxConVarSnapshot_t &ConVars, int nDraw)
+{
+	float fl = 0.0f;
+	fl += ConVars.m_nFullbright == 2 ? 1.0f : 0.0f;
+	fl += ConVars.m_bLuxels ? 2.0f : 0.0f;
+	fl += ConVars.m_bSpecular ? (float)(nDraw & 3) : 0.0f;
+	fl += ConVars.m_bBumpMap ? 0.5f : 0.0f;
+	fl += ConVars.m_bPhong ? 0.25f : 0.0f;
+	fl += ConVars.m_bDisableLightWarp ? 0.125f : 0.0f;
+	fl += (float)ConVars.m_nFlashlightDepthRes * 0.001f;
+	return fl;
+}
+
+// Every Field through T, Draw Code reading ConVars directly
+template <class T>
+static inline void ReadAll(T &Reader, LuxConVarSnapshot_t &Out)
+{
+#define LUX_BENCH_READ(ID, Type, Member, Name, Default) LuxConVar_Read(Reader, LUXCONVAR_##ID, Out.Member);
+	LUX_CONVARSNAPSHOT_FIELDS(LUX_BENCH_READ)
+#undef LUX_BENCH_READ
+}
+
+// FindVar() on every Read
+class CFindVarReader
+{
+public:
+	CFindVarReader(const CFakeCVar &CVar) : m_CVar(CVar) {}
+
+	int GetInt(int nIndex, int nDefault) const
+	{
+		IFakeConVar *pConVar = m_CVar.FindVar(LuxConVar_Name(nIndex));
+		return pConVar ? pConVar->GetInt() : nDefault;
+	}
+
+	float GetFloat(int nIndex, float flDefault) const
+	{
+		IFakeConVar *pConVar = m_CVar.FindVar(LuxConVar_Name(nIndex));
+		return pConVar ? pConVar->GetFloat() : flDefault;
+	}
+
+private:
+	const CFakeCVar &m_CVar;
+};
+
+static int CheckVersions(CFakeCVar &CVar, CFakeConVar *pFullbright)
+{
+	CFakeReader Reader(CVar);
+	CLuxConVarSnapshot Snapshot;
+	int nFailed = 0;
+
+	uint32_t nVersion = Snapshot.Refresh(0, Reader).m_nVersion;
+	for (int nFrame = 1; nFrame < 100; nFrame++)
+	{
+		// Changes on Frames 10, 20 .. and a Set to the same Value on Frames 15, 25 ..
+		if (nFrame % 10 == 0)
+			pFullbright->SetValue((float)((nFrame / 10) % 3));
+		else if (nFrame % 10 == 5)
+			pFullbright->SetValue((float)pFullbright->GetInt());
+
+		const LuxConVarSnapshot_t &ConVars = Snapshot.Refresh(nFrame, Reader);
+		uint32_t nExpected = nVersion + (nFrame % 10 == 0 ? 1 : 0);
+		if (ConVars.m_nVersion != nExpected || ConVars.m_nFullbright != pFullbright->GetInt())
+		{
+			printf("Frame %d : Version %u, expected %u, mat_fullbright %d, expected %d\n", nFrame, ConVars.m_nVersion, nExpected, ConVars.m_nFullbright, pFullbright->GetInt());
+			nFailed++;
+		}
+		nVersion = ConVars.m_nVersion;
+
+		// Same Frame again, nothing is read
+		pFullbright->SetValue(7.0f);
+		if (Snapshot.Refresh(nFrame, Reader).m_nFullbright == 7)
+		{
+			printf("Frame %d : Refresh() read twice in one Frame\n", nFrame);
+			nFailed++;
+		}
+		pFullbright->SetValue((float)ConVars.m_nFullbright);
+	}
+
+	printf("Versions : %s\n", nFailed ? "FAILED" : "passed");
+	return nFailed;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nFrames = std::max(1, CommandLine.ParmValue("-frames", 500));
+	int nDraws = std::max(1, CommandLine.ParmValue("-draws", 3000));
+
+	// A few hundred ConVars in the Engine, so the Name Lookup isn't unrealistically short
+	CFakeCVar CVar;
+	static char s_szNames[400][32];
+	for (int n = 0; n < 400; n++)
+	{
+		snprintf(s_szNames[n], sizeof(s_szNames[n]), "cl_fake_convar_%03d", n);
+		CVar.Register(s_szNames[n], (float)n);
+	}
+	CFakeConVar *pFullbright = CVar.Register("mat_fullbright", 0.0f);
+	CVar.Register("mat_luxels", 0.0f);
+	CVar.Register("mat_specular", 1.0f);
+	CVar.Register("mat_bumpmap", 1.0f);
+	CVar.Register("mat_phong", 1.0f);
+	CVar.Register("mat_disable_lightwarp", 0.0f);
+	CVar.Register("r_flashlightdepthres", 2048.0f);
+
+	int nFailed = CheckVersions(CVar, pFullbright);
+
+	CFindVarReader FindVarReader(CVar);
+	CFakeReader CachedReader(CVar);
+	CLuxConVarSnapshot Snapshot;
+	double flSum[3] = { 0.0, 0.0, 0.0 };
+	double flTime[3];
+
+	double flStart = LuxTimeSeconds();
+	for (int nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		for (int nDraw = 0; nDraw < nDraws; nDraw++)
+		{
+			LuxConVarSnapshot_t ConVars;
+			ReadAll(FindVarReader, ConVars);
+			flSum[0] += UseValues(ConVars, nDraw);
+		}
+	}
+	flTime[0] = LuxTimeSeconds() - flStart;
+
+	flStart = LuxTimeSeconds();
+	for (int nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		for (int nDraw = 0; nDraw < nDraws; nDraw++)
+		{
+			LuxConVarSnapshot_t ConVars;
+			ReadAll(CachedReader, ConVars);
+			flSum[1] += UseValues(ConVars, nDraw);
+		}
+	}
+	flTime[1] = LuxTimeSeconds() - flStart;
+
+	flStart = LuxTimeSeconds();
+	for (int nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		for (int nDraw = 0; nDraw < nDraws; nDraw++)
+		{
+			// Every Draw asks, only the first one per Frame reads
+			const LuxConVarSnapshot_t &ConVars = Snapshot.Refresh(nFrame, CachedReader);
+			flSum[2] += UseValues(ConVars, nDraw);
+		}
+	}
+	flTime[2] = LuxTimeSeconds() - flStart;
+
+	const char *pNames[3] = { "FindVar per Read", "cached ConVar*", "Snapshot" };
+	printf("\n%d Frames, %d Draws, %d ConVars per Draw\n", nFrames, nDraws, (int)NUM_LUXCONVARS);
+	for (int n = 0; n < 3; n++)
+	{
+		printf("%-18s %7.2f ns per Draw%s\n", pNames[n], flTime[n] * 1e9 / ((double)nFrames * nDraws),
+			flSum[n] == flSum[0] ? "" : "  ( Checksum differs! )");
+		nFailed += flSum[n] == flSum[0] ? 0 : 1;
+	}
+
+	return nFailed ? 1 : 0;
+}
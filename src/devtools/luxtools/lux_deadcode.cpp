@@ -0,0 +1,915 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Finds the Functions, Constants, Samplers and Headers no Combo of a Shader uses
+//
+//	lux_custom_common_ps.h and lux_common_vs_model.h pull in everything any Shader might want, Morph Helpers,
+//	Skinning Overloads, every Fog Model. The Compiler throws the unused Parts away, but it still preprocesses
+//	and parses them for every Combo, and a Constant or Sampler nobody reads still holds its register().
+//
+//	Per Combo this preprocesses the Shader, splits the active Code into its top-level Declarations and follows
+//	the Call Graph from main() : Calls ( matched by Name and Argument Count, so Overloads are told apart ),
+//	Globals, Structs and Macros, Macro Bodies included. A Header is needed when something live was declared
+//	or #defined in it, when a needed File's #if asks about a Macro it defines, or when it includes a needed one.
+//
+//	Reports what's dead in every Combo, Constants and Samplers with a register() first, and the Headers no Combo
+//	needs. -out writes <out>/<shader>_slim.fxc : the Shader with every needed Header inlined, the others dropped,
+//	and the Functions no Combo calls removed. Then it checks every Combo of the slim File sees the same live Code.
+//
+//	Usage :	lux_deadcode [-fxc ../../shaders/fxc] [-list ../../compile_all_shaders.txt] [-out <dir>] [-verbose] <shader.fxc> ..
+//			-verbose	Every Declaration with the Number of Combos it's live in, not just the dead ones
+//
+//	Exits with 1 when a slim File doesn't check out.
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+#include "luxtools_combodedup.h"
+
+//==========================================================================//
+// Tokens of the active Lines
+//==========================================================================//
+struct Token_t
+{
+	std::string Text;
+	int nLine;				// Index into CLuxPreprocessor::Lines()
+};
+
+static void Tokenize(const std::string &Text, int nLine, std::vector<Token_t> &Tokens)
+{
+	for (size_t n = 0; n < Text.size(); )
+	{
+		if (isspace((unsigned char)Text[n]))
+		{
+			n++;
+			continue;
+		}
+
+		size_t nEnd = n + 1;
+		if (LuxIsIdentChar(Text[n]))
+		{
+			// 1.5e3f is one Token
+			bool bNumber = isdigit((unsigned char)Text[n]) != 0;
+			while (nEnd < Text.size() && (LuxIsIdentChar(Text[nEnd]) || (bNumber && Text[nEnd] == '.')))
+				nEnd++;
+		}
+		else if (Text[n] == '.' && nEnd < Text.size() && isdigit((unsigned char)Text[nEnd]))
+		{
+			while (nEnd < Text.size() && LuxIsIdentChar(Text[nEnd]))
+				nEnd++;
+		}
+		else if (Text[n] == '"')
+		{
+			while (nEnd < Text.size() && Text[nEnd] != '"')
+				nEnd += Text[nEnd] == '\\' ? 2 : 1;
+			nEnd = std::min(nEnd + 1, Text.size());
+		}
+
+		Token_t Token;
+		Token.Text = Text.substr(n, nEnd - n);
+		Token.nLine = nLine;
+		Tokens.push_back(Token);
+		n = nEnd;
+	}
+}
+
+// Index of the Bracket closing the one at n, or the End
+static size_t Match(const std::vector<Token_t> &Tokens, size_t n)
+{
+	int nDepth = 0;
+	for (; n < Tokens.size(); n++)
+	{
+		const std::string &Text = Tokens[n].Text;
+		if (Text == "(" || Text == "[" || Text == "{")
+			nDepth++;
+		else if ((Text == ")" || Text == "]" || Text == "}") && --nDepth == 0)
+			return n;
+	}
+	return Tokens.size();
+}
+
+// Arguments between the Parenthesis at n and its Match
+static int CountArguments(const std::vector<Token_t> &Tokens, size_t n, bool *pOptional = NULL)
+{
+	size_t nEnd = Match(Tokens, n);
+	if (nEnd == n + 1 || (nEnd == n + 2 && Tokens[n + 1].Text == "void"))
+		return 0;
+
+	int nArguments = 1, nOptional = 0;
+	for (size_t i = n + 1; i < nEnd; i++)
+	{
+		const std::string &Text = Tokens[i].Text;
+		if (Text == "(" || Text == "[" || Text == "{")
+			i = Match(Tokens, i);
+		else if (Text == ",")
+			nArguments++;
+		else if (Text == "=")
+			nOptional++;
+	}
+	if (pOptional)
+		*pOptional = nOptional != 0;
+	return pOptional ? nArguments - nOptional : nArguments;
+}
+
+//==========================================================================//
+// Top-level Declarations
+//==========================================================================//
+enum DeclKind_t
+{
+	DECL_FUNCTION,
+	DECL_CONSTANT,
+	DECL_SAMPLER,
+	DECL_STRUCT,
+};
+
+static const char *s_pKindNames[] = { "function", "constant", "sampler", "struct" };
+
+struct Decl_t
+{
+	DeclKind_t Kind;
+	std::string Name;
+	std::string Register;	// "c12", "s3", empty without register()
+	size_t nFirst;			// Tokens
+	size_t nEnd;
+	int nMinArguments;		// Functions, Parameters with a Default are optional
+	int nMaxArguments;
+};
+
+static bool IsSamplerType(const std::string &Type)
+{
+	return !Type.compare(0, 7, "sampler") || !Type.compare(0, 7, "texture") || !Type.compare(0, 7, "Texture");
+}
+
+// One Statement of Globals, "float4 a : register(c0), b[2];"
+static void ParseGlobals(const std::vector<Token_t> &Tokens, size_t nFirst, size_t nEnd, std::vector<Decl_t> &Decls)
+{
+	bool bSampler = false, bFirst = true;
+	size_t nPiece = nFirst;
+	for (size_t n = nFirst; n <= nEnd; n++)
+	{
+		if (n < nEnd && (Tokens[n].Text == "(" || Tokens[n].Text == "[" || Tokens[n].Text == "{"))
+		{
+			n = Match(Tokens, n);
+			continue;
+		}
+		if (n < nEnd && Tokens[n].Text != ",")
+			continue;
+
+		// The Name is right before the first ':', '[' or '=', Type Tokens before it. Later Pieces start with it
+		size_t nName = nPiece;
+		for (size_t i = nPiece; i < n; i++)
+		{
+			const std::string &Text = Tokens[i].Text;
+			if (Text == ":" || Text == "[" || Text == "=" || Text == "<")
+				break;
+			if (LuxIsIdentStart(Text[0]))
+				nName = i;
+			if (!bFirst)
+				break;
+		}
+		for (size_t i = nFirst; bFirst && i < nName; i++)
+			bSampler |= IsSamplerType(Tokens[i].Text);
+
+		Decl_t Decl;
+		Decl.Kind = bSampler ? DECL_SAMPLER : DECL_CONSTANT;
+		Decl.Name = Tokens[nName].Text;
+		Decl.nFirst = nFirst;
+		Decl.nEnd = nEnd + 1;
+		Decl.nMinArguments = Decl.nMaxArguments = 0;
+		for (size_t i = nPiece; i + 2 < n; i++)
+		{
+			if (Tokens[i].Text == "register" && Tokens[i + 1].Text == "(")
+			{
+				size_t nClose = Match(Tokens, i + 1);
+				Decl.Register = Tokens[nClose - 1].Text;
+			}
+		}
+		if (LuxIsIdentStart(Decl.Name[0]))
+			Decls.push_back(Decl);
+
+		bFirst = false;
+		nPiece = n + 1;
+	}
+}
+
+static void ParseDeclarations(const std::vector<Token_t> &Tokens, std::vector<Decl_t> &Decls)
+{
+	size_t nStart = 0;
+	while (nStart < Tokens.size())
+	{
+		if (Tokens[nStart].Text == ";")
+		{
+			nStart++;
+			continue;
+		}
+
+		// Up to the ';', or the Body of a Function. The first '(' before any ':' or '=' makes it a Function
+		bool bStruct = Tokens[nStart].Text == "struct";
+		size_t nParen = std::string::npos, n = nStart;
+		bool bSeparator = false, bBody = false;
+		for (; n < Tokens.size(); n++)
+		{
+			const std::string &Text = Tokens[n].Text;
+			if (Text == "(" || Text == "[")
+			{
+				if (Text == "(" && nParen == std::string::npos && !bSeparator && !bStruct)
+					nParen = n;
+				n = Match(Tokens, n);
+			}
+			else if (Text == "{")
+			{
+				n = Match(Tokens, n);
+				if (nParen != std::string::npos)
+				{
+					bBody = true;
+					break;
+				}
+			}
+			else if (Text == ":" || Text == "=")
+				bSeparator = true;
+			else if (Text == ";")
+				break;
+		}
+		size_t nEnd = std::min(n, Tokens.size() - 1);
+
+		Decl_t Decl;
+		Decl.nFirst = nStart;
+		Decl.nEnd = nEnd + 1;
+		Decl.nMinArguments = Decl.nMaxArguments = 0;
+		if (bStruct && nStart + 1 < Tokens.size())
+		{
+			Decl.Kind = DECL_STRUCT;
+			Decl.Name = Tokens[nStart + 1].Text;
+			Decls.push_back(Decl);
+		}
+		else if (bBody && nParen > nStart && LuxIsIdentStart(Tokens[nParen - 1].Text[0]))
+		{
+			bool bOptional = false;
+			Decl.Kind = DECL_FUNCTION;
+			Decl.Name = Tokens[nParen - 1].Text;
+			Decl.nMaxArguments = CountArguments(Tokens, nParen);
+			Decl.nMinArguments = CountArguments(Tokens, nParen, &bOptional);
+			Decls.push_back(Decl);
+		}
+		else if (nParen == std::string::npos && nEnd > nStart && Tokens[nStart].Text != "typedef")
+			ParseGlobals(Tokens, nStart, nEnd, Decls);
+		// Prototypes and anything else aren't Declarations of their own
+
+		nStart = nEnd + 1;
+	}
+}
+
+//==========================================================================//
+// One Combo. Everything main() reaches, and the Files that takes
+//==========================================================================//
+class CComboAnalysis
+{
+public:
+	CComboAnalysis(CLuxPreprocessor &PP) : m_PP(PP)
+	{
+		const std::vector<LuxActiveLine_t> &Lines = PP.Lines();
+		for (size_t n = 0; n < Lines.size(); n++)
+			Tokenize(Lines[n].Text, (int)n, m_Tokens);
+		ParseDeclarations(m_Tokens, m_Decls);
+		for (size_t n = 0; n < m_Decls.size(); n++)
+		{
+			m_ByName[m_Decls[n].Name].push_back(n);
+			if (!m_Decls[n].Register.empty())
+				m_Decls[n].Register = LuxTrim(PP.Expand(m_Decls[n].Register));
+		}
+
+		m_Live.assign(m_Decls.size(), false);
+		std::map<std::string, std::vector<size_t> >::const_iterator Main = m_ByName.find("main");
+		for (size_t n = 0; Main != m_ByName.end() && n < Main->second.size(); n++)
+			Mark(Main->second[n]);
+		Propagate();
+
+		// Files with something live in them, and everything including those. Then what their #ifs ask about
+		std::vector<std::string> Files = PP.Files();
+		for (;;)
+		{
+			m_Needed.clear();
+			m_Needed.insert(Files[0]);
+			for (size_t n = 0; n < PP.Directives().size(); n++)
+				m_Needed.insert(Files[PP.Directives()[n].nFile]);
+			for (size_t n = 0; n < m_Decls.size(); n++)
+			{
+				if (m_Live[n])
+					m_Needed.insert(DeclFile(n));
+			}
+			for (std::set<std::string>::const_iterator It = m_Macros.begin(); It != m_Macros.end(); ++It)
+			{
+				const LuxMacro_t *pMacro = PP.FindMacro(*It);
+				if (pMacro && pMacro->nFile >= 0)
+					m_Needed.insert(Files[pMacro->nFile]);
+			}
+			for (size_t n = 0; n < Files.size(); n++)
+			{
+				if (!m_Needed.count(Files[n]))
+					continue;
+				for (int nParent = PP.Parents()[n]; nParent >= 0; nParent = PP.Parents()[nParent])
+					m_Needed.insert(Files[nParent]);
+			}
+
+			size_t nMacros = m_Macros.size();
+			for (std::set<std::pair<std::string, int> >::const_iterator It = PP.Tested().begin(); It != PP.Tested().end(); ++It)
+			{
+				if (m_Needed.count(Files[It->second]))
+					UseMacro(It->first);
+			}
+			Propagate();
+			if (m_Macros.size() == nMacros)
+				break;
+		}
+	}
+
+	const std::vector<Token_t> &Tokens() const { return m_Tokens; }
+	const std::vector<Decl_t> &Decls() const { return m_Decls; }
+	bool IsLive(size_t nDecl) const { return m_Live[nDecl]; }
+	const std::set<std::string> &Needed() const { return m_Needed; }
+
+	const std::string &DeclFile(size_t nDecl) const { return m_PP.Files()[m_PP.Lines()[m_Tokens[m_Decls[nDecl].nFirst].nLine].nFile]; }
+	int DeclLine(size_t nDecl) const { return m_PP.Lines()[m_Tokens[m_Decls[nDecl].nFirst].nLine].nLine; }
+	int DeclEndLine(size_t nDecl) const { return m_PP.Lines()[m_Tokens[m_Decls[nDecl].nEnd - 1].nLine].nLine; }
+
+	// Nothing else starts on its first Line or goes on on its last, so the Lines can go
+	bool HasOwnLines(size_t nDecl) const
+	{
+		const Decl_t &Decl = m_Decls[nDecl];
+		bool bFirst = !Decl.nFirst || m_Tokens[Decl.nFirst - 1].nLine != m_Tokens[Decl.nFirst].nLine;
+		bool bLast = Decl.nEnd >= m_Tokens.size() || m_Tokens[Decl.nEnd].nLine != m_Tokens[Decl.nEnd - 1].nLine;
+		return bFirst && bLast;
+	}
+
+	// Every Name a Declaration refers to, through Macros too
+	void References(size_t nDecl, std::set<std::string> &Names) const
+	{
+		std::vector<Token_t> Body(m_Tokens.begin() + m_Decls[nDecl].nFirst, m_Tokens.begin() + m_Decls[nDecl].nEnd);
+		for (size_t n = 0; n < Body.size(); n++)
+		{
+			if (!LuxIsIdentStart(Body[n].Text[0]) || !Names.insert(Body[n].Text).second)
+				continue;
+			const LuxMacro_t *pMacro = m_PP.FindMacro(Body[n].Text);
+			if (pMacro)
+				Tokenize(pMacro->Body, -1, Body);
+		}
+	}
+
+	// The live Code as the Compiler gets it, to compare two Versions of a Shader
+	std::string LiveCode() const
+	{
+		std::string Code;
+		for (size_t n = 0; n < m_Decls.size(); n++)
+		{
+			if (!m_Live[n])
+				continue;
+			std::string Text;
+			for (size_t i = m_Decls[n].nFirst; i < m_Decls[n].nEnd; i++)
+				Text += m_Tokens[i].Text + " ";
+			LuxAppendNormalized(m_PP.Expand(Text), Code);
+		}
+		for (size_t n = 0; n < m_PP.Directives().size(); n++)
+			LuxAppendNormalized(m_PP.Directives()[n].Text, Code);
+		return Code;
+	}
+
+private:
+	void Mark(size_t nDecl)
+	{
+		if (m_Live[nDecl])
+			return;
+		m_Live[nDecl] = true;
+		m_Work.push_back(nDecl);
+	}
+
+	void Propagate()
+	{
+		while (!m_Work.empty())
+		{
+			const Decl_t &Decl = m_Decls[m_Work.back()];
+			m_Work.pop_back();
+			Scan(m_Tokens, Decl.nFirst, Decl.nEnd);
+		}
+	}
+
+	void UseMacro(const std::string &Name)
+	{
+		const LuxMacro_t *pMacro = m_PP.FindMacro(Name);
+		if (!pMacro || !m_Macros.insert(Name).second)
+			return;
+		std::vector<Token_t> Body;
+		Tokenize(pMacro->Body, -1, Body);
+		Scan(Body, 0, Body.size());
+	}
+
+	void Scan(const std::vector<Token_t> &Tokens, size_t nFirst, size_t nEnd)
+	{
+		for (size_t n = nFirst; n < nEnd; n++)
+		{
+			const std::string &Name = Tokens[n].Text;
+			if (!LuxIsIdentStart(Name[0]))
+				continue;
+			UseMacro(Name);
+
+			std::map<std::string, std::vector<size_t> >::const_iterator It = m_ByName.find(Name);
+			if (It == m_ByName.end())
+				continue;
+
+			// A Call marks the Overloads taking that many Arguments. All of them when none does, or on no Call
+			bool bCall = n + 1 < nEnd && Tokens[n + 1].Text == "(";
+			int nArguments = bCall ? CountArguments(Tokens, n + 1) : -1;
+			bool bMatched = false;
+			for (size_t i = 0; i < It->second.size(); i++)
+			{
+				const Decl_t &Decl = m_Decls[It->second[i]];
+				if (Decl.Kind != DECL_FUNCTION || !bCall || (nArguments >= Decl.nMinArguments && nArguments <= Decl.nMaxArguments))
+				{
+					Mark(It->second[i]);
+					bMatched = true;
+				}
+			}
+			for (size_t i = 0; !bMatched && i < It->second.size(); i++)
+				Mark(It->second[i]);
+		}
+	}
+
+	CLuxPreprocessor &m_PP;
+	std::vector<Token_t> m_Tokens;
+	std::vector<Decl_t> m_Decls;
+	std::map<std::string, std::vector<size_t> > m_ByName;
+	std::vector<bool> m_Live;
+	std::vector<size_t> m_Work;
+	std::set<std::string> m_Macros;
+	std::set<std::string> m_Needed;
+};
+
+//==========================================================================//
+// All Combos of a Shader
+//==========================================================================//
+struct DeclStats_t
+{
+	DeclStats_t() : nLine(0), nEndLine(0), nCombos(0), nLive(0), bOwnLines(true) {}
+
+	DeclKind_t Kind;
+	std::string Name;
+	std::string Register;
+	std::string File;
+	int nLine;
+	int nEndLine;
+	int nCombos;			// Declared in
+	int nLive;
+	bool bOwnLines;
+	std::set<std::string> References;
+};
+
+struct ShaderStats_t
+{
+	ShaderStats_t() : nCombos(0), nLines(0), nLiveLines(0) {}
+
+	int nCombos;
+	int64_t nLines;			// Active, summed over the Combos
+	int64_t nLiveLines;
+	std::map<std::string, DeclStats_t> Decls;		// File, Line and Name
+	std::map<std::string, int> Included;			// Combos
+	std::map<std::string, int> Needed;
+	std::vector<std::string> Problems;
+};
+
+struct Options_t
+{
+	std::string FxcDir;
+	std::string OutDir;
+	bool bVerbose;
+};
+
+static void PreprocessCombo(CLuxPreprocessor &PP, const Options_t &Options, const std::string &Path, bool bVertex, const CLuxComboSet &Combos, const std::vector<int> &Values)
+{
+	PP.AddIncludeDir(Options.FxcDir);
+	PP.Define(bVertex ? "SHADER_MODEL_VS_3_0" : "SHADER_MODEL_PS_3_0", "1");
+	for (int n = 0; n < Combos.NumCombos(); n++)
+	{
+		char szValue[16];
+		snprintf(szValue, sizeof(szValue), "%d", Values[n]);
+		PP.Define(Combos.Combo(n).Name, szValue);
+	}
+	PP.Run(Path);
+}
+
+static void AnalyseShader(CLuxSourceCache &Cache, const Options_t &Options, const std::string &Path, bool bVertex, const CLuxComboSet &Combos, ShaderStats_t &Stats)
+{
+	std::vector<int> Values;
+	std::set<std::string> Problems;
+	for (int64_t nIndex = 0; nIndex < Combos.NumIndices(); nIndex++)
+	{
+		Combos.Decode(nIndex, Values);
+		if (Combos.IsSkipped(Values))
+			continue;
+
+		CLuxPreprocessor PP(&Cache);
+		PreprocessCombo(PP, Options, Path, bVertex, Combos, Values);
+		Problems.insert(PP.Problems().begin(), PP.Problems().end());
+		CComboAnalysis Analysis(PP);
+		Stats.nCombos++;
+		Stats.nLines += PP.Lines().size();
+
+		std::set<int> LiveLines;
+		for (size_t n = 0; n < Analysis.Decls().size(); n++)
+		{
+			const Decl_t &Decl = Analysis.Decls()[n];
+			char szKey[32];
+			snprintf(szKey, sizeof(szKey), "\n%08d\n", Analysis.DeclLine(n));
+			DeclStats_t &Decl_ = Stats.Decls[Analysis.DeclFile(n) + szKey + Decl.Name];
+			Decl_.Kind = Decl.Kind;
+			Decl_.Name = Decl.Name;
+			Decl_.Register = Decl.Register;
+			Decl_.File = Analysis.DeclFile(n);
+			Decl_.nLine = Analysis.DeclLine(n);
+			Decl_.nEndLine = std::max(Decl_.nEndLine, Analysis.DeclEndLine(n));
+			Decl_.nCombos++;
+			Decl_.bOwnLines &= Analysis.HasOwnLines(n);
+			Analysis.References(n, Decl_.References);
+			if (!Analysis.IsLive(n))
+				continue;
+			Decl_.nLive++;
+			for (size_t i = Decl.nFirst; i < Decl.nEnd; i++)
+				LiveLines.insert(Analysis.Tokens()[i].nLine);
+		}
+		Stats.nLiveLines += LiveLines.size();
+
+		std::set<std::string> Files(PP.Files().begin(), PP.Files().end());
+		for (std::set<std::string>::const_iterator It = Files.begin(); It != Files.end(); ++It)
+		{
+			Stats.Included[*It]++;
+			Stats.Needed[*It] += Analysis.Needed().count(*It) ? 1 : 0;
+		}
+	}
+	Stats.Problems.assign(Problems.begin(), Problems.end());
+}
+
+//==========================================================================//
+// Slim File
+//==========================================================================//
+// #if / #endif balanced and no #else or #elif of an outer Block, so the Lines can go without breaking the Structure
+static bool IsSelfContained(const std::vector<LuxSourceLine_t> &Lines, int nFirstLine, int nLastLine)
+{
+	int nDepth = 0;
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		if (Lines[n].nLine < nFirstLine || Lines[n].nLine > nLastLine)
+			continue;
+		std::string Text = LuxTrim(Lines[n].Text);
+		if (Text.empty() || Text[0] != '#')
+			continue;
+		std::string Directive = LuxTrim(Text.substr(1));
+		Directive = Directive.substr(0, Directive.find_first_not_of("abcdefghijklmnopqrstuvwxyz"));
+		if (Directive == "if" || Directive == "ifdef" || Directive == "ifndef")
+			nDepth++;
+		else if (Directive == "endif" && --nDepth < 0)
+			return false;
+		else if ((Directive == "else" || Directive == "elif") && nDepth == 0)
+			return false;
+	}
+	return nDepth == 0;
+}
+
+class CSlimWriter
+{
+public:
+	CSlimWriter(CLuxSourceCache &Cache, const std::string &FxcDir, const std::set<std::string> &Needed, const std::map<std::string, std::vector<std::pair<int, int> > > &Removed)
+		: m_nInlined(0), m_nDropped(0), m_Cache(Cache), m_FxcDir(FxcDir), m_Needed(Needed), m_Removed(Removed) {}
+
+	bool Write(const std::string &Path, std::string &Out)
+	{
+		Out.clear();
+		return Emit(Path, Out, 0);
+	}
+
+	int m_nInlined;
+	int m_nDropped;
+
+private:
+	bool Emit(const std::string &Path, std::string &Out, int nDepth)
+	{
+		std::string Source;
+		if (nDepth > 64 || !LuxReadFile(Path.c_str(), Source))
+			return false;
+
+		// Comments still in, and the Line Numbers are physical
+		std::vector<std::string> Lines;
+		size_t nStart = 0;
+		while (nStart <= Source.size())
+		{
+			size_t nEnd = Source.find('\n', nStart);
+			nEnd = nEnd == std::string::npos ? Source.size() : nEnd;
+			std::string Line = Source.substr(nStart, nEnd - nStart);
+			if (!Line.empty() && Line[Line.size() - 1] == '\r')
+				Line.erase(Line.size() - 1);
+			Lines.push_back(Line);
+			nStart = nEnd + 1;
+		}
+
+		std::map<std::string, std::vector<std::pair<int, int> > >::const_iterator Removed = m_Removed.find(Path);
+		for (size_t n = 0; n < Lines.size(); n++)
+		{
+			int nLine = (int)n + 1;
+			bool bRemoved = false;
+			for (size_t i = 0; Removed != m_Removed.end() && i < Removed->second.size(); i++)
+				bRemoved |= nLine >= Removed->second[i].first && nLine <= Removed->second[i].second;
+			if (bRemoved)
+				continue;
+
+			std::string Text = LuxTrim(Lines[n]);
+			std::string Name;
+			if (!Text.empty() && Text[0] == '#' && !LuxTrim(Text.substr(1)).compare(0, 7, "include"))
+			{
+				size_t nQuote = Text.find_first_of("\"<");
+				size_t nClose = nQuote == std::string::npos ? nQuote : Text.find_first_of("\">", nQuote + 1);
+				if (nClose != std::string::npos)
+					Name = Text.substr(nQuote + 1, nClose - nQuote - 1);
+			}
+
+			std::string IncludePath = Name.empty() ? Name : Resolve(Name, Path);
+			if (IncludePath.empty())
+			{
+				Out += Lines[n] + "\n";
+				continue;
+			}
+			if (!m_Needed.count(IncludePath))
+			{
+				Out += "// lux_deadcode : " + Name + " dropped, no Combo needs it\n";
+				m_nDropped++;
+				continue;
+			}
+			Out += "// lux_deadcode : " + Name + "\n";
+			m_nInlined++;
+			if (!Emit(IncludePath, Out, nDepth + 1))
+				return false;
+		}
+		return true;
+	}
+
+	// Same Order as CLuxPreprocessor, next to the File first
+	std::string Resolve(const std::string &Name, const std::string &From)
+	{
+		std::string Path = LuxDirectoryOf(From) + Name;
+		if (m_Cache.Load(Path))
+			return Path;
+		Path = m_FxcDir + Name;
+		return m_Cache.Load(Path) ? Path : std::string();
+	}
+
+	CLuxSourceCache &m_Cache;
+	std::string m_FxcDir;
+	const std::set<std::string> &m_Needed;
+	const std::map<std::string, std::vector<std::pair<int, int> > > &m_Removed;
+};
+
+// Writes the slim File and checks it. Returns false when a Combo's live Code changed
+static bool WriteSlim(CLuxSourceCache &Cache, const Options_t &Options, const std::string &Path, const std::string &Name, bool bVertex, const CLuxComboSet &Combos,
+	const ShaderStats_t &Stats)
+{
+	std::set<std::string> Needed;
+	for (std::map<std::string, int>::const_iterator It = Stats.Needed.begin(); It != Stats.Needed.end(); ++It)
+	{
+		if (It->second)
+			Needed.insert(It->first);
+	}
+
+	// Functions no Combo calls, as long as their Lines are their own. Not if something that stays refers to them
+	std::map<std::string, const DeclStats_t *> Removable;
+	for (std::map<std::string, DeclStats_t>::const_iterator It = Stats.Decls.begin(); It != Stats.Decls.end(); ++It)
+	{
+		const DeclStats_t &Decl = It->second;
+		const std::vector<LuxSourceLine_t> *pLines = Cache.Load(Decl.File);
+		if (Decl.Kind == DECL_FUNCTION && !Decl.nLive && Decl.bOwnLines && pLines && IsSelfContained(*pLines, Decl.nLine, Decl.nEndLine))
+			Removable[It->first] = &Decl;
+	}
+	for (bool bChanged = true; bChanged; )
+	{
+		std::set<std::string> Names, Kept;
+		for (std::map<std::string, const DeclStats_t *>::const_iterator It = Removable.begin(); It != Removable.end(); ++It)
+			Names.insert(It->second->Name);
+		for (std::map<std::string, DeclStats_t>::const_iterator It = Stats.Decls.begin(); It != Stats.Decls.end(); ++It)
+		{
+			if (Removable.count(It->first) || !Needed.count(It->second.File))
+				continue;
+			for (std::set<std::string>::const_iterator Ref = It->second.References.begin(); Ref != It->second.References.end(); ++Ref)
+			{
+				if (Names.count(*Ref) && *Ref != It->second.Name)
+					Kept.insert(*Ref);
+			}
+		}
+		bChanged = false;
+		for (std::map<std::string, const DeclStats_t *>::iterator It = Removable.begin(); It != Removable.end(); )
+		{
+			if (Kept.count(It->second->Name))
+			{
+				Removable.erase(It++);
+				bChanged = true;
+			}
+			else
+				++It;
+		}
+	}
+
+	std::map<std::string, std::vector<std::pair<int, int> > > Removed;
+	for (std::map<std::string, const DeclStats_t *>::const_iterator It = Removable.begin(); It != Removable.end(); ++It)
+	{
+		// Continuation Lines belong to the last one
+		const std::vector<LuxSourceLine_t> &Lines = *Cache.Load(It->second->File);
+		int nLastLine = It->second->nEndLine;
+		for (size_t n = 0; n + 1 < Lines.size(); n++)
+		{
+			if (Lines[n].nLine == nLastLine)
+				nLastLine = Lines[n + 1].nLine - 1;
+		}
+		Removed[It->second->File].push_back(std::make_pair(It->second->nLine, nLastLine));
+	}
+
+	CSlimWriter Writer(Cache, Options.FxcDir, Needed, Removed);
+	std::string Slim;
+	std::string OutPath = Options.OutDir + Name + "_slim.fxc";
+	if (!Writer.Write(Path, Slim) || !LuxWriteFile(OutPath.c_str(), Slim))
+	{
+		printf("  ERROR: can't write %s\n", OutPath.c_str());
+		return false;
+	}
+	printf("  Wrote %s, %d Headers inlined, %d dropped, %d Functions removed\n", OutPath.c_str(), Writer.m_nInlined, Writer.m_nDropped, (int)Removable.size());
+
+	// Every Combo has to see the same live Code through both
+	CLuxSourceCache SlimCache;
+	std::vector<int> Values;
+	int nSame = 0, nChecked = 0;
+	int64_t nLines = 0, nSlimLines = 0;
+	for (int64_t nIndex = 0; nIndex < Combos.NumIndices(); nIndex++)
+	{
+		Combos.Decode(nIndex, Values);
+		if (Combos.IsSkipped(Values))
+			continue;
+
+		CLuxPreprocessor Original(&Cache), Slimmed(&SlimCache);
+		PreprocessCombo(Original, Options, Path, bVertex, Combos, Values);
+		PreprocessCombo(Slimmed, Options, OutPath, bVertex, Combos, Values);
+		nLines += Original.Lines().size();
+		nSlimLines += Slimmed.Lines().size();
+		bool bSame = CComboAnalysis(Original).LiveCode() == CComboAnalysis(Slimmed).LiveCode() && Slimmed.Problems().size() <= Original.Problems().size();
+		if (!bSame && nChecked == nSame)
+			printf("  ERROR: Combo %lld ( %s ) sees different live Code in the slim File\n", (long long)nIndex, Combos.Describe(Values).c_str());
+		nSame += bSame;
+		nChecked++;
+	}
+	printf("  Slim Check : %d of %d Combos see the same live Code, Preprocessed Lines per Combo %lld -> %lld\n", nSame, nChecked,
+		(long long)(nChecked ? nLines / nChecked : 0), (long long)(nChecked ? nSlimLines / nChecked : 0));
+	return nSame == nChecked;
+}
+
+//==========================================================================//
+// Report
+//==========================================================================//
+// compile_all_shaders.txt, same Rules as buildshaders.bat : empty Lines and // Lines are skipped
+static bool ReadList(const char *pPath, std::vector<std::string> &Files)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = LuxTrim(Data.substr(nStart, nEnd - nStart));
+		nStart = nEnd + 1;
+		if (!Line.empty() && Line.compare(0, 2, "//"))
+			Files.push_back(Line);
+	}
+	return true;
+}
+
+static bool ReportShader(CLuxSourceCache &Cache, const Options_t &Options, const std::string &Path)
+{
+	printf("==== %s ====\n", Path.c_str());
+	std::string Source;
+	CLuxComboSet Combos;
+	if (!LuxReadFile(Path.c_str(), Source) || !Combos.Parse(Source))
+	{
+		printf("  ERROR: can't read the Combos\n\n");
+		return false;
+	}
+	std::string Name = LuxFileNameOf(Path);
+	if (Name.size() > 4 && Name.compare(Name.size() - 4, 4, ".fxc") == 0)
+		Name.resize(Name.size() - 4);
+	bool bVertex = Name.find("_vs") != std::string::npos;
+
+	ShaderStats_t Stats;
+	AnalyseShader(Cache, Options, Path, bVertex, Combos, Stats);
+	if (!Stats.nCombos)
+	{
+		printf("  Every Combo is SKIPped\n\n");
+		return true;
+	}
+	for (size_t n = 0; n < Stats.Problems.size(); n++)
+		printf("  WARNING: %s\n", Stats.Problems[n].c_str());
+
+	int nDeclared[4] = { 0 }, nDead[4] = { 0 }, nSometimes[4] = { 0 };
+	for (std::map<std::string, DeclStats_t>::const_iterator It = Stats.Decls.begin(); It != Stats.Decls.end(); ++It)
+	{
+		nDeclared[It->second.Kind]++;
+		nDead[It->second.Kind] += !It->second.nLive;
+		nSometimes[It->second.Kind] += It->second.nLive && It->second.nLive < Stats.nCombos;
+	}
+	int nHeaders = 0, nDeadHeaders = 0;
+	for (std::map<std::string, int>::const_iterator It = Stats.Included.begin(); It != Stats.Included.end(); ++It)
+	{
+		nHeaders++;
+		nDeadHeaders += !Stats.Needed[It->first];
+	}
+
+	printf("  %d Combos, %lld active Lines per Combo, %lld of them in live Code\n", Stats.nCombos, (long long)(Stats.nLines / Stats.nCombos),
+		(long long)(Stats.nLiveLines / Stats.nCombos));
+	const char *pLabels[] = { "Functions", "Constants", "Samplers", "Structs" };
+	for (int n = 0; n < 4; n++)
+		printf("  %-10s %5d declared, %5d dead in every Combo, %5d live only in some\n", pLabels[n], nDeclared[n], nDead[n], nSometimes[n]);
+	printf("  %-10s %5d included, %5d no Combo needs\n", "Headers", nHeaders, nDeadHeaders);
+
+	// register() Reservations first, those cost something even unread
+	for (int nPass = 0; nPass < 2; nPass++)
+	{
+		bool bTitle = false;
+		for (std::map<std::string, DeclStats_t>::const_iterator It = Stats.Decls.begin(); It != Stats.Decls.end(); ++It)
+		{
+			const DeclStats_t &Decl = It->second;
+			bool bReserves = !Decl.Register.empty();
+			if ((Decl.nLive && !Options.bVerbose) || bReserves != !nPass)
+				continue;
+			if (!bTitle)
+				printf("  %s :\n", nPass ? "Declarations" : "register() Declarations");
+			bTitle = true;
+
+			char szWhere[512], szLive[64];
+			snprintf(szWhere, sizeof(szWhere), "%s(%d)", LuxFileNameOf(Decl.File).c_str(), Decl.nLine);
+			snprintf(szLive, sizeof(szLive), Decl.nLive ? "live in %d of %d" : "dead in all %d", Decl.nLive ? Decl.nLive : Stats.nCombos, Stats.nCombos);
+			printf("    %-8s %-36s %-32s %-8s %s\n", s_pKindNames[Decl.Kind], szWhere, Decl.Name.c_str(), Decl.Register.c_str(), szLive);
+		}
+	}
+
+	if (nDeadHeaders)
+	{
+		printf("  Headers no Combo needs :\n");
+		for (std::map<std::string, int>::const_iterator It = Stats.Included.begin(); It != Stats.Included.end(); ++It)
+		{
+			if (!Stats.Needed[It->first])
+				printf("    %s\n", LuxFileNameOf(It->first).c_str());
+		}
+	}
+
+	bool bOk = Options.OutDir.empty() || WriteSlim(Cache, Options, Path, Name, bVertex, Combos, Stats);
+	printf("\n");
+	return bOk;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	Options_t Options;
+	Options.FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!Options.FxcDir.empty() && Options.FxcDir[Options.FxcDir.size() - 1] != '/' && Options.FxcDir[Options.FxcDir.size() - 1] != '\\')
+		Options.FxcDir += '/';
+	Options.OutDir = CommandLine.ParmValue("-out", "");
+	if (!Options.OutDir.empty() && Options.OutDir[Options.OutDir.size() - 1] != '/' && Options.OutDir[Options.OutDir.size() - 1] != '\\')
+		Options.OutDir += '/';
+	Options.bVerbose = CommandLine.HasParm("-verbose");
+	const char *pList = CommandLine.ParmValue("-list", (const char *)NULL);
+
+	std::vector<std::string> Files;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-list" || Arg == "-out") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+			Files.push_back(Arg);
+	}
+	if (pList && !ReadList(pList, Files))
+	{
+		fprintf(stderr, "Can't read %s\n", pList);
+		return 1;
+	}
+	if (Files.empty())
+	{
+		fprintf(stderr, "Usage: lux_deadcode [-fxc dir] [-list compile_all_shaders.txt] [-out dir] [-verbose] <shader.fxc> ..\n");
+		return 1;
+	}
+
+	CLuxSourceCache Cache;
+	int nFailed = 0;
+	for (size_t n = 0; n < Files.size(); n++)
+	{
+		std::string Path = Files[n].find('/') == std::string::npos && Files[n].find('\\') == std::string::npos ? Options.FxcDir + Files[n] : Files[n];
+		nFailed += !ReportShader(Cache, Options, Path);
+	}
+	return nFailed ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Replays Draw Lists through cpp_lux_drawsort.h, Sorting Cost against State Changes saved
+//
+//	Checks that every sorted View is a stable Permutation of its Draws, then times Sort() and weighs
+//	the State Changes it saved with rough per-Change Costs. Constant Uploads are sized from the Register Map,
+//	the Material Registers LUX_PS_FLOAT_COLOR_FACTORS .. LUX_PS_FLOAT_PHONG_MINLIGHT_BOOST.
+//
+//	Usage :	lux_drawsort_replay [-list draws.txt] [-views 64] [-draws 3000] [-materials 400] [-record out.txt]
+//			[-cost_shader 2.0] [-cost_texture 0.5] [-cost_register 0.01]		Microseconds per Change
+//			-list		Captured Draw List. Without it a synthetic World is generated
+//			-record		Writes the synthetic List, to have something to -list back in
+//
+//	List Format, one Line each :
+//			view
+//			draw <shader> <static combo> <texture set> <constant hash> [<registers>]	Decimal or 0x Hex
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include "../../shaders/fxc/lux_registermap_cpp.h"
+#include "../../shaders/fxc/cpp_lux_drawsort.h"
+
+#include <algorithm>
+
+static const int s_nMaterialRegisters = LUX_PS_FLOAT_PHONG_MINLIGHT_BOOST - LUX_PS_FLOAT_COLOR_FACTORS + 1;
+
+typedef std::vector<LuxDrawState_t> View_t;
+
+static bool LoadList(const char *pPath, std::vector<View_t> &Views)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+	{
+		fprintf(stderr, "Can't read %s\n", pPath);
+		return false;
+	}
+
+	size_t nStart = 0;
+	int nLine = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = Data.substr(nStart, nEnd - nStart);
+		nStart = nEnd + 1;
+		nLine++;
+
+		if (!strncmp(Line.c_str(), "view", 4))
+			Views.push_back(View_t());
+		else if (!strncmp(Line.c_str(), "draw ", 5))
+		{
+			unsigned long nValues[4];
+			int nRegisters = s_nMaterialRegisters;
+			char *p = (char *)Line.c_str() + 5;
+			for (int n = 0; n < 4; n++)
+				nValues[n] = strtoul(p, &p, 0);
+			long nOptional = strtol(p, &p, 0);
+			if (nOptional > 0)
+				nRegisters = (int)nOptional;
+
+			if (Views.empty())
+				Views.push_back(View_t());
+
+			LuxDrawState_t State = { (uint32_t)nValues[0], (uint32_t)nValues[1], (uint32_t)nValues[2], (uint32_t)nValues[3], nRegisters };
+			Views.back().push_back(State);
+		}
+		else if (!Line.empty() && Line[0] != '\r' && Line[0] != '/')
+		{
+			fprintf(stderr, "%s(%d) : Can't parse '%s'\n", pPath, nLine, Line.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+//==========================================================================//
+// Synthetic World. Materials pick from a few Shaders and Combos, Props are drawn in World Order ( random ),
+// a Fifth of the Draws have per-Instance Constants ( Tint, Skin ) that never match
+//==========================================================================//
+static void Synthesize(std::vector<View_t> &Views, int nViews, int nDraws, int nMaterials)
+{
+	std::vector<LuxDrawState_t> Materials;
+	for (int n = 0; n < nMaterials; n++)
+	{
+		uint32_t h = LuxHash(n + 1);
+		LuxDrawState_t Material;
+		Material.m_nShader = h % 6;
+		Material.m_nStaticCombo = LuxHash(h) % 24;
+		Material.m_nTextureSet = LuxHash(h + 1);
+		Material.m_nConstantHash = LuxHash(h + 2);
+		Material.m_nConstantRegisters = s_nMaterialRegisters;
+		Materials.push_back(Material);
+	}
+
+	for (int nView = 0; nView < nViews; nView++)
+	{
+		Views.push_back(View_t());
+		for (int n = 0; n < nDraws; n++)
+		{
+			uint32_t h = LuxHash(nView * 1000003 + n);
+
+			// Skewed, a few Materials cover most of the Map
+			float flPick = LuxHashFloat(h);
+			LuxDrawState_t State = Materials[(int)(flPick * flPick * flPick * nMaterials)];
+			if (LuxHashFloat(h + 1) < 0.2f)
+				State.m_nConstantHash = LuxHash(h + 2);
+			Views.back().push_back(State);
+		}
+	}
+}
+
+static bool SaveList(const char *pPath, const std::vector<View_t> &Views)
+{
+	std::string Out;
+	char szLine[128];
+	for (size_t nView = 0; nView < Views.size(); nView++)
+	{
+		Out += "view\n";
+		for (size_t n = 0; n < Views[nView].size(); n++)
+		{
+			const LuxDrawState_t &State = Views[nView][n];
+			snprintf(szLine, sizeof(szLine), "draw %u %u 0x%08x 0x%08x %d\n", State.m_nShader, State.m_nStaticCombo, State.m_nTextureSet, State.m_nConstantHash, State.m_nConstantRegisters);
+			Out += szLine;
+		}
+	}
+	return LuxWriteFile(pPath, Out);
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	const char *pList = CommandLine.ParmValue("-list", (const char *)NULL);
+	const char *pRecord = CommandLine.ParmValue("-record", (const char *)NULL);
+	float flCostShader = CommandLine.ParmValue("-cost_shader", 2.0f);
+	float flCostTexture = CommandLine.ParmValue("-cost_texture", 0.5f);
+	float flCostRegister = CommandLine.ParmValue("-cost_register", 0.01f);
+
+	std::vector<View_t> Views;
+	if (pList)
+	{
+		if (!LoadList(pList, Views))
+			return 1;
+	}
+	else
+	{
+		Synthesize(Views, std::max(1, CommandLine.ParmValue("-views", 64)), std::max(1, CommandLine.ParmValue("-draws", 3000)),
+			std::max(1, CommandLine.ParmValue("-materials", 400)));
+	}
+
+	if (pRecord && !SaveList(pRecord, Views))
+	{
+		fprintf(stderr, "Can't write %s\n", pRecord);
+		return 1;
+	}
+
+	// Correctness, once per View
+	CLuxDrawSorter Sorter;
+	int nFailed = 0;
+	for (size_t nView = 0; nView < Views.size(); nView++)
+	{
+		Sorter.BeginView();
+		for (size_t n = 0; n < Views[nView].size(); n++)
+			Sorter.Add(Views[nView][n], (uint32_t)n);
+
+		const uint32_t *pOrder = Sorter.Sort();
+		std::vector<bool> Seen(Views[nView].size(), false);
+		for (int n = 0; n < Sorter.NumDraws(); n++)
+		{
+			bool bOrdered = n == 0 || Sorter.SortedKey(n - 1) < Sorter.SortedKey(n) || (Sorter.SortedKey(n - 1) == Sorter.SortedKey(n) && pOrder[n - 1] < pOrder[n]);
+			if (pOrder[n] >= Seen.size() || Seen[pOrder[n]] || !bOrdered || LuxDrawSortKey(Views[nView][pOrder[n]]) != Sorter.SortedKey(n))
+			{
+				printf("View %d : sorted Order is broken at %d\n", (int)nView, n);
+				nFailed++;
+				break;
+			}
+			Seen[pOrder[n]] = true;
+		}
+	}
+
+	LuxDrawSortStats_t Stats = Sorter.GetStats();
+
+	// Timing, Sort() only
+	const int nRepeats = 10;
+	double flSort = 0.0;
+	for (int nRepeat = 0; nRepeat < nRepeats; nRepeat++)
+	{
+		for (size_t nView = 0; nView < Views.size(); nView++)
+		{
+			Sorter.BeginView();
+			for (size_t n = 0; n < Views[nView].size(); n++)
+				Sorter.Add(Views[nView][n], (uint32_t)n);
+
+			double flStart = LuxTimeSeconds();
+			Sorter.Sort();
+			flSort += LuxTimeSeconds() - flStart;
+		}
+	}
+	flSort /= nRepeats;
+
+	printf("%lld Views, %lld Draws, %d Material Registers per Constant Upload\n\n", (long long)Stats.m_nViews, (long long)Stats.m_nDraws, s_nMaterialRegisters);
+	printf("                   Submitted     Sorted\n");
+	printf("Shader Changes     %-12lld  %lld\n", (long long)Stats.m_nShaderChanges[0], (long long)Stats.m_nShaderChanges[1]);
+	printf("Combo Changes      %-12lld  %lld\n", (long long)Stats.m_nComboChanges[0], (long long)Stats.m_nComboChanges[1]);
+	printf("Texture Changes    %-12lld  %lld\n", (long long)Stats.m_nTextureChanges[0], (long long)Stats.m_nTextureChanges[1]);
+	printf("Registers uploaded %-12lld  %lld\n", (long long)Stats.m_nConstantUploads[0], (long long)Stats.m_nConstantUploads[1]);
+
+	double flSaved = (Stats.m_nComboChanges[0] - Stats.m_nComboChanges[1]) * flCostShader +
+		(Stats.m_nTextureChanges[0] - Stats.m_nTextureChanges[1]) * flCostTexture +
+		(Stats.m_nConstantUploads[0] - Stats.m_nConstantUploads[1]) * flCostRegister;
+	double flSortUs = flSort * 1e6;
+
+	printf("\nSort               %.1f us per View, %.1f ns per Draw\n", flSortUs / Stats.m_nViews, flSort * 1e9 / Stats.m_nDraws);
+	printf("Saved              %.1f us per View ( %.1f us / Combo, %.1f us / Texture Set, %.3f us / Register )\n",
+		flSaved / Stats.m_nViews, flCostShader, flCostTexture, flCostRegister);
+	printf("Net                %.1f us per View, %s\n", (flSaved - flSortUs) / Stats.m_nViews, flSaved > flSortUs ? "worth it" : "not worth it");
+
+	return nFailed ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Checks and times CLuxFrameAllocator from cpp_lux_framearena.h
+//
+//	Check :	Random Sizes and Alignments over many Frames. Every Allocation is filled with its own Pattern
+//			and verified at Frame End, so Overlaps, bad Alignment and Reset() Problems show up.
+//	Bench :	The transient Data of a Draw ( Flashlight Matrix, packed Light Data, Ambient Cube )
+//			allocated through malloc, std::vector, the atomic Arena and the Frame Allocator.
+//			Reports ns per Allocation, the Cost of Reset() and the High-Water Mark.
+//
+//	Usage :	lux_framearena_bench [-frames 200] [-draws 2000] [-arena 1024]
+//			-arena		Arena Size in KB, small Values exercise the Overflow Path
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include "../../shaders/fxc/cpp_lux_framearena.h"
+
+#include <algorithm>
+
+struct Allocation_t
+{
+	uint8_t *p;
+	size_t nBytes;
+	uint32_t nPattern;
+};
+
+static int Check(CLuxFrameArena &Arena, int nFrames, int nDraws)
+{
+	CLuxFrameAllocator Frame(Arena);
+	std::vector<Allocation_t> Allocations;
+	int nFailed = 0;
+
+	for (int nFrame = 0; nFrame < nFrames && !nFailed; nFrame++)
+	{
+		Frame.Reset();
+		Arena.Reset();
+		Allocations.clear();
+
+		int nCount = 1 + (int)(LuxHash(nFrame) % (uint32_t)(nDraws * 3));
+		for (int n = 0; n < nCount; n++)
+		{
+			uint32_t h = LuxHash(nFrame * 65537 + n);
+
+			// Mostly small, now and then bigger than a Chunk
+			size_t nBytes = (h & 31) == 0 ? 1 + (h >> 8) % (LUX_FRAMEALLOCATOR_CHUNK * 2) : 1 + (h >> 8) % 256;
+			size_t nAlign = (size_t)1 << ((h >> 5) % 7);
+
+			Allocation_t Allocation;
+			Allocation.p = (uint8_t *)Frame.Alloc(nBytes, nAlign);
+			Allocation.nBytes = nBytes;
+			Allocation.nPattern = h;
+			if (!Allocation.p || ((uintptr_t)Allocation.p & (nAlign - 1)))
+			{
+				printf("Frame %d : Allocation %d of %d Bytes is misaligned for %d\n", nFrame, n, (int)nBytes, (int)nAlign);
+				nFailed++;
+				break;
+			}
+			memset(Allocation.p, (int)(h & 255), nBytes);
+			Allocations.push_back(Allocation);
+		}
+
+		for (size_t n = 0; n < Allocations.size(); n++)
+		{
+			const Allocation_t &Allocation = Allocations[n];
+			for (size_t i = 0; i < Allocation.nBytes; i++)
+			{
+				if (Allocation.p[i] != (uint8_t)(Allocation.nPattern & 255))
+				{
+					printf("Frame %d : Allocation %d was overwritten at Byte %d\n", nFrame, (int)n, (int)i);
+					nFailed++;
+					break;
+				}
+			}
+		}
+	}
+
+	printf("Check : %d Frames, %s, Arena High-Water %.1f KB of %.1f KB, Allocator High-Water %.1f KB\n",
+		nFrames, nFailed ? "FAILED" : "passed", Arena.HighWater() / 1024.0, Arena.Capacity() / 1024.0, Frame.HighWater() / 1024.0);
+	return nFailed;
+}
+
+//==========================================================================//
+// Per Draw : Flashlight Matrix ( 4 Registers ), Light Data ( 6 ), Ambient Cube ( 6 ), a Bone Palette every 8th Draw ( 53 )
+//==========================================================================//
+static const int s_nDrawRegisters[4] = { 4, 6, 6, 53 };
+
+static inline int AllocationsPerDraw(int nDraw) { return (nDraw & 7) == 0 ? 4 : 3; }
+
+// Touches the Data like filling Constants would, so nothing gets optimised away
+static inline float Fill(float *p, int nRegisters, int nDraw)
+{
+	for (int n = 0; n < nRegisters * 4; n++)
+		p[n] = (float)(nDraw + n);
+	return p[nRegisters * 4 - 1];
+}
+
+struct Timing_t
+{
+	const char *pName;
+	double flAlloc;
+	double flReset;
+	double flSum;
+};
+
+template <class Func, class ResetFunc>
+static Timing_t Time(const char *pName, int nFrames, int nDraws, Func Alloc, ResetFunc Reset)
+{
+	Timing_t Timing = { pName, 0.0, 0.0, 0.0 };
+	for (int nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		double flStart = LuxTimeSeconds();
+		for (int nDraw = 0; nDraw < nDraws; nDraw++)
+		{
+			for (int n = 0; n < AllocationsPerDraw(nDraw); n++)
+				Timing.flSum += Alloc(s_nDrawRegisters[n], nDraw);
+		}
+		double flMid = LuxTimeSeconds();
+		Reset();
+		Timing.flAlloc += flMid - flStart;
+		Timing.flReset += LuxTimeSeconds() - flMid;
+	}
+	return Timing;
+}
+
+static void Bench(CLuxFrameArena &Arena, int nFrames, int nDraws)
+{
+	CLuxFrameAllocator Frame(Arena);
+	Arena.Reset();
+
+	std::vector<Timing_t> Timings;
+
+	Timings.push_back(Time("malloc/free", nFrames, nDraws,
+		[](int nRegisters, int nDraw) { float *p = (float *)malloc(nRegisters * 16); float f = Fill(p, nRegisters, nDraw); free(p); return f; },
+		[]() {}));
+
+	Timings.push_back(Time("std::vector", nFrames, nDraws,
+		[](int nRegisters, int nDraw) { std::vector<float> v(nRegisters * 4); return Fill(&v[0], nRegisters, nDraw); },
+		[]() {}));
+
+	Timings.push_back(Time("Arena, atomic", nFrames, nDraws,
+		[&Arena](int nRegisters, int nDraw) { return Fill((float *)Arena.Alloc(nRegisters * 16), nRegisters, nDraw); },
+		[&Arena]() { Arena.Reset(); }));
+
+	Timings.push_back(Time("Frame Allocator", nFrames, nDraws,
+		[&Frame](int nRegisters, int nDraw) { return Fill(Frame.AllocFloat4(nRegisters), nRegisters, nDraw); },
+		[&Frame, &Arena]() { Frame.Reset(); Arena.Reset(); }));
+
+	// One more Frame to read the Allocator's Usage before it resets
+	for (int nDraw = 0; nDraw < nDraws; nDraw++)
+	{
+		for (int n = 0; n < AllocationsPerDraw(nDraw); n++)
+			Fill(Frame.AllocFloat4(s_nDrawRegisters[n]), s_nDrawRegisters[n], nDraw);
+	}
+	int nAllocs = Frame.Allocs();
+
+	printf("\n%d Draws, %d Allocations per Frame, %.1f KB\n", nDraws, nAllocs, Frame.Used() / 1024.0);
+	printf("%-16s  ns/Alloc  Reset us\n", "");
+	for (size_t n = 0; n < Timings.size(); n++)
+	{
+		printf("%-16s  %-8.1f  %.2f%s\n", Timings[n].pName,
+			Timings[n].flAlloc * 1e9 / ((double)nFrames * nAllocs), Timings[n].flReset * 1e6 / nFrames,
+			Timings[n].flSum == Timings[0].flSum ? "" : "  ( Checksum differs! )");
+	}
+
+	printf("Arena High-Water %.1f KB of %.1f KB, Overflow %.1f KB\n", Arena.HighWater() / 1024.0, Arena.Capacity() / 1024.0, Arena.OverflowBytes() / 1024.0);
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nFrames = std::max(1, CommandLine.ParmValue("-frames", 200));
+	int nDraws = std::max(1, CommandLine.ParmValue("-draws", 2000));
+	int nArenaKB = std::max(1, CommandLine.ParmValue("-arena", 1024));
+
+	CLuxFrameArena Arena((size_t)nArenaKB * 1024);
+	int nFailed = Check(Arena, nFrames, nDraws);
+
+	CLuxFrameArena BenchArena((size_t)nArenaKB * 1024);
+	Bench(BenchArena, nFrames, nDraws);
+
+	return nFailed ? 1 : 0;
+}
@@ -0,0 +1,364 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Bakes the INFECTED_FARLOD Textures, one per Gradient Row,
+//							and checks them against the full Infected Path from cpp_lux_infectedlod.h
+//
+//	The Gate is what the close Shader would show at that Distance : the full Path on mipped Inputs,
+//	every Texture filtered on its own, Albedo + Burn, and the Wound clip() on the filtered CutOut.
+//	The LOD Texture has no Wounds and a single Burn Tint, that's the Error the Gate measures.
+//	"Box" is the Average of the full Path over the Texels a LOD Texel covers, which the Bake stores.
+//	Against that the LOD is only off by 8 Bit, so it's printed but never gated.
+//
+//	Usage :	lux_infected_lodbake -base base.tga -gradient gradient.tga [-burn burn.tga] [-wound wound.tga] [-out prefix]
+//							[-variations 8] [-downscale 4] [-burnstrength 1] [-cutoutbias 0.5] [-maxerror 0.05]
+//			Without -base it runs on synthetic Textures, to check the Math
+//			-wound		$WoundCutOutTexture already projected into $BaseTexture UV, Alpha is the CutOut
+//			-out		Writes <prefix>_lod<N>.tga for every Variation. Run vtex on those ( sRGB, no Compression below DXT5 )
+//			-maxerror	Fails ( Exit Code 1 ) when a Variation's RMS Error against the mipped Shader goes above this, sRGB
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#define LUX_INFECTEDLOD_BAKE_ONLY
+#include "../../shaders/fxc/cpp_lux_infectedlod.h"
+
+//==========================================================================//
+// Linear Float Images
+//==========================================================================//
+struct Texture_t
+{
+	Texture_t() : nWidth(0), nHeight(0) {}
+
+	int nWidth;
+	int nHeight;
+	std::vector<float> RGBA; // RGB Linear, A as is
+
+	float *Texel(int x, int y) { return &RGBA[((size_t)y * nWidth + x) * 4]; }
+	const float *Texel(int x, int y) const { return &RGBA[((size_t)y * nWidth + x) * 4]; }
+};
+
+static void FromImage(const LuxImage_t &Image, bool bSRGB, Texture_t &Out)
+{
+	Out.nWidth = Image.nWidth;
+	Out.nHeight = Image.nHeight;
+	Out.RGBA.resize(Image.RGBA.size());
+	for (size_t n = 0; n < Image.RGBA.size(); n++)
+	{
+		float f = Image.RGBA[n] / 255.0f;
+		Out.RGBA[n] = (bSRGB && (n & 3) != 3) ? LuxInfectedLOD_SrgbToLinear(f) : f;
+	}
+}
+
+// Something with Structure in every Channel, a flat Colour would hide all Errors
+static void MakeSynthetic(Texture_t &Base, Texture_t &Gradient, Texture_t &Burn, Texture_t &Wound, int nVariations)
+{
+	const int nSize = 512;
+	Base.nWidth = Base.nHeight = Burn.nWidth = Burn.nHeight = Wound.nWidth = Wound.nHeight = nSize;
+	Base.RGBA.resize(nSize * nSize * 4);
+	Burn.RGBA.resize(nSize * nSize * 4);
+	Wound.RGBA.resize(nSize * nSize * 4);
+
+	for (int y = 0; y < nSize; y++)
+	{
+		for (int x = 0; x < nSize; x++)
+		{
+			float *pBase = Base.Texel(x, y);
+			float *pBurn = Burn.Texel(x, y);
+			uint32_t nSeed = (uint32_t)(y * nSize + x);
+
+			// Skin and Cloth Patches with some Grain, the Alpha is the Gradient Column
+			float flPatch = 0.5f + 0.5f * sinf(x * 0.031f) * cosf(y * 0.023f);
+			for (int c = 0; c < 3; c++)
+				pBase[c] = LuxInfectedLOD_SrgbToLinear(0.35f + 0.4f * flPatch + 0.2f * LuxHashFloat(nSeed * 3 + c));
+			pBase[3] = saturate(flPatch + 0.15f * (LuxHashFloat(nSeed * 7) - 0.5f));
+
+			// Orange Embers
+			float flEmber = powf(LuxHashFloat(nSeed * 11 + 1), 8.0f);
+			pBurn[0] = flEmber;
+			pBurn[1] = flEmber * 0.45f;
+			pBurn[2] = flEmber * 0.1f;
+			pBurn[3] = 1.0f;
+
+			// A few small round Wounds with soft Rims, the LOD drops them
+			float *pWound = Wound.Texel(x, y);
+			float flCutOut = 1.0f;
+			for (int n = 0; n < 4; n++)
+			{
+				float dx = x - (96.0f + n * 107.0f), dy = y - (128.0f + (n & 1) * 256.0f);
+				flCutOut = fminf(flCutOut, saturate((sqrtf(dx * dx + dy * dy) - 4.0f) / 4.0f));
+			}
+			pWound[0] = pWound[1] = pWound[2] = pWound[3] = flCutOut;
+		}
+	}
+
+	Gradient.nWidth = 64;
+	Gradient.nHeight = nVariations;
+	Gradient.RGBA.resize(Gradient.nWidth * Gradient.nHeight * 4);
+	for (int y = 0; y < Gradient.nHeight; y++)
+	{
+		for (int x = 0; x < Gradient.nWidth; x++)
+		{
+			float *p = Gradient.Texel(x, y);
+			float t = (float)x / (Gradient.nWidth - 1);
+			for (int c = 0; c < 3; c++)
+				p[c] = 0.2f + 0.8f * saturate(0.5f + 0.5f * sinf(t * 6.0f + y * 1.7f + c * 2.1f));
+			p[3] = 1.0f;
+		}
+	}
+}
+
+//==========================================================================//
+// The full Path for one Texel, at full Resolution
+//==========================================================================//
+static void FullPath(const float *pBase, const float *pBurn, const std::vector<float> &GradientRGB, const Texture_t &Gradient,
+					 float flOffset, float flBurnStrength, float f3Albedo[3], float f3Burn[3])
+{
+	float f3Gradient[3];
+	LuxInfectedLOD_SampleClamped(GradientRGB.data(), Gradient.nWidth, Gradient.nHeight, pBase[3], flOffset, f3Gradient);
+	LuxInfected_GradientAlbedo(pBase, f3Gradient, f3Albedo);
+	LuxInfected_BurnFactor(pBurn, flBurnStrength, f3Burn);
+}
+
+// What ends up on Screen, unlit : Albedo plus the additive Burn, nothing where the Wound clips
+static void Shade(const float f3Albedo[3], const float f3Burn[3], float flCoverage, float f3Out[3])
+{
+	for (int c = 0; c < 3; c++)
+		f3Out[c] = (f3Albedo[c] + f3Burn[c]) * flCoverage;
+}
+
+struct Error_t
+{
+	Error_t() : flSumSq(0.0), flMax(0.0), nCount(0) {}
+
+	void Add(const float a[3], const float b[3])
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			// Compared in sRGB, that's what the Eye sees
+			double d = fabs(LuxInfectedLOD_LinearToSrgb(a[c]) - LuxInfectedLOD_LinearToSrgb(b[c]));
+			flSumSq += d * d;
+			flMax = d > flMax ? d : flMax;
+			nCount++;
+		}
+	}
+
+	double Rms() const { return nCount ? sqrt(flSumSq / nCount) : 0.0; }
+
+	double flSumSq;
+	double flMax;
+	int64_t nCount;
+};
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	const char *pBasePath = CommandLine.ParmValue("-base", (const char *)0);
+	const char *pGradientPath = CommandLine.ParmValue("-gradient", (const char *)0);
+	const char *pBurnPath = CommandLine.ParmValue("-burn", (const char *)0);
+	const char *pWoundPath = CommandLine.ParmValue("-wound", (const char *)0);
+	const char *pOut = CommandLine.ParmValue("-out", (const char *)0);
+	int nVariations = CommandLine.ParmValue("-variations", LUX_INFECTEDLOD_VARIATIONS);
+	int nDownscale = CommandLine.ParmValue("-downscale", LUX_INFECTEDLOD_DOWNSCALE);
+	float flBurnStrength = CommandLine.ParmValue("-burnstrength", 1.0f);
+	float flCutOutBias = CommandLine.ParmValue("-cutoutbias", 0.5f);
+	float flMaxError = CommandLine.ParmValue("-maxerror", 0.05f);
+
+	if (nVariations < 1 || nDownscale < 1 || (pBasePath && !pGradientPath))
+	{
+		fprintf(stderr, "Usage: lux_infected_lodbake -base base.tga -gradient gradient.tga [-burn burn.tga] [-wound wound.tga] [-out prefix] [-variations N] [-downscale N] [-burnstrength X] [-cutoutbias X] [-maxerror X]\n");
+		return 1;
+	}
+
+	Texture_t Base, Gradient, Burn, Wound;
+	if (pBasePath)
+	{
+		LuxImage_t Image;
+		if (!LuxLoadTGA(pBasePath, Image))
+			return fprintf(stderr, "Failed to load %s\n", pBasePath), 1;
+		FromImage(Image, true, Base);
+
+		if (!LuxLoadTGA(pGradientPath, Image))
+			return fprintf(stderr, "Failed to load %s\n", pGradientPath), 1;
+		FromImage(Image, true, Gradient);
+
+		if (pBurnPath)
+		{
+			if (!LuxLoadTGA(pBurnPath, Image))
+				return fprintf(stderr, "Failed to load %s\n", pBurnPath), 1;
+			FromImage(Image, true, Burn);
+		}
+		else
+		{
+			// No Burn, all Zero
+			Burn.nWidth = Base.nWidth;
+			Burn.nHeight = Base.nHeight;
+			Burn.RGBA.assign(Base.RGBA.size(), 0.0f);
+		}
+
+		if (pWoundPath)
+		{
+			if (!LuxLoadTGA(pWoundPath, Image))
+				return fprintf(stderr, "Failed to load %s\n", pWoundPath), 1;
+			FromImage(Image, false, Wound);
+		}
+		else
+		{
+			// No Wounds, nothing is cut
+			Wound.nWidth = Base.nWidth;
+			Wound.nHeight = Base.nHeight;
+			Wound.RGBA.assign(Base.RGBA.size(), 1.0f);
+		}
+
+		if (Burn.nWidth != Base.nWidth || Burn.nHeight != Base.nHeight)
+			return fprintf(stderr, "$BurnDetailTexture must be the same Size as $BaseTexture\n"), 1;
+		if (Wound.nWidth != Base.nWidth || Wound.nHeight != Base.nHeight)
+			return fprintf(stderr, "-wound must be the same Size as $BaseTexture\n"), 1;
+	}
+	else
+	{
+		MakeSynthetic(Base, Gradient, Burn, Wound, nVariations);
+		printf("No -base given, using synthetic Textures\n");
+	}
+
+	const int nLODWidth = Base.nWidth / nDownscale > 0 ? Base.nWidth / nDownscale : 1;
+	const int nLODHeight = Base.nHeight / nDownscale > 0 ? Base.nHeight / nDownscale : 1;
+	const int nBlockW = Base.nWidth / nLODWidth, nBlockH = Base.nHeight / nLODHeight;
+	const float flRcpBlock = 1.0f / (nBlockW * nBlockH);
+
+	// The Gradient Sampler wants packed RGB
+	std::vector<float> GradientRGB(Gradient.nWidth * Gradient.nHeight * 3);
+	for (int n = 0; n < Gradient.nWidth * Gradient.nHeight; n++)
+	{
+		for (int c = 0; c < 3; c++)
+			GradientRGB[n * 3 + c] = Gradient.RGBA[n * 4 + c];
+	}
+
+	// Average Burn Colour, weighted by how bright the Burn is. Luminance 1.0f, so only Red and Blue go to the Shader
+	double flBurnSum[3] = { 0.0, 0.0, 0.0 }, flBurnLuminance = 0.0;
+	for (size_t n = 0; n < Burn.RGBA.size(); n += 4)
+	{
+		float f4Texel[4], f3Zero[3] = { 0.0f, 0.0f, 0.0f };
+		LuxInfectedLOD_BakeTexel(f3Zero, &Burn.RGBA[n], f4Texel);
+		for (int c = 0; c < 3; c++)
+			flBurnSum[c] += Burn.RGBA[n + c];
+		flBurnLuminance += f4Texel[3];
+	}
+
+	float f2BurnTint[2] = { 1.0f, 1.0f };
+	if (flBurnLuminance > 0.0)
+	{
+		f2BurnTint[0] = (float)(flBurnSum[0] / flBurnLuminance);
+		f2BurnTint[1] = (float)(flBurnSum[2] / flBurnLuminance);
+	}
+
+	printf("$BaseTexture %dx%d -> LOD %dx%d, %d Variations, Burn Strength %.2f\n",
+		Base.nWidth, Base.nHeight, nLODWidth, nLODHeight, nVariations, flBurnStrength);
+	printf("Close: 4 Fetches ( Base, Gradient, BurnDetail, WoundCutOut ), Far: 1 Fetch. LOD Textures: %.1f KB each, uncompressed\n\n",
+		nLODWidth * nLODHeight * 4 / 1024.0);
+	printf("%-9s %-8s %10s %10s %10s %10s %10s\n", "Variation", "Offset", "Box RMS", "Burn RMS", "Cut", "Gate RMS", "Gate Max");
+
+	int nFailed = 0;
+	double flStart = LuxTimeSeconds();
+
+	for (int nVariation = 0; nVariation < nVariations; nVariation++)
+	{
+		const float flOffset = LuxInfectedLOD_VariationOffset(nVariation, nVariations);
+		Error_t BoxError, BurnError, GateError;
+		int nCut = 0;
+
+		LuxImage_t LODImage;
+		LODImage.nWidth = nLODWidth;
+		LODImage.nHeight = nLODHeight;
+		LODImage.bHasAlpha = true;
+		LODImage.RGBA.resize((size_t)nLODWidth * nLODHeight * 4);
+
+		for (int y = 0; y < nLODHeight; y++)
+		{
+			for (int x = 0; x < nLODWidth; x++)
+			{
+				// Box Reference and the LOD Bake are the same Average, the LOD just goes through 8 Bit after
+				float f3RefAlbedo[3] = { 0, 0, 0 }, f3RefBurn[3] = { 0, 0, 0 };
+				float f4MipBase[4] = { 0, 0, 0, 0 }, f3MipBurn[3] = { 0, 0, 0 }, flMipCutOut = 0.0f;
+				float f4Bake[4] = { 0, 0, 0, 0 };
+
+				for (int by = 0; by < nBlockH; by++)
+				{
+					for (int bx = 0; bx < nBlockW; bx++)
+					{
+						const float *pBase = Base.Texel(x * nBlockW + bx, y * nBlockH + by);
+						const float *pBurn = Burn.Texel(x * nBlockW + bx, y * nBlockH + by);
+						flMipCutOut += Wound.Texel(x * nBlockW + bx, y * nBlockH + by)[3] * flRcpBlock;
+
+						float f3Albedo[3], f3Burn[3], f4Texel[4];
+						FullPath(pBase, pBurn, GradientRGB, Gradient, flOffset, flBurnStrength, f3Albedo, f3Burn);
+						LuxInfectedLOD_BakeTexel(f3Albedo, pBurn, f4Texel);
+
+						for (int c = 0; c < 3; c++)
+						{
+							f3RefAlbedo[c] += f3Albedo[c] * flRcpBlock;
+							f3RefBurn[c] += f3Burn[c] * flRcpBlock;
+							f3MipBurn[c] += pBurn[c] * flRcpBlock;
+						}
+						for (int c = 0; c < 4; c++)
+						{
+							f4MipBase[c] += pBase[c] * flRcpBlock;
+							f4Bake[c] += f4Texel[c] * flRcpBlock;
+						}
+					}
+				}
+
+				// Full Path on filtered Inputs, what the close Shader shows at this Distance
+				float f3MipAlbedo[3], f3MipBurnOut[3], f3MipShaded[3];
+				FullPath(f4MipBase, f3MipBurn, GradientRGB, Gradient, flOffset, flBurnStrength, f3MipAlbedo, f3MipBurnOut);
+				float flCoverage = LuxInfected_WoundCoverage(flMipCutOut, flCutOutBias);
+				Shade(f3MipAlbedo, f3MipBurnOut, flCoverage, f3MipShaded);
+				nCut += flCoverage < 1.0f ? 1 : 0;
+
+				// Store, then read back like the GPU would
+				unsigned char *pDst = &LODImage.RGBA[((size_t)y * nLODWidth + x) * 4];
+				float f4Stored[4];
+				for (int c = 0; c < 4; c++)
+				{
+					float f = (c < 3) ? LuxInfectedLOD_LinearToSrgb(f4Bake[c]) : saturate(f4Bake[c]);
+					pDst[c] = (unsigned char)(f * 255.0f + 0.5f);
+					f4Stored[c] = (c < 3) ? LuxInfectedLOD_SrgbToLinear(pDst[c] / 255.0f) : pDst[c] / 255.0f;
+				}
+
+				float f3LODAlbedo[3], f3LODBurn[3], f3LODShaded[3];
+				LuxInfectedLOD_Evaluate(f4Stored, f2BurnTint, flBurnStrength, f3LODAlbedo, f3LODBurn);
+				Shade(f3LODAlbedo, f3LODBurn, 1.0f, f3LODShaded);
+
+				BoxError.Add(f3LODAlbedo, f3RefAlbedo);
+				BurnError.Add(f3LODBurn, f3RefBurn);
+				GateError.Add(f3LODShaded, f3MipShaded);
+			}
+		}
+
+		bool bFailed = GateError.Rms() > flMaxError;
+		nFailed += bFailed ? 1 : 0;
+		printf("%-9d %-8.4f %10.5f %10.5f %9.2f%% %10.5f %10.5f%s\n", nVariation, flOffset,
+			BoxError.Rms(), BurnError.Rms(), 100.0 * nCut / (nLODWidth * nLODHeight), GateError.Rms(), GateError.flMax, bFailed ? "  FAILED" : "");
+
+		if (pOut)
+		{
+			char szPath[1024];
+			snprintf(szPath, sizeof(szPath), "%s_lod%d.tga", pOut, nVariation);
+			if (!LuxSaveTGA(szPath, LODImage))
+				return fprintf(stderr, "Failed to write %s\n", szPath), 1;
+		}
+	}
+
+	printf("\nBaked in %.1f ms. Errors are sRGB. Box and Burn against the averaged full Path, Gate against the mipped Shader with Burn and Wounds\n",
+		(LuxTimeSeconds() - flStart) * 1000.0);
+	printf("g_f2BurnLODTint ( INFECTED_CUTOUTCONTROLS3.zw ) : %.4f %.4f\n", f2BurnTint[0], f2BurnTint[1]);
+	if (pOut)
+		printf("Wrote %s_lod0.tga .. %s_lod%d.tga\n", pOut, pOut, nVariations - 1);
+
+	if (nFailed)
+		printf("%d Variations above -maxerror %.4f\n", nFailed, flMaxError);
+	return nFailed ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Checks cpp_lux_materialblock.h against the per-Constant Path
+//
+//	Random Materials, every Parameter defined or not, and sometimes missing from the Shader altogether ( Index -1 ).
+//	Each one is uploaded twice : the Block, and the Constants one at a Time like OnDrawElements() sets them
+//	without it ( GetVecValue() with Defaults, SetPixelShaderConstantGammaToLinear() for $EnvMapTint ).
+//	Registers have to match. LUX_PS_FLOAT_ENVMAP_FRESNEL is compared through EnvMapFresnel() from lux_common_envmap.h
+//	instead, over NdotV 0 .. 1 : without $EnvMapFresnel the per-Constant Path doesn't apply a Fresnel at all,
+//	so the Block's Values have to come out as 1 everywhere.
+//
+//	Usage :	lux_materialblock_check [-materials 20000] [-seed 1]
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include "../../shaders/fxc/lux_registermap_cpp.h"
+
+#define LUX_MATERIALBLOCK_CORE_ONLY
+#include "../../shaders/fxc/cpp_lux_materialblock.h"
+
+#include <map>
+
+//==========================================================================//
+// IMaterialVar Stand-in, only what the Builders call
+//==========================================================================//
+class CFakeVar
+{
+public:
+	CFakeVar() : m_bDefined(false), m_bTexture(false), m_nValue(0)
+	{
+		m_flValue[0] = m_flValue[1] = m_flValue[2] = 0.0f;
+	}
+
+	bool IsDefined() const { return m_bDefined; }
+	bool IsTexture() const { return m_bTexture; }
+	float GetFloatValue() const { return m_flValue[0]; }
+	int GetIntValue() const { return m_nValue; }
+	void GetVecValue(float *pOut, int nComponents) const
+	{
+		for (int n = 0; n < nComponents; n++)
+			pOut[n] = m_flValue[n];
+	}
+
+	bool m_bDefined;
+	bool m_bTexture;
+	float m_flValue[3];
+	int m_nValue;
+};
+
+// Same Members as Vars_Detail_t and Vars_EnvMap_t in cpp_lux_shared.h
+struct DetailVars_t
+{
+	int m_nDetail;
+	int m_nDetailBlendmode;
+	int m_nDetailTint;
+	int m_nDetailBlendFactor;
+};
+
+struct EnvMapVars_t
+{
+	int m_nEnvMap;
+	int m_nEnvMapTint;
+	int m_nEnvMapContrast;
+	int m_nEnvMapSaturation;
+	int m_nEnvMapLightScale;
+	int m_nEnvMapFresnel;
+	int m_nEnvMapFresnelMinMaxExp;
+};
+
+enum
+{
+	PARAM_DETAIL = 0,
+	PARAM_DETAILBLENDMODE,
+	PARAM_DETAILTINT,
+	PARAM_DETAILBLENDFACTOR,
+	PARAM_ENVMAP,
+	PARAM_ENVMAPTINT,
+	PARAM_ENVMAPCONTRAST,
+	PARAM_ENVMAPSATURATION,
+	PARAM_ENVMAPLIGHTSCALE,
+	PARAM_ENVMAPFRESNEL,
+	PARAM_ENVMAPFRESNELMINMAXEXP,
+
+	NUM_PARAMS
+};
+
+//==========================================================================//
+// Registers as the GPU ends up with them
+//==========================================================================//
+class CRegisters
+{
+public:
+	void SetPixelShaderConstant(int nFirstRegister, const float *pData, int nRegisters = 1)
+	{
+		for (int n = 0; n < nRegisters; n++)
+			memcpy(m_Registers[nFirstRegister + n].fl4, pData + n * 4, sizeof(float) * 4);
+	}
+
+	// IShaderDynamicAPI's, Gamma -> Linear on RGB
+	void SetPixelShaderConstantGammaToLinear(int nRegister, const float *pData)
+	{
+		float fl4[4];
+		for (int n = 0; n < 3; n++)
+			fl4[n] = pData[n] <= 0.0f ? 0.0f : (float)pow((double)pData[n], 2.2);
+		fl4[3] = pData[3];
+		SetPixelShaderConstant(nRegister, fl4);
+	}
+
+	struct Register_t
+	{
+		float fl4[4];
+	};
+	std::map<int, Register_t> m_Registers;
+};
+
+//==========================================================================//
+// The per-Constant Path, what the Draw Code does without the Block
+//==========================================================================//
+static void ReferenceDetail(CRegisters &Out, CFakeVar **params, const DetailVars_t &Vars)
+{
+	if (Vars.m_nDetail == -1 || !params[Vars.m_nDetail]->IsTexture())
+		return;
+
+	float f4TintFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	if (Vars.m_nDetailTint != -1 && params[Vars.m_nDetailTint]->IsDefined())
+		params[Vars.m_nDetailTint]->GetVecValue(f4TintFactor, 3);
+	if (Vars.m_nDetailBlendFactor != -1 && params[Vars.m_nDetailBlendFactor]->IsDefined())
+		f4TintFactor[3] = params[Vars.m_nDetailBlendFactor]->GetFloatValue();
+	Out.SetPixelShaderConstant(LUX_PS_FLOAT_DETAIL_FACTORS, f4TintFactor);
+
+	float f4BlendMode[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	if (Vars.m_nDetailBlendmode != -1 && params[Vars.m_nDetailBlendmode]->IsDefined())
+		f4BlendMode[0] = (float)params[Vars.m_nDetailBlendmode]->GetIntValue();
+	Out.SetPixelShaderConstant(LUX_PS_FLOAT_DETAIL_BLENDMODE, f4BlendMode);
+}
+
+// Fresnel isn't uploaded here, ReferenceFresnel() is what the Shader would compute
+static void ReferenceEnvMap(CRegisters &Out, CFakeVar **params, const EnvMapVars_t &Vars)
+{
+	if (Vars.m_nEnvMap == -1 || !params[Vars.m_nEnvMap]->IsTexture())
+		return;
+
+	float f4Tint[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+	if (Vars.m_nEnvMapTint != -1 && params[Vars.m_nEnvMapTint]->IsDefined())
+		params[Vars.m_nEnvMapTint]->GetVecValue(f4Tint, 3);
+	if (Vars.m_nEnvMapLightScale != -1 && params[Vars.m_nEnvMapLightScale]->IsDefined())
+		f4Tint[3] = params[Vars.m_nEnvMapLightScale]->GetFloatValue();
+	Out.SetPixelShaderConstantGammaToLinear(LUX_PS_FLOAT_ENVMAP_TINT, f4Tint);
+
+	float f4Factors[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+	if (Vars.m_nEnvMapSaturation != -1 && params[Vars.m_nEnvMapSaturation]->IsDefined())
+		params[Vars.m_nEnvMapSaturation]->GetVecValue(f4Factors, 3);
+	if (Vars.m_nEnvMapContrast != -1 && params[Vars.m_nEnvMapContrast]->IsDefined())
+		f4Factors[3] = params[Vars.m_nEnvMapContrast]->GetFloatValue();
+	Out.SetPixelShaderConstant(LUX_PS_FLOAT_ENVMAP_FACTORS, f4Factors);
+}
+
+static float Saturate(float fl)
+{
+	return fl < 0.0f ? 0.0f : (fl > 1.0f ? 1.0f : fl);
+}
+
+// EnvMapFresnel() from lux_common_envmap.h, the Factor it multiplies the Lookup with
+static float ShaderFresnel(const float fl4Fresnel[4], float flNdotV)
+{
+	float flFresnel = 1.0f - flNdotV;
+	flFresnel *= flFresnel;
+	return Saturate(fl4Fresnel[0] * powf(flFresnel, fl4Fresnel[2]) + fl4Fresnel[1]);
+}
+
+// 1 without $EnvMapFresnel, the Ranges from $EnvMapFresnelMinMaxExp with it
+static float ReferenceFresnel(CFakeVar **params, const EnvMapVars_t &Vars, float flNdotV)
+{
+	if (Vars.m_nEnvMapFresnel == -1 || !params[Vars.m_nEnvMapFresnel]->IsDefined() || params[Vars.m_nEnvMapFresnel]->GetFloatValue() == 0.0f)
+		return 1.0f;
+
+	float flMinMaxExp[3] = { 0.0f, 1.0f, 2.0f };
+	if (Vars.m_nEnvMapFresnelMinMaxExp != -1 && params[Vars.m_nEnvMapFresnelMinMaxExp]->IsDefined())
+		params[Vars.m_nEnvMapFresnelMinMaxExp]->GetVecValue(flMinMaxExp, 3);
+
+	float flFresnel = 1.0f - flNdotV;
+	flFresnel *= flFresnel;
+	return Saturate((flMinMaxExp[1] - flMinMaxExp[0]) * powf(flFresnel, flMinMaxExp[2]) + flMinMaxExp[0]);
+}
+
+//==========================================================================//
+// Random Materials
+//==========================================================================//
+static bool Chance(uint32_t &nSeed, float flChance)
+{
+	nSeed = LuxHash(nSeed);
+	return LuxHashFloat(nSeed) < flChance;
+}
+
+static float Range(uint32_t &nSeed, float flMin, float flMax)
+{
+	nSeed = LuxHash(nSeed);
+	return flMin + (flMax - flMin) * LuxHashFloat(nSeed);
+}
+
+static void RandomMaterial(uint32_t nSeed, CFakeVar *pParams, DetailVars_t &Detail, EnvMapVars_t &EnvMap)
+{
+	for (int n = 0; n < NUM_PARAMS; n++)
+	{
+		CFakeVar &Var = pParams[n];
+		Var = CFakeVar();
+		Var.m_bDefined = Chance(nSeed, 0.6f);
+
+		// Overbright Tints and odd Exponents included
+		for (int i = 0; i < 3; i++)
+			Var.m_flValue[i] = Range(nSeed, -0.25f, 2.0f);
+		Var.m_nValue = (int)Range(nSeed, 0.0f, 12.0f);
+	}
+	pParams[PARAM_DETAIL].m_bTexture = pParams[PARAM_DETAIL].m_bDefined;
+	pParams[PARAM_ENVMAP].m_bTexture = pParams[PARAM_ENVMAP].m_bDefined;
+	pParams[PARAM_ENVMAPFRESNELMINMAXEXP].m_flValue[2] = Range(nSeed, 0.5f, 8.0f);
+	if (Chance(nSeed, 0.5f))
+		pParams[PARAM_ENVMAPFRESNEL].m_flValue[0] = 0.0f;
+
+	// Shaders that don't declare a Parameter have -1 for it
+	Detail.m_nDetail = PARAM_DETAIL;
+	Detail.m_nDetailBlendmode = Chance(nSeed, 0.1f) ? -1 : PARAM_DETAILBLENDMODE;
+	Detail.m_nDetailTint = Chance(nSeed, 0.1f) ? -1 : PARAM_DETAILTINT;
+	Detail.m_nDetailBlendFactor = Chance(nSeed, 0.1f) ? -1 : PARAM_DETAILBLENDFACTOR;
+
+	EnvMap.m_nEnvMap = PARAM_ENVMAP;
+	EnvMap.m_nEnvMapTint = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPTINT;
+	EnvMap.m_nEnvMapContrast = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPCONTRAST;
+	EnvMap.m_nEnvMapSaturation = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPSATURATION;
+	EnvMap.m_nEnvMapLightScale = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPLIGHTSCALE;
+	EnvMap.m_nEnvMapFresnel = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPFRESNEL;
+	EnvMap.m_nEnvMapFresnelMinMaxExp = Chance(nSeed, 0.1f) ? -1 : PARAM_ENVMAPFRESNELMINMAXEXP;
+}
+
+static bool Close(float a, float b)
+{
+	return fabsf(a - b) <= 1e-5f * std::max(1.0f, fabsf(b));
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nMaterials = std::max(1, CommandLine.ParmValue("-materials", 20000));
+	uint32_t nSeed = (uint32_t)CommandLine.ParmValue("-seed", 1);
+
+	CFakeVar Params[NUM_PARAMS];
+	CFakeVar *pParams[NUM_PARAMS];
+	for (int n = 0; n < NUM_PARAMS; n++)
+		pParams[n] = &Params[n];
+
+	int nMismatches = 0, nRegisters = 0, nFresnelSamples = 0;
+	for (int nMaterial = 0; nMaterial < nMaterials; nMaterial++)
+	{
+		DetailVars_t Detail;
+		EnvMapVars_t EnvMap;
+		RandomMaterial(LuxHash(nSeed * 1000003 + nMaterial), Params, Detail, EnvMap);
+
+		CLuxMaterialConstantBlock Block;
+		LuxBlock_Detail(Block, pParams, Detail);
+		LuxBlock_EnvMap(Block, pParams, EnvMap);
+		CRegisters Blocked, Reference;
+		Block.UploadPS(Blocked);
+		ReferenceDetail(Reference, pParams, Detail);
+		ReferenceEnvMap(Reference, pParams, EnvMap);
+
+		bool bMismatch = false;
+		for (std::map<int, CRegisters::Register_t>::const_iterator It = Reference.m_Registers.begin(); It != Reference.m_Registers.end(); ++It)
+		{
+			nRegisters++;
+			std::map<int, CRegisters::Register_t>::const_iterator Other = Blocked.m_Registers.find(It->first);
+			for (int n = 0; n < 4; n++)
+			{
+				if (Other == Blocked.m_Registers.end() || !Close(Other->second.fl4[n], It->second.fl4[n]))
+				{
+					if (!bMismatch && nMismatches < 10)
+						printf("Material %d : c%d.%c is %g, the per-Constant Path has %g\n", nMaterial, It->first, "xyzw"[n],
+							Other == Blocked.m_Registers.end() ? 0.0f : Other->second.fl4[n], It->second.fl4[n]);
+					bMismatch = true;
+				}
+			}
+		}
+
+		// Anything else the Block sets has to be the Fresnel
+		for (std::map<int, CRegisters::Register_t>::const_iterator It = Blocked.m_Registers.begin(); It != Blocked.m_Registers.end(); ++It)
+		{
+			if (It->first == LUX_PS_FLOAT_ENVMAP_FRESNEL || Reference.m_Registers.count(It->first))
+				continue;
+			if (!bMismatch && nMismatches < 10)
+				printf("Material %d : c%d is set by the Block only\n", nMaterial, It->first);
+			bMismatch = true;
+		}
+
+		if (Params[PARAM_ENVMAP].m_bTexture)
+		{
+			std::map<int, CRegisters::Register_t>::const_iterator Fresnel = Blocked.m_Registers.find(LUX_PS_FLOAT_ENVMAP_FRESNEL);
+			for (int nStep = 0; nStep <= 64; nStep++)
+			{
+				float flNdotV = nStep / 64.0f;
+				float flReference = ReferenceFresnel(pParams, EnvMap, flNdotV);
+				float flShader = Fresnel == Blocked.m_Registers.end() ? -1.0f : ShaderFresnel(Fresnel->second.fl4, flNdotV);
+				nFresnelSamples++;
+				if (!Close(flShader, flReference))
+				{
+					if (!bMismatch && nMismatches < 10)
+						printf("Material %d : EnvMapFresnel() at NdotV %.3f is %g, should be %g\n", nMaterial, flNdotV, flShader, flReference);
+					bMismatch = true;
+				}
+			}
+		}
+		nMismatches += bMismatch;
+	}
+
+	printf("%d Materials, %d Registers and %d Fresnel Samples compared, %d Mismatches\n", nMaterials, nRegisters, nFresnelSamples, nMismatches);
+	return nMismatches ? 1 : 0;
+}
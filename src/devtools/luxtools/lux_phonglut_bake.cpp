@@ -0,0 +1,170 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Bakes the PHONG_LUT Table from cpp_lux_phonglut.h and measures
+//							how far the Lookups are off from pow() and SetupPhongFresnel()
+//
+//	Usage :	lux_phonglut_bake [-ranges 0.05 0.5 1.0] [-out lut.raw]
+//			-ranges	$PhongFresnelRanges ( min, mid, max ), default is the Stock Default
+//			-out	Writes the Table as raw RGBA16 ( 256 x 64 ), for Inspection
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#define LUX_PHONGLUT_BAKE_ONLY
+#include "../../shaders/fxc/cpp_lux_phonglut.h"
+
+struct Error_t
+{
+	Error_t() : flSumSq(0.0), flMax(0.0), flMaxAt(0.0f), nCount(0) {}
+
+	void Add(double flError, float flWhere)
+	{
+		flError = fabs(flError);
+		flSumSq += flError * flError;
+		nCount++;
+		if (flError > flMax)
+		{
+			flMax = flError;
+			flMaxAt = flWhere;
+		}
+	}
+
+	double Rms() const { return nCount ? sqrt(flSumSq / nCount) : 0.0; }
+
+	double flSumSq;
+	double flMax;
+	float flMaxAt;
+	int64_t nCount;
+};
+
+static void Quantise(std::vector<float> &Table, int nBits)
+{
+	float flScale = (float)((1 << nBits) - 1);
+	for (size_t n = 0; n < Table.size(); n++)
+		Table[n] = floorf(Table[n] * flScale + 0.5f) / flScale;
+}
+
+// Highest Exponent we measure. The Table covers all of them but nobody goes past this
+#define MAX_MEASURED_EXPONENT 256
+
+// pow() Channel against the real Thing, Exponents 1 to MAX_MEASURED_EXPONENT
+static void MeasurePow(const std::vector<float> &Table, Error_t &Total, Error_t *pBuckets, int nBuckets)
+{
+	for (int nExp = 1; nExp <= MAX_MEASURED_EXPONENT; nExp++)
+	{
+		float flExponent = (float)nExp;
+		int nBucket = (nExp - 1) * nBuckets / MAX_MEASURED_EXPONENT;
+
+		for (int nSample = 0; nSample < 2048; nSample++)
+		{
+			// Bias the Samples towards 1, that's where the Highlight is
+			float x = 1.0f - powf(LuxHashFloat(nExp * 4096 + nSample), 3.0f);
+
+			// Shader Side. Same Mapping as lux_common_phong_data.h
+			float u = (1.0f - x) * flExponent * (1.0f / LUX_PHONGLUT_RANGE);
+			u = u > 1.0f ? 1.0f : u;
+			float v = 1.0f / flExponent;
+
+			float flLUT = LuxPhongLUT_Sample(Table.data(), 0, u, v);
+			double flError = flLUT - pow(x, flExponent);
+			Total.Add(flError, flExponent);
+			pBuckets[nBucket].Add(flError, flExponent);
+		}
+	}
+}
+
+static void MeasureFresnel(const std::vector<float> &Table, const float flRanges[3], Error_t &Fresnel, Error_t &Rim)
+{
+	for (int nSample = 0; nSample < 65536; nSample++)
+	{
+		float flNdotV = nSample / 65535.0f;
+		float flReference = LuxPhongLUT_Fresnel(flNdotV, flRanges);
+		flReference = saturate(flReference);
+
+		Fresnel.Add(LuxPhongLUT_Sample(Table.data(), 1, flNdotV, 0.5f) - flReference, flNdotV);
+		Rim.Add(LuxPhongLUT_Sample(Table.data(), 2, flNdotV, 0.5f) - LuxPhongLUT_RimFresnel(flNdotV), flNdotV);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+
+	// Stock Default $PhongFresnelRanges is [0 0.5 1]
+	float flMinMidMax[3] = { 0.0f, 0.5f, 1.0f };
+	for (int n = 1; n + 3 < argc; n++)
+	{
+		if (!strcmp(argv[n], "-ranges"))
+		{
+			for (int c = 0; c < 3; c++)
+				flMinMidMax[c] = (float)atof(argv[n + 1 + c]);
+		}
+	}
+
+	// Encode like the C++ does before uploading to LUX_PS_FLOAT_PHONG_FRESNEL
+	float flRanges[3] = { (flMinMidMax[1] - flMinMidMax[0]) * 2.0f, flMinMidMax[1], (flMinMidMax[2] - flMinMidMax[1]) * 2.0f };
+
+	// The Cache bakes from the quantised Ranges, the Error is against the exact ones
+	int nQuantised[3];
+	float flBakedRanges[3];
+	LuxPhongLUT_QuantiseRanges(flRanges, nQuantised);
+	LuxPhongLUT_DequantiseRanges(nQuantised, flBakedRanges);
+
+	std::vector<float> Table(LUX_PHONGLUT_WIDTH * LUX_PHONGLUT_HEIGHT * 4);
+	double flStart = LuxTimeSeconds();
+	LuxPhongLUT_Bake(Table.data(), flBakedRanges);
+	double flBakeTime = LuxTimeSeconds() - flStart;
+
+	printf("Phong LUT %dx%d, Range %.1f, Ranges [%g %g %g], baked in %.2f ms\n\n",
+		LUX_PHONGLUT_WIDTH, LUX_PHONGLUT_HEIGHT, LUX_PHONGLUT_RANGE,
+		flMinMidMax[0], flMinMidMax[1], flMinMidMax[2], flBakeTime * 1000.0);
+
+	static const int s_nBits[] = { 32, 16, 8 };
+	printf("%-6s %-10s %10s %10s %10s\n", "Format", "Channel", "RMS Error", "Max Error", "Max At");
+
+	for (size_t nFormat = 0; nFormat < sizeof(s_nBits) / sizeof(s_nBits[0]); nFormat++)
+	{
+		std::vector<float> Quantised = Table;
+		if (s_nBits[nFormat] < 32)
+			Quantise(Quantised, s_nBits[nFormat]);
+
+		const int nBuckets = 4;
+		Error_t Pow, Buckets[nBuckets], Fresnel, Rim;
+		MeasurePow(Quantised, Pow, Buckets, nBuckets);
+		MeasureFresnel(Quantised, flRanges, Fresnel, Rim);
+
+		char szFormat[16];
+		snprintf(szFormat, sizeof(szFormat), s_nBits[nFormat] == 32 ? "F32" : "U%d", s_nBits[nFormat]);
+		printf("%-6s %-10s %10.6f %10.6f %10s\n", szFormat, "pow", Pow.Rms(), Pow.flMax, "");
+		for (int n = 0; n < nBuckets; n++)
+		{
+			char szName[32];
+			snprintf(szName, sizeof(szName), " e<=%d", MAX_MEASURED_EXPONENT * (n + 1) / nBuckets);
+			printf("%-6s %-10s %10.6f %10.6f %10.1f\n", "", szName, Buckets[n].Rms(), Buckets[n].flMax, Buckets[n].flMaxAt);
+		}
+		printf("%-6s %-10s %10.6f %10.6f %10.3f\n", "", "fresnel", Fresnel.Rms(), Fresnel.flMax, Fresnel.flMaxAt);
+		printf("%-6s %-10s %10.6f %10.6f %10.3f\n\n", "", "rim", Rim.Rms(), Rim.flMax, Rim.flMaxAt);
+	}
+
+	const char *pOut = CommandLine.ParmValue("-out", (const char *)0);
+	if (pOut)
+	{
+		std::string Data(Table.size() * sizeof(unsigned short), '\0');
+		unsigned short *pDst = (unsigned short *)&Data[0];
+		for (size_t n = 0; n < Table.size(); n++)
+			pDst[n] = (unsigned short)(Table[n] * 65535.0f + 0.5f);
+
+		if (!LuxWriteFile(pOut, Data))
+		{
+			fprintf(stderr, "Failed to write %s\n", pOut);
+			return 1;
+		}
+		printf("Wrote %s\n", pOut);
+	}
+
+	return 0;
+}
@@ -0,0 +1,642 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Packs a declarative List of Constants into float4 Registers and writes the Register Map for it
+//
+//	lux_registermap_ps.h and _vs.h are hand-maintained, one Register per Constant, even when only .x is read.
+//	This takes a Layout File instead, each Constant with its Width and the Combos it's live in,
+//	and writes a Header with :
+//
+//	- <PREFIX>_n Register Macros as REGISTER_FLOAT_xxx, so the same Header gives the CIB Index to HLSL
+//	  ( after lux_registermap_hlsl.h ) and the raw Index to C++ ( after lux_registermap_cpp.h )
+//	- <PREFIX>_<NAME>_REGISTER / _COMPONENT / _WIDTH / _OFFSET for the C++ Side
+//	- The register() Declarations and Swizzle Accessors ( #define g_f2Foo (cPacked_1.zw) ) for HLSL
+//
+//	Constants are packed so each Draw uploads as few Registers as possible :
+//	Constants that are live in the same Combos share Registers, and Registers live in the same Combos are adjacent.
+//
+//	Layout File, one Directive per Line, // Comments :
+//		prefix		LUX_PS_PACKED				Macro Prefix
+//		variable	cPacked						HLSL Register Variables, cPacked_0 ..
+//		first		49							First Register to use
+//		limit		224							Registers available, 224 for ps30 and 256 for vs30
+//		combo		ENVMAPCOMBO 0..2			Combos the Conditions use
+//		skip		BRUSH == 0 && ENVMAPCOMBO == 2
+//		constant	ENVMAP_TINT g_f3EnvMapTint 3 ENVMAPCOMBO > 0
+//					C++ Name, HLSL Accessor, Width, Condition ( optional, the Rest of the Line, Preprocessor Syntax )
+//					Widths over 4 take whole Registers and are declared as float4 <Accessor>[Width / 4]
+//
+//	lux_registermap_verify -emit writes a Layout from what a Shader reads today.
+//	lux_common_envmap.lrp and the lux_common_envmap_packed.h it packs to are checked in next to this File,
+//	-check regenerates the Header in Memory and fails on any Difference, so Changes to the Packer show up there.
+//
+//	Usage :	lux_registermap_pack <layout> [-out <header>] [-check] [-maxcombos N]
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+
+#include <algorithm>
+
+struct Constant_t
+{
+	std::string Name;
+	std::string Accessor;
+	std::string Condition;
+	int nWidth;
+	int nLine;
+
+	// Result
+	int nRegister;		// Index into the Packed Registers, before Ordering
+	int nComponent;
+	std::vector<bool> Live;	// Per Combo
+	int nLive;
+};
+
+struct Register_t
+{
+	int nUsedLanes;			// Bitmask
+	int nCount;				// More than 1 for whole-Register Constants
+	std::vector<bool> Live;
+	int nLive;
+	std::vector<int> Constants;
+};
+
+struct Layout_t
+{
+	Layout_t() : Variable("cPacked"), nFirst(0), nLimit(224) {}
+
+	std::string Prefix;
+	std::string Variable;
+	int nFirst;
+	int nLimit;
+	CLuxComboSet Combos;
+	std::vector<Constant_t> Constants;
+};
+
+static bool IsIdentifier(const std::string &Name)
+{
+	if (Name.empty() || !LuxIsIdentStart(Name[0]))
+		return false;
+	for (size_t n = 1; n < Name.size(); n++)
+	{
+		if (!LuxIsIdentChar(Name[n]))
+			return false;
+	}
+	return true;
+}
+
+static int BitCountLanes(int nLanes)
+{
+	return (nLanes & 1) + ((nLanes >> 1) & 1) + ((nLanes >> 2) & 1) + ((nLanes >> 3) & 1);
+}
+
+// Next whitespace separated Word from nPos, moves nPos past it
+static std::string NextWord(const std::string &Text, size_t &nPos)
+{
+	while (nPos < Text.size() && isspace((unsigned char)Text[nPos]))
+		nPos++;
+	size_t nStart = nPos;
+	while (nPos < Text.size() && !isspace((unsigned char)Text[nPos]))
+		nPos++;
+	return Text.substr(nStart, nPos - nStart);
+}
+
+static bool ParseLayout(const char *pPath, Layout_t &Layout)
+{
+	std::string Source;
+	if (!LuxReadFile(pPath, Source))
+	{
+		fprintf(stderr, "Can't open %s\n", pPath);
+		return false;
+	}
+
+	std::vector<LuxSourceLine_t> Lines;
+	CLuxSourceCache::Split(Source, Lines);
+
+	bool bOk = true;
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		std::string Text = LuxTrim(Lines[n].Text);
+		if (Text.empty())
+			continue;
+
+		size_t nSpace = Text.find_first_of(" \t");
+		std::string Directive = Text.substr(0, nSpace);
+		std::string Rest = nSpace == std::string::npos ? std::string() : LuxTrim(Text.substr(nSpace));
+
+		size_t nPos = 0;
+		std::string Word[3];
+		int nWords = 0;
+		for (; nWords < 3; nWords++)
+		{
+			Word[nWords] = NextWord(Rest, nPos);
+			if (Word[nWords].empty())
+				break;
+		}
+
+		if (Directive == "prefix" && nWords >= 1)
+			Layout.Prefix = Word[0];
+		else if (Directive == "variable" && nWords >= 1)
+			Layout.Variable = Word[0];
+		else if (Directive == "first" && nWords >= 1)
+			Layout.nFirst = atoi(Word[0].c_str());
+		else if (Directive == "limit" && nWords >= 1)
+			Layout.nLimit = atoi(Word[0].c_str());
+		else if (Directive == "skip")
+			Layout.Combos.AddSkip(Rest);
+		else if (Directive == "combo" && nWords >= 2)
+		{
+			int nMin, nMax;
+			if (sscanf(Word[1].c_str(), "%d..%d", &nMin, &nMax) != 2 || nMax < nMin)
+			{
+				fprintf(stderr, "%s(%d): combo wants NAME min..max\n", pPath, Lines[n].nLine);
+				bOk = false;
+				continue;
+			}
+			Layout.Combos.Add(Word[0], nMin, nMax, true);
+		}
+		else if (Directive == "constant" && nWords >= 3)
+		{
+			Constant_t Constant;
+			Constant.Name = Word[0];
+			Constant.Accessor = Word[1];
+			Constant.nWidth = atoi(Word[2].c_str());
+			Constant.nLine = Lines[n].nLine;
+			Constant.nRegister = Constant.nComponent = -1;
+			Constant.nLive = 0;
+
+			// Condition is whatever follows the Width
+			Constant.Condition = LuxTrim(Rest.substr(nPos));
+
+			bool bWidthOk = (Constant.nWidth >= 1 && Constant.nWidth <= 4) || (Constant.nWidth > 4 && Constant.nWidth % 4 == 0);
+			if (!IsIdentifier(Constant.Name) || !IsIdentifier(Constant.Accessor) || !bWidthOk)
+			{
+				fprintf(stderr, "%s(%d): constant wants NAME Accessor Width [Condition], Width 1..4 or a Multiple of 4\n", pPath, Lines[n].nLine);
+				bOk = false;
+				continue;
+			}
+
+			for (size_t nOther = 0; nOther < Layout.Constants.size(); nOther++)
+			{
+				if (Layout.Constants[nOther].Name == Constant.Name || Layout.Constants[nOther].Accessor == Constant.Accessor)
+				{
+					fprintf(stderr, "%s(%d): %s is already declared in Line %d\n", pPath, Lines[n].nLine, Constant.Name.c_str(), Layout.Constants[nOther].nLine);
+					bOk = false;
+				}
+			}
+			Layout.Constants.push_back(Constant);
+		}
+		else
+		{
+			fprintf(stderr, "%s(%d): unknown or incomplete Directive '%s'\n", pPath, Lines[n].nLine, Directive.c_str());
+			bOk = false;
+		}
+	}
+
+	if (Layout.Prefix.empty() || !IsIdentifier(Layout.Prefix) || !IsIdentifier(Layout.Variable))
+	{
+		fprintf(stderr, "%s: needs a valid prefix and variable\n", pPath);
+		bOk = false;
+	}
+	return bOk;
+}
+
+//==========================================================================//
+// Which Constant is live in which Combo
+//==========================================================================//
+static int EvaluateLiveness(Layout_t &Layout, int nMaxCombos)
+{
+	int64_t nTotal = Layout.Combos.NumIndices();
+	int64_t nStride = (nTotal + nMaxCombos - 1) / nMaxCombos;
+	nStride = nStride < 1 ? 1 : nStride;
+
+	int nCombos = 0;
+	std::vector<int> Values;
+	for (int64_t nBase = 0; nBase < nTotal; nBase += nStride)
+	{
+		int64_t nIndex = nStride > 1 ? nBase + LuxHash((uint32_t)(nBase / nStride)) % nStride : nBase;
+		if (nIndex >= nTotal)
+			continue;
+
+		Layout.Combos.Decode(nIndex, Values);
+
+		CLuxPreprocessor PP;
+		char Buffer[16];
+		for (int n = 0; n < Layout.Combos.NumCombos(); n++)
+		{
+			snprintf(Buffer, sizeof(Buffer), "%d", Values[n]);
+			PP.Define(Layout.Combos.Combo(n).Name, Buffer);
+		}
+
+		// Skips here use the Names directly, like the Conditions
+		bool bSkipped = false;
+		for (size_t n = 0; n < Layout.Combos.Skips().size() && !bSkipped; n++)
+		{
+			int64_t nResult;
+			bSkipped = PP.Evaluate(Layout.Combos.Skips()[n], nResult) && nResult;
+		}
+		if (bSkipped)
+			continue;
+
+		for (size_t n = 0; n < Layout.Constants.size(); n++)
+		{
+			Constant_t &Constant = Layout.Constants[n];
+			int64_t nResult = 1;
+			if (!Constant.Condition.empty() && !PP.Evaluate(Constant.Condition, nResult))
+			{
+				fprintf(stderr, "Line %d: can't evaluate '%s', treated as always live\n", Constant.nLine, Constant.Condition.c_str());
+				Constant.Condition.clear();
+				nResult = 1;
+			}
+
+			Constant.Live.push_back(nResult != 0);
+			Constant.nLive += nResult != 0;
+		}
+		nCombos++;
+	}
+	return nCombos;
+}
+
+//==========================================================================//
+// Packing
+//==========================================================================//
+static int UnionCount(const std::vector<bool> &a, const std::vector<bool> &b)
+{
+	int nCount = 0;
+	for (size_t n = 0; n < a.size(); n++)
+		nCount += a[n] || b[n];
+	return nCount;
+}
+
+// Lowest Component where nWidth free Lanes start, -1 if none
+static int FindLanes(int nUsedLanes, int nWidth)
+{
+	for (int nStart = 0; nStart + nWidth <= 4; nStart++)
+	{
+		int nMask = ((1 << nWidth) - 1) << nStart;
+		if (!(nUsedLanes & nMask))
+			return nStart;
+	}
+	return -1;
+}
+
+static void Pack(Layout_t &Layout, std::vector<Register_t> &Registers)
+{
+	std::vector<int> Order;
+	for (size_t n = 0; n < Layout.Constants.size(); n++)
+		Order.push_back((int)n);
+
+	// Widest first, then most often live. Declaration Order breaks Ties so the Output is stable
+	std::stable_sort(Order.begin(), Order.end(), [&Layout](int a, int b)
+	{
+		const Constant_t &A = Layout.Constants[a], &B = Layout.Constants[b];
+		if (A.nWidth != B.nWidth)
+			return A.nWidth > B.nWidth;
+		return A.nLive > B.nLive;
+	});
+
+	for (size_t nOrder = 0; nOrder < Order.size(); nOrder++)
+	{
+		Constant_t &Constant = Layout.Constants[Order[nOrder]];
+
+		// Whole Registers, never shared
+		if (Constant.nWidth > 4)
+		{
+			Register_t Register;
+			Register.nUsedLanes = 15;
+			Register.nCount = Constant.nWidth / 4;
+			Register.Live = Constant.Live;
+			Register.nLive = Constant.nLive;
+			Register.Constants.push_back(Order[nOrder]);
+			Constant.nRegister = (int)Registers.size();
+			Constant.nComponent = 0;
+			Registers.push_back(Register);
+			continue;
+		}
+
+		// Sharing costs the Combos where the Register wasn't uploaded before. A new Register costs all of ours
+		int nBest = -1, nBestCost = Constant.nLive + 1, nBestFree = 5;
+		for (size_t n = 0; n < Registers.size(); n++)
+		{
+			const Register_t &Register = Registers[n];
+			if (Register.nCount != 1 || FindLanes(Register.nUsedLanes, Constant.nWidth) < 0)
+				continue;
+
+			int nCost = UnionCount(Register.Live, Constant.Live) - Register.nLive;
+			int nFree = 4 - BitCountLanes(Register.nUsedLanes) - Constant.nWidth;
+			if (nCost < nBestCost || (nCost == nBestCost && nFree < nBestFree))
+			{
+				nBest = (int)n;
+				nBestCost = nCost;
+				nBestFree = nFree;
+			}
+		}
+
+		if (nBest < 0)
+		{
+			Register_t Register;
+			Register.nUsedLanes = 0;
+			Register.nCount = 1;
+			Register.Live.assign(Constant.Live.size(), false);
+			Register.nLive = 0;
+			nBest = (int)Registers.size();
+			Registers.push_back(Register);
+		}
+
+		Register_t &Register = Registers[nBest];
+		Constant.nRegister = nBest;
+		Constant.nComponent = FindLanes(Register.nUsedLanes, Constant.nWidth);
+		Register.nUsedLanes |= ((1 << Constant.nWidth) - 1) << Constant.nComponent;
+		Register.Constants.push_back(Order[nOrder]);
+		for (size_t n = 0; n < Register.Live.size(); n++)
+			Register.Live[n] = Register.Live[n] || Constant.Live[n];
+		Register.nLive = 0;
+		for (size_t n = 0; n < Register.Live.size(); n++)
+			Register.nLive += Register.Live[n];
+	}
+}
+
+// Registers live in the same Combos next to each other, most often live first. Returns the Order
+static std::vector<int> OrderRegisters(const std::vector<Register_t> &Registers)
+{
+	std::vector<int> Order;
+	for (size_t n = 0; n < Registers.size(); n++)
+		Order.push_back((int)n);
+
+	std::stable_sort(Order.begin(), Order.end(), [&Registers](int a, int b)
+	{
+		if (Registers[a].nLive != Registers[b].nLive)
+			return Registers[a].nLive > Registers[b].nLive;
+		return Registers[a].Live > Registers[b].Live;
+	});
+	return Order;
+}
+
+struct Cost_t
+{
+	double flRegisters;		// Uploaded per Draw, Average over Combos
+	double flRuns;
+	int nFootprint;
+};
+
+// Per Combo, Live Registers and contiguous Runs. pFirst gives each Unit's first Register
+static Cost_t MeasureCost(const std::vector<std::vector<bool> > &Live, const std::vector<int> &Count, const std::vector<int> &First, int nCombos)
+{
+	Cost_t Cost = { 0.0, 0.0, 0 };
+	for (size_t n = 0; n < Count.size(); n++)
+		Cost.nFootprint = std::max(Cost.nFootprint, First[n] + Count[n]);
+
+	for (int nCombo = 0; nCombo < nCombos; nCombo++)
+	{
+		std::vector<bool> Uploaded(Cost.nFootprint, false);
+		for (size_t n = 0; n < Count.size(); n++)
+		{
+			if (!Live[n][nCombo])
+				continue;
+			for (int nReg = 0; nReg < Count[n]; nReg++)
+				Uploaded[First[n] + nReg] = true;
+		}
+
+		for (int n = 0; n < Cost.nFootprint; n++)
+		{
+			Cost.flRegisters += Uploaded[n];
+			Cost.flRuns += Uploaded[n] && (!n || !Uploaded[n - 1]);
+		}
+	}
+
+	if (nCombos)
+	{
+		Cost.flRegisters /= nCombos;
+		Cost.flRuns /= nCombos;
+	}
+	return Cost;
+}
+
+//==========================================================================//
+// Output
+//==========================================================================//
+static std::string RegisterMacro(int nRegister)
+{
+	char Buffer[32];
+	snprintf(Buffer, sizeof(Buffer), "REGISTER_FLOAT_%03d", nRegister);
+	return Buffer;
+}
+
+static std::string Swizzle(int nComponent, int nWidth)
+{
+	return std::string("xyzw").substr(nComponent, nWidth);
+}
+
+static std::string WriteHeader(const Layout_t &Layout, const std::vector<Register_t> &Registers, const std::vector<int> &Order, const std::vector<int> &First,
+	const char *pLayoutPath)
+{
+	std::string Out;
+	char Line[1024];
+	int nCount = 0;
+	for (size_t n = 0; n < Registers.size(); n++)
+		nCount += Registers[n].nCount;
+
+	std::string Guard = Layout.Prefix + "_H_";
+	std::string LayoutName = LuxFileNameOf(pLayoutPath);
+
+	Out += "//===================== File of the LUX Shader Project =====================//\n";
+	Out += "//\n";
+	Out += "//	Generated by lux_registermap_pack from " + LayoutName + "\n";
+	Out += "//	Don't edit this, edit the Layout and run the Tool again\n";
+	Out += "//\n";
+	Out += "//	Include after lux_registermap_hlsl.h ( Shaders ) or lux_registermap_cpp.h ( C++ ),\n";
+	Out += "//	REGISTER_FLOAT_xxx is the CIB Index for one and the raw Index for the other\n";
+	Out += "//\n";
+	Out += "//==========================================================================//\n\n";
+	Out += "#ifndef " + Guard + "\n#define " + Guard + "\n\n";
+
+	snprintf(Line, sizeof(Line), "// %d Registers. One Upload of %s_COUNT from %s_FIRST covers all of them\n", nCount, Layout.Prefix.c_str(), Layout.Prefix.c_str());
+	Out += Line;
+	snprintf(Line, sizeof(Line), "#define %s_FIRST\t\t\t%s\n#define %s_COUNT\t\t\t%d\n\n", Layout.Prefix.c_str(), RegisterMacro(Layout.nFirst).c_str(), Layout.Prefix.c_str(), nCount);
+	Out += Line;
+
+	// Register Macros, in final Order
+	int nIndex = 0;
+	for (size_t nOrder = 0; nOrder < Order.size(); nOrder++)
+	{
+		const Register_t &Register = Registers[Order[nOrder]];
+		for (int n = 0; n < Register.nCount; n++, nIndex++)
+		{
+			snprintf(Line, sizeof(Line), "#define %s_%d\t\t\t%s\n", Layout.Prefix.c_str(), nIndex, RegisterMacro(Layout.nFirst + First[nOrder] + n).c_str());
+			Out += Line;
+		}
+	}
+
+	// Constant Placement
+	Out += "\n// Register, first Component and Width of each Constant\n";
+	Out += "// _OFFSET is the Float Index into a Block that starts at _FIRST, for filling it on the C++ Side\n";
+	for (size_t n = 0; n < Layout.Constants.size(); n++)
+	{
+		const Constant_t &Constant = Layout.Constants[n];
+		int nOrder = (int)(std::find(Order.begin(), Order.end(), Constant.nRegister) - Order.begin());
+		int nRegister = First[nOrder];
+		std::string Name = Layout.Prefix + "_" + Constant.Name;
+
+		snprintf(Line, sizeof(Line), "#define %s_REGISTER\t%s_%d\n#define %s_COMPONENT\t%d\n#define %s_WIDTH\t\t%d\n#define %s_OFFSET\t\t%d\n",
+			Name.c_str(), Layout.Prefix.c_str(), nRegister, Name.c_str(), Constant.nComponent, Name.c_str(), Constant.nWidth, Name.c_str(), nRegister * 4 + Constant.nComponent);
+		Out += Line;
+	}
+
+	// HLSL Declarations and Accessors
+	Out += "\n#if defined(LUX_REGISTERMAP_HLSL_H_)\n";
+	nIndex = 0;
+	for (size_t nOrder = 0; nOrder < Order.size(); nOrder++)
+	{
+		const Register_t &Register = Registers[Order[nOrder]];
+		if (Register.nCount > 1)
+		{
+			const Constant_t &Constant = Layout.Constants[Register.Constants[0]];
+			if (!Constant.Condition.empty())
+				Out += "#if (" + Constant.Condition + ")\n";
+			snprintf(Line, sizeof(Line), "const float4\t%s[%d]\t: register(%s_%d);\n", Constant.Accessor.c_str(), Register.nCount, Layout.Prefix.c_str(), nIndex);
+			Out += Line;
+			if (!Constant.Condition.empty())
+				Out += "#endif\n";
+			nIndex += Register.nCount;
+			continue;
+		}
+
+		snprintf(Line, sizeof(Line), "const float4\t%s_%d\t: register(%s_%d);\n", Layout.Variable.c_str(), nIndex, Layout.Prefix.c_str(), nIndex);
+		Out += Line;
+
+		// Lane Order reads best
+		std::vector<int> Constants = Register.Constants;
+		std::sort(Constants.begin(), Constants.end(), [&Layout](int a, int b) { return Layout.Constants[a].nComponent < Layout.Constants[b].nComponent; });
+		for (size_t n = 0; n < Constants.size(); n++)
+		{
+			const Constant_t &Constant = Layout.Constants[Constants[n]];
+			if (!Constant.Condition.empty())
+				Out += "#if (" + Constant.Condition + ")\n";
+			snprintf(Line, sizeof(Line), "#define\t%s\t(%s_%d.%s)\n", Constant.Accessor.c_str(), Layout.Variable.c_str(), nIndex, Swizzle(Constant.nComponent, Constant.nWidth).c_str());
+			Out += Line;
+			if (!Constant.Condition.empty())
+				Out += "#endif\n";
+		}
+		nIndex++;
+	}
+	Out += "#endif // LUX_REGISTERMAP_HLSL_H_\n\n";
+	Out += "#endif // " + Guard + "\n";
+	return Out;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	const char *pOut = CommandLine.ParmValue("-out", (const char *)NULL);
+	bool bCheck = CommandLine.HasParm("-check");
+	int nMaxCombos = CommandLine.ParmValue("-maxcombos", 20000);
+	nMaxCombos = nMaxCombos < 1 ? 1 : nMaxCombos;
+
+	const char *pLayoutPath = NULL;
+	for (int n = 1; n < argc; n++)
+	{
+		if (!strcmp(argv[n], "-out") || !strcmp(argv[n], "-maxcombos"))
+			n++;
+		else if (argv[n][0] != '-')
+			pLayoutPath = argv[n];
+	}
+
+	if (!pLayoutPath || (bCheck && !pOut))
+	{
+		fprintf(stderr, "Usage: lux_registermap_pack <layout> [-out <header>] [-check] [-maxcombos N]\n");
+		return 1;
+	}
+
+	Layout_t Layout;
+	if (!ParseLayout(pLayoutPath, Layout))
+		return 1;
+	if (Layout.Constants.empty())
+	{
+		fprintf(stderr, "%s has no Constants, nothing to pack\n", pLayoutPath);
+		return 1;
+	}
+
+	int nCombos = EvaluateLiveness(Layout, nMaxCombos);
+	printf("%d Constants, %d Combos\n", (int)Layout.Constants.size(), nCombos);
+
+	std::vector<Register_t> Registers;
+	Pack(Layout, Registers);
+
+	std::vector<int> Order = OrderRegisters(Registers);
+	std::vector<int> First(Order.size());
+	std::vector<std::vector<bool> > Live(Order.size());
+	std::vector<int> Count(Order.size());
+	for (size_t n = 0, nNext = 0; n < Order.size(); n++)
+	{
+		First[n] = (int)nNext;
+		Live[n] = Registers[Order[n]].Live;
+		Count[n] = Registers[Order[n]].nCount;
+		nNext += Count[n];
+	}
+
+	// Against one Register per Constant in Declaration Order, which is what the hand-maintained Maps do
+	std::vector<std::vector<bool> > NaiveLive;
+	std::vector<int> NaiveCount, NaiveFirst;
+	for (size_t n = 0, nNext = 0; n < Layout.Constants.size(); n++)
+	{
+		int nRegisters = (Layout.Constants[n].nWidth + 3) / 4;
+		NaiveLive.push_back(Layout.Constants[n].Live);
+		NaiveCount.push_back(nRegisters);
+		NaiveFirst.push_back((int)nNext);
+		nNext += nRegisters;
+	}
+
+	Cost_t Naive = MeasureCost(NaiveLive, NaiveCount, NaiveFirst, nCombos);
+	Cost_t Packed = MeasureCost(Live, Count, First, nCombos);
+
+	printf("One per Constant : %3d Registers, %5.2f uploaded per Draw in %.2f Runs\n", Naive.nFootprint, Naive.flRegisters, Naive.flRuns);
+	printf("Packed           : %3d Registers, %5.2f uploaded per Draw in %.2f Runs\n", Packed.nFootprint, Packed.flRegisters, Packed.flRuns);
+
+	if (Layout.nFirst + Packed.nFootprint > Layout.nLimit)
+	{
+		fprintf(stderr, "Doesn't fit, c%d..c%d is past the Limit of %d\n", Layout.nFirst, Layout.nFirst + Packed.nFootprint - 1, Layout.nLimit);
+		return 1;
+	}
+
+	for (size_t n = 0; n < Order.size(); n++)
+	{
+		const Register_t &Register = Registers[Order[n]];
+		printf("  c%-3d", Layout.nFirst + First[n]);
+		for (size_t nConstant = 0; nConstant < Register.Constants.size(); nConstant++)
+		{
+			const Constant_t &Constant = Layout.Constants[Register.Constants[nConstant]];
+			printf(" %s.%s", Constant.Accessor.c_str(), Register.nCount > 1 ? "xyzw" : Swizzle(Constant.nComponent, Constant.nWidth).c_str());
+		}
+		printf("%s  ( live in %d of %d )\n", Register.nCount > 1 ? " [whole]" : "", Register.nLive, nCombos);
+	}
+
+	std::string Header = WriteHeader(Layout, Registers, Order, First, pLayoutPath);
+	if (!pOut)
+	{
+		printf("\n%s", Header.c_str());
+		return 0;
+	}
+
+	if (bCheck)
+	{
+		std::string Existing;
+		if (!LuxReadFile(pOut, Existing) || Existing != Header)
+		{
+			fprintf(stderr, "%s is out of Date, run lux_registermap_pack %s -out %s\n", pOut, pLayoutPath, pOut);
+			return 1;
+		}
+		printf("%s is up to Date\n", pOut);
+		return 0;
+	}
+
+	if (!LuxWriteFile(pOut, Header))
+	{
+		fprintf(stderr, "Can't write %s\n", pOut);
+		return 1;
+	}
+	printf("Wrote %s\n", pOut);
+	return 0;
+}
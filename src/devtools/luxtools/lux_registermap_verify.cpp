@@ -0,0 +1,1063 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Checks the Register Maps and every Shader's register() Declarations per Combo
+//
+//	Some Registers are shared on Purpose, LUX_PS_FLOAT_PROJTEX_COLOR and LUX_PS_FLOAT_LIGHTDATA are both c19
+//	because no Combo has a Flashlight and LightData. Shaders also move Registers around
+//	( MOVED_REGISTERS_* in lux_infected_ps30.h ). Whether two Declarations really collide depends on the Combo,
+//	so this preprocesses each Shader once per Combo and looks at what's left :
+//
+//	1.	lux_registermap_hlsl.h + _ps.h + _vs.h against lux_registermap_cpp.h, the C++ Index has to be the same Register.
+//		Macros sharing a Register are listed, they're only a Problem if the Shaders use both at once.
+//	2.	Per Combo, every register() Declaration that's live ( read by Code that survived the Preprocessor ).
+//		Two live Declarations on the same Register are an Error. Declared but unread Overlaps are a Warning.
+//	3.	Packing Suggestions. Components never read, Declarations never read, Registers that could share
+//		a float4 and how many Upload Runs a Draw would need if Registers live in the same Combos were adjacent.
+//
+//	Usage :	lux_registermap_verify [-fxc <dir>] [-I <dir>] [-pre <header>] [-D NAME=VALUE] [-combo NAME min..max]
+//			[-maxcombos N] [-movable N] [-emit <dir>] [-verbose] a.fxc b.h ..
+//			-fxc		Where the lux_registermap_*.h Files are. Default ../../shaders/fxc
+//			-I			More Include Directories. The Shader's own Directory is always searched
+//			-pre		Preprocessed before each Shader, for Headers that rely on the .fxc's Includes
+//			-D			Fixed Define, for Headers without Combo Declarations
+//			-combo		Extra Combo to iterate, same
+//			-maxcombos	Sample this many Combos when there are more. Default 20000
+//			-movable	First Float Register Packing may move. Stock Code sets the ones below. Default 32
+//			-emit		Write <dir>/<shader>.lrp, a lux_registermap_pack Layout of the movable Registers as they're read today.
+//						Nothing is written when none are live. lux_common_envmap.lrp next to this File came from
+//						lux_common_envmap.h, its Header says how
+//			-verbose	Print every Declaration
+//			All of these but -fxc, -maxcombos and -movable can be given more than once.
+//
+//	Exits with 1 on live Overlaps, Map Mismatches and Registers that don't resolve.
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+
+#include <algorithm>
+
+struct Options_t
+{
+	Options_t() : nMaxCombos(20000), nMovable(32), bVerbose(false) {}
+
+	std::string FxcDir;
+	std::vector<std::string> IncludeDirs;
+	std::vector<std::string> PreHeaders;
+	std::vector<std::pair<std::string, std::string> > Defines;
+	std::vector<LuxCombo_t> ExtraCombos;
+	int nMaxCombos;
+	int nMovable;
+	bool bVerbose;
+	std::string EmitDir;
+};
+
+static int s_nErrors = 0;
+static int s_nWarnings = 0;
+
+//==========================================================================//
+// Register Names. 'c' Float, 'b' Bool, 'i' Int, 's' Sampler
+// Bool Macros in the PS are Indices into Bools[16], those are 'B'
+//==========================================================================//
+static bool ParseRegister(const std::string &Text, char &cClass, int &nIndex)
+{
+	std::string Trimmed = LuxTrim(Text);
+	if (Trimmed.empty())
+		return false;
+
+	const char *p = Trimmed.c_str();
+	if (isdigit((unsigned char)p[0]))
+	{
+		cClass = 'B';
+	}
+	else
+	{
+		cClass = p[0];
+		if (!strchr("cbis", cClass) || !isdigit((unsigned char)p[1]))
+			return false;
+		p++;
+	}
+
+	char *pEnd;
+	nIndex = (int)strtol(p, &pEnd, 10);
+	return *pEnd == 0;
+}
+
+//==========================================================================//
+// 1. Register Maps
+//==========================================================================//
+static void VerifyMaps(const Options_t &Options)
+{
+	printf("==== Register Maps ====\n");
+
+	const char *pMaps[] = { "lux_registermap_ps.h", "lux_registermap_vs.h", "lux_infected_registermap.h" };
+
+	CLuxSourceCache Cache;
+	CLuxPreprocessor HLSL(&Cache), CPP(&Cache);
+	HLSL.Run(Options.FxcDir + "lux_registermap_hlsl.h");
+	for (int n = 0; n < 3; n++)
+		HLSL.Run(Options.FxcDir + pMaps[n]);
+
+	CPP.Run(Options.FxcDir + "lux_registermap_cpp.h");
+	CPP.Run(Options.FxcDir + pMaps[2]);
+
+	for (size_t n = 0; n < HLSL.Problems().size(); n++)
+		printf("  ERROR: %s\n", HLSL.Problems()[n].c_str()), s_nErrors++;
+	for (size_t n = 0; n < CPP.Problems().size(); n++)
+		printf("  ERROR: %s\n", CPP.Problems()[n].c_str()), s_nErrors++;
+
+	// Stage, Class, Index -> Macros
+	std::map<std::string, std::vector<std::string> > Aliases;
+	int nChecked = 0;
+
+	const std::map<std::string, LuxMacro_t> &Macros = HLSL.Macros();
+	for (std::map<std::string, LuxMacro_t>::const_iterator it = Macros.begin(); it != Macros.end(); ++it)
+	{
+		if (it->second.nFile < 0)
+			continue;
+
+		std::string File = LuxFileNameOf(HLSL.Files()[it->second.nFile]);
+		const char *pStage = File == pMaps[1] ? "VS" : (File == pMaps[0] || File == pMaps[2] ? "PS" : NULL);
+		if (!pStage || it->second.Body.empty())
+			continue;
+
+		char cClass;
+		int nHLSL, nCPP;
+		if (!ParseRegister(HLSL.Expand(it->first), cClass, nHLSL))
+		{
+			printf("  ERROR: %s ( %s ) doesn't resolve to a Register in HLSL : '%s'\n", it->first.c_str(), File.c_str(), HLSL.Expand(it->first).c_str());
+			s_nErrors++;
+			continue;
+		}
+
+		int64_t nValue;
+		if (!CPP.Evaluate(it->first, nValue) || !CPP.IsDefined(it->first))
+		{
+			printf("  ERROR: %s ( %s ) has no C++ Index, lux_registermap_cpp.h doesn't see it\n", it->first.c_str(), File.c_str());
+			s_nErrors++;
+			continue;
+		}
+
+		nCPP = (int)nValue;
+		if (nCPP != nHLSL)
+		{
+			printf("  ERROR: %s is %c%d in HLSL but %d in C++\n", it->first.c_str(), cClass, nHLSL, nCPP);
+			s_nErrors++;
+		}
+
+		char Key[64];
+		snprintf(Key, sizeof(Key), "%s %c%03d", pStage, cClass, nHLSL);
+		Aliases[Key].push_back(it->first);
+		nChecked++;
+	}
+
+	printf("  %d Macros checked against lux_registermap_cpp.h\n", nChecked);
+
+	// Shared Registers, for Information. The Per-Combo Pass decides if they collide
+	for (std::map<std::string, std::vector<std::string> >::iterator it = Aliases.begin(); it != Aliases.end(); ++it)
+	{
+		if (it->second.size() < 2)
+			continue;
+
+		std::string Key = it->first;
+		printf("  Shared %s%s :", Key.substr(0, 3).c_str(), Key[3] == 'B' ? ("Bools[" + Key.substr(4) + "]").c_str() : Key.substr(3).c_str());
+		for (size_t n = 0; n < it->second.size(); n++)
+			printf(" %s", it->second[n].c_str());
+		printf("\n");
+	}
+	printf("\n");
+}
+
+//==========================================================================//
+// 2. Declarations
+//==========================================================================//
+struct Declaration_t
+{
+	std::string Name;
+	std::string Type;
+	char cClass;
+	int nFirst;
+	int nCount;			// Registers
+	int nComponents;	// Per Register
+	bool bWhole;		// Array, Matrix or Struct, Swizzles don't tell us which Register they hit
+	int nFile;
+	int nLine;
+	std::string Where;
+};
+
+// Registers and Components of a Type. Column-major like fxc, a float4x3 is 3 Registers of 4
+static bool TypeSize(const std::string &Type, bool bRowMajor, const std::map<std::string, int> &Structs, int &nRegisters, int &nComponents)
+{
+	nRegisters = 1;
+	nComponents = 4;
+
+	std::map<std::string, int>::const_iterator it = Structs.find(Type);
+	if (it != Structs.end())
+	{
+		nRegisters = it->second;
+		return true;
+	}
+
+	if (!Type.compare(0, 7, "sampler") || !Type.compare(0, 7, "texture") || Type == "bool" || Type == "int")
+	{
+		nComponents = 1;
+		return true;
+	}
+
+	size_t nPrefix = !Type.compare(0, 5, "float") ? 5 : (!Type.compare(0, 4, "half") ? 4 : 0);
+	if (!nPrefix)
+		return false;
+
+	int nRows = 1, nColumns = 1;
+	const char *p = Type.c_str() + nPrefix;
+	if (*p && sscanf(p, "%dx%d", &nRows, &nColumns) == 2)
+	{
+		nRegisters = bRowMajor ? nRows : nColumns;
+		nComponents = bRowMajor ? nColumns : nRows;
+		return true;
+	}
+
+	if (*p && sscanf(p, "%d", &nRows) != 1)
+		return false;
+
+	nComponents = nRows;
+	return true;
+}
+
+// struct Name { Members }; in the active Source, Size in Registers
+static void ParseStructs(const std::vector<LuxActiveLine_t> &Lines, std::map<std::string, int> &Structs)
+{
+	std::string Source;
+	for (size_t n = 0; n < Lines.size(); n++)
+		Source += Lines[n].Text + "\n";
+
+	size_t nPos = 0;
+	while ((nPos = Source.find("struct", nPos)) != std::string::npos)
+	{
+		size_t nStart = nPos;
+		nPos += 6;
+		if ((nStart && LuxIsIdentChar(Source[nStart - 1])) || LuxIsIdentChar(Source[nPos]))
+			continue;
+
+		size_t nOpen = Source.find('{', nPos);
+		size_t nClose = nOpen == std::string::npos ? nOpen : Source.find('}', nOpen);
+		if (nClose == std::string::npos)
+			break;
+
+		std::string Name = LuxTrim(Source.substr(nPos, nOpen - nPos));
+		std::string Body = Source.substr(nOpen + 1, nClose - nOpen - 1);
+
+		int nSize = 0;
+		size_t nMember = 0;
+		while (nMember < Body.size())
+		{
+			size_t nEnd = Body.find(';', nMember);
+			if (nEnd == std::string::npos)
+				break;
+
+			std::string Member = Body.substr(nMember, nEnd - nMember);
+			nMember = nEnd + 1;
+
+			size_t nColon = Member.find(':');
+			if (nColon != std::string::npos)
+				Member = Member.substr(0, nColon);
+
+			char Type[64] = { 0 };
+			if (sscanf(Member.c_str(), " %63s", Type) != 1)
+				continue;
+
+			int nRegisters, nComponents;
+			if (!TypeSize(Type, false, Structs, nRegisters, nComponents))
+				nRegisters = 1;
+
+			int nArray = 1;
+			size_t nBracket = Member.find('[');
+			if (nBracket != std::string::npos)
+				nArray = atoi(Member.c_str() + nBracket + 1);
+			nSize += nRegisters * (nArray > 0 ? nArray : 1);
+		}
+
+		if (!Name.empty())
+			Structs[Name] = nSize;
+		nPos = nClose;
+	}
+}
+
+static bool ParseDeclaration(const CLuxPreprocessor &PP, const LuxActiveLine_t &Line, const std::map<std::string, int> &Structs, Declaration_t &Decl, std::string &Error)
+{
+	const std::string &Text = Line.Text;
+	size_t nRegister = Text.find("register");
+	while (nRegister != std::string::npos && ((nRegister && LuxIsIdentChar(Text[nRegister - 1])) || LuxIsIdentChar(Text[nRegister + 8])))
+		nRegister = Text.find("register", nRegister + 8);
+	if (nRegister == std::string::npos)
+		return false;
+
+	size_t nColon = Text.rfind(':', nRegister);
+	size_t nOpen = Text.find('(', nRegister);
+	size_t nClose = nOpen == std::string::npos ? nOpen : Text.find(')', nOpen);
+	if (nColon == std::string::npos || nClose == std::string::npos)
+		return false;
+
+	// Qualifiers Type Name[Array]
+	std::string Head = LuxTrim(Text.substr(0, nColon));
+	std::string Array;
+	size_t nBracket = Head.find('[');
+	if (nBracket != std::string::npos)
+	{
+		Array = Head.substr(nBracket + 1, Head.find(']', nBracket) - nBracket - 1);
+		Head = LuxTrim(Head.substr(0, nBracket));
+	}
+
+	std::vector<std::string> Words;
+	for (size_t n = 0; n < Head.size(); )
+	{
+		if (!LuxIsIdentChar(Head[n]))
+		{
+			n++;
+			continue;
+		}
+		size_t nEnd = n;
+		while (nEnd < Head.size() && LuxIsIdentChar(Head[nEnd]))
+			nEnd++;
+		Words.push_back(Head.substr(n, nEnd - n));
+		n = nEnd;
+	}
+
+	if (Words.size() < 2)
+		return false;
+
+	Decl.Name = Words[Words.size() - 1];
+	Decl.Type = Words[Words.size() - 2];
+	bool bRowMajor = std::find(Words.begin(), Words.end(), std::string("row_major")) != Words.end();
+
+	std::string Argument = Text.substr(nOpen + 1, nClose - nOpen - 1);
+	std::string Expanded = PP.Expand(Argument);
+	if (!ParseRegister(Expanded, Decl.cClass, Decl.nFirst) || Decl.cClass == 'B')
+	{
+		Error = "register(" + LuxTrim(Argument) + ") doesn't resolve, got '" + LuxTrim(Expanded) + "'";
+		return true;
+	}
+
+	int nRegisters, nComponents;
+	if (!TypeSize(Decl.Type, bRowMajor, Structs, nRegisters, nComponents))
+	{
+		Error = "unknown Type " + Decl.Type + ", counted as one Register";
+		nRegisters = 1;
+		nComponents = 4;
+	}
+
+	int64_t nArray = 1;
+	if (!Array.empty() && (!PP.Evaluate(Array, nArray) || nArray < 1))
+	{
+		Error = "Array Size [" + Array + "] doesn't evaluate";
+		nArray = 1;
+	}
+
+	Decl.nCount = nRegisters * (int)nArray;
+	Decl.nComponents = nComponents;
+	Decl.bWhole = Decl.nCount > 1 || Structs.count(Decl.Type);
+	Decl.nFile = Line.nFile;
+	Decl.nLine = Line.nLine;
+
+	char Where[512];
+	snprintf(Where, sizeof(Where), "%s(%d)", LuxFileNameOf(PP.Files()[Line.nFile]).c_str(), Line.nLine);
+	Decl.Where = Where;
+	return true;
+}
+
+// Component Mask per Identifier. 15 for anything that isn't a plain Swizzle
+static void CollectUses(const std::string &Text, std::map<std::string, int> &Uses)
+{
+	for (size_t n = 0; n < Text.size(); )
+	{
+		if (isdigit((unsigned char)Text[n]))
+		{
+			while (n < Text.size() && (LuxIsIdentChar(Text[n]) || Text[n] == '.'))
+				n++;
+			continue;
+		}
+
+		if (!LuxIsIdentStart(Text[n]) || (n && Text[n - 1] == '.'))
+		{
+			n++;
+			continue;
+		}
+
+		size_t nEnd = n;
+		while (nEnd < Text.size() && LuxIsIdentChar(Text[nEnd]))
+			nEnd++;
+
+		std::string Name = Text.substr(n, nEnd - n);
+		int nMask = 15;
+
+		size_t nDot = nEnd;
+		while (nDot < Text.size() && Text[nDot] == ' ')
+			nDot++;
+		if (nDot < Text.size() && Text[nDot] == '.')
+		{
+			size_t nSwizzle = nDot + 1;
+			while (nSwizzle < Text.size() && Text[nSwizzle] == ' ')
+				nSwizzle++;
+
+			int nSwizzleMask = 0;
+			size_t nChar = nSwizzle;
+			for (; nChar < Text.size() && LuxIsIdentChar(Text[nChar]); nChar++)
+			{
+				const char *pLane = strchr("xyzwrgba", Text[nChar]);
+				if (!pLane)
+				{
+					nSwizzleMask = 15;
+					break;
+				}
+				nSwizzleMask |= 1 << ((pLane - "xyzwrgba") & 3);
+			}
+			if (nChar > nSwizzle && nChar - nSwizzle <= 4)
+				nMask = nSwizzleMask;
+		}
+
+		Uses[Name] |= nMask;
+		n = nEnd;
+	}
+}
+
+// What one Combo declares and reads
+struct ComboResult_t
+{
+	std::vector<Declaration_t> Declarations;
+	std::vector<int> LiveMask;			// Per Declaration, Components read, 0 if dead
+};
+
+static void AnalyseCombo(const CLuxPreprocessor &PP, std::vector<std::string> &Problems, ComboResult_t &Result)
+{
+	const std::vector<LuxActiveLine_t> &Lines = PP.Lines();
+
+	std::map<std::string, int> Structs;
+	ParseStructs(Lines, Structs);
+
+	// Declarations, and what everything else reads
+	std::map<std::string, int> Uses;
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		Declaration_t Decl;
+		std::string Error;
+		if (ParseDeclaration(PP, Lines[n], Structs, Decl, Error))
+		{
+			if (!Error.empty())
+				Problems.push_back(Decl.Where.empty() ? Error : Decl.Where + ": " + Error);
+			if (!Decl.Where.empty())
+				Result.Declarations.push_back(Decl);
+			continue;
+		}
+		CollectUses(Lines[n].Text, Uses);
+	}
+
+	// Macros only count when something reads the Macro
+	std::map<std::string, std::map<std::string, int> > MacroUses;
+	const std::map<std::string, LuxMacro_t> &Macros = PP.Macros();
+	for (std::map<std::string, LuxMacro_t>::const_iterator it = Macros.begin(); it != Macros.end(); ++it)
+		CollectUses(it->second.Body, MacroUses[it->first]);
+
+	std::set<std::string> Expanded;
+	for (bool bChanged = true; bChanged; )
+	{
+		bChanged = false;
+		for (std::map<std::string, std::map<std::string, int> >::iterator it = MacroUses.begin(); it != MacroUses.end(); ++it)
+		{
+			if (!Uses.count(it->first) || Expanded.count(it->first))
+				continue;
+
+			Expanded.insert(it->first);
+			for (std::map<std::string, int>::iterator Use = it->second.begin(); Use != it->second.end(); ++Use)
+				Uses[Use->first] |= Use->second;
+			bChanged = true;
+		}
+	}
+
+	Result.LiveMask.resize(Result.Declarations.size());
+	for (size_t n = 0; n < Result.Declarations.size(); n++)
+	{
+		std::map<std::string, int>::iterator it = Uses.find(Result.Declarations[n].Name);
+		Result.LiveMask[n] = it == Uses.end() ? 0 : it->second;
+	}
+}
+
+//==========================================================================//
+// Per Shader
+//==========================================================================//
+struct DeclarationStats_t
+{
+	Declaration_t Decl;
+	int nDeclared;
+	int nLive;
+	int nMask;						// Components read in any Combo
+	std::vector<bool> LiveIn;		// Per analysed Combo
+};
+
+struct Overlap_t
+{
+	int nLive;
+	int nDeclared;
+	std::string Example;
+};
+
+static std::string MaskToSwizzle(int nMask)
+{
+	std::string Out;
+	for (int n = 0; n < 4; n++)
+	{
+		if (nMask & (1 << n))
+			Out += "xyzw"[n];
+	}
+	return Out.empty() ? "-" : Out;
+}
+
+static int BitCount(int nMask)
+{
+	int nCount = 0;
+	for (; nMask; nMask >>= 1)
+		nCount += nMask & 1;
+	return nCount;
+}
+
+// Upload Runs over the live Float Registers
+static int CountRuns(const std::vector<int> &Registers)
+{
+	std::vector<int> Sorted = Registers;
+	std::sort(Sorted.begin(), Sorted.end());
+	Sorted.erase(std::unique(Sorted.begin(), Sorted.end()), Sorted.end());
+
+	int nRuns = 0;
+	for (size_t n = 0; n < Sorted.size(); n++)
+	{
+		if (!n || Sorted[n] != Sorted[n - 1] + 1)
+			nRuns++;
+	}
+	return nRuns;
+}
+
+//==========================================================================//
+// Layout for lux_registermap_pack. Conditions are derived from which Combos a Declaration was live in,
+// as a Function of one or two Combos. Anything more complicated is left always live, with a Note
+//==========================================================================//
+static std::string DeriveCondition(const CLuxComboSet &Combos, const std::vector<std::vector<int> > &ComboValues, const std::vector<bool> &LiveIn)
+{
+	int nLive = 0;
+	for (size_t n = 0; n < LiveIn.size(); n++)
+		nLive += LiveIn[n];
+	if (nLive == (int)LiveIn.size())
+		return std::string();
+
+	char Buffer[256];
+	for (int nPair = 0; nPair < 2; nPair++)
+	{
+		for (int a = 0; a < Combos.NumCombos(); a++)
+		{
+			for (int b = nPair ? a + 1 : a; b < (nPair ? Combos.NumCombos() : a + 1); b++)
+			{
+				// Liveness per ( Value a, Value b ), -1 unseen
+				std::map<std::pair<int, int>, int> Table;
+				bool bConsistent = true;
+				for (size_t n = 0; n < ComboValues.size() && bConsistent; n++)
+				{
+					std::pair<int, int> Key(ComboValues[n][a], nPair ? ComboValues[n][b] : 0);
+					std::map<std::pair<int, int>, int>::iterator it = Table.find(Key);
+					if (it == Table.end())
+						Table[Key] = LiveIn[n];
+					else
+						bConsistent = it->second == (int)LiveIn[n];
+				}
+				if (!bConsistent)
+					continue;
+
+				std::string Condition;
+				int nTerms = 0;
+				for (std::map<std::pair<int, int>, int>::iterator it = Table.begin(); it != Table.end(); ++it)
+				{
+					if (!it->second)
+						continue;
+
+					if (nPair)
+						snprintf(Buffer, sizeof(Buffer), "(%s == %d && %s == %d)", Combos.Combo(a).Name.c_str(), it->first.first, Combos.Combo(b).Name.c_str(), it->first.second);
+					else
+						snprintf(Buffer, sizeof(Buffer), "%s == %d", Combos.Combo(a).Name.c_str(), it->first.first);
+					Condition += (nTerms++ ? " || " : "") + std::string(Buffer);
+				}
+
+				if (nTerms <= 4)
+					return Condition;
+			}
+		}
+	}
+	return "?";
+}
+
+static void EmitLayout(const std::string &Path, const Options_t &Options, const CLuxComboSet &Combos, const std::vector<DeclarationStats_t> &Stats,
+	const std::vector<std::vector<int> > &ComboValues)
+{
+	std::string Name = LuxFileNameOf(Path);
+	Name = Name.substr(0, Name.find('.'));
+
+	std::string Prefix = Name;
+	for (size_t n = 0; n < Prefix.size(); n++)
+		Prefix[n] = (char)toupper((unsigned char)Prefix[n]);
+
+	std::string Out;
+	char Line[1024];
+	Out += "// Written by lux_registermap_verify from " + LuxFileNameOf(Path) + "\n";
+	Out += "// Widths are the Span of Components read, so Accessors keep their Swizzle from .x on. Check those before packing\n\n";
+	Out += "prefix\t\t" + Prefix + "_PACKED\n";
+	Out += "variable\tcPacked\n";
+	snprintf(Line, sizeof(Line), "first\t\t%d\nlimit\t\t%d\n\n", Options.nMovable, Name.find("_vs") != std::string::npos ? 256 : 224);
+	Out += Line;
+
+	for (int n = 0; n < Combos.NumCombos(); n++)
+	{
+		snprintf(Line, sizeof(Line), "combo\t\t%s\t%d..%d\n", Combos.Combo(n).Name.c_str(), Combos.Combo(n).nMin, Combos.Combo(n).nMax);
+		Out += Line;
+	}
+	for (size_t n = 0; n < Combos.Skips().size(); n++)
+	{
+		// Layout Skips use plain Names
+		std::string Skip = Combos.Skips()[n];
+		Skip.erase(std::remove(Skip.begin(), Skip.end(), '$'), Skip.end());
+		Out += "skip\t\t" + Skip + "\n";
+	}
+	Out += "\n";
+
+	int nEmitted = 0;
+	for (size_t n = 0; n < Stats.size(); n++)
+	{
+		const Declaration_t &Decl = Stats[n].Decl;
+		if (!Stats[n].nLive || Decl.cClass != 'c' || Decl.nFirst < Options.nMovable)
+			continue;
+
+		int nWidth = Decl.nCount * 4;
+		if (!Decl.bWhole)
+		{
+			nWidth = 0;
+			for (int nLane = 0; nLane < 4; nLane++)
+				nWidth = (Stats[n].nMask & (1 << nLane)) ? nLane + 1 : nWidth;
+		}
+
+		std::string Constant = Decl.Name;
+		for (size_t nChar = 0; nChar < Constant.size(); nChar++)
+			Constant[nChar] = (char)toupper((unsigned char)Constant[nChar]);
+
+		std::string Condition = DeriveCondition(Combos, ComboValues, Stats[n].LiveIn);
+		if (Condition == "?")
+		{
+			snprintf(Line, sizeof(Line), "// Live in %d of %d Combos, no simple Condition. Left always live\n", Stats[n].nLive, (int)ComboValues.size());
+			Out += Line;
+			Condition.clear();
+		}
+
+		snprintf(Line, sizeof(Line), "constant\t%s\t%s\t%d%s%s\t// c%d %s\n", Constant.c_str(), Decl.Name.c_str(), nWidth, Condition.empty() ? "" : "\t",
+			Condition.c_str(), Decl.nFirst, Decl.Where.c_str());
+		Out += Line;
+		nEmitted++;
+	}
+
+	// An empty Layout packs into a Header of Nothing, don't write one
+	if (!nEmitted)
+	{
+		int nHighest = -1;
+		for (size_t n = 0; n < Stats.size(); n++)
+		{
+			if (Stats[n].nLive && Stats[n].Decl.cClass == 'c')
+				nHighest = std::max(nHighest, Stats[n].Decl.nFirst + Stats[n].Decl.nCount - 1);
+		}
+		printf("  No Layout written, no live Float Register at c%d or above ( highest live is c%d ). -movable moves that Boundary\n", Options.nMovable, nHighest);
+		return;
+	}
+
+	std::string OutPath = Options.EmitDir;
+	if (OutPath[OutPath.size() - 1] != '/' && OutPath[OutPath.size() - 1] != '\\')
+		OutPath += '/';
+	OutPath += Name + ".lrp";
+
+	if (LuxWriteFile(OutPath.c_str(), Out))
+		printf("  Wrote %s, %d Constants\n", OutPath.c_str(), nEmitted);
+	else
+	{
+		printf("  ERROR: can't write %s\n", OutPath.c_str());
+		s_nErrors++;
+	}
+}
+
+static void VerifyShader(const std::string &Path, const Options_t &Options, CLuxSourceCache &Cache)
+{
+	printf("==== %s ====\n", Path.c_str());
+
+	std::string Source;
+	if (!LuxReadFile(Path.c_str(), Source))
+	{
+		printf("  ERROR: can't open\n\n");
+		s_nErrors++;
+		return;
+	}
+
+	CLuxComboSet Combos;
+	Combos.Parse(Source);
+	for (size_t n = 0; n < Options.ExtraCombos.size(); n++)
+		Combos.Add(Options.ExtraCombos[n].Name, Options.ExtraCombos[n].nMin, Options.ExtraCombos[n].nMax, true);
+
+	std::string FileName = LuxFileNameOf(Path);
+	bool bVertex = FileName.find("_vs") != std::string::npos;
+
+	int64_t nTotal = Combos.NumIndices();
+	int64_t nStride = (nTotal + Options.nMaxCombos - 1) / Options.nMaxCombos;
+	nStride = nStride < 1 ? 1 : nStride;
+
+	std::vector<DeclarationStats_t> Stats;
+	std::map<std::string, int> StatsIndex;
+	std::map<std::string, Overlap_t> Overlaps;
+	std::set<std::string> Problems;
+	std::set<std::string> Missing;
+	std::vector<std::vector<int> > LivePerCombo;	// Float Registers live per Combo
+	std::vector<std::vector<int> > DeclsPerCombo;	// Stats Indices live per Combo
+	std::vector<std::vector<int> > ComboValues;		// Per analysed Combo
+	int nAnalysed = 0, nSkipped = 0;
+
+	std::vector<int> Values;
+	for (int64_t nBase = 0; nBase < nTotal; nBase += nStride)
+	{
+		// Sampling walks a Hash through each Stride, so we don't only see the first Value of the slow Combos
+		int64_t nIndex = nStride > 1 ? nBase + LuxHash((uint32_t)(nBase / nStride)) % nStride : nBase;
+		if (nIndex >= nTotal)
+			continue;
+
+		Combos.Decode(nIndex, Values);
+		if (Combos.IsSkipped(Values))
+		{
+			nSkipped++;
+			continue;
+		}
+
+		CLuxPreprocessor PP(&Cache);
+		PP.AddIncludeDir(Options.FxcDir);
+		for (size_t n = 0; n < Options.IncludeDirs.size(); n++)
+			PP.AddIncludeDir(Options.IncludeDirs[n]);
+
+		PP.Define(bVertex ? "SHADER_MODEL_VS_3_0" : "SHADER_MODEL_PS_3_0", "1");
+		for (size_t n = 0; n < Options.Defines.size(); n++)
+			PP.Define(Options.Defines[n].first, Options.Defines[n].second);
+
+		char Buffer[16];
+		for (int n = 0; n < Combos.NumCombos(); n++)
+		{
+			snprintf(Buffer, sizeof(Buffer), "%d", Values[n]);
+			PP.Define(Combos.Combo(n).Name, Buffer);
+		}
+
+		for (size_t n = 0; n < Options.PreHeaders.size(); n++)
+			PP.Run(Options.PreHeaders[n]);
+		PP.Run(Path);
+
+		std::string ComboName = Combos.Describe(Values);
+		for (size_t n = 0; n < PP.Problems().size(); n++)
+			Problems.insert(PP.Problems()[n]);
+		for (std::set<std::string>::const_iterator it = PP.Missing().begin(); it != PP.Missing().end(); ++it)
+			Missing.insert(*it);
+
+		std::vector<std::string> DeclProblems;
+		ComboResult_t Result;
+		AnalyseCombo(PP, DeclProblems, Result);
+		for (size_t n = 0; n < DeclProblems.size(); n++)
+			Problems.insert(DeclProblems[n]);
+
+		std::vector<int> LiveFloats, LiveDecls;
+		for (size_t nDecl = 0; nDecl < Result.Declarations.size(); nDecl++)
+		{
+			const Declaration_t &Decl = Result.Declarations[nDecl];
+			char Key[512];
+			snprintf(Key, sizeof(Key), "%s %s %c%d", Decl.Where.c_str(), Decl.Name.c_str(), Decl.cClass, Decl.nFirst);
+
+			std::map<std::string, int>::iterator it = StatsIndex.find(Key);
+			if (it == StatsIndex.end())
+			{
+				DeclarationStats_t New;
+				New.Decl = Decl;
+				New.nDeclared = New.nLive = New.nMask = 0;
+				it = StatsIndex.insert(std::make_pair(std::string(Key), (int)Stats.size())).first;
+				Stats.push_back(New);
+			}
+
+			DeclarationStats_t &DeclStats = Stats[it->second];
+			DeclStats.LiveIn.resize(nAnalysed + 1, false);
+			DeclStats.nDeclared++;
+			if (Result.LiveMask[nDecl])
+			{
+				DeclStats.nLive++;
+				DeclStats.nMask |= Result.LiveMask[nDecl];
+				DeclStats.LiveIn[nAnalysed] = true;
+				LiveDecls.push_back(it->second);
+				if (Decl.cClass == 'c')
+				{
+					for (int n = 0; n < Decl.nCount; n++)
+						LiveFloats.push_back(Decl.nFirst + n);
+				}
+			}
+
+			// Against every earlier Declaration of this Combo
+			for (size_t nOther = 0; nOther < nDecl; nOther++)
+			{
+				const Declaration_t &Other = Result.Declarations[nOther];
+				if (Other.cClass != Decl.cClass || Other.nFirst >= Decl.nFirst + Decl.nCount || Decl.nFirst >= Other.nFirst + Other.nCount)
+					continue;
+
+				// Same Declaration seen twice, e.g. a Header without Guard
+				if (Other.Name == Decl.Name && Other.nFirst == Decl.nFirst)
+					continue;
+
+				std::string PairKey = Other.Name + " ( " + Other.Where + " ) and " + Decl.Name + " ( " + Decl.Where + " )";
+				Overlap_t &Overlap = Overlaps[PairKey];
+				bool bLive = Result.LiveMask[nDecl] && Result.LiveMask[nOther];
+				(bLive ? Overlap.nLive : Overlap.nDeclared)++;
+				if (Overlap.Example.empty() || (bLive && Overlap.nLive == 1))
+					Overlap.Example = ComboName;
+			}
+		}
+
+		LivePerCombo.push_back(LiveFloats);
+		DeclsPerCombo.push_back(LiveDecls);
+		ComboValues.push_back(Values);
+		nAnalysed++;
+	}
+
+	for (size_t n = 0; n < Stats.size(); n++)
+		Stats[n].LiveIn.resize(nAnalysed, false);
+
+	printf("  %s Shader, %lld Combos, %d analysed, %d skipped%s\n", bVertex ? "Vertex" : "Pixel", (long long)nTotal, nAnalysed, nSkipped,
+		nStride > 1 ? " ( sampled )" : "");
+
+	// SDK Headers usually, they don't declare anything we map
+	for (std::set<std::string>::iterator it = Missing.begin(); it != Missing.end(); ++it)
+		printf("  Not found, skipped : %s\n", it->c_str());
+
+	for (std::set<std::string>::iterator it = Problems.begin(); it != Problems.end(); ++it)
+	{
+		bool bFatal = it->find("doesn't resolve") != std::string::npos || it->find("#error") != std::string::npos;
+		printf("  %s: %s\n", bFatal ? "ERROR" : "WARNING", it->c_str());
+		(bFatal ? s_nErrors : s_nWarnings)++;
+	}
+
+	if (Options.bVerbose)
+	{
+		for (size_t n = 0; n < Stats.size(); n++)
+		{
+			const Declaration_t &Decl = Stats[n].Decl;
+			printf("  %c%-3d x%-2d %-12s %-32s live in %d of %d, reads .%s  %s\n", Decl.cClass, Decl.nFirst, Decl.nCount, Decl.Type.c_str(), Decl.Name.c_str(),
+				Stats[n].nLive, Stats[n].nDeclared, MaskToSwizzle(Stats[n].nMask).c_str(), Decl.Where.c_str());
+		}
+	}
+
+	// Overlaps
+	int nLiveOverlaps = 0;
+	for (std::map<std::string, Overlap_t>::iterator it = Overlaps.begin(); it != Overlaps.end(); ++it)
+	{
+		if (it->second.nLive)
+		{
+			printf("  ERROR: %s are both live in %d Combos, e.g. %s\n", it->first.c_str(), it->second.nLive, it->second.Example.c_str());
+			s_nErrors++;
+			nLiveOverlaps++;
+		}
+		else
+		{
+			printf("  WARNING: %s overlap in %d Combos, but never both read, e.g. %s\n", it->first.c_str(), it->second.nDeclared, it->second.Example.c_str());
+			s_nWarnings++;
+		}
+	}
+	if (!nLiveOverlaps)
+		printf("  No live Overlaps\n");
+
+	//==========================================================================//
+	// 3. Packing Suggestions
+	//==========================================================================//
+	printf("  Packing :\n");
+	int nSuggestions = 0;
+
+	// Declared but never read
+	for (size_t n = 0; n < Stats.size(); n++)
+	{
+		const Declaration_t &Decl = Stats[n].Decl;
+		if (Stats[n].nLive || Decl.cClass == 's')
+			continue;
+
+		printf("    %c%d %s is declared in %d Combos and never read, don't upload it\n", Decl.cClass, Decl.nFirst, Decl.Name.c_str(), Stats[n].nDeclared);
+		nSuggestions++;
+	}
+
+	// Components never read. Only single Registers, Swizzles on Arrays don't say which Element
+	std::vector<int> Partial;
+	for (size_t n = 0; n < Stats.size(); n++)
+	{
+		const Declaration_t &Decl = Stats[n].Decl;
+		if (!Stats[n].nLive || Decl.cClass != 'c' || Decl.bWhole)
+			continue;
+
+		int nDeclaredMask = (1 << Decl.nComponents) - 1;
+		int nRead = BitCount(Stats[n].nMask & nDeclaredMask);
+		if (nRead >= 4)
+			continue;
+
+		Partial.push_back((int)n);
+		printf("    c%d %s reads .%s, %d of 4 Components free\n", Decl.nFirst, Decl.Name.c_str(), MaskToSwizzle(Stats[n].nMask & nDeclaredMask).c_str(), 4 - nRead);
+		nSuggestions++;
+	}
+
+	// Pairs that fit one Register, most Combos where both are live first
+	struct Pair_t { int a, b, nBoth; };
+	std::vector<Pair_t> Pairs;
+	for (size_t a = 0; a < Partial.size(); a++)
+	{
+		for (size_t b = a + 1; b < Partial.size(); b++)
+		{
+			const DeclarationStats_t &A = Stats[Partial[a]], &B = Stats[Partial[b]];
+			if (BitCount(A.nMask & 15) + BitCount(B.nMask & 15) > 4)
+				continue;
+			if (A.Decl.nFirst < Options.nMovable && B.Decl.nFirst < Options.nMovable)
+				continue;
+
+			Pair_t Pair = { Partial[a], Partial[b], 0 };
+			for (int n = 0; n < nAnalysed; n++)
+				Pair.nBoth += A.LiveIn[n] && B.LiveIn[n];
+			if (Pair.nBoth)
+				Pairs.push_back(Pair);
+		}
+	}
+
+	std::sort(Pairs.begin(), Pairs.end(), [](const Pair_t &a, const Pair_t &b) { return a.nBoth > b.nBoth; });
+	std::set<int> Used;
+	for (size_t n = 0; n < Pairs.size(); n++)
+	{
+		if (Used.count(Pairs[n].a) || Used.count(Pairs[n].b))
+			continue;
+
+		Used.insert(Pairs[n].a);
+		Used.insert(Pairs[n].b);
+		printf("    Merge c%d %s.%s and c%d %s.%s into one Register, saves one Upload in %d Combos\n",
+			Stats[Pairs[n].a].Decl.nFirst, Stats[Pairs[n].a].Decl.Name.c_str(), MaskToSwizzle(Stats[Pairs[n].a].nMask).c_str(),
+			Stats[Pairs[n].b].Decl.nFirst, Stats[Pairs[n].b].Decl.Name.c_str(), MaskToSwizzle(Stats[Pairs[n].b].nMask).c_str(), Pairs[n].nBoth);
+		nSuggestions++;
+	}
+
+	// Upload Runs now, and with the movable Registers grouped by the Combos they're live in
+	if (nAnalysed)
+	{
+		std::vector<int> Movable;
+		for (size_t n = 0; n < Stats.size(); n++)
+		{
+			if (Stats[n].nLive && Stats[n].Decl.cClass == 'c' && Stats[n].Decl.nFirst >= Options.nMovable)
+				Movable.push_back((int)n);
+		}
+
+		// Most often live first, same Combo Set next to each other
+		std::sort(Movable.begin(), Movable.end(), [&Stats](int a, int b)
+		{
+			if (Stats[a].nLive != Stats[b].nLive)
+				return Stats[a].nLive > Stats[b].nLive;
+			return Stats[a].LiveIn > Stats[b].LiveIn;
+		});
+
+		std::map<int, int> NewFirst;
+		int nNext = Options.nMovable;
+		for (size_t n = 0; n < Movable.size(); n++)
+		{
+			NewFirst[Movable[n]] = nNext;
+			nNext += Stats[Movable[n]].Decl.nCount;
+		}
+
+		double flRegisters = 0.0, flRunsNow = 0.0, flRunsGrouped = 0.0;
+		for (int nCombo = 0; nCombo < nAnalysed; nCombo++)
+		{
+			std::vector<int> Grouped;
+			const std::vector<int> &Decls = DeclsPerCombo[nCombo];
+			for (size_t n = 0; n < Decls.size(); n++)
+			{
+				const Declaration_t &Decl = Stats[Decls[n]].Decl;
+				if (Decl.cClass != 'c')
+					continue;
+
+				std::map<int, int>::iterator it = NewFirst.find(Decls[n]);
+				int nFirst = it == NewFirst.end() ? Decl.nFirst : it->second;
+				for (int nReg = 0; nReg < Decl.nCount; nReg++)
+					Grouped.push_back(nFirst + nReg);
+			}
+
+			flRegisters += CountRuns(LivePerCombo[nCombo]) ? (double)LivePerCombo[nCombo].size() : 0.0;
+			flRunsNow += CountRuns(LivePerCombo[nCombo]);
+			flRunsGrouped += CountRuns(Grouped);
+		}
+
+		printf("    Per Draw : %.1f live Float Registers in %.1f Runs, %.1f Runs with c%d+ grouped by Combo\n",
+			flRegisters / nAnalysed, flRunsNow / nAnalysed, flRunsGrouped / nAnalysed, Options.nMovable);
+	}
+
+	if (!nSuggestions)
+		printf("    Nothing to pack\n");
+
+	if (!Options.EmitDir.empty())
+		EmitLayout(Path, Options, Combos, Stats, ComboValues);
+
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+
+	Options_t Options;
+	Options.FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!Options.FxcDir.empty() && Options.FxcDir[Options.FxcDir.size() - 1] != '/' && Options.FxcDir[Options.FxcDir.size() - 1] != '\\')
+		Options.FxcDir += '/';
+	Options.nMaxCombos = CommandLine.ParmValue("-maxcombos", 20000);
+	Options.nMovable = CommandLine.ParmValue("-movable", 32);
+	Options.bVerbose = CommandLine.HasParm("-verbose");
+	Options.EmitDir = CommandLine.ParmValue("-emit", "");
+	Options.nMaxCombos = Options.nMaxCombos < 1 ? 1 : Options.nMaxCombos;
+
+	std::vector<std::string> Shaders;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		bool bHasValue = n + 1 < argc;
+		if (Arg == "-I" && bHasValue)
+			Options.IncludeDirs.push_back(argv[++n]);
+		else if (Arg == "-pre" && bHasValue)
+			Options.PreHeaders.push_back(argv[++n]);
+		else if (Arg == "-D" && bHasValue)
+		{
+			std::string Define = argv[++n];
+			size_t nEquals = Define.find('=');
+			Options.Defines.push_back(nEquals == std::string::npos ? std::make_pair(Define, std::string("1")) : std::make_pair(Define.substr(0, nEquals), Define.substr(nEquals + 1)));
+		}
+		else if (Arg == "-combo" && n + 2 < argc)
+		{
+			LuxCombo_t Combo;
+			Combo.Name = argv[++n];
+			Combo.bStatic = true;
+			if (sscanf(argv[++n], "%d..%d", &Combo.nMin, &Combo.nMax) != 2 || Combo.nMax < Combo.nMin)
+			{
+				fprintf(stderr, "-combo %s wants min..max\n", Combo.Name.c_str());
+				return 1;
+			}
+			Options.ExtraCombos.push_back(Combo);
+		}
+		else if ((Arg == "-fxc" || Arg == "-maxcombos" || Arg == "-movable" || Arg == "-emit") && bHasValue)
+			n++;
+		else if (Arg[0] != '-')
+			Shaders.push_back(Arg);
+	}
+
+	VerifyMaps(Options);
+
+	CLuxSourceCache Cache;
+	for (size_t n = 0; n < Shaders.size(); n++)
+		VerifyShader(Shaders[n], Options, Cache);
+
+	printf("%d Errors, %d Warnings\n", s_nErrors, s_nWarnings);
+	return s_nErrors ? 1 : 0;
+}
@@ -0,0 +1,642 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Packs $SelfIllumMask into an unused Alpha Channel and rewrites the VMT
+//
+//	A separate $SelfIllumMask costs SAMPLER_SELFILLUM and a Fetch per Pixel.
+//	Most Masks are greyscale, so they fit into the Alpha of $EnvMapMask or $BaseTexture
+//	when nothing else reads it. The Shader then picks SELFILLUM_MASK_ENVMAPMASK_ALPHA or
+//	SELFILLUM_MASK_BASE_ALPHA ( lux_common_selfillum.h ) and never binds the Mask.
+//
+//	Works on the TGA Sources in materialsrc, run vtex on the Output afterwards.
+//	$EnvMapMask Alpha is preferred, since the Base Alpha is wanted by a lot of other Features.
+//	The Mask is read with the $BaseTexture UVs, so $EnvMapMask is only used when $EnvMapMaskTransform
+//	matches $BaseTextureTransform.
+//
+//	Saved Memory is counted as vtex would store it, DXT with Mips : the Mask Texture goes away,
+//	but a Target that had no Alpha before grows from DXT1 to DXT5.
+//
+//	Usage :	lux_selfillum_pack -materialsrc <dir> [-materials <dir>] [-dryrun] [-inplace] [-force] [-base] a.vmt b.vmt ..
+//			-materialsrc	Where the TGAs are, Texture Names are appended to this
+//			-materials		The whole VMT Tree. Every VMT in it is scanned for other Users of a Target
+//			-dryrun			Only print what would be done
+//			-inplace		Overwrite the Target TGA instead of writing <name>_si<Mask Hash>.tga.
+//							Needs -materials, and refuses a Target that any other VMT in the Tree uses.
+//							Only VMTs are scanned, Textures referenced from Code or Scripts aren't found
+//			-force			Pack coloured Masks too ( stored as Luminance )
+//			-base			Prefer $BaseTexture Alpha over $EnvMapMask Alpha
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <map>
+#include <set>
+
+// Bilinear, Texel Centers. Only used when the Mask isn't the same Size as the Target
+static float SampleChannel(const LuxImage_t &Image, int nChannel, float u, float v)
+{
+	float fx = u * Image.nWidth - 0.5f;
+	float fy = v * Image.nHeight - 0.5f;
+	int x0 = (int)floorf(fx), y0 = (int)floorf(fy);
+	float tx = fx - x0, ty = fy - y0;
+
+	// Wrap, Textures tile
+	int x1 = x0 + 1, y1 = y0 + 1;
+	x0 = (x0 % Image.nWidth + Image.nWidth) % Image.nWidth;
+	x1 = (x1 % Image.nWidth + Image.nWidth) % Image.nWidth;
+	y0 = (y0 % Image.nHeight + Image.nHeight) % Image.nHeight;
+	y1 = (y1 % Image.nHeight + Image.nHeight) % Image.nHeight;
+
+	#define TEXEL(x, y) (float)Image.RGBA[((size_t)(y) * Image.nWidth + (x)) * 4 + nChannel]
+	float a = lerp(TEXEL(x0, y0), TEXEL(x1, y0), tx);
+	float b = lerp(TEXEL(x0, y1), TEXEL(x1, y1), tx);
+	#undef TEXEL
+	return lerp(a, b, ty);
+}
+
+//==========================================================================//
+// VMT. We only touch the Root Block, and keep every other Line as it is
+//==========================================================================//
+struct VMTLine_t
+{
+	std::string Text;
+	std::string Key;	// Lowercase, without Quotes. Empty for anything that isn't "key" "value"
+	std::string Value;
+	int nDepth;			// Brace Depth the Line is in
+};
+
+static std::string ToLower(std::string s)
+{
+	for (size_t n = 0; n < s.size(); n++)
+		s[n] = (char)tolower((unsigned char)s[n]);
+	return s;
+}
+
+// Reads the next Token, quoted or not. Returns false at the End of the Line or on a Comment
+static bool NextToken(const std::string &Line, size_t &nPos, std::string &Token)
+{
+	while (nPos < Line.size() && isspace((unsigned char)Line[nPos]))
+		nPos++;
+	if (nPos >= Line.size() || Line.compare(nPos, 2, "//") == 0)
+		return false;
+
+	Token.clear();
+	if (Line[nPos] == '"')
+	{
+		size_t nEnd = Line.find('"', nPos + 1);
+		if (nEnd == std::string::npos)
+			nEnd = Line.size();
+		Token = Line.substr(nPos + 1, nEnd - nPos - 1);
+		nPos = nEnd + 1;
+		return true;
+	}
+
+	// Braces are always their own Token
+	if (Line[nPos] == '{' || Line[nPos] == '}')
+	{
+		Token = Line[nPos++];
+		return true;
+	}
+
+	while (nPos < Line.size() && !isspace((unsigned char)Line[nPos]) && !strchr("\"{}", Line[nPos]))
+		Token += Line[nPos++];
+	return true;
+}
+
+static bool ParseVMT(const std::string &Data, std::vector<VMTLine_t> &Lines)
+{
+	int nDepth = 0;
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+
+		VMTLine_t Line;
+		Line.Text = Data.substr(nStart, nEnd - nStart);
+		if (!Line.Text.empty() && Line.Text[Line.Text.size() - 1] == '\r')
+			Line.Text.erase(Line.Text.size() - 1);
+		Line.nDepth = nDepth;
+
+		size_t nPos = 0;
+		std::string Token;
+		std::vector<std::string> Tokens;
+		while (NextToken(Line.Text, nPos, Token))
+		{
+			if (Token == "{")
+				nDepth++;
+			else if (Token == "}")
+				nDepth--;
+			Tokens.push_back(Token);
+		}
+
+		if (Tokens.size() >= 2 && Tokens[0] != "{" && Tokens[0] != "}" && Tokens[1] != "{" && Tokens[1] != "}")
+		{
+			Line.Key = ToLower(Tokens[0]);
+			Line.Value = Tokens[1];
+		}
+
+		Lines.push_back(Line);
+		nStart = nEnd + 1;
+	}
+	return nDepth == 0;
+}
+
+static const VMTLine_t *FindKey(const std::vector<VMTLine_t> &Lines, const char *pKey)
+{
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		if (Lines[n].nDepth == 1 && Lines[n].Key == pKey)
+			return &Lines[n];
+	}
+	return NULL;
+}
+
+static bool IsKeySet(const std::vector<VMTLine_t> &Lines, const char *pKey)
+{
+	const VMTLine_t *pLine = FindKey(Lines, pKey);
+	return pLine && atof(pLine->Value.c_str()) != 0.0;
+}
+
+//==========================================================================//
+// Who else reads the Alpha Channels. Anything in here blocks packing into that Texture
+//==========================================================================//
+static const char *s_pBaseAlphaUsers[] =
+{
+	"$translucent", "$alphatest", "$basealphaenvmapmask", "$basemapalphaphongmask",
+	"$blendtintbybasealpha", "$desaturatewithbasealpha", "$basemapalphaenvmapmask",
+};
+
+// TextureCombine() in lux_common_detailtexture.h. 4 and 7 blend by Base Alpha, 3, 8 and 9 write it into the Output Alpha
+static const int s_nBaseAlphaBlendModes[] = { 3, 4, 7, 8, 9 };
+
+static const char *FindBaseAlphaUser(const std::vector<VMTLine_t> &Lines)
+{
+	for (size_t n = 0; n < sizeof(s_pBaseAlphaUsers) / sizeof(s_pBaseAlphaUsers[0]); n++)
+	{
+		if (IsKeySet(Lines, s_pBaseAlphaUsers[n]))
+			return s_pBaseAlphaUsers[n];
+	}
+
+	// Distance coded Alpha, from the Base unless told otherwise
+	if (IsKeySet(Lines, "$distancealpha") && !IsKeySet(Lines, "$distancealphafromdetail"))
+		return "$distancealpha";
+
+	// Blendmode only matters with a $Detail
+	const VMTLine_t *pBlendMode = FindKey(Lines, "$detailblendmode");
+	if (pBlendMode && FindKey(Lines, "$detail"))
+	{
+		int nBlendMode = atoi(pBlendMode->Value.c_str());
+		for (size_t n = 0; n < sizeof(s_nBaseAlphaBlendModes) / sizeof(s_nBaseAlphaBlendModes[0]); n++)
+		{
+			if (nBlendMode == s_nBaseAlphaBlendModes[n])
+				return "$detailblendmode";
+		}
+	}
+
+	return NULL;
+}
+
+// center .5 .5 scale 1 1 rotate 0 translate 0 0, missing Parts keep those Defaults
+static void ParseTransform(const VMTLine_t *pLine, float flTransform[7])
+{
+	static const float s_flIdentity[7] = { 0.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+	memcpy(flTransform, s_flIdentity, sizeof(s_flIdentity));
+	if (!pLine)
+		return;
+
+	// Token, first Index, Number of Values
+	static const struct { const char *pName; int nFirst; int nCount; } s_Parts[] =
+	{
+		{ "center", 0, 2 }, { "scale", 2, 2 }, { "rotate", 4, 1 }, { "translate", 5, 2 },
+	};
+
+	std::vector<std::string> Tokens;
+	const std::string Value = ToLower(pLine->Value);
+	for (size_t nPos = 0; nPos < Value.size();)
+	{
+		size_t nEnd = Value.find_first_of(" \t", nPos);
+		if (nEnd == std::string::npos)
+			nEnd = Value.size();
+		if (nEnd > nPos)
+			Tokens.push_back(Value.substr(nPos, nEnd - nPos));
+		nPos = nEnd + 1;
+	}
+
+	for (size_t n = 0; n < Tokens.size(); n++)
+	{
+		for (size_t nPart = 0; nPart < sizeof(s_Parts) / sizeof(s_Parts[0]); nPart++)
+		{
+			if (Tokens[n] != s_Parts[nPart].pName)
+				continue;
+			for (int i = 0; i < s_Parts[nPart].nCount && n + 1 < Tokens.size(); i++)
+				flTransform[s_Parts[nPart].nFirst + i] = (float)atof(Tokens[++n].c_str());
+		}
+	}
+}
+
+static bool SameTransform(const VMTLine_t *pA, const VMTLine_t *pB)
+{
+	float flA[7], flB[7];
+	ParseTransform(pA, flA);
+	ParseTransform(pB, flB);
+	for (int n = 0; n < 7; n++)
+	{
+		if (fabsf(flA[n] - flB[n]) > 1e-5f)
+			return false;
+	}
+	return true;
+}
+
+//==========================================================================//
+// Packing
+//==========================================================================//
+struct Options_t
+{
+	std::string MaterialSrc;
+	std::string Materials;
+	bool bDryRun;
+	bool bInPlace;
+	bool bForce;
+	bool bPreferBase;
+
+	// Texture Name to every VMT in -materials that uses it, Full Paths
+	std::map<std::string, std::vector<std::string> > TextureUsers;
+};
+
+struct Totals_t
+{
+	Totals_t() : nPacked(0), nSkipped(0), nMaskBytes(0), nGrowthBytes(0) {}
+
+	int nPacked;
+	int nSkipped;
+	int64_t nMaskBytes;		// Mask Textures that no longer exist
+	int64_t nGrowthBytes;	// Targets that went from DXT1 to DXT5
+
+	// Output Texture to the Mask that went into it. Two Masks can't share one Alpha Channel
+	std::map<std::string, std::string> Outputs;
+	std::set<std::string> Masks;
+};
+
+// Lowercase, forward Slashes, no Extension. VMTs write Texture Names every which Way
+static std::string TextureKey(const std::string &Name)
+{
+	std::string Key = ToLower(Name);
+	for (size_t n = 0; n < Key.size(); n++)
+	{
+		if (Key[n] == '\\')
+			Key[n] = '/';
+	}
+	if (Key.size() > 4 && Key.compare(Key.size() - 4, 4, ".vtf") == 0)
+		Key.erase(Key.size() - 4);
+	return Key;
+}
+
+static std::string FullPath(const char *pPath)
+{
+#ifdef _WIN32
+	char szPath[_MAX_PATH];
+	if (_fullpath(szPath, pPath, sizeof(szPath)))
+		return ToLower(szPath);
+#else
+	char szPath[PATH_MAX];
+	if (realpath(pPath, szPath))
+		return szPath;
+#endif
+	return pPath;
+}
+
+// Every Value in every Block, Proxies and Fallbacks included. Anything that isn't a Texture Name just never matches
+static void ScanMaterials(Options_t &Options)
+{
+	std::vector<std::string> Files;
+	LuxFindFiles(Options.Materials, ".vmt", Files);
+	for (size_t n = 0; n < Files.size(); n++)
+	{
+		std::string Data;
+		std::vector<VMTLine_t> Lines;
+		if (!LuxReadFile(Files[n].c_str(), Data) || !ParseVMT(Data, Lines))
+			continue;
+
+		const std::string Path = FullPath(Files[n].c_str());
+		for (size_t nLine = 0; nLine < Lines.size(); nLine++)
+		{
+			if (Lines[nLine].Value.empty())
+				continue;
+			std::vector<std::string> &Users = Options.TextureUsers[TextureKey(Lines[nLine].Value)];
+			if (Users.empty() || Users.back() != Path)
+				Users.push_back(Path);
+		}
+	}
+	printf("Scanned %d VMTs in %s\n", (int)Files.size(), Options.Materials.c_str());
+}
+
+// Bytes vtex stores for the Image, DXT1 or DXT5 with the full Mip Chain
+static int64_t DXTBytes(int nWidth, int nHeight, bool bAlpha)
+{
+	int64_t nBytes = 0;
+	for (;;)
+	{
+		nBytes += (int64_t)((nWidth + 3) / 4) * ((nHeight + 3) / 4) * (bAlpha ? 16 : 8);
+		if (nWidth == 1 && nHeight == 1)
+			return nBytes;
+		nWidth = nWidth > 1 ? nWidth / 2 : 1;
+		nHeight = nHeight > 1 ? nHeight / 2 : 1;
+	}
+}
+
+static bool HasAlpha(const LuxImage_t &Image)
+{
+	for (size_t n = 3; n < Image.RGBA.size(); n += 4)
+	{
+		if (Image.RGBA[n] != 255)
+			return true;
+	}
+	return false;
+}
+
+static std::string TexturePath(const Options_t &Options, const std::string &Name)
+{
+	std::string Path = Options.MaterialSrc + "/" + Name;
+	for (size_t n = 0; n < Path.size(); n++)
+	{
+		if (Path[n] == '\\')
+			Path[n] = '/';
+	}
+	return Path + ".tga";
+}
+
+// Materials share $BaseTexture and $EnvMapMask with different Masks, so the Mask goes into the Name
+static std::string OutputName(const std::string &Target, const std::string &Mask)
+{
+	std::string Key = ToLower(Mask);
+	for (size_t n = 0; n < Key.size(); n++)
+	{
+		if (Key[n] == '\\')
+			Key[n] = '/';
+	}
+
+	char szHash[16];
+	snprintf(szHash, sizeof(szHash), "_si%08x", (uint32_t)LuxHashBytes(Key.data(), Key.size()));
+	return Target + szHash;
+}
+
+static bool PackMaterial(const char *pVMT, const Options_t &Options, Totals_t &Totals)
+{
+	std::string Data;
+	std::vector<VMTLine_t> Lines;
+	if (!LuxReadFile(pVMT, Data) || !ParseVMT(Data, Lines))
+	{
+		fprintf(stderr, "%s : Failed to read or parse\n", pVMT);
+		return false;
+	}
+
+	const VMTLine_t *pMask = FindKey(Lines, "$selfillummask");
+	if (!pMask || !IsKeySet(Lines, "$selfillum"))
+	{
+		printf("%s : No $SelfIllumMask, nothing to do\n", pVMT);
+		Totals.nSkipped++;
+		return true;
+	}
+
+	// Pick the Target. Animated Targets would need the Mask in every Frame, skip those
+	const VMTLine_t *pEnvMapMask = FindKey(Lines, "$envmapmask");
+	const VMTLine_t *pBase = FindKey(Lines, "$basetexture");
+	const char *pBaseUser = FindBaseAlphaUser(Lines);
+
+	bool bEnvMapMaskOk = pEnvMapMask && !FindKey(Lines, "$envmapmaskframe");
+	bool bBaseOk = pBase && !pBaseUser && !FindKey(Lines, "$frame");
+
+	// The Mask would come out of the EnvMapMask Fetch, with its UVs
+	bool bTransformOk = SameTransform(FindKey(Lines, "$envmapmasktransform"), FindKey(Lines, "$basetexturetransform"));
+	if (bEnvMapMaskOk && !bTransformOk)
+	{
+		printf("%s : $EnvMapMaskTransform differs from $BaseTextureTransform, not packing into $EnvMapMask\n", pVMT);
+		bEnvMapMaskOk = false;
+	}
+
+	const VMTLine_t *pTarget = NULL;
+	if (bBaseOk && (Options.bPreferBase || !bEnvMapMaskOk))
+		pTarget = pBase;
+	else if (bEnvMapMaskOk)
+		pTarget = pEnvMapMask;
+
+	if (!pTarget)
+	{
+		printf("%s : No free Alpha Channel ( %s )\n", pVMT, pBaseUser ? pBaseUser : "no $EnvMapMask or $BaseTexture");
+		Totals.nSkipped++;
+		return true;
+	}
+
+	const bool bIntoBase = pTarget == pBase;
+	const std::string MaskPath = TexturePath(Options, pMask->Value);
+	const std::string TargetPath = TexturePath(Options, pTarget->Value);
+
+	const std::string NewName = Options.bInPlace ? pTarget->Value : OutputName(pTarget->Value, pMask->Value);
+	const std::string OutPath = TexturePath(Options, NewName);
+
+	// Overwriting a Texture is only safe when this Material is the only one that reads it
+	if (Options.bInPlace)
+	{
+		const std::string Self = FullPath(pVMT);
+		std::map<std::string, std::vector<std::string> >::const_iterator Users = Options.TextureUsers.find(TextureKey(pTarget->Value));
+		bool bScanned = false;
+		const char *pOther = NULL;
+		int nOthers = 0;
+		for (size_t n = 0; Users != Options.TextureUsers.end() && n < Users->second.size(); n++)
+		{
+			if (Users->second[n] == Self)
+				bScanned = true;
+			else if (!nOthers++)
+				pOther = Users->second[n].c_str();
+		}
+
+		if (!bScanned)
+		{
+			fprintf(stderr, "%s : Not in %s, can't tell who else uses %s. Not packing in place\n", pVMT, Options.Materials.c_str(), pTarget->Value.c_str());
+			return false;
+		}
+		if (nOthers)
+		{
+			fprintf(stderr, "%s : %s is also used by %s%s, not packing in place\n", pVMT, pTarget->Value.c_str(), pOther, nOthers > 1 ? " and others" : "");
+			return false;
+		}
+	}
+
+	std::map<std::string, std::string>::const_iterator It = Totals.Outputs.find(OutPath);
+	if (It != Totals.Outputs.end() && It->second != MaskPath)
+	{
+		fprintf(stderr, "%s : %s already holds %s in its Alpha, refusing to put %s there\n", pVMT, OutPath.c_str(), It->second.c_str(), MaskPath.c_str());
+		return false;
+	}
+
+	LuxImage_t Mask, Target;
+	if (!LuxLoadTGA(MaskPath.c_str(), Mask) || !LuxLoadTGA(TargetPath.c_str(), Target))
+	{
+		fprintf(stderr, "%s : Can't load %s or %s\n", pVMT, MaskPath.c_str(), TargetPath.c_str());
+		return false;
+	}
+	const bool bTargetHadAlpha = HasAlpha(Target);
+
+	// A coloured Mask can't go into a single Channel without losing the Colour
+	int nMaxChroma = 0;
+	for (size_t n = 0; n < Mask.RGBA.size(); n += 4)
+	{
+		int r = Mask.RGBA[n], g = Mask.RGBA[n + 1], b = Mask.RGBA[n + 2];
+		int nChroma = abs(r - g) > abs(g - b) ? abs(r - g) : abs(g - b);
+		nMaxChroma = nChroma > nMaxChroma ? nChroma : nMaxChroma;
+	}
+
+	if (nMaxChroma > 2 && !Options.bForce)
+	{
+		printf("%s : $SelfIllumMask is coloured ( max Channel Difference %d ), use -force to store Luminance\n", pVMT, nMaxChroma);
+		Totals.nSkipped++;
+		return true;
+	}
+
+	const bool bResample = Mask.nWidth != Target.nWidth || Mask.nHeight != Target.nHeight;
+	for (int y = 0; y < Target.nHeight; y++)
+	{
+		for (int x = 0; x < Target.nWidth; x++)
+		{
+			float u = (x + 0.5f) / Target.nWidth, v = (y + 0.5f) / Target.nHeight;
+			float r, g, b;
+			if (bResample)
+			{
+				r = SampleChannel(Mask, 0, u, v);
+				g = SampleChannel(Mask, 1, u, v);
+				b = SampleChannel(Mask, 2, u, v);
+			}
+			else
+			{
+				const unsigned char *pSrc = &Mask.RGBA[((size_t)y * Mask.nWidth + x) * 4];
+				r = pSrc[0]; g = pSrc[1]; b = pSrc[2];
+			}
+
+			// Greyscale Masks come out unchanged, coloured ones as Rec. 709 Luminance
+			float flValue = nMaxChroma > 2 ? r * 0.2126f + g * 0.7152f + b * 0.0722f : g;
+			Target.RGBA[((size_t)y * Target.nWidth + x) * 4 + 3] = (unsigned char)(flValue + 0.5f);
+		}
+	}
+
+	printf("%s : $SelfIllumMask %dx%d -> %s Alpha %dx%d%s%s\n", pVMT, Mask.nWidth, Mask.nHeight,
+		bIntoBase ? "$BaseTexture" : "$EnvMapMask", Target.nWidth, Target.nHeight,
+		bResample ? " ( resampled )" : "", nMaxChroma > 2 ? " ( Luminance )" : "");
+
+	// Closing Brace of the Root Block, the Flag goes right before it
+	size_t nRootEnd = Lines.size();
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		size_t nPos = 0;
+		std::string Token;
+		if (Lines[n].nDepth == 1 && NextToken(Lines[n].Text, nPos, Token) && Token == "}")
+			nRootEnd = n;
+	}
+
+	// Rewrite the VMT. Mask goes away, Target gets the new Name, EnvMapMask needs the Flag
+	std::string Out;
+	bool bFlagWritten = bIntoBase;
+	for (size_t n = 0; n < Lines.size(); n++)
+	{
+		const VMTLine_t &Line = Lines[n];
+		if (Line.nDepth == 1 && (Line.Key == "$selfillummask" || Line.Key == "$selfillummaskframe" || Line.Key == "$selfillum_envmapmask_alpha"))
+			continue;
+
+		if (!bFlagWritten && n == nRootEnd)
+		{
+			Out += "\t\"$SelfIllum_EnvMapMask_Alpha\" \"1\"\n";
+			bFlagWritten = true;
+		}
+
+		if (&Line == pTarget && NewName != pTarget->Value)
+		{
+			size_t nValue = Line.Text.rfind(pTarget->Value);
+			Out += Line.Text.substr(0, nValue) + NewName + Line.Text.substr(nValue + pTarget->Value.size()) + "\n";
+			continue;
+		}
+
+		Out += Line.Text + "\n";
+	}
+
+	if (!bFlagWritten)
+	{
+		fprintf(stderr, "%s : Couldn't find the End of the Root Block\n", pVMT);
+		return false;
+	}
+
+	// Materials share Masks and Targets, each Texture counts once
+	Totals.nPacked++;
+	if (Totals.Masks.insert(MaskPath).second)
+		Totals.nMaskBytes += DXTBytes(Mask.nWidth, Mask.nHeight, HasAlpha(Mask));
+	if (!Totals.Outputs.count(OutPath) && !bTargetHadAlpha && HasAlpha(Target))
+		Totals.nGrowthBytes += DXTBytes(Target.nWidth, Target.nHeight, true) - DXTBytes(Target.nWidth, Target.nHeight, false);
+	Totals.Outputs[OutPath] = MaskPath;
+
+	if (Options.bDryRun)
+		return true;
+
+	if (!LuxSaveTGA(OutPath.c_str(), Target) || !LuxWriteFile(pVMT, Out))
+	{
+		fprintf(stderr, "%s : Failed to write %s\n", pVMT, OutPath.c_str());
+		return false;
+	}
+	printf("%s : Wrote %s\n", pVMT, OutPath.c_str());
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+
+	Options_t Options;
+	Options.MaterialSrc = CommandLine.ParmValue("-materialsrc", "");
+	Options.Materials = CommandLine.ParmValue("-materials", "");
+	Options.bDryRun = CommandLine.HasParm("-dryrun");
+	Options.bInPlace = CommandLine.HasParm("-inplace");
+	Options.bForce = CommandLine.HasParm("-force");
+	Options.bPreferBase = CommandLine.HasParm("-base");
+
+	std::vector<const char *> VMTs;
+	for (int n = 1; n < argc; n++)
+	{
+		if (!strcmp(argv[n], "-materialsrc") || !strcmp(argv[n], "-materials"))
+			n++;
+		else if (argv[n][0] != '-')
+			VMTs.push_back(argv[n]);
+	}
+
+	if (Options.MaterialSrc.empty() || VMTs.empty())
+	{
+		fprintf(stderr, "Usage: lux_selfillum_pack -materialsrc <dir> [-materials <dir>] [-dryrun] [-inplace] [-force] [-base] a.vmt b.vmt ..\n");
+		return 1;
+	}
+
+	if (Options.bInPlace && Options.Materials.empty())
+	{
+		fprintf(stderr, "-inplace needs -materials <dir>, the whole Material Tree, to make sure nothing else uses the Targets\n");
+		return 1;
+	}
+	if (!Options.Materials.empty())
+		ScanMaterials(Options);
+
+	Totals_t Totals;
+	int nFailed = 0;
+	for (size_t n = 0; n < VMTs.size(); n++)
+	{
+		if (!PackMaterial(VMTs[n], Options, Totals))
+			nFailed++;
+	}
+
+	printf("\n%d packed, %d skipped, %d failed%s\n", Totals.nPacked, Totals.nSkipped, nFailed, Options.bDryRun ? " ( Dry Run )" : "");
+	printf("Saved %d SelfIllum Sampler Binds and Fetches per Draw\n", Totals.nPacked);
+	printf("Saved %.2f MB of Masks, %.2f MB back to Targets grown from DXT1 to DXT5, %.2f MB net\n",
+		Totals.nMaskBytes / (1024.0 * 1024.0), Totals.nGrowthBytes / (1024.0 * 1024.0),
+		(Totals.nMaskBytes - Totals.nGrowthBytes) / (1024.0 * 1024.0));
+	return nFailed ? 1 : 0;
+}
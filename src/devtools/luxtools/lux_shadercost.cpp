@@ -0,0 +1,610 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Per-Combo Instruction Counts against a Baseline and the SM3.0 Limits
+//
+//	Every live Combo is compiled on its own through -compiler, a Command with %profile%, %in% and %out% in it
+//	that writes an SM3 Assembly Listing : fxc /Fc on Windows, vkd3d-compiler elsewhere, so a Change to
+//	ComputeDirectSpecular() or LUX_Finalise() can be measured without Windows.
+//	%in% is a small File that #defines the Combo and #includes the .fxc, the Compiler does the Preprocessing.
+//
+//	From the Listing : ALU, Texture and Flow Control Instructions, Temp Registers ( highest r# + 1 ),
+//	Constant Registers ( distinct c#, def'd ones too, they take the Register ) and Samplers.
+//	A Combo fails when it's above what every SM3.0 Part runs ( 512 Slots, 32 Temps, 224 / 256 Constants,
+//	16 / 4 Samplers ) or when any Count grew more than -threshold Percent over the Baseline.
+//	The Baseline is a Text File, one Line per Combo, sorted, -update writes it :
+//		<shader> <combo index> <alu> <tex> <flow> <temps> <constants> <samplers>
+//	Its first Line is the Compiler it came from, the first Line -compiler_version prints. fxc and vkd3d-compiler
+//	don't emit the same Instructions, so a Baseline from another Compiler is refused, -update starts a new one.
+//	buildshaders.bat checks against shaders/fxc/lux_shadercost_baseline.txt with fxc, that's the one to check in.
+//
+//	Usage :	lux_shadercost [-fxc ../../shaders/fxc] [-list ../../compile_all_shaders.txt] [-compiler "cmd"] [-compiler_version "cmd"]
+//			[-baseline <fxc>/lux_shadercost_baseline.txt] [-threshold 2] [-threads N] [-temp .] [-update] [-verbose] <shader.fxc> ..
+//			Exit Code 1 when a Combo failed, for CI
+//			lux_shadercost -selftest [lux_shadercost_selftest.asm]
+//			Parses the Listing and compares against the Counts its "expects :" Line has, no Compiler needed
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+
+#include <thread>
+#include <atomic>
+
+#ifdef _WIN32
+static const char *s_pDefaultCompiler = "fxc /nologo /O3 /E main /T %profile% /Fc %out% %in% >nul";
+static const char *s_pDefaultCompilerVersion = "fxc /? 2>nul";
+#define popen _popen
+#define pclose _pclose
+#else
+static const char *s_pDefaultCompiler = "vkd3d-compiler -x hlsl -b d3d-asm -p %profile% -o %out% %in% >/dev/null";
+static const char *s_pDefaultCompilerVersion = "vkd3d-compiler --version 2>/dev/null";
+#endif
+
+// First non-empty Line the Command prints, "Microsoft (R) Direct3D Shader Compiler 10.1 .." or "vkd3d shader compiler 1.x .."
+static bool CompilerVersion(const char *pCommand, std::string &Version)
+{
+	FILE *pPipe = popen(pCommand, "r");
+	if (!pPipe)
+		return false;
+
+	char szLine[512];
+	Version.clear();
+	while (Version.empty() && fgets(szLine, sizeof(szLine), pPipe))
+		Version = LuxTrim(szLine);
+	while (fgets(szLine, sizeof(szLine), pPipe))
+		;
+	pclose(pPipe);
+	return !Version.empty();
+}
+
+enum CostCount_t
+{
+	COST_ALU = 0,
+	COST_TEX,
+	COST_FLOW,
+	COST_TEMPS,
+	COST_CONSTANTS,
+	COST_SAMPLERS,
+	COST_COUNT,
+};
+
+static const char *s_pCostNames[COST_COUNT] = { "alu", "tex", "flow", "temps", "constants", "samplers" };
+
+struct Cost_t
+{
+	Cost_t() : nSlots(0), nConstantRange(0), nSamplerRange(0), bOk(false) { memset(nCounts, 0, sizeof(nCounts)); }
+	int nCounts[COST_COUNT];
+	int nSlots;			// fxc's own Count, Macros like m4x4 take more than one Slot. Not in the Baseline
+	int nConstantRange;	// Highest c# + 1, the SM3.0 Limit is on the Register, not the Count
+	int nSamplerRange;
+	bool bOk;
+	std::string Error;
+
+	int Slots() const { return nSlots ? nSlots : nCounts[COST_ALU] + nCounts[COST_TEX] + nCounts[COST_FLOW]; }
+};
+
+//==========================================================================//
+// SM3 Assembly, as fxc /Fc and vkd3d print it
+//==========================================================================//
+static bool IsFlowControl(const std::string &Op)
+{
+	static const char *s_pOps[] = { "if", "else", "endif", "rep", "endrep", "loop", "endloop", "break", "breakp", "call", "callnz", "ret", "label" };
+	std::string Base = Op.substr(0, Op.find('_'));
+	for (size_t n = 0; n < sizeof(s_pOps) / sizeof(s_pOps[0]); n++)
+	{
+		if (Base == s_pOps[n])
+			return true;
+	}
+	return false;
+}
+
+static bool ParseListing(const std::string &Listing, Cost_t &Cost)
+{
+	std::set<int> Constants, Samplers;
+	int nTemps = 0;
+	bool bVersion = false;
+
+	size_t nStart = 0;
+	while (nStart < Listing.size())
+	{
+		size_t nEnd = Listing.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Listing.size();
+		std::string Line = LuxTrim(Listing.substr(nStart, nEnd - nStart));
+		nStart = nEnd + 1;
+
+		// "// approximately 87 instruction slots used ( 6 texture, 81 arithmetic )"
+		size_t nComment = Line.find("//");
+		if (nComment != std::string::npos)
+		{
+			size_t nApproximately = Line.find("approximately", nComment);
+			if (nApproximately != std::string::npos && Line.find("instruction slots", nApproximately) != std::string::npos)
+				Cost.nSlots = atoi(Line.c_str() + nApproximately + 13);
+			Line = LuxTrim(Line.substr(0, nComment));
+		}
+		if (Line.empty())
+			continue;
+
+		// Predicated Instructions start with ( p0.x )
+		if (Line[0] == '(')
+		{
+			size_t nClose = Line.find(')');
+			Line = nClose == std::string::npos ? std::string() : LuxTrim(Line.substr(nClose + 1));
+		}
+
+		size_t nSpace = Line.find_first_of(" \t");
+		std::string Op = Line.substr(0, nSpace);
+		for (size_t n = 0; n < Op.size(); n++)
+			Op[n] = (char)tolower((unsigned char)Op[n]);
+		std::string Operands = nSpace == std::string::npos ? std::string() : Line.substr(nSpace);
+
+		// Registers : r# Temps, c# Constants, s# Samplers. c12[a0.x] is relative, only the Base counts
+		// Source Modifiers follow the Number ( r1_abs, c3_abs ), the Register ends at the '_'
+		for (size_t n = 0; n < Operands.size(); n++)
+		{
+			char c = Operands[n];
+			if ((c != 'r' && c != 'c' && c != 's') || (n && (isalnum((unsigned char)Operands[n - 1]) || Operands[n - 1] == '_')))
+				continue;
+			size_t nDigit = n + 1;
+			while (nDigit < Operands.size() && isdigit((unsigned char)Operands[nDigit]))
+				nDigit++;
+			if (nDigit == n + 1 || (nDigit < Operands.size() && isalpha((unsigned char)Operands[nDigit])))
+				continue;
+			int nRegister = atoi(Operands.c_str() + n + 1);
+			if (c == 'r')
+				nTemps = std::max(nTemps, nRegister + 1);
+			else if (c == 'c')
+				Constants.insert(nRegister);
+			else
+				Samplers.insert(nRegister);
+			n = nDigit - 1;
+		}
+
+		if (Op == "ps_3_0" || Op == "vs_3_0")
+		{
+			bVersion = true;
+			continue;
+		}
+		if (Op.compare(0, 3, "dcl") == 0 || Op.compare(0, 3, "def") == 0)
+			continue;
+
+		if (Op.compare(0, 5, "texld") == 0 || Op == "texkill")
+			Cost.nCounts[COST_TEX]++;
+		else if (IsFlowControl(Op))
+			Cost.nCounts[COST_FLOW]++;
+		else
+			Cost.nCounts[COST_ALU]++;
+	}
+
+	Cost.nCounts[COST_TEMPS] = nTemps;
+	Cost.nCounts[COST_CONSTANTS] = (int)Constants.size();
+	Cost.nCounts[COST_SAMPLERS] = (int)Samplers.size();
+	Cost.nConstantRange = Constants.empty() ? 0 : *Constants.rbegin() + 1;
+	Cost.nSamplerRange = Samplers.empty() ? 0 : *Samplers.rbegin() + 1;
+	return bVersion;
+}
+
+// The Fixture's Comment says what it should come out as : "expects : alu 9 tex 2 .. slots 13"
+static int SelfTest(const char *pPath)
+{
+	std::string Listing;
+	if (!LuxReadFile(pPath, Listing))
+	{
+		fprintf(stderr, "Can't read %s\n", pPath);
+		return 1;
+	}
+
+	size_t nExpects = Listing.find("expects :");
+	if (nExpects == std::string::npos)
+	{
+		fprintf(stderr, "%s has no \"expects :\" Line\n", pPath);
+		return 1;
+	}
+	std::string Expects = Listing.substr(nExpects + 9, Listing.find('\n', nExpects) - nExpects - 9);
+
+	Cost_t Cost;
+	if (!ParseListing(Listing, Cost))
+	{
+		fprintf(stderr, "%s : No ps_3_0 or vs_3_0 Line\n", pPath);
+		return 1;
+	}
+
+	int nFailed = 0, nChecked = 0;
+	char szName[32];
+	int nExpected, nRead;
+	for (const char *p = Expects.c_str(); sscanf(p, "%31s %d%n", szName, &nExpected, &nRead) == 2; p += nRead)
+	{
+		int nGot = -1;
+		if (!strcmp(szName, "slots"))
+			nGot = Cost.nSlots;
+		for (int n = 0; n < COST_COUNT; n++)
+		{
+			if (!strcmp(szName, s_pCostNames[n]))
+				nGot = Cost.nCounts[n];
+		}
+
+		if (nGot == nExpected)
+			printf("  %-10s %4d\n", szName, nGot);
+		else
+			printf("  %-10s %4d, expected %d\n", szName, nGot, nExpected);
+		nFailed += nGot != nExpected;
+		nChecked++;
+	}
+
+	printf("%s : %d of %d Counts match\n", pPath, nChecked - nFailed, nChecked);
+	return nFailed || !nChecked ? 1 : 0;
+}
+
+//==========================================================================//
+// Baseline
+//==========================================================================//
+typedef std::map<std::pair<std::string, int64_t>, Cost_t> CostMap_t;
+
+static const char s_szCompilerTag[] = "// compiler : ";
+
+static bool LoadBaseline(const char *pPath, CostMap_t &Baseline, std::string &Compiler)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = Data.substr(nStart, nEnd - nStart);
+		nStart = nEnd + 1;
+
+		char szShader[256];
+		long long nIndex;
+		Cost_t Cost;
+		int *p = Cost.nCounts;
+		if (Line.compare(0, sizeof(s_szCompilerTag) - 1, s_szCompilerTag) == 0)
+			Compiler = LuxTrim(Line.substr(sizeof(s_szCompilerTag) - 1));
+		else if (Line.compare(0, 2, "//") && sscanf(Line.c_str(), "%255s %lld %d %d %d %d %d %d", szShader, &nIndex, &p[0], &p[1], &p[2], &p[3], &p[4], &p[5]) == 8)
+		{
+			Cost.bOk = true;
+			Baseline[std::make_pair(std::string(szShader), (int64_t)nIndex)] = Cost;
+		}
+	}
+	return true;
+}
+
+static bool SaveBaseline(const char *pPath, const CostMap_t &Baseline, const std::string &Compiler)
+{
+	std::string Out = s_szCompilerTag + Compiler + "\n";
+	Out += "// lux_shadercost Baseline : <shader> <combo index> <alu> <tex> <flow> <temps> <constants> <samplers>\n";
+	char szLine[384];
+	for (CostMap_t::const_iterator It = Baseline.begin(); It != Baseline.end(); ++It)
+	{
+		const int *p = It->second.nCounts;
+		snprintf(szLine, sizeof(szLine), "%s %lld %d %d %d %d %d %d\n", It->first.first.c_str(), (long long)It->first.second, p[0], p[1], p[2], p[3], p[4], p[5]);
+		Out += szLine;
+	}
+	return LuxWriteFile(pPath, Out);
+}
+
+//==========================================================================//
+// Compiling
+//==========================================================================//
+struct Shader_t
+{
+	std::string Name;					// Without .fxc
+	std::string Path;					// Absolute, the Wrapper #includes it
+	bool bVertex;
+	CLuxComboSet Combos;
+};
+
+struct Job_t
+{
+	size_t nShader;
+	int64_t nIndex;
+	Cost_t Cost;
+};
+
+struct Compile_t
+{
+	const std::vector<Shader_t> *pShaders;
+	std::vector<Job_t> *pJobs;
+	std::string Compiler;
+	std::string TempDir;
+	std::atomic<size_t> nNext;
+};
+
+static std::string AbsolutePath(const std::string &Path)
+{
+#ifdef _WIN32
+	char szPath[MAX_PATH];
+	return _fullpath(szPath, Path.c_str(), sizeof(szPath)) ? std::string(szPath) : Path;
+#else
+	char *pPath = realpath(Path.c_str(), NULL);
+	std::string Absolute = pPath ? std::string(pPath) : Path;
+	free(pPath);
+	return Absolute;
+#endif
+}
+
+static void Replace(std::string &Text, const std::string &From, const std::string &To)
+{
+	for (size_t nPos = Text.find(From); nPos != std::string::npos; nPos = Text.find(From, nPos + To.size()))
+		Text.replace(nPos, From.size(), To);
+}
+
+static void CompileThread(Compile_t *pCompile, int nThread)
+{
+	char szName[64];
+	snprintf(szName, sizeof(szName), "combo_%d", nThread);
+	std::string In = pCompile->TempDir + szName + ".hlsl";
+	std::string Out = pCompile->TempDir + szName + ".asm";
+
+	std::vector<int> Values;
+	for (size_t nJob = pCompile->nNext++; nJob < pCompile->pJobs->size(); nJob = pCompile->nNext++)
+	{
+		Job_t &Job = (*pCompile->pJobs)[nJob];
+		const Shader_t &Shader = (*pCompile->pShaders)[Job.nShader];
+
+		// Same Defines ShaderCompile2 sets
+		std::string Wrapper = Shader.bVertex ? "#define SHADER_MODEL_VS_3_0 1\n" : "#define SHADER_MODEL_PS_3_0 1\n";
+		Shader.Combos.Decode(Job.nIndex, Values);
+		for (int n = 0; n < Shader.Combos.NumCombos(); n++)
+		{
+			char szDefine[160];
+			snprintf(szDefine, sizeof(szDefine), "#define %s %d\n", Shader.Combos.Combo(n).Name.c_str(), Values[n]);
+			Wrapper += szDefine;
+		}
+		Wrapper += "#include \"" + Shader.Path + "\"\n";
+
+		remove(Out.c_str());
+		std::string Command = pCompile->Compiler;
+		Replace(Command, "%profile%", Shader.bVertex ? "vs_3_0" : "ps_3_0");
+		Replace(Command, "%in%", "\"" + In + "\"");
+		Replace(Command, "%out%", "\"" + Out + "\"");
+
+		std::string Listing;
+		if (!LuxWriteFile(In.c_str(), Wrapper))
+			Job.Cost.Error = "Can't write " + In;
+		else if (system(Command.c_str()) != 0 || !LuxReadFile(Out.c_str(), Listing))
+			Job.Cost.Error = "Compile failed ( " + Shader.Combos.Describe(Values) + " )";
+		else if (!ParseListing(Listing, Job.Cost))
+			Job.Cost.Error = "No SM3 Listing in the Compiler Output";
+		else
+			Job.Cost.bOk = true;
+	}
+	remove(In.c_str());
+	remove(Out.c_str());
+}
+
+static bool ReadList(const char *pPath, std::vector<std::string> &Files)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = LuxTrim(Data.substr(nStart, nEnd - nStart));
+		nStart = nEnd + 1;
+		if (!Line.empty() && Line.compare(0, 2, "//"))
+			Files.push_back(Line);
+	}
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	if (CommandLine.HasParm("-selftest"))
+		return SelfTest(CommandLine.ParmValue("-selftest", "lux_shadercost_selftest.asm"));
+
+	std::string FxcDir = CommandLine.ParmValue("-fxc", "../../shaders/fxc");
+	if (!FxcDir.empty() && FxcDir[FxcDir.size() - 1] != '/' && FxcDir[FxcDir.size() - 1] != '\\')
+		FxcDir += '/';
+	std::string BaselinePath = CommandLine.ParmValue("-baseline", (FxcDir + "lux_shadercost_baseline.txt").c_str());
+	const char *pList = CommandLine.ParmValue("-list", "../../compile_all_shaders.txt");
+	float flThreshold = std::max(0.0f, CommandLine.ParmValue("-threshold", 2.0f));
+	int nThreads = std::max(1, CommandLine.ParmValue("-threads", (int)std::thread::hardware_concurrency()));
+	bool bUpdate = CommandLine.HasParm("-update");
+	bool bVerbose = CommandLine.HasParm("-verbose");
+
+	std::vector<std::string> Files;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-baseline" || Arg == "-list" || Arg == "-compiler" || Arg == "-compiler_version" || Arg == "-threshold" || Arg == "-threads" || Arg == "-temp") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+			Files.push_back(Arg);
+	}
+	if (Files.empty() && !ReadList(pList, Files))
+	{
+		fprintf(stderr, "Usage: lux_shadercost [-fxc dir] [-list compile_all_shaders.txt] [-compiler \"cmd %%profile%% %%in%% %%out%%\"] [-compiler_version \"cmd\"] [-baseline file] [-threshold percent] [-threads N] [-update] [-verbose] <shader.fxc> ..\n");
+		return 1;
+	}
+
+	std::vector<Shader_t> Shaders;
+	std::vector<Job_t> Jobs;
+	for (size_t nFile = 0; nFile < Files.size(); nFile++)
+	{
+		Shader_t Shader;
+		std::string Path = Files[nFile].find('/') == std::string::npos && Files[nFile].find('\\') == std::string::npos ? FxcDir + Files[nFile] : Files[nFile];
+		std::string Source;
+		if (!LuxReadFile(Path.c_str(), Source) || !Shader.Combos.Parse(Source))
+		{
+			fprintf(stderr, "Can't read the Combos of %s\n", Path.c_str());
+			return 1;
+		}
+		Shader.Path = AbsolutePath(Path);
+		Shader.Name = LuxFileNameOf(Path);
+		if (Shader.Name.size() > 4 && Shader.Name.compare(Shader.Name.size() - 4, 4, ".fxc") == 0)
+			Shader.Name.resize(Shader.Name.size() - 4);
+		Shader.bVertex = Shader.Name.find("_vs") != std::string::npos;
+
+		std::vector<int> Values;
+		for (int64_t nIndex = 0; nIndex < Shader.Combos.NumIndices(); nIndex++)
+		{
+			Shader.Combos.Decode(nIndex, Values);
+			if (Shader.Combos.IsSkipped(Values))
+				continue;
+			Job_t Job;
+			Job.nShader = Shaders.size();
+			Job.nIndex = nIndex;
+			Jobs.push_back(Job);
+		}
+		Shaders.push_back(Shader);
+	}
+
+	// Before compiling anything, a Baseline from another Compiler makes the whole Run pointless
+	std::string Compiler, BaselineCompiler;
+	if (!CompilerVersion(CommandLine.ParmValue("-compiler_version", s_pDefaultCompilerVersion), Compiler))
+	{
+		fprintf(stderr, "Can't tell which Compiler this is, -compiler_version should print its Name and Version\n");
+		return 1;
+	}
+	printf("Compiler : %s\n", Compiler.c_str());
+
+	CostMap_t Baseline;
+	bool bBaseline = LoadBaseline(BaselinePath.c_str(), Baseline, BaselineCompiler);
+	if (bBaseline && BaselineCompiler != Compiler)
+	{
+		if (!bUpdate)
+		{
+			fprintf(stderr, "%s is from \"%s\", refusing to compare against \"%s\". -update starts a new Baseline\n",
+				BaselinePath.c_str(), BaselineCompiler.empty() ? "an unknown Compiler" : BaselineCompiler.c_str(), Compiler.c_str());
+			return 1;
+		}
+		printf("%s is from \"%s\", replacing it\n", BaselinePath.c_str(), BaselineCompiler.c_str());
+		Baseline.clear();
+		bBaseline = false;
+	}
+	if (!bBaseline && !bUpdate)
+		printf("No Baseline at %s, only the SM3.0 Limits are checked. -update writes one\n", BaselinePath.c_str());
+
+	Compile_t Compile;
+	Compile.pShaders = &Shaders;
+	Compile.pJobs = &Jobs;
+	Compile.Compiler = CommandLine.ParmValue("-compiler", s_pDefaultCompiler);
+	Compile.TempDir = CommandLine.ParmValue("-temp", ".");
+	if (!Compile.TempDir.empty() && Compile.TempDir[Compile.TempDir.size() - 1] != '/' && Compile.TempDir[Compile.TempDir.size() - 1] != '\\')
+		Compile.TempDir += '/';
+	Compile.TempDir += "lux_shadercost_";
+	Compile.nNext = 0;
+
+	double flStart = LuxTimeSeconds();
+	std::vector<std::thread> Threads;
+	for (int n = 0; n < nThreads; n++)
+		Threads.push_back(std::thread(CompileThread, &Compile, n));
+	for (size_t n = 0; n < Threads.size(); n++)
+		Threads[n].join();
+	printf("%d Combos compiled in %.2f s\n", (int)Jobs.size(), LuxTimeSeconds() - flStart);
+
+	// Per Shader : Failures, Regressions, Averages and Maxima
+	int nFailed = 0, nRegressed = 0, nNew = 0;
+	for (size_t nShader = 0; nShader < Shaders.size(); nShader++)
+	{
+		const Shader_t &Shader = Shaders[nShader];
+		const int nLimits[COST_COUNT] = { 0, 0, 0, 32, Shader.bVertex ? 256 : 224, Shader.bVertex ? 4 : 16 };
+		const char *pLimitNames[COST_COUNT] = { "", "", "", "Temps", "Constant Registers", "Sampler Registers" };
+		double flTotal[COST_COUNT] = {};
+		int nMax[COST_COUNT] = {}, nCompiled = 0;
+		std::vector<int> Values;
+
+		for (size_t nJob = 0; nJob < Jobs.size(); nJob++)
+		{
+			const Job_t &Job = Jobs[nJob];
+			if (Job.nShader != nShader)
+				continue;
+
+			Shader.Combos.Decode(Job.nIndex, Values);
+			if (!Job.Cost.bOk)
+			{
+				if (!nFailed || bVerbose)
+					printf("%s %lld : %s\n", Shader.Name.c_str(), (long long)Job.nIndex, Job.Cost.Error.c_str());
+				nFailed++;
+				continue;
+			}
+
+			nCompiled++;
+			std::string Problems;
+			char szProblem[192];
+			if (Job.Cost.Slots() > 512)
+			{
+				snprintf(szProblem, sizeof(szProblem), " %d Slots > 512", Job.Cost.Slots());
+				Problems += szProblem;
+			}
+			const int nUsed[COST_COUNT] = { 0, 0, 0, Job.Cost.nCounts[COST_TEMPS], Job.Cost.nConstantRange, Job.Cost.nSamplerRange };
+			for (int n = 0; n < COST_COUNT; n++)
+			{
+				flTotal[n] += Job.Cost.nCounts[n];
+				nMax[n] = std::max(nMax[n], Job.Cost.nCounts[n]);
+				if (nLimits[n] && nUsed[n] > nLimits[n])
+				{
+					snprintf(szProblem, sizeof(szProblem), " %d %s > %d", nUsed[n], pLimitNames[n], nLimits[n]);
+					Problems += szProblem;
+				}
+			}
+			if (!Problems.empty())
+			{
+				printf("%s %lld ( %s ) exceeds SM3.0 :%s\n", Shader.Name.c_str(), (long long)Job.nIndex, Shader.Combos.Describe(Values).c_str(), Problems.c_str());
+				nFailed++;
+			}
+
+			std::pair<std::string, int64_t> Key(Shader.Name, Job.nIndex);
+			CostMap_t::iterator Base = Baseline.find(Key);
+			if (Base == Baseline.end())
+			{
+				if (bBaseline && bVerbose)
+					printf("%s %lld : not in the Baseline\n", Shader.Name.c_str(), (long long)Job.nIndex);
+				nNew++;
+			}
+			else
+			{
+				std::string Growth;
+				for (int n = 0; n < COST_COUNT; n++)
+				{
+					int nOld = Base->second.nCounts[n], nNow = Job.Cost.nCounts[n];
+					if (nNow > nOld * (1.0f + flThreshold * 0.01f))
+					{
+						snprintf(szProblem, sizeof(szProblem), " %s %d -> %d", s_pCostNames[n], nOld, nNow);
+						Growth += szProblem;
+					}
+				}
+				if (!Growth.empty())
+				{
+					if (!bUpdate)
+						printf("%s %lld ( %s ) grew :%s\n", Shader.Name.c_str(), (long long)Job.nIndex, Shader.Combos.Describe(Values).c_str(), Growth.c_str());
+					nRegressed++;
+				}
+			}
+			if (bUpdate)
+				Baseline[Key] = Job.Cost;
+		}
+
+		printf("%-32s %6d Combos", Shader.Name.c_str(), nCompiled);
+		for (int n = 0; n < COST_COUNT; n++)
+			printf("  %s %.1f / %d", s_pCostNames[n], nCompiled ? flTotal[n] / nCompiled : 0.0, nMax[n]);
+		printf("   ( Average / Max )\n");
+	}
+
+	if (bUpdate)
+	{
+		if (!SaveBaseline(BaselinePath.c_str(), Baseline, Compiler))
+		{
+			fprintf(stderr, "Can't write %s\n", BaselinePath.c_str());
+			return 1;
+		}
+		printf("Baseline written to %s, %d Combos grew, %d new\n", BaselinePath.c_str(), nRegressed, nNew);
+		return nFailed ? 1 : 0;
+	}
+
+	printf("%d failed, %d grew more than %.1f%%, %d not in the Baseline\n", nFailed, nRegressed, flThreshold, nNew);
+	return nFailed || nRegressed ? 1 : 0;
+}
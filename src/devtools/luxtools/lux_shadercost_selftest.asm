@@ -0,0 +1,44 @@
+//
+// Fixture for lux_shadercost -selftest, a hand-written fxc /Fc Listing with everything ParseListing() has to get right :
+// Source Modifiers right after the Register ( c3_abs is the only Use of c3 ), Instruction Modifiers, Predication,
+// relative Addressing, def'd Constants and Output Registers that aren't Constants ( oC0 ).
+//
+// lux_shadercost -selftest expects : alu 9 tex 2 flow 2 temps 4 constants 4 samplers 2 slots 13
+//
+// Parameters:
+//
+//   float4 cEnvMapTint;
+//   sampler2D Sampler_BaseTexture;
+//   samplerCUBE Sampler_EnvironmentMap;
+//
+//
+// Registers:
+//
+//   Name                   Reg   Size
+//   ---------------------- ----- ----
+//   cEnvMapTint            c37      1
+//   Sampler_BaseTexture    s0       1
+//   Sampler_EnvironmentMap s14      1
+//
+
+    ps_3_0
+    def c0, 1, 0, 0.5, 2
+    dcl_texcoord v0.xy
+    dcl_texcoord1 v1.xyz
+    dcl_2d s0
+    dcl_cube s14
+    texld r0, v0, s0
+    texld_pp r1, v1, s14
+    mul r2.xyz, r0, c37
+    mad_sat r2.xyz, r1_abs, c3_abs, r2
+    add r3.x, -r2_abs.x, c0.x
+    if_lt r3.x, c0.y
+      mov r3.x, c0.z
+    endif
+    setp_gt p0.x, r3.x, c0.y
+    (p0.x) mul r2.xyz, r2, r3.x
+    mova a0.x, c0.x
+    mov oC0.xyz, r2
+    mov oC0.w, c38[a0.x].w
+
+// approximately 13 instruction slots used (2 texture, 11 arithmetic)
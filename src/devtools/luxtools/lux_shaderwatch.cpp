@@ -0,0 +1,585 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Watches the Shader Sources and recompiles only the Combos a Change affects
+//
+//	Every Combo of every watched Shader is preprocessed once ( luxtools_fxc.h ), which gives the Files it
+//	really includes : the .fxc, lux_common_*.h, the Register Maps, only through the #if Branches that Combo takes.
+//	On a Change ( inotify on Linux, polled Timestamps elsewhere ) the affected Combos go to a Worker Pool
+//	( luxtools_workerpool.h ) that stays up between Changes, so there's no Startup per Edit.
+//
+//	Combos listed in -mru ( "<shader> <combo index>" per Line, most recent first, what the Game drew last )
+//	are compiled and published first, the Rest follows longest predicted first ( -times, luxtools_compiletimes.h ).
+//	Each Blob is written to <out>/<shader>/<combo index>.bin through a temporary File and a Rename, so a
+//	running Game never reads half a Blob. <out>/lux_hotreload.txt is replaced last, that's the one File the Game
+//	has to poll : "generation N", then every Blob published since Startup as "<shader>/<combo index>.bin G",
+//	G being the Generation it last changed in. The Game reloads everything newer than the Generation it saw last,
+//	so skipping a Generation or two between Polls loses nothing.
+//	Only .fxc and .h Files are watched, the Compile Times this writes next to the Sources don't trigger anything.
+//
+//	Usage :	lux_shaderwatch [-fxc ../../shaders/fxc] [-list ../../compile_all_shaders.txt] [-out hotreload]
+//			[-workers N] [-backend d3d|stub] [-mru file] [-times <fxc>/lux_compiletimes.txt] [-once] <shader.fxc> ..
+//			-once		Exits after the first Batch, for Scripts
+//
+//==========================================================================//
+
+#include "luxtools_fxc.h"
+#include "luxtools_workerpool.h"
+#include "luxtools_compiletimes.h"
+
+#include <limits.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+struct Shader_t
+{
+	std::string Name;					// Without .fxc
+	std::string Path;
+	CLuxComboSet Combos;
+	std::vector<int64_t> Indices;		// Combos that aren't SKIPped
+	std::vector<int> Includes;			// Per Combo, into IncludeSets
+	std::vector<std::set<std::string> > IncludeSets;	// File Names, shared between Combos with the same Includes
+	uint32_t nPoolShader;
+};
+
+static std::string ShaderName(const std::string &Path)
+{
+	std::string Name = LuxFileNameOf(Path);
+	if (Name.size() > 4 && Name.compare(Name.size() - 4, 4, ".fxc") == 0)
+		Name.resize(Name.size() - 4);
+	return Name;
+}
+
+static bool ReadList(const char *pPath, std::vector<std::string> &Files)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data))
+		return false;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		std::string Line = LuxTrim(Data.substr(nStart, nEnd - nStart));
+		nStart = nEnd + 1;
+		if (!Line.empty() && Line.compare(0, 2, "//"))
+			Files.push_back(Line);
+	}
+	return true;
+}
+
+// Re-reads the Combos and the Include Graph. The Cache is fresh, so Edits are seen
+static bool LoadShader(Shader_t &Shader, const std::string &FxcDir)
+{
+	std::string Source;
+	CLuxComboSet Combos;
+	if (!LuxReadFile(Shader.Path.c_str(), Source) || !Combos.Parse(Source))
+		return false;
+
+	Shader.Combos = Combos;
+	Shader.Indices.clear();
+	Shader.Includes.clear();
+	Shader.IncludeSets.clear();
+
+	bool bVertex = Shader.Name.find("_vs") != std::string::npos;
+	CLuxSourceCache Cache;
+	std::map<std::set<std::string>, int> SetIDs;
+	std::vector<int> Values;
+	for (int64_t nIndex = 0; nIndex < Combos.NumIndices(); nIndex++)
+	{
+		Combos.Decode(nIndex, Values);
+		if (Combos.IsSkipped(Values))
+			continue;
+
+		CLuxPreprocessor PP(&Cache);
+		PP.AddIncludeDir(FxcDir);
+		PP.Define(bVertex ? "SHADER_MODEL_VS_3_0" : "SHADER_MODEL_PS_3_0", "1");
+		for (int n = 0; n < Combos.NumCombos(); n++)
+		{
+			char szValue[16];
+			snprintf(szValue, sizeof(szValue), "%d", Values[n]);
+			PP.Define(Combos.Combo(n).Name, szValue);
+		}
+		PP.Run(Shader.Path);
+
+		std::set<std::string> Files;
+		for (size_t n = 0; n < PP.Files().size(); n++)
+			Files.insert(LuxFileNameOf(PP.Files()[n]));
+
+		std::map<std::set<std::string>, int>::iterator It = SetIDs.find(Files);
+		if (It == SetIDs.end())
+		{
+			It = SetIDs.insert(std::make_pair(Files, (int)Shader.IncludeSets.size())).first;
+			Shader.IncludeSets.push_back(Files);
+		}
+		Shader.Indices.push_back(nIndex);
+		Shader.Includes.push_back(It->second);
+	}
+	return true;
+}
+
+// Combo Indices whose Includes have one of the Files
+static void Affected(const Shader_t &Shader, const std::set<std::string> &Changed, std::set<int64_t> &Indices)
+{
+	std::vector<bool> Hit(Shader.IncludeSets.size(), false);
+	for (size_t nSet = 0; nSet < Shader.IncludeSets.size(); nSet++)
+	{
+		for (std::set<std::string>::const_iterator It = Changed.begin(); It != Changed.end() && !Hit[nSet]; ++It)
+			Hit[nSet] = Shader.IncludeSets[nSet].count(*It) != 0;
+	}
+	for (size_t n = 0; n < Shader.Indices.size(); n++)
+	{
+		if (Hit[Shader.Includes[n]])
+			Indices.insert(Shader.Indices[n]);
+	}
+}
+
+//==========================================================================//
+// Publishing. Rename is atomic, a Reader sees the old or the new File, never a Mix
+//==========================================================================//
+static void MakeDirectory(const std::string &Path)
+{
+#ifdef _WIN32
+	CreateDirectoryA(Path.c_str(), NULL);
+#else
+	mkdir(Path.c_str(), 0755);
+#endif
+}
+
+static bool PublishFile(const std::string &Path, const std::string &Data)
+{
+	std::string Temp = Path + ".tmp";
+	if (!LuxWriteFile(Temp.c_str(), Data))
+		return false;
+#ifdef _WIN32
+	return MoveFileExA(Temp.c_str(), Path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(Temp.c_str(), Path.c_str()) == 0;
+#endif
+}
+
+//==========================================================================//
+// Watching
+//==========================================================================//
+// Everything else in the Directories is Output, ours or the Build's
+static bool IsSourceFile(const std::string &Name)
+{
+	size_t nDot = Name.rfind('.');
+	return nDot != std::string::npos && (Name.compare(nDot, std::string::npos, ".fxc") == 0 || Name.compare(nDot, std::string::npos, ".h") == 0);
+}
+
+class CWatcher
+{
+public:
+	CWatcher(const std::vector<std::string> &Dirs) : m_Dirs(Dirs)
+	{
+#ifdef __linux__
+		m_nFD = inotify_init1(IN_NONBLOCK);
+		for (size_t n = 0; n < Dirs.size() && m_nFD >= 0; n++)
+			inotify_add_watch(m_nFD, Dirs[n].c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+#endif
+		Poll(m_Times);
+	}
+
+	~CWatcher()
+	{
+#ifdef __linux__
+		if (m_nFD >= 0)
+			close(m_nFD);
+#endif
+	}
+
+	// Blocks until something changed, then waits until the Files have been quiet for a Moment,
+	// Editors write in Bursts. Returns File Names
+	void Wait(std::set<std::string> &Changed)
+	{
+		Changed.clear();
+		while (Changed.empty())
+			Collect(Changed, 1000);
+
+		std::set<std::string> More;
+		do
+		{
+			More.clear();
+			Collect(More, 100);
+			Changed.insert(More.begin(), More.end());
+		} while (!More.empty());
+	}
+
+private:
+	void Collect(std::set<std::string> &Changed, int nTimeoutMs)
+	{
+#ifdef __linux__
+		if (m_nFD >= 0)
+		{
+			struct pollfd Poll = { m_nFD, POLLIN, 0 };
+			if (poll(&Poll, 1, nTimeoutMs) <= 0)
+				return;
+
+			char Buffer[16384];
+			ssize_t nRead;
+			while ((nRead = read(m_nFD, Buffer, sizeof(Buffer))) > 0)
+			{
+				for (char *p = Buffer; p < Buffer + nRead; )
+				{
+					struct inotify_event *pEvent = (struct inotify_event *)p;
+					if (pEvent->len && !(pEvent->mask & IN_ISDIR) && IsSourceFile(pEvent->name))
+						Changed.insert(pEvent->name);
+					p += sizeof(struct inotify_event) + pEvent->len;
+				}
+			}
+			return;
+		}
+#endif
+		std::this_thread::sleep_for(std::chrono::milliseconds(std::min(nTimeoutMs, 200)));
+		std::map<std::string, int64_t> Times;
+		Poll(Times);
+		for (std::map<std::string, int64_t>::const_iterator It = Times.begin(); It != Times.end(); ++It)
+		{
+			std::map<std::string, int64_t>::const_iterator Old = m_Times.find(It->first);
+			if (Old == m_Times.end() || Old->second != It->second)
+				Changed.insert(LuxFileNameOf(It->first));
+		}
+		m_Times.swap(Times);
+	}
+
+	// Without inotify : Timestamps of every Source File
+	void Poll(std::map<std::string, int64_t> &Times)
+	{
+		std::vector<std::string> Files;
+		for (size_t n = 0; n < m_Dirs.size(); n++)
+		{
+			LuxFindFiles(m_Dirs[n], ".fxc", Files);
+			LuxFindFiles(m_Dirs[n], ".h", Files);
+		}
+		for (size_t n = 0; n < Files.size(); n++)
+		{
+			struct stat Info;
+			if (stat(Files[n].c_str(), &Info) == 0)
+				Times[Files[n]] = (int64_t)Info.st_mtime * 1000000000 + (int64_t)Info.st_size;
+		}
+	}
+
+	std::vector<std::string> m_Dirs;
+	std::map<std::string, int64_t> m_Times;
+#ifdef __linux__
+	int m_nFD;
+#endif
+};
+
+//==========================================================================//
+// Recompile
+//==========================================================================//
+struct Job_t
+{
+	size_t nShader;
+	int64_t nIndex;
+	int nRank;			// In the MRU List, or INT_MAX
+	float flPredicted;
+};
+
+// "<shader> <combo index>" per Line, most recent first
+static void LoadMRU(const char *pPath, std::map<std::pair<std::string, int64_t>, int> &Ranks)
+{
+	Ranks.clear();
+	std::string Data;
+	if (!pPath || !LuxReadFile(pPath, Data))
+		return;
+
+	size_t nStart = 0;
+	while (nStart < Data.size())
+	{
+		size_t nEnd = Data.find('\n', nStart);
+		if (nEnd == std::string::npos)
+			nEnd = Data.size();
+		char szShader[256];
+		long long nIndex;
+		if (sscanf(Data.substr(nStart, nEnd - nStart).c_str(), "%255s %lld", szShader, &nIndex) == 2)
+		{
+			std::pair<std::string, int64_t> Key(ShaderName(szShader), nIndex);
+			if (!Ranks.count(Key))
+				Ranks[Key] = (int)Ranks.size();
+		}
+		nStart = nEnd + 1;
+	}
+}
+
+class CRecompiler
+{
+public:
+	CRecompiler(CLuxWorkerPool &Pool, std::vector<Shader_t> &Shaders, const std::string &OutDir, const char *pTimes)
+		: m_Pool(Pool), m_Shaders(Shaders), m_OutDir(OutDir), m_pTimes(pTimes), m_nGeneration(0)
+	{
+		m_Times.Load(pTimes);
+		MakeDirectory(OutDir);
+		for (size_t n = 0; n < Shaders.size(); n++)
+		{
+			SetLayout(Shaders[n]);
+			MakeDirectory(OutDir + Shaders[n].Name);
+		}
+	}
+
+	// After the Declarations were read, again on every Reload
+	void SetLayout(const Shader_t &Shader)
+	{
+		if (m_Times.SetLayout(Shader.Name, Shader.Combos.NumDynamicIndices(), Shader.Combos.LayoutHash()))
+			printf("%s : Combo Declarations changed, dropped its Compile Time History\n", Shader.Name.c_str());
+	}
+
+	// Two Batches : MRU Combos, then the Rest. flSince is when the Change was seen
+	void Run(std::vector<Job_t> &Jobs, double flSince)
+	{
+		std::stable_sort(Jobs.begin(), Jobs.end(), [](const Job_t &a, const Job_t &b)
+		{
+			return a.nRank != b.nRank ? a.nRank < b.nRank : a.flPredicted > b.flPredicted;
+		});
+
+		size_t nMRU = 0;
+		while (nMRU < Jobs.size() && Jobs[nMRU].nRank != INT_MAX)
+			nMRU++;
+
+		m_nGeneration++;
+		int nFailed = 0;
+		if (nMRU)
+		{
+			std::vector<Job_t> First(Jobs.begin(), Jobs.begin() + nMRU);
+			nFailed += Compile(First);
+			printf("  %d recently used Combos published after %.2f s\n", (int)nMRU, LuxTimeSeconds() - flSince);
+		}
+		if (nMRU < Jobs.size())
+		{
+			std::vector<Job_t> Rest(Jobs.begin() + nMRU, Jobs.end());
+			nFailed += Compile(Rest);
+		}
+
+		m_Times.Rebuild();
+		m_Times.Save(m_pTimes);
+		printf("  %d Combos, %d failed, all published after %.2f s ( Generation %d )\n", (int)Jobs.size(), nFailed, LuxTimeSeconds() - flSince, m_nGeneration);
+	}
+
+	const CLuxCompileTimes &Times() const { return m_Times; }
+
+private:
+	int Compile(const std::vector<Job_t> &Jobs)
+	{
+		std::vector<LuxWorkerJob_t> WorkerJobs(Jobs.size());
+		for (size_t n = 0; n < Jobs.size(); n++)
+		{
+			const Shader_t &Shader = m_Shaders[Jobs[n].nShader];
+			WorkerJobs[n].nShader = Shader.nPoolShader;
+			Shader.Combos.Decode(Jobs[n].nIndex, WorkerJobs[n].Values);
+		}
+		m_Pool.Run(WorkerJobs);
+
+		int nFailed = 0;
+		for (size_t n = 0; n < Jobs.size(); n++)
+		{
+			const Shader_t &Shader = m_Shaders[Jobs[n].nShader];
+			if (!WorkerJobs[n].bOk)
+			{
+				if (!nFailed)
+					printf("%s : Combo %lld ( %s ) failed :\n%s\n", Shader.Name.c_str(), (long long)Jobs[n].nIndex, Shader.Combos.Describe(WorkerJobs[n].Values).c_str(), WorkerJobs[n].Out.c_str());
+				nFailed++;
+				continue;
+			}
+
+			char szFile[64];
+			snprintf(szFile, sizeof(szFile), "/%lld.bin", (long long)Jobs[n].nIndex);
+			if (!PublishFile(m_OutDir + Shader.Name + szFile, WorkerJobs[n].Out))
+				fprintf(stderr, "Can't publish %s%s\n", Shader.Name.c_str(), szFile);
+			m_Times.Record(Shader.Name, Jobs[n].nIndex, WorkerJobs[n].flSeconds);
+			m_Published[Shader.Name + szFile] = m_nGeneration;
+		}
+
+		// The Game polls this one, it goes last. Every Blob since Startup, so a missed Generation is still in here
+		char szLine[512];
+		snprintf(szLine, sizeof(szLine), "generation %d\n", m_nGeneration);
+		std::string Manifest = szLine;
+		for (std::map<std::string, int>::const_iterator It = m_Published.begin(); It != m_Published.end(); ++It)
+		{
+			snprintf(szLine, sizeof(szLine), "%s %d\n", It->first.c_str(), It->second);
+			Manifest += szLine;
+		}
+		PublishFile(m_OutDir + "lux_hotreload.txt", Manifest);
+		return nFailed;
+	}
+
+	CLuxWorkerPool &m_Pool;
+	std::vector<Shader_t> &m_Shaders;
+	std::string m_OutDir;
+	const char *m_pTimes;
+	CLuxCompileTimes m_Times;
+	std::map<std::string, int> m_Published;	// Blob to the Generation it last changed in
+	int m_nGeneration;
+};
+
+static std::string WithSeparator(std::string Dir)
+{
+	if (!Dir.empty() && Dir[Dir.size() - 1] != '/' && Dir[Dir.size() - 1] != '\\')
+		Dir += '/';
+	return Dir;
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	if (CommandLine.HasParm("-worker"))
+	{
+		fprintf(stderr, "lux_shaderwatch starts lux_compilepool Workers, it isn't one\n");
+		return 1;
+	}
+
+	std::string FxcDir = WithSeparator(CommandLine.ParmValue("-fxc", "../../shaders/fxc"));
+	std::string OutDir = WithSeparator(CommandLine.ParmValue("-out", "hotreload"));
+	const char *pList = CommandLine.ParmValue("-list", "../../compile_all_shaders.txt");
+	const char *pMRU = CommandLine.ParmValue("-mru", (const char *)NULL);
+	std::string TimesPath = CommandLine.ParmValue("-times", (FxcDir + "lux_compiletimes.txt").c_str());
+	const char *pTimes = TimesPath.c_str();
+	int nWorkers = std::max(1, CommandLine.ParmValue("-workers", (int)std::thread::hardware_concurrency()));
+	bool bOnce = CommandLine.HasParm("-once");
+
+	std::vector<std::string> Files;
+	for (int n = 1; n < argc; n++)
+	{
+		std::string Arg = argv[n];
+		if ((Arg == "-fxc" || Arg == "-out" || Arg == "-list" || Arg == "-mru" || Arg == "-times" || Arg == "-workers" || Arg == "-backend" ||
+			Arg == "-compilepool" || Arg == "-load_ms" || Arg == "-compile_us" || Arg == "-bytes") && n + 1 < argc)
+			n++;
+		else if (Arg[0] != '-')
+			Files.push_back(Arg);
+	}
+	if (Files.empty() && !ReadList(pList, Files))
+	{
+		fprintf(stderr, "Usage: lux_shaderwatch [-fxc dir] [-list compile_all_shaders.txt] [-out dir] [-workers N] [-backend d3d|stub] [-mru file] [-times file] [-once] <shader.fxc> ..\n");
+		return 1;
+	}
+
+	// Include Graphs
+	double flStart = LuxTimeSeconds();
+	std::vector<Shader_t> Shaders;
+	for (size_t n = 0; n < Files.size(); n++)
+	{
+		Shader_t Shader;
+		Shader.Path = Files[n].find('/') == std::string::npos && Files[n].find('\\') == std::string::npos ? FxcDir + Files[n] : Files[n];
+		Shader.Name = ShaderName(Shader.Path);
+		Shader.nPoolShader = (uint32_t)Shaders.size();
+		if (!LoadShader(Shader, FxcDir))
+		{
+			fprintf(stderr, "Can't read the Combos of %s\n", Shader.Path.c_str());
+			return 1;
+		}
+		printf("%-32s %6d Combos, %d distinct Include Sets\n", Shader.Name.c_str(), (int)Shader.Indices.size(), (int)Shader.IncludeSets.size());
+		Shaders.push_back(Shader);
+	}
+	printf("Include Graphs in %.2f s\n", LuxTimeSeconds() - flStart);
+
+	// Workers are lux_compilepool's, this Tool doesn't link a Backend
+	std::string Executable = CommandLine.ParmValue("-compilepool", (LuxDirectoryOf(LuxExecutablePath(argv[0])) + "lux_compilepool").c_str());
+	std::vector<std::string> Args;
+	Args.push_back("-worker");
+	Args.push_back("-backend");
+	Args.push_back(CommandLine.ParmValue("-backend", "d3d"));
+	const char *pStubParms[] = { "-load_ms", "-compile_us", "-bytes" };
+	for (int n = 0; n < 3; n++)
+	{
+		if (CommandLine.HasParm(pStubParms[n]))
+		{
+			Args.push_back(pStubParms[n]);
+			Args.push_back(CommandLine.ParmValue(pStubParms[n], ""));
+		}
+	}
+
+	CLuxWorkerPool Pool;
+	std::string Error;
+	if (!Pool.Start(nWorkers, Executable, Args, Error))
+	{
+		fprintf(stderr, "Can't start the Pool ( %s ) : %s\n", Executable.c_str(), Error.c_str());
+		return 1;
+	}
+
+	CRecompiler Recompiler(Pool, Shaders, OutDir, pTimes);
+	std::vector<std::string> Dirs(1, FxcDir);
+	CWatcher Watcher(Dirs);
+	printf("Watching %s, %d Workers\n", FxcDir.c_str(), Pool.NumWorkers());
+
+	std::set<std::string> Changed;
+	while (true)
+	{
+		Watcher.Wait(Changed);
+		double flSeen = LuxTimeSeconds();
+
+		std::map<std::pair<std::string, int64_t>, int> Ranks;
+		LoadMRU(pMRU, Ranks);
+
+		std::vector<Job_t> Jobs;
+		std::string Names;
+		for (std::set<std::string>::const_iterator It = Changed.begin(); It != Changed.end(); ++It)
+			Names += (Names.empty() ? "" : ", ") + *It;
+
+		for (size_t nShader = 0; nShader < Shaders.size(); nShader++)
+		{
+			Shader_t &Shader = Shaders[nShader];
+
+			// Old and new Graph, an Edit can add or drop Includes
+			std::set<int64_t> Indices;
+			Affected(Shader, Changed, Indices);
+			if (Indices.empty() && !Changed.count(LuxFileNameOf(Shader.Path)))
+				continue;
+
+			if (!LoadShader(Shader, FxcDir))
+			{
+				fprintf(stderr, "Can't read the Combos of %s, keeping the old Blobs\n", Shader.Path.c_str());
+				continue;
+			}
+
+			// Declarations may have moved, the Workers get the Shader again
+			LuxWorkerShader_t WorkerShader;
+			WorkerShader.Path = Shader.Path;
+			WorkerShader.Target = Shader.Name.find("_vs") != std::string::npos ? "vs_3_0" : "ps_3_0";
+			for (int n = 0; n < Shader.Combos.NumCombos(); n++)
+				WorkerShader.Combos.push_back(Shader.Combos.Combo(n).Name);
+			Pool.AddShader(Shader.nPoolShader, WorkerShader);
+			Recompiler.SetLayout(Shader);
+
+			if (Changed.count(LuxFileNameOf(Shader.Path)))
+				Indices.insert(Shader.Indices.begin(), Shader.Indices.end());
+			else
+				Affected(Shader, Changed, Indices);
+
+			// Only Combos that still exist
+			std::set<int64_t> Live(Shader.Indices.begin(), Shader.Indices.end());
+			for (std::set<int64_t>::const_iterator It = Indices.begin(); It != Indices.end(); ++It)
+			{
+				if (!Live.count(*It))
+					continue;
+				Job_t Job;
+				Job.nShader = nShader;
+				Job.nIndex = *It;
+				std::map<std::pair<std::string, int64_t>, int>::const_iterator Rank = Ranks.find(std::make_pair(Shader.Name, *It));
+				Job.nRank = Rank == Ranks.end() ? INT_MAX : Rank->second;
+				Job.flPredicted = Recompiler.Times().Predict(Shader.Name, *It);
+				Jobs.push_back(Job);
+			}
+		}
+
+		printf("%s changed : %d Combos affected\n", Names.c_str(), (int)Jobs.size());
+		if (!Jobs.empty())
+			Recompiler.Run(Jobs, flSeen);
+		fflush(stdout);
+
+		if (bOnce)
+			break;
+	}
+	return 0;
+}
@@ -0,0 +1,187 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Checks LuxSpline_Evaluate() from cpp_lux_splinecache.h against the Shader's Spline
+//
+//	The Cache replaces CatmullRomSpline() and DCatmullRomSpline3() from lux_common_spline.h with an expanded
+//	Polynomial, four t's per SIMD Op. Random Ropes go through both : every Vertex Position ( Width included ),
+//	Tangent and Rope t is compared against the scalar Functions, with the same duplicated End Points.
+//	Also checks the Vertex Count and that nothing is written past LuxSpline_NumVertices().
+//
+//	Errors are relative to the largest Control Point Coordinate of the Rope, Ropes span a whole Map.
+//
+//	Usage :	lux_splinecache_check [-ropes 20000] [-seed 1] [-tolerance 1e-5]
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#define LUX_SPLINECACHE_CORE_ONLY
+#include "../../shaders/fxc/cpp_lux_splinecache.h"
+
+//==========================================================================//
+// lux_common_spline.h, per Component. The HLSL is componentwise anyway
+//==========================================================================//
+static float DCatmullRomSpline3(float a, float b, float c, float d, float t)
+{
+	return 0.5f * ( c - a + t * ( 2.0f * a - 5.0f * b + 4.0f * c - d + t * (3.0f * b - a - 3.0f * c + d ) )
+				 + t * ( 2.0f * a - 5.0f * b + 4.0f * c - d + 2.0f * ( t * ( 3.0f * b - a - 3.0f * c + d ) ) ) );
+}
+
+static float CatmullRomSpline(float a, float b, float c, float d, float t)
+{
+	return b + 0.5f * t * ( c - a + t * ( 2.0f * a - 5.0f * b + 4.0f * c - d + t * ( -a + 3.0f * b - 3.0f * c + d ) ) );
+}
+
+// What the Spline VS computes for the Rope, same Vertex Order as LuxSpline_Evaluate()
+static void ReferenceRope(const std::vector<LuxSplinePoint_t> &Points, int nSubdivisions, std::vector<LuxSplineVertex_t> &Out)
+{
+	Out.clear();
+	int nPoints = (int)Points.size();
+	for (int nSegment = 0; nSegment < nPoints - 1; nSegment++)
+	{
+		const float *a = Points[std::max(nSegment - 1, 0)].m_fl;
+		const float *b = Points[nSegment].m_fl;
+		const float *c = Points[nSegment + 1].m_fl;
+		const float *d = Points[std::min(nSegment + 2, nPoints - 1)].m_fl;
+
+		int nSteps = (nSegment == nPoints - 2) ? nSubdivisions + 1 : nSubdivisions;
+		for (int nStep = 0; nStep < nSteps; nStep++)
+		{
+			float t = (float)nStep / (float)nSubdivisions;
+			LuxSplineVertex_t Vertex;
+			for (int n = 0; n < 4; n++)
+				Vertex.m_flPos[n] = CatmullRomSpline(a[n], b[n], c[n], d[n], t);
+			for (int n = 0; n < 3; n++)
+				Vertex.m_flTangent[n] = DCatmullRomSpline3(a[n], b[n], c[n], d[n], t);
+			Vertex.m_flTangent[3] = (nSegment + t) / (float)(nPoints - 1);
+			Out.push_back(Vertex);
+		}
+	}
+}
+
+//==========================================================================//
+// Random Ropes
+//==========================================================================//
+static float Range(uint32_t &nSeed, float flMin, float flMax)
+{
+	nSeed = LuxHash(nSeed);
+	return flMin + (flMax - flMin) * LuxHashFloat(nSeed);
+}
+
+// Mostly sagging Ropes between two Anchors, some Zig-Zags and coincident Points
+static void RandomRope(uint32_t nSeed, std::vector<LuxSplinePoint_t> &Points, int &nSubdivisions)
+{
+	int nPoints = 2 + (int)Range(nSeed, 0.0f, 30.0f);
+	nSubdivisions = 1 + (int)Range(nSeed, 0.0f, 24.0f);
+	float flScale = Range(nSeed, 0.0f, 1.0f) < 0.2f ? 1.0f : 4096.0f;
+
+	float3 Start(Range(nSeed, -1.0f, 1.0f), Range(nSeed, -1.0f, 1.0f), Range(nSeed, -1.0f, 1.0f));
+	float3 End(Range(nSeed, -1.0f, 1.0f), Range(nSeed, -1.0f, 1.0f), Range(nSeed, -1.0f, 1.0f));
+	float flSag = Range(nSeed, 0.0f, 0.5f);
+	float flJitter = Range(nSeed, 0.0f, 1.0f) < 0.3f ? 0.2f : 0.0f;
+
+	Points.resize(nPoints);
+	for (int n = 0; n < nPoints; n++)
+	{
+		float f = (float)n / (float)(nPoints - 1);
+		float3 Pos = lerp(Start, End, f);
+		Pos.z -= flSag * 4.0f * f * (1.0f - f);
+		Pos += float3(Range(nSeed, -flJitter, flJitter), Range(nSeed, -flJitter, flJitter), Range(nSeed, -flJitter, flJitter));
+		if (n && Range(nSeed, 0.0f, 1.0f) < 0.05f)
+			Pos = float3(Points[n - 1].m_fl[0], Points[n - 1].m_fl[1], Points[n - 1].m_fl[2]) / flScale;
+
+		Points[n].m_fl[0] = Pos.x * flScale;
+		Points[n].m_fl[1] = Pos.y * flScale;
+		Points[n].m_fl[2] = Pos.z * flScale;
+		Points[n].m_fl[3] = Range(nSeed, 0.5f, 8.0f);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nRopes = std::max(1, CommandLine.ParmValue("-ropes", 20000));
+	uint32_t nSeed = (uint32_t)CommandLine.ParmValue("-seed", 1);
+	float flTolerance = CommandLine.ParmValue("-tolerance", 1e-5f);
+
+	// Past the End, LuxSpline_Evaluate() must never touch these
+	const int nGuard = 4;
+	const float flGuard = -12345.0f;
+
+	std::vector<LuxSplinePoint_t> Points;
+	std::vector<LuxSplineVertex_t> Reference, Vertices;
+	int nMismatches = 0;
+	int64_t nVertices = 0;
+	float flMaxPos = 0.0f, flMaxTangent = 0.0f, flMaxT = 0.0f;
+
+	for (int nRope = 0; nRope < nRopes; nRope++)
+	{
+		int nSubdivisions;
+		RandomRope(LuxHash(nSeed * 1000003 + nRope), Points, nSubdivisions);
+		ReferenceRope(Points, nSubdivisions, Reference);
+
+		int nCount = LuxSpline_NumVertices((int)Points.size(), nSubdivisions);
+		LuxSplineVertex_t Guard;
+		for (int n = 0; n < 4; n++)
+			Guard.m_flPos[n] = Guard.m_flTangent[n] = flGuard;
+		Vertices.assign(nCount + nGuard, Guard);
+		LuxSpline_Evaluate(&Points[0], (int)Points.size(), nSubdivisions, &Vertices[0]);
+
+		bool bMismatch = false;
+		if (nCount != (int)Reference.size())
+		{
+			if (nMismatches < 10)
+				printf("Rope %d : %d Vertices, the Shader would have %d\n", nRope, nCount, (int)Reference.size());
+			nMismatches++;
+			continue;
+		}
+		for (int n = nCount; n < nCount + nGuard; n++)
+		{
+			if (Vertices[n].m_flPos[0] != flGuard || Vertices[n].m_flTangent[3] != flGuard)
+				bMismatch = true;
+		}
+		if (bMismatch && nMismatches < 10)
+			printf("Rope %d : written past Vertex %d\n", nRope, nCount);
+
+		float flScale = 1.0f;
+		for (size_t n = 0; n < Points.size(); n++)
+		{
+			for (int i = 0; i < 4; i++)
+				flScale = std::max(flScale, fabsf(Points[n].m_fl[i]));
+		}
+
+		for (int nVertex = 0; nVertex < nCount; nVertex++)
+		{
+			const LuxSplineVertex_t &A = Vertices[nVertex];
+			const LuxSplineVertex_t &B = Reference[nVertex];
+			float flPos = 0.0f, flTangent = 0.0f;
+			for (int n = 0; n < 4; n++)
+				flPos = std::max(flPos, fabsf(A.m_flPos[n] - B.m_flPos[n]) / flScale);
+			for (int n = 0; n < 3; n++)
+				flTangent = std::max(flTangent, fabsf(A.m_flTangent[n] - B.m_flTangent[n]) / flScale);
+			float flT = fabsf(A.m_flTangent[3] - B.m_flTangent[3]);
+
+			// NaN fails all of these
+			if (!(flPos <= flTolerance && flTangent <= flTolerance && flT <= flTolerance))
+			{
+				if (!bMismatch && nMismatches < 10)
+					printf("Rope %d, Vertex %d of %d : Position off by %g, Tangent by %g, t by %g ( relative )\n", nRope, nVertex, nCount, flPos, flTangent, flT);
+				bMismatch = true;
+			}
+			flMaxPos = std::max(flMaxPos, flPos);
+			flMaxTangent = std::max(flMaxTangent, flTangent);
+			flMaxT = std::max(flMaxT, flT);
+		}
+
+		nVertices += nCount;
+		nMismatches += bMismatch;
+	}
+
+	printf("%d Ropes, %lld Vertices. Largest Error : Position %.3g, Tangent %.3g, t %.3g ( Tolerance %.3g )\n",
+		nRopes, (long long)nVertices, flMaxPos, flMaxTangent, flMaxT, flTolerance);
+	printf("%d Mismatches\n", nMismatches);
+	return nMismatches ? 1 : 0;
+}
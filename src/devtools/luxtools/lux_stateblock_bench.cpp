@@ -0,0 +1,263 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Snapshots a synthetic World through cpp_lux_stateblock.h
+//
+//	Materials get random Parameters, weighted like a real Map ( most are plain Base + Bump ),
+//	and go through the modelshadertest Combo Keys ( include/lux_modelshadertest_*_combokey.h ).
+//	Every Snapshot is taken with and without the Cache, and each cached Block has to match the one
+//	built from Scratch, or the Key is missing something the Block depends on.
+//	Reports Hit Rate, Memory shared against one Block per Material and the Snapshot Time.
+//	"Uncached" only fills the Struct here, the real SHADOW_STATE also goes through IShaderShadow for every Call.
+//	So the Time is the Lookup against the cheapest possible Fill, the Cache has to be at least as fast as that.
+//
+//	Usage :	lux_stateblock_bench [-materials 5000] [-reloads 4] [-repeats 5] [-seed 1]
+//			-reloads	Snapshots per Material, like mat_reloadallmaterials or Map Changes would
+//			-repeats	Times are the fastest of this many Runs, the Cache starts empty for each
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+#define LUX_STATEBLOCK_CACHE_ONLY
+#include "../../shaders/fxc/cpp_lux_stateblock.h"
+#include "../../shaders/fxc/include/lux_modelshadertest_ps30_combokey.h"
+#include "../../shaders/fxc/include/lux_modelshadertest_vs30_combokey.h"
+
+#include <algorithm>
+
+// Same Numbers as cpp_lux_shared.h
+enum
+{
+	SAMPLER_BASETEXTURE = 0,
+	SAMPLER_NORMALTEXTURE = 1,
+	SAMPLER_DETAILTEXTURE = 4,
+	SAMPLER_ENVMAPMASK = 5,
+	SAMPLER_LIGHTWARP = 6,
+	SAMPLER_SELFILLUM = 13,
+	SAMPLER_ENVMAPTEXTURE = 14,
+};
+
+enum
+{
+	STATEFLAG_TRANSLUCENT = 1 << 0,
+	STATEFLAG_ADDITIVE = 1 << 1,
+	STATEFLAG_ALPHATEST = 1 << 2,
+	STATEFLAG_NOCULL = 1 << 3,
+};
+
+// What a Shader reads out of its Parameters for SHADOW_STATE
+struct Material_t
+{
+	bool bBumpMap;
+	bool bVertexColors;
+	int nEnvMap;				// 0 none, 1 Cubemap, 2 with Mask
+	bool bDetail;
+	bool bSelfIllum;
+	bool bLightWarp;
+	bool bDetailGamma;
+	int nStateFlags;
+	float flAlphaRef;			// $AlphaTestReference
+};
+
+static bool Chance(uint32_t &nSeed, float flChance)
+{
+	nSeed = LuxHash(nSeed);
+	return LuxHashFloat(nSeed) < flChance;
+}
+
+static Material_t RandomMaterial(uint32_t nSeed)
+{
+	Material_t Material;
+	Material.bBumpMap = Chance(nSeed, 0.7f);
+	Material.bVertexColors = Chance(nSeed, 0.05f);
+	Material.nEnvMap = Chance(nSeed, 0.3f) ? (Chance(nSeed, 0.5f) ? 2 : 1) : 0;
+	Material.bDetail = Chance(nSeed, 0.15f);
+	Material.bDetailGamma = Material.bDetail && Chance(nSeed, 0.5f);
+	Material.bSelfIllum = Chance(nSeed, 0.05f);
+	Material.bLightWarp = Material.bBumpMap && Chance(nSeed, 0.03f);
+	Material.nStateFlags = (Chance(nSeed, 0.08f) ? STATEFLAG_TRANSLUCENT : 0) | (Chance(nSeed, 0.02f) ? STATEFLAG_ADDITIVE : 0) |
+		(Chance(nSeed, 0.06f) ? STATEFLAG_ALPHATEST : 0) | (Chance(nSeed, 0.03f) ? STATEFLAG_NOCULL : 0);
+
+	// Mostly the Default, Foliage and Fences like their own
+	static const float s_flAlphaRefs[] = { 0.25f, 0.3f, 0.4f, 0.6f, 0.75f };
+	Material.flAlphaRef = 0.5f;
+	if (Chance(nSeed, 0.3f))
+	{
+		nSeed = LuxHash(nSeed);
+		Material.flAlphaRef = s_flAlphaRefs[nSeed % 5];
+	}
+	return Material;
+}
+
+//==========================================================================//
+// The SHADOW_STATE a Shader would run
+//==========================================================================//
+static void BuildBlock(const Material_t &Material, LuxStateBlock_t &Block)
+{
+	Block = LuxStateBlock_t();
+	Block.m_nSamplers = 1 << SAMPLER_BASETEXTURE;
+	Block.m_nSRGBSamplers = 1 << SAMPLER_BASETEXTURE;
+	if (Material.bBumpMap)
+		Block.m_nSamplers |= 1 << SAMPLER_NORMALTEXTURE;
+	if (Material.bDetail)
+	{
+		Block.m_nSamplers |= 1 << SAMPLER_DETAILTEXTURE;
+		Block.m_nSRGBSamplers |= Material.bDetailGamma ? 1 << SAMPLER_DETAILTEXTURE : 0;
+	}
+	if (Material.nEnvMap)
+	{
+		Block.m_nSamplers |= 1 << SAMPLER_ENVMAPTEXTURE;
+		Block.m_nSRGBSamplers |= 1 << SAMPLER_ENVMAPTEXTURE;
+	}
+	if (Material.nEnvMap == 2)
+		Block.m_nSamplers |= 1 << SAMPLER_ENVMAPMASK;
+	if (Material.bSelfIllum)
+		Block.m_nSamplers |= 1 << SAMPLER_SELFILLUM;
+	if (Material.bLightWarp)
+		Block.m_nSamplers |= 1 << SAMPLER_LIGHTWARP;
+
+	bool bTranslucent = (Material.nStateFlags & (STATEFLAG_TRANSLUCENT | STATEFLAG_ADDITIVE)) != 0;
+	Block.m_bBlending = bTranslucent;
+	Block.m_nBlendSrc = 4;		// SHADER_BLEND_SRC_ALPHA
+	Block.m_nBlendDst = (Material.nStateFlags & STATEFLAG_ADDITIVE) ? 1 : 5;
+	Block.m_bAlphaTest = (Material.nStateFlags & STATEFLAG_ALPHATEST) != 0;
+	Block.m_nAlphaFunc = 6;		// SHADER_ALPHAFUNC_GEQUAL
+	Block.m_flAlphaRef = Block.m_bAlphaTest ? Material.flAlphaRef : 0.0f;
+	Block.m_bDepthWrites = !bTranslucent;
+	Block.m_bAlphaWrites = !bTranslucent;
+	Block.m_bSRGBWrite = true;
+	Block.m_bCulling = !(Material.nStateFlags & STATEFLAG_NOCULL);
+
+	Block.m_nVertexFormat = 0x1 | 0x2 | (Material.bVertexColors ? 0x4 : 0);
+	Block.m_nTexCoords = 1;
+	Block.m_nTexCoordDims[0] = 2;
+	Block.m_nUserDataSize = Material.bBumpMap ? 4 : 0;
+
+	lux_modelshadertest_vs30_StaticKey VSKey = lux_modelshadertest_vs30_StaticKey()
+		.Set_NORMALS(Material.bBumpMap ? 2 : 1)
+		.Set_VERTEXCOLORS(Material.bVertexColors)
+		.Set_BUMPMAPPED(Material.bBumpMap);
+
+	lux_modelshadertest_ps30_StaticKey PSKey = lux_modelshadertest_ps30_StaticKey()
+		.Set_BRUSH<0>()
+		.Set_AMBIENTCUBES<1>()
+		.Set_LIGHTDATA<1>()
+		.Set_ENVMAPCOMBO(Material.nEnvMap ? 1 : 0)
+		.Set_BUMPMAPPED(Material.bBumpMap)
+		.Set_VERTEXCOLORS(Material.bVertexColors);
+
+	Block.m_pVertexShader = "lux_modelshadertest_vs30";
+	Block.m_pPixelShader = "lux_modelshadertest_ps30";
+	Block.m_nVertexShaderIndex = VSKey.Index();
+	Block.m_nPixelShaderIndex = PSKey.Index();
+}
+
+// The Key, without reading anything BuildBlock() doesn't
+static LuxStateBlockKey_t BuildKey(const Material_t &Material)
+{
+	lux_modelshadertest_vs30_StaticKey VSKey = lux_modelshadertest_vs30_StaticKey()
+		.Set_NORMALS(Material.bBumpMap ? 2 : 1)
+		.Set_VERTEXCOLORS(Material.bVertexColors)
+		.Set_BUMPMAPPED(Material.bBumpMap);
+
+	lux_modelshadertest_ps30_StaticKey PSKey = lux_modelshadertest_ps30_StaticKey()
+		.Set_BRUSH<0>()
+		.Set_AMBIENTCUBES<1>()
+		.Set_LIGHTDATA<1>()
+		.Set_ENVMAPCOMBO(Material.nEnvMap ? 1 : 0)
+		.Set_BUMPMAPPED(Material.bBumpMap)
+		.Set_VERTEXCOLORS(Material.bVertexColors);
+
+	uint32_t nSamplers = (Material.bDetail ? 1 << SAMPLER_DETAILTEXTURE : 0) | (Material.nEnvMap == 2 ? 1 << SAMPLER_ENVMAPMASK : 0) |
+		(Material.bSelfIllum ? 1 << SAMPLER_SELFILLUM : 0) | (Material.bLightWarp ? 1 << SAMPLER_LIGHTWARP : 0);
+	uint32_t nSRGBSamplers = Material.bDetailGamma ? 1 << SAMPLER_DETAILTEXTURE : 0;
+
+	float flAlphaRef = (Material.nStateFlags & STATEFLAG_ALPHATEST) ? Material.flAlphaRef : 0.0f;
+
+	static const uint32_t s_nShader = LuxStateBlock_ShaderID("lux_modelshadertest");
+	return LuxStateBlockKey(s_nShader, PSKey.Key(), VSKey.Key(), nSamplers, nSRGBSamplers, Material.nStateFlags, flAlphaRef);
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nMaterials = std::max(1, CommandLine.ParmValue("-materials", 5000));
+	int nReloads = std::max(1, CommandLine.ParmValue("-reloads", 4));
+	int nRepeats = std::max(1, CommandLine.ParmValue("-repeats", 5));
+	uint32_t nSeed = (uint32_t)CommandLine.ParmValue("-seed", 1);
+
+	std::vector<Material_t> Materials;
+	for (int n = 0; n < nMaterials; n++)
+		Materials.push_back(RandomMaterial(LuxHash(nSeed * 1000003 + n)));
+
+	CLuxStateBlockCache Cache;
+	std::vector<LuxStateBlock_t> Unshared(nMaterials);
+	std::vector<const LuxStateBlock_t *> Shared(nMaterials);
+
+	double flUncached = 1e30, flCached = 1e30;
+	for (int nRepeat = 0; nRepeat < nRepeats; nRepeat++)
+	{
+		// Uncached, one Block per Material like every Snapshot today
+		double flStart = LuxTimeSeconds();
+		for (int nReload = 0; nReload < nReloads; nReload++)
+		{
+			for (int n = 0; n < nMaterials; n++)
+				BuildBlock(Materials[n], Unshared[n]);
+		}
+		flUncached = std::min(flUncached, LuxTimeSeconds() - flStart);
+
+		Cache.Clear();
+		flStart = LuxTimeSeconds();
+		for (int nReload = 0; nReload < nReloads; nReload++)
+		{
+			for (int n = 0; n < nMaterials; n++)
+			{
+				LuxStateBlockKey_t Key = BuildKey(Materials[n]);
+				const LuxStateBlock_t *pBlock = Cache.Find(Key);
+				if (!pBlock)
+				{
+					LuxStateBlock_t Block;
+					BuildBlock(Materials[n], Block);
+					pBlock = Cache.Insert(Key, Block);
+				}
+				Shared[n] = pBlock;
+			}
+		}
+		flCached = std::min(flCached, LuxTimeSeconds() - flStart);
+	}
+
+	int nMismatches = 0;
+	for (int n = 0; n < nMaterials; n++)
+	{
+		if (memcmp(Shared[n], &Unshared[n], sizeof(LuxStateBlock_t)))
+		{
+			if (!nMismatches)
+				printf("Material %d got a Block that doesn't match its own, the Key is missing an Input\n", n);
+			nMismatches++;
+		}
+	}
+
+	const LuxStateBlockStats_t &Stats = Cache.GetStats();
+	size_t nUnsharedBytes = (size_t)nMaterials * sizeof(LuxStateBlock_t);
+	printf("%d Materials, %d Snapshots each, %d unique Blocks\n", nMaterials, nReloads, Stats.m_nBlocks);
+	printf("Hit Rate      %.2f%% of %lld Lookups\n", Stats.HitRate() * 100.0f, (long long)Stats.m_nLookups);
+	printf("Memory        %.1f KB shared, %.1f KB with one Block per Material\n", Stats.m_nBytes / 1024.0, nUnsharedBytes / 1024.0);
+	printf("Snapshot      %.1f ns uncached, %.1f ns cached\n", flUncached * 1e9 / ((double)nMaterials * nReloads), flCached * 1e9 / ((double)nMaterials * nReloads));
+	if (flCached > flUncached)
+		printf("Cached Snapshots are slower than filling the Struct, the Lookup Path needs work\n");
+	printf("%d Mismatches\n", nMismatches);
+
+	// Shader IDs are Identities : the same Name in another Buffer is the same ID, any other Name isn't
+	char szCopy[] = "lux_modelshadertest";
+	if (LuxStateBlock_ShaderID(szCopy) != LuxStateBlock_ShaderID("lux_modelshadertest") ||
+		LuxStateBlock_ShaderID("lux_modelshadertest_decal") == LuxStateBlock_ShaderID("lux_modelshadertest"))
+	{
+		printf("LuxStateBlock_ShaderID() doesn't tell Shaders apart\n");
+		nMismatches++;
+	}
+
+	return nMismatches ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	CPU Reference for the Triplanar Modes in lux_common_triplanar.h
+//							Measures how many Samples each Mode takes and how far it is off
+//							from regular Triplanar Mapping, over a Sphere of Normals.
+//
+//	Usage :	lux_triplanar_ref [-normals 16384] [-positions 8] [-threshold 0.05] [-sweep]
+//
+//==========================================================================//
+
+#include "luxtools.h"
+
+//==========================================================================//
+// Test Texture. Tiling Value Noise with a few Octaves, sampled bilinear with wrap
+// Something with actual high frequency Detail, a flat Color would hide all Errors
+//==========================================================================//
+class CTestTexture
+{
+public:
+	CTestTexture(int nSize) : m_nSize(nSize), m_Texels(nSize * nSize)
+	{
+		for (int y = 0; y < nSize; y++)
+		{
+			for (int x = 0; x < nSize; x++)
+			{
+				float3 f3Color;
+				float f1Amplitude = 0.5f;
+				for (int nOctave = 0, nPeriod = 8; nOctave < 4; nOctave++, nPeriod *= 2)
+				{
+					for (int c = 0; c < 3; c++)
+						f3Color[c] += f1Amplitude * Lattice(x, y, nPeriod, c + nOctave * 3);
+					f1Amplitude *= 0.5f;
+				}
+				m_Texels[y * nSize + x] = f3Color;
+			}
+		}
+	}
+
+	float3 Sample(float u, float v) const
+	{
+		float fx = frac(u) * m_nSize - 0.5f;
+		float fy = frac(v) * m_nSize - 0.5f;
+		int x0 = (int)floorf(fx);
+		int y0 = (int)floorf(fy);
+		float tx = fx - x0;
+		float ty = fy - y0;
+
+		float3 a = Texel(x0, y0), b = Texel(x0 + 1, y0);
+		float3 c = Texel(x0, y0 + 1), d = Texel(x0 + 1, y0 + 1);
+		return lerp(lerp(a, b, tx), lerp(c, d, tx), ty);
+	}
+
+private:
+	float3 Texel(int x, int y) const
+	{
+		x = ((x % m_nSize) + m_nSize) % m_nSize;
+		y = ((y % m_nSize) + m_nSize) % m_nSize;
+		return m_Texels[y * m_nSize + x];
+	}
+
+	// Smooth Noise on a Lattice with nPeriod Cells across the Texture
+	float Lattice(int x, int y, int nPeriod, int nChannel) const
+	{
+		float fx = (float)x * nPeriod / m_nSize;
+		float fy = (float)y * nPeriod / m_nSize;
+		int ix = (int)fx, iy = (int)fy;
+		float tx = fx - ix, ty = fy - iy;
+		tx = tx * tx * (3.0f - 2.0f * tx);
+		ty = ty * ty * (3.0f - 2.0f * ty);
+
+		float a = Corner(ix, iy, nPeriod, nChannel), b = Corner(ix + 1, iy, nPeriod, nChannel);
+		float c = Corner(ix, iy + 1, nPeriod, nChannel), d = Corner(ix + 1, iy + 1, nPeriod, nChannel);
+		return lerp(lerp(a, b, tx), lerp(c, d, tx), ty);
+	}
+
+	float Corner(int x, int y, int nPeriod, int nChannel) const
+	{
+		x %= nPeriod;
+		y %= nPeriod;
+		return LuxHashFloat((uint32_t)(x + y * 4099 + nPeriod * 131071 + nChannel * 524287));
+	}
+
+	int m_nSize;
+	std::vector<float3> m_Texels;
+};
+
+//==========================================================================//
+// Ports of the HLSL Functions. Keep these 1:1 with lux_common_triplanar.h
+//==========================================================================//
+enum TriplanarModes_t
+{
+	TRIPLANARMODE_FULL = 0,
+	TRIPLANARMODE_EARLYOUT,
+	TRIPLANARMODE_BIPLANAR,
+
+	NUM_TRIPLANARMODES
+};
+
+static const char *s_pModeNames[NUM_TRIPLANARMODES] = { "Triplanar", "EarlyOut", "Biplanar" };
+
+static float3 Triplanar_ComputeWeights(const float3 &vNormal)
+{
+	return vNormal * vNormal;
+}
+
+// Returns the Color, nSamples receives the Number of Texture Fetches
+static float3 Triplanar_Sample(const CTestTexture &Tex, int nMode, float f1Threshold,
+								const float3 &Weights, const float3 &uvw, int &nSamples)
+{
+	float3 f3Weights = Weights;
+
+	if (nMode == TRIPLANARMODE_EARLYOUT)
+	{
+		for (int n = 0; n < 3; n++)
+			f3Weights[n] = (Weights[n] >= f1Threshold) ? Weights[n] : 0.0f;
+
+		f3Weights = f3Weights / dot(f3Weights, float3(1.0f));
+	}
+	else if (nMode == TRIPLANARMODE_BIPLANAR)
+	{
+		float3 f3IsMin = (Weights.x <= Weights.y && Weights.x <= Weights.z) ? float3(1.0f, 0.0f, 0.0f) :
+						((Weights.y <= Weights.z) ? float3(0.0f, 1.0f, 0.0f) : float3(0.0f, 0.0f, 1.0f));
+
+		float f1Min = fminf(Weights.x, fminf(Weights.y, Weights.z));
+		f3Weights = (Weights - float3(f1Min)) * (float3(1.0f) - f3IsMin);
+		float f1Sum = dot(f3Weights, float3(1.0f));
+
+		f3Weights = (f1Sum > 0.00001f) ? (f3Weights / f1Sum) : ((float3(1.0f) - f3IsMin) * 0.5f);
+
+		// Biplanar always takes two Samples, even if one of them has a zero Weight
+		for (int n = 0; n < 3; n++)
+		{
+			if (f3IsMin[n] != 0.0f)
+				f3Weights[n] = -1.0f;
+		}
+	}
+
+	float3 f3Result;
+	nSamples = 0;
+
+	const float Coords[3][2] = { { uvw.z, uvw.y }, { uvw.x, uvw.z }, { uvw.x, uvw.y } };
+	for (int n = 0; n < 3; n++)
+	{
+		bool bTaken = (nMode == TRIPLANARMODE_FULL) || (nMode == TRIPLANARMODE_BIPLANAR ? f3Weights[n] >= 0.0f : f3Weights[n] > 0.0f);
+		if (!bTaken)
+			continue;
+
+		f3Result += Tex.Sample(Coords[n][0], Coords[n][1]) * f3Weights[n];
+		nSamples++;
+	}
+
+	return f3Result;
+}
+
+//==========================================================================//
+// Statistics for one Mode
+//==========================================================================//
+struct ModeStats_t
+{
+	ModeStats_t() : nPixels(0), nSamples(0), flSumSqError(0.0), flMaxError(0.0)
+	{
+		memset(nHistogram, 0, sizeof(nHistogram));
+	}
+
+	int64_t nPixels;
+	int64_t nSamples;
+	int64_t nHistogram[4]; // Pixels that took 0..3 Samples
+	double flSumSqError;
+	double flMaxError;
+};
+
+static void RunMode(const CTestTexture &Tex, int nMode, float f1Threshold, int nNormals, int nPositions, ModeStats_t &Stats)
+{
+	for (int nNormal = 0; nNormal < nNormals; nNormal++)
+	{
+		float3 f3Normal = LuxSphereDirection(nNormal, nNormals);
+		float3 f3Weights = Triplanar_ComputeWeights(f3Normal);
+
+		for (int nPos = 0; nPos < nPositions; nPos++)
+		{
+			uint32_t nSeed = (uint32_t)(nNormal * 16 + nPos) * 3;
+			float3 uvw(LuxHashFloat(nSeed) * 8.0f, LuxHashFloat(nSeed + 1) * 8.0f, LuxHashFloat(nSeed + 2) * 8.0f);
+
+			int nUnused, nSamples;
+			float3 f3Reference = Triplanar_Sample(Tex, TRIPLANARMODE_FULL, f1Threshold, f3Weights, uvw, nUnused);
+			float3 f3Result = Triplanar_Sample(Tex, nMode, f1Threshold, f3Weights, uvw, nSamples);
+
+			float3 f3Delta = f3Result - f3Reference;
+			double flError = sqrt(dot(f3Delta, f3Delta) / 3.0f);
+
+			Stats.nPixels++;
+			Stats.nSamples += nSamples;
+			Stats.nHistogram[nSamples]++;
+			Stats.flSumSqError += flError * flError;
+			if (flError > Stats.flMaxError)
+				Stats.flMaxError = flError;
+		}
+	}
+}
+
+static void PrintStats(const char *pName, float f1Threshold, const ModeStats_t &Stats)
+{
+	double flPixels = (double)Stats.nPixels;
+	double flAvgSamples = Stats.nSamples / flPixels;
+
+	printf("%-10s %9.3f %8.3f %7.1f%% %6.1f%% %6.1f%% %6.1f%% %10.5f %10.5f\n",
+		pName, f1Threshold, flAvgSamples, 100.0 * (1.0 - flAvgSamples / 3.0),
+		100.0 * Stats.nHistogram[1] / flPixels, 100.0 * Stats.nHistogram[2] / flPixels, 100.0 * Stats.nHistogram[3] / flPixels,
+		sqrt(Stats.flSumSqError / flPixels), Stats.flMaxError);
+}
+
+static void PrintHeader()
+{
+	printf("%-10s %9s %8s %8s %7s %7s %7s %10s %10s\n",
+		"Mode", "Threshold", "Samples", "Saved", "1-Tap", "2-Tap", "3-Tap", "RMS Error", "Max Error");
+}
+
+int main(int argc, char **argv)
+{
+	CLuxCommandLine CommandLine(argc, argv);
+	int nNormals = CommandLine.ParmValue("-normals", 16384);
+	int nPositions = CommandLine.ParmValue("-positions", 8);
+	float f1Threshold = CommandLine.ParmValue("-threshold", 0.05f);
+
+	if (nNormals <= 0 || nPositions <= 0)
+	{
+		fprintf(stderr, "Usage: lux_triplanar_ref [-normals N] [-positions N] [-threshold X] [-sweep]\n");
+		return 1;
+	}
+
+	CTestTexture Tex(256);
+
+	printf("%d Normals x %d Positions, Errors are RGB RMS against 3-Sample Triplanar\n\n", nNormals, nPositions);
+	PrintHeader();
+
+	if (CommandLine.HasParm("-sweep"))
+	{
+		static const float s_Thresholds[] = { 0.01f, 0.02f, 0.05f, 0.1f, 0.15f, 0.2f, 0.25f, 0.3f };
+		for (size_t n = 0; n < sizeof(s_Thresholds) / sizeof(s_Thresholds[0]); n++)
+		{
+			ModeStats_t Stats;
+			RunMode(Tex, TRIPLANARMODE_EARLYOUT, s_Thresholds[n], nNormals, nPositions, Stats);
+			PrintStats(s_pModeNames[TRIPLANARMODE_EARLYOUT], s_Thresholds[n], Stats);
+		}
+		return 0;
+	}
+
+	for (int nMode = 0; nMode < NUM_TRIPLANARMODES; nMode++)
+	{
+		ModeStats_t Stats;
+		RunMode(Tex, nMode, f1Threshold, nNormals, nPositions, Stats);
+		PrintStats(s_pModeNames[nMode], nMode == TRIPLANARMODE_EARLYOUT ? f1Threshold : 0.0f, Stats);
+	}
+
+	return 0;
+}
@@ -0,0 +1,363 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Shared Helpers for the standalone LUX Tools
+//							No Dependencies on the SDK, every Tool is a single .cpp File
+//							Build with : g++ -O2 -std=c++11 lux_<tool>.cpp -o lux_<tool> -lpthread
+//							Or on Windows : cl /O2 /EHsc lux_<tool>.cpp
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_H
+#define LUXTOOLS_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+//==========================================================================//
+// HLSL-Style Vector, same Idea as cpp_floatx.h but without the SDK
+//==========================================================================//
+struct float3
+{
+	float x, y, z;
+
+	float3() : x(0.0f), y(0.0f), z(0.0f) {}
+	float3(float f) : x(f), y(f), z(f) {}
+	float3(float fx, float fy, float fz) : x(fx), y(fy), z(fz) {}
+
+	float &operator[](int n) { return (&x)[n]; }
+	float operator[](int n) const { return (&x)[n]; }
+};
+
+inline float3 operator+(const float3 &a, const float3 &b) { return float3(a.x + b.x, a.y + b.y, a.z + b.z); }
+inline float3 operator-(const float3 &a, const float3 &b) { return float3(a.x - b.x, a.y - b.y, a.z - b.z); }
+inline float3 operator*(const float3 &a, const float3 &b) { return float3(a.x * b.x, a.y * b.y, a.z * b.z); }
+inline float3 operator*(const float3 &a, float f) { return float3(a.x * f, a.y * f, a.z * f); }
+inline float3 operator/(const float3 &a, float f) { return a * (1.0f / f); }
+inline float3 &operator+=(float3 &a, const float3 &b) { a = a + b; return a; }
+
+inline float dot(const float3 &a, const float3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline float3 normalize(const float3 &v) { return v / sqrtf(dot(v, v)); }
+inline float saturate(float f) { return f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f); }
+inline float frac(float f) { return f - floorf(f); }
+inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
+inline float3 lerp(const float3 &a, const float3 &b, float t) { return a + (b - a) * t; }
+
+//==========================================================================//
+// Deterministic Random Numbers. Tools must give the same Output on every Run
+//==========================================================================//
+inline uint32_t LuxHash(uint32_t x)
+{
+	x ^= x >> 16; x *= 0x7feb352dU;
+	x ^= x >> 15; x *= 0x846ca68bU;
+	x ^= x >> 16;
+	return x;
+}
+
+// [0..1)
+inline float LuxHashFloat(uint32_t x)
+{
+	return (LuxHash(x) >> 8) * (1.0f / 16777216.0f);
+}
+
+// FNV-1a, used for Content Hashes ( Registers, Control Points, Source Text )
+inline uint64_t LuxHashBytes(const void *pData, size_t nSize, uint64_t nSeed = 14695981039346656037ULL)
+{
+	const unsigned char *p = (const unsigned char *)pData;
+	uint64_t h = nSeed;
+	for (size_t n = 0; n < nSize; n++)
+	{
+		h ^= p[n];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+// Evenly distributed Unit Vectors on a Sphere ( Fibonacci Lattice )
+inline float3 LuxSphereDirection(int nIndex, int nCount)
+{
+	const float f1GoldenAngle = 2.39996322972865332f;
+	float z = 1.0f - (2.0f * nIndex + 1.0f) / nCount;
+	float r = sqrtf(1.0f - z * z);
+	float phi = f1GoldenAngle * nIndex;
+	return float3(cosf(phi) * r, sinf(phi) * r, z);
+}
+
+//==========================================================================//
+// Timing
+//==========================================================================//
+inline double LuxTimeSeconds()
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//==========================================================================//
+// Command Line. Source Style, -option value
+//==========================================================================//
+class CLuxCommandLine
+{
+public:
+	CLuxCommandLine(int argc, char **argv) : m_argc(argc), m_argv(argv) {}
+
+	bool HasParm(const char *pName) const { return FindParm(pName) != 0; }
+
+	const char *ParmValue(const char *pName, const char *pDefault) const
+	{
+		int n = FindParm(pName);
+		return (n && n + 1 < m_argc) ? m_argv[n + 1] : pDefault;
+	}
+
+	int ParmValue(const char *pName, int nDefault) const
+	{
+		const char *p = ParmValue(pName, (const char *)0);
+		return p ? atoi(p) : nDefault;
+	}
+
+	float ParmValue(const char *pName, float flDefault) const
+	{
+		const char *p = ParmValue(pName, (const char *)0);
+		return p ? (float)atof(p) : flDefault;
+	}
+
+	// Last Argument that isn't an Option or the Value of one
+	const char *LastArg(const char *pDefault) const
+	{
+		if (m_argc < 2 || m_argv[m_argc - 1][0] == '-')
+			return pDefault;
+		if (m_argc >= 3 && m_argv[m_argc - 2][0] == '-')
+			return pDefault;
+		return m_argv[m_argc - 1];
+	}
+
+private:
+	int FindParm(const char *pName) const
+	{
+		for (int n = 1; n < m_argc; n++)
+		{
+			if (!strcmp(m_argv[n], pName))
+				return n;
+		}
+		return 0;
+	}
+
+	int m_argc;
+	char **m_argv;
+};
+
+//==========================================================================//
+// Files
+//==========================================================================//
+inline bool LuxReadFile(const char *pPath, std::string &Out)
+{
+	FILE *f = fopen(pPath, "rb");
+	if (!f)
+		return false;
+
+	char Buffer[16384];
+	size_t nRead;
+	Out.clear();
+	while ((nRead = fread(Buffer, 1, sizeof(Buffer), f)) > 0)
+		Out.append(Buffer, nRead);
+
+	fclose(f);
+	return true;
+}
+
+inline bool LuxWriteFile(const char *pPath, const std::string &Data)
+{
+	FILE *f = fopen(pPath, "wb");
+	if (!f)
+		return false;
+
+	bool bOk = fwrite(Data.data(), 1, Data.size(), f) == Data.size();
+	fclose(f);
+	return bOk;
+}
+
+// Every File under Dir ending in pExtension ( ".vmt", case-insensitive ), Subdirectories included
+inline void LuxFindFiles(const std::string &Dir, const char *pExtension, std::vector<std::string> &Files)
+{
+	std::string Base = Dir;
+	if (!Base.empty() && Base[Base.size() - 1] != '/' && Base[Base.size() - 1] != '\\')
+		Base += '/';
+
+	std::vector<std::string> Names;
+	std::vector<std::string> Subdirs;
+#ifdef _WIN32
+	struct _finddata_t Data;
+	intptr_t hFind = _findfirst((Base + "*").c_str(), &Data);
+	if (hFind == -1)
+		return;
+	do
+	{
+		if (!strcmp(Data.name, ".") || !strcmp(Data.name, ".."))
+			continue;
+		((Data.attrib & _A_SUBDIR) ? Subdirs : Names).push_back(Data.name);
+	} while (_findnext(hFind, &Data) == 0);
+	_findclose(hFind);
+#else
+	DIR *pDir = opendir(Base.c_str());
+	if (!pDir)
+		return;
+	while (struct dirent *pEntry = readdir(pDir))
+	{
+		if (!strcmp(pEntry->d_name, ".") || !strcmp(pEntry->d_name, ".."))
+			continue;
+		struct stat Info;
+		if (stat((Base + pEntry->d_name).c_str(), &Info) == 0)
+			(S_ISDIR(Info.st_mode) ? Subdirs : Names).push_back(pEntry->d_name);
+	}
+	closedir(pDir);
+#endif
+
+	// Sorted, so Tools walk the same Tree in the same Order everywhere
+	std::sort(Names.begin(), Names.end());
+	std::sort(Subdirs.begin(), Subdirs.end());
+
+	size_t nExtension = strlen(pExtension);
+	for (size_t n = 0; n < Names.size(); n++)
+	{
+		const std::string &Name = Names[n];
+		bool bMatch = Name.size() >= nExtension;
+		for (size_t i = 0; bMatch && i < nExtension; i++)
+			bMatch = tolower((unsigned char)Name[Name.size() - nExtension + i]) == tolower((unsigned char)pExtension[i]);
+		if (bMatch)
+			Files.push_back(Base + Name);
+	}
+
+	for (size_t n = 0; n < Subdirs.size(); n++)
+		LuxFindFiles(Base + Subdirs[n], pExtension, Files);
+}
+
+//==========================================================================//
+// TGA, 24 and 32 Bit, raw and RLE. That's what vtex takes, so that's what's in materialsrc
+// 8 Bit per Channel, RGBA, top-down
+//==========================================================================//
+struct LuxImage_t
+{
+	LuxImage_t() : nWidth(0), nHeight(0), bHasAlpha(false) {}
+
+	int nWidth;
+	int nHeight;
+	bool bHasAlpha;
+	std::vector<unsigned char> RGBA; // Top-down
+};
+
+inline bool LuxLoadTGA(const char *pPath, LuxImage_t &Image)
+{
+	std::string Data;
+	if (!LuxReadFile(pPath, Data) || Data.size() < 18)
+		return false;
+
+	const unsigned char *p = (const unsigned char *)Data.data();
+	int nIDLength = p[0], nColorMapType = p[1], nType = p[2];
+	int nWidth = p[12] | (p[13] << 8), nHeight = p[14] | (p[15] << 8);
+	int nBits = p[16], nDescriptor = p[17];
+
+	if (nColorMapType != 0 || (nType != 2 && nType != 10) || (nBits != 24 && nBits != 32) || !nWidth || !nHeight)
+	{
+		fprintf(stderr, "%s : Only 24/32 Bit truecolor TGAs are supported\n", pPath);
+		return false;
+	}
+
+	const int nBytesPerPixel = nBits / 8;
+	const size_t nPixels = (size_t)nWidth * nHeight;
+	std::vector<unsigned char> BGRA(nPixels * 4, 255);
+
+	size_t nOffset = 18 + nIDLength;
+	size_t nPixel = 0;
+	while (nPixel < nPixels)
+	{
+		int nRun = 1;
+		bool bRepeat = false;
+		if (nType == 10)
+		{
+			if (nOffset >= Data.size())
+				break;
+			unsigned char nHeader = p[nOffset++];
+			nRun = (nHeader & 0x7F) + 1;
+			bRepeat = (nHeader & 0x80) != 0;
+		}
+
+		for (int n = 0; n < nRun && nPixel < nPixels; n++, nPixel++)
+		{
+			if (nOffset + nBytesPerPixel > Data.size())
+				return false;
+
+			memcpy(&BGRA[nPixel * 4], p + nOffset, nBytesPerPixel);
+			if (!bRepeat || n == nRun - 1)
+				nOffset += nBytesPerPixel;
+		}
+	}
+
+	if (nPixel != nPixels)
+		return false;
+
+	// Bottom-up unless Bit 5 of the Descriptor is set
+	bool bTopDown = (nDescriptor & 0x20) != 0;
+	Image.nWidth = nWidth;
+	Image.nHeight = nHeight;
+	Image.bHasAlpha = nBits == 32;
+	Image.RGBA.resize(nPixels * 4);
+	for (int y = 0; y < nHeight; y++)
+	{
+		int nSrcRow = bTopDown ? y : nHeight - 1 - y;
+		for (int x = 0; x < nWidth; x++)
+		{
+			const unsigned char *pSrc = &BGRA[((size_t)nSrcRow * nWidth + x) * 4];
+			unsigned char *pDst = &Image.RGBA[((size_t)y * nWidth + x) * 4];
+			pDst[0] = pSrc[2];
+			pDst[1] = pSrc[1];
+			pDst[2] = pSrc[0];
+			pDst[3] = pSrc[3];
+		}
+	}
+	return true;
+}
+
+// Always 32 Bit, uncompressed, top-down
+inline bool LuxSaveTGA(const char *pPath, const LuxImage_t &Image)
+{
+	std::string Data(18, '\0');
+	Data[2] = 2;
+	Data[12] = (char)(Image.nWidth & 0xFF);
+	Data[13] = (char)(Image.nWidth >> 8);
+	Data[14] = (char)(Image.nHeight & 0xFF);
+	Data[15] = (char)(Image.nHeight >> 8);
+	Data[16] = 32;
+	Data[17] = 0x20 | 8;
+
+	Data.reserve(18 + Image.RGBA.size());
+	for (size_t n = 0; n < Image.RGBA.size(); n += 4)
+	{
+		Data += (char)Image.RGBA[n + 2];
+		Data += (char)Image.RGBA[n + 1];
+		Data += (char)Image.RGBA[n + 0];
+		Data += (char)Image.RGBA[n + 3];
+	}
+	return LuxWriteFile(pPath, Data);
+}
+
+#endif // LUXTOOLS_H
@@ -0,0 +1,133 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Finds Combos that preprocess to the same Source, so only one of them is compiled
+//
+//	A Combo whose Code is compiled out by another ( COMPRESSION when nothing reads the Normal, SKINNING without
+//	APPLY_MODEL_MATRIX .. ) gives the Compiler the same Text as its Neighbour, and the same Text compiles to the
+//	same Bytecode. Each Combo is preprocessed in the Compiler View ( luxtools_fxc.h ) : Object-like Macros are
+//	expanded where they're used, so Defines nothing reads drop out. Whitespace is collapsed, the Target and the
+//	Bodies of Function-like Macros go in too. Two 64 Bit Hashes of that decide.
+//
+//	Combos the Preprocessor isn't sure about ( a missing Include, #error, a broken #if ) are never aliased.
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_COMBODEDUP_H
+#define LUXTOOLS_COMBODEDUP_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "luxtools_fxc.h"
+
+struct LuxSourceHash_t
+{
+	uint64_t nLow;
+	uint64_t nHigh;
+
+	bool operator<(const LuxSourceHash_t &Other) const { return nLow != Other.nLow ? nLow < Other.nLow : nHigh < Other.nHigh; }
+};
+
+// One Space between two Identifiers or Numbers, none anywhere else. String Literals stay as they are
+inline void LuxAppendNormalized(const std::string &Text, std::string &Out)
+{
+	bool bSpace = false;
+	for (size_t n = 0; n < Text.size(); n++)
+	{
+		char c = Text[n];
+		if (isspace((unsigned char)c))
+		{
+			bSpace = true;
+			continue;
+		}
+		if (bSpace && !Out.empty() && LuxIsIdentChar(Out[Out.size() - 1]) && LuxIsIdentChar(c))
+			Out += ' ';
+		bSpace = false;
+
+		if (c == '"')
+		{
+			size_t nEnd = n + 1;
+			while (nEnd < Text.size() && Text[nEnd] != '"')
+				nEnd += Text[nEnd] == '\\' ? 2 : 1;
+			nEnd = std::min(nEnd, Text.size() - 1);
+			Out.append(Text, n, nEnd - n + 1);
+			n = nEnd;
+			continue;
+		}
+		Out += c;
+	}
+	Out += '\n';
+}
+
+class CLuxComboDedup
+{
+public:
+	CLuxComboDedup(const std::string &FxcDir) : m_FxcDir(FxcDir), m_nCombos(0), m_nUncertain(0) {}
+
+	// The first Key added with the same Source, or nKey itself
+	size_t Add(size_t nKey, const std::string &Path, const std::string &Target, const CLuxComboSet &Combos, const std::vector<int> &Values)
+	{
+		m_nCombos++;
+		LuxSourceHash_t Hash;
+		if (!HashSource(Path, Target, Combos, Values, Hash))
+		{
+			m_nUncertain++;
+			return nKey;
+		}
+		std::map<LuxSourceHash_t, size_t>::iterator It = m_First.find(Hash);
+		if (It != m_First.end())
+			return It->second;
+		m_First[Hash] = nKey;
+		return nKey;
+	}
+
+	int NumCombos() const { return m_nCombos; }
+	int NumUnique() const { return (int)m_First.size() + m_nUncertain; }
+	int NumUncertain() const { return m_nUncertain; }
+
+private:
+	bool HashSource(const std::string &Path, const std::string &Target, const CLuxComboSet &Combos, const std::vector<int> &Values, LuxSourceHash_t &Hash)
+	{
+		CLuxPreprocessor PP(&m_Cache);
+		PP.SetCompilerView(true);
+		PP.AddIncludeDir(m_FxcDir);
+		PP.Define(Target == "vs_3_0" ? "SHADER_MODEL_VS_3_0" : "SHADER_MODEL_PS_3_0", "1");
+		for (int n = 0; n < Combos.NumCombos(); n++)
+		{
+			char szValue[16];
+			snprintf(szValue, sizeof(szValue), "%d", Values[n]);
+			PP.Define(Combos.Combo(n).Name, szValue);
+		}
+		if (!PP.Run(Path) || !PP.Problems().empty() || !PP.Missing().empty())
+			return false;
+
+		m_Text = Target + "\n";
+		const std::vector<LuxActiveLine_t> &Lines = PP.Lines();
+		for (size_t n = 0; n < Lines.size(); n++)
+			LuxAppendNormalized(Lines[n].Text, m_Text);
+
+		// Not expanded in the Lines, so whatever they expand to counts
+		for (std::map<std::string, LuxMacro_t>::const_iterator It = PP.Macros().begin(); It != PP.Macros().end(); ++It)
+		{
+			if (It->second.bFunction)
+				LuxAppendNormalized("#define " + It->first + "() " + PP.Expand(It->second.Body), m_Text);
+		}
+
+		Hash.nLow = LuxHashBytes(m_Text.data(), m_Text.size());
+		Hash.nHigh = LuxHashBytes(m_Text.data(), m_Text.size(), 0x9E3779B97F4A7C15ULL);
+		return true;
+	}
+
+	std::string m_FxcDir;
+	CLuxSourceCache m_Cache;
+	std::map<LuxSourceHash_t, size_t> m_First;
+	std::string m_Text;
+	int m_nCombos;
+	int m_nUncertain;
+};
+
+#endif // LUXTOOLS_COMBODEDUP_H
@@ -0,0 +1,143 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Deterministic pairwise Sample of a Shader's Combos, for quick CI Builds
+//
+//	Picks Combos until every Value of every Combo ( STATIC and DYNAMIC ) and every Pair of Values of two
+//	Combos that some live Combo has is covered. Only Combos the SKIPs leave are picked, so Values and Pairs
+//	that only exist in SKIPped Combos can't be covered and aren't counted.
+//	Greedy, the Combo that covers the most new Values and Pairs goes first, the lowest Index on a Tie.
+//	Gains only ever drop, so a Combo is only re-counted when it comes up top of the Queue.
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_COMBOSAMPLE_H
+#define LUXTOOLS_COMBOSAMPLE_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "luxtools_fxc.h"
+
+#include <queue>
+
+struct LuxComboCoverage_t
+{
+	LuxComboCoverage_t() : nLive(0), nValues(0), nValuesCovered(0), nPairs(0), nPairsCovered(0), nPairsSkipped(0) {}
+	int64_t nLive;				// Combos the SKIPs leave
+	int64_t nValues;			// Values some live Combo has
+	int64_t nValuesCovered;
+	int64_t nPairs;				// Pairs some live Combo has
+	int64_t nPairsCovered;
+	int64_t nPairsSkipped;		// Pairs only SKIPped Combos have
+};
+
+class CLuxComboSampler
+{
+public:
+	CLuxComboSampler(const CLuxComboSet &Combos) : m_Combos(Combos)
+	{
+		// Values first, then the Pairs of each two Combos
+		int nCombos = Combos.NumCombos();
+		m_nElements = 0;
+		m_ValueOffsets.resize(nCombos);
+		for (int n = 0; n < nCombos; n++)
+		{
+			m_ValueOffsets[n] = m_nElements;
+			m_nElements += Combos.Combo(n).Count();
+		}
+		m_nPairsStart = m_nElements;
+		m_PairOffsets.assign(nCombos * nCombos, 0);
+		for (int a = 0; a < nCombos; a++)
+		{
+			for (int b = a + 1; b < nCombos; b++)
+			{
+				m_PairOffsets[a * nCombos + b] = m_nElements;
+				m_nElements += (int64_t)Combos.Combo(a).Count() * Combos.Combo(b).Count();
+			}
+		}
+	}
+
+	// Indices in ascending Order
+	void Sample(std::vector<int64_t> &Indices, LuxComboCoverage_t &Coverage) const
+	{
+		Indices.clear();
+		Coverage = LuxComboCoverage_t();
+
+		std::vector<bool> Possible(m_nElements, false), Covered(m_nElements, false);
+		std::vector<int64_t> Elements;
+		std::vector<int> Values;
+
+		// std::priority_queue is a Max Heap : highest Gain, then lowest Index
+		std::priority_queue<std::pair<int64_t, int64_t> > Queue;
+		for (int64_t nIndex = 0; nIndex < m_Combos.NumIndices(); nIndex++)
+		{
+			m_Combos.Decode(nIndex, Values);
+			if (m_Combos.IsSkipped(Values))
+				continue;
+			Coverage.nLive++;
+			GetElements(Values, Elements);
+			for (size_t n = 0; n < Elements.size(); n++)
+				Possible[Elements[n]] = true;
+			Queue.push(std::make_pair((int64_t)Elements.size(), -nIndex));
+		}
+
+		while (!Queue.empty())
+		{
+			std::pair<int64_t, int64_t> Top = Queue.top();
+			Queue.pop();
+
+			m_Combos.Decode(-Top.second, Values);
+			GetElements(Values, Elements);
+			int64_t nGain = 0;
+			for (size_t n = 0; n < Elements.size(); n++)
+				nGain += !Covered[Elements[n]];
+			if (!nGain)
+				continue;
+
+			// Still the best, Gains of the others can only be lower than what's queued
+			if (nGain < Top.first)
+			{
+				Queue.push(std::make_pair(nGain, Top.second));
+				continue;
+			}
+			for (size_t n = 0; n < Elements.size(); n++)
+				Covered[Elements[n]] = true;
+			Indices.push_back(-Top.second);
+		}
+		std::sort(Indices.begin(), Indices.end());
+
+		for (int64_t n = 0; n < m_nElements; n++)
+		{
+			bool bPair = n >= m_nPairsStart;
+			(bPair ? Coverage.nPairs : Coverage.nValues) += Possible[n];
+			(bPair ? Coverage.nPairsCovered : Coverage.nValuesCovered) += Covered[n];
+			Coverage.nPairsSkipped += bPair && !Possible[n];
+		}
+	}
+
+private:
+	void GetElements(const std::vector<int> &Values, std::vector<int64_t> &Elements) const
+	{
+		int nCombos = m_Combos.NumCombos();
+		Elements.clear();
+		for (int a = 0; a < nCombos; a++)
+		{
+			int nA = Values[a] - m_Combos.Combo(a).nMin;
+			Elements.push_back(m_ValueOffsets[a] + nA);
+			for (int b = a + 1; b < nCombos; b++)
+				Elements.push_back(m_PairOffsets[a * nCombos + b] + (int64_t)nA * m_Combos.Combo(b).Count() + Values[b] - m_Combos.Combo(b).nMin);
+		}
+	}
+
+	const CLuxComboSet &m_Combos;
+	std::vector<int64_t> m_ValueOffsets;
+	std::vector<int64_t> m_PairOffsets;
+	int64_t m_nPairsStart;
+	int64_t m_nElements;
+};
+
+#endif // LUXTOOLS_COMBOSAMPLE_H
@@ -0,0 +1,209 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Per-Combo Compile Time History for the LUX Tools
+//
+//	A Text File, one Line per compiled Combo, sorted :
+//		<shader> <combo index> <microseconds>
+//	and one per Shader with the Hash of its Combo Declarations ( CLuxComboSet::LayoutHash() ) :
+//		// layout <shader> <hash>
+//	A Shader whose Declarations changed has its History dropped, its old Indices mean other Combos now.
+//	Tools keep the File next to the Shaders ( <fxc>/lux_compiletimes.txt ), it's in the .gitignore.
+//	Record() blends new Times into old ones, so one slow Run doesn't throw the History away.
+//	Predict() falls back to Combos with the same Static Index, then the Shader, then every Shader,
+//	so new Combos and new Shaders still get a sensible Guess.
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_COMPILETIMES_H
+#define LUXTOOLS_COMPILETIMES_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "luxtools.h"
+
+#include <map>
+
+class CLuxCompileTimes
+{
+public:
+	CLuxCompileTimes() : m_flTotal(0.0), m_nTotal(0) {}
+
+	// A missing File is an empty History
+	bool Load(const char *pPath)
+	{
+		std::string Data;
+		if (!LuxReadFile(pPath, Data))
+			return false;
+
+		size_t nStart = 0;
+		while (nStart < Data.size())
+		{
+			size_t nEnd = Data.find('\n', nStart);
+			if (nEnd == std::string::npos)
+				nEnd = Data.size();
+			std::string Line = Data.substr(nStart, nEnd - nStart);
+			nStart = nEnd + 1;
+
+			char szShader[256];
+			long long nIndex;
+			unsigned long long nLayout;
+			float flMicroseconds;
+			if (sscanf(Line.c_str(), "// layout %255s %llx", szShader, &nLayout) == 2)
+				m_Shaders[szShader].nLayout = nLayout;
+			else if (Line.compare(0, 2, "//") && sscanf(Line.c_str(), "%255s %lld %f", szShader, &nIndex, &flMicroseconds) == 3)
+				Set(szShader, nIndex, flMicroseconds * 1e-6f);
+		}
+		Rebuild();
+		return true;
+	}
+
+	bool Save(const char *pPath) const
+	{
+		std::string Out = "// lux_compilepool Compile Times : <shader> <combo index> <microseconds>\n";
+		char szLine[320];
+		for (std::map<std::string, Shader_t>::const_iterator It = m_Shaders.begin(); It != m_Shaders.end(); ++It)
+		{
+			if (It->second.nLayout)
+			{
+				snprintf(szLine, sizeof(szLine), "// layout %s %016llx\n", It->first.c_str(), (unsigned long long)It->second.nLayout);
+				Out += szLine;
+			}
+			for (std::map<int64_t, float>::const_iterator Combo = It->second.Combos.begin(); Combo != It->second.Combos.end(); ++Combo)
+			{
+				snprintf(szLine, sizeof(szLine), "%s %lld %.0f\n", It->first.c_str(), (long long)Combo->first, Combo->second * 1e6f);
+				Out += szLine;
+			}
+		}
+		return LuxWriteFile(pPath, Out);
+	}
+
+	// nDynamicIndices groups Combos by Static Index for the Fallback.
+	// A History recorded under another nLayout, or without one, is dropped. Returns true if it was
+	bool SetLayout(const std::string &Shader, int64_t nDynamicIndices, uint64_t nLayout)
+	{
+		Shader_t &Times = m_Shaders[Shader];
+		bool bDropped = Times.nLayout != nLayout && !Times.Combos.empty();
+		if (Times.nLayout != nLayout)
+			Times.Combos.clear();
+		Times.nLayout = nLayout;
+		Times.nDynamicIndices = std::max((int64_t)1, nDynamicIndices);
+		Rebuild();
+		return bDropped;
+	}
+
+	void Record(const std::string &Shader, int64_t nIndex, float flSeconds)
+	{
+		std::map<int64_t, float> &Combos = m_Shaders[Shader].Combos;
+		std::map<int64_t, float>::iterator It = Combos.find(nIndex);
+		if (It == Combos.end())
+			Combos[nIndex] = flSeconds;
+		else
+			It->second = It->second * 0.5f + flSeconds * 0.5f;
+	}
+
+	// Call after a Batch of Record()s, Predict() uses the Averages
+	void Rebuild()
+	{
+		m_flTotal = 0.0;
+		m_nTotal = 0;
+		for (std::map<std::string, Shader_t>::iterator It = m_Shaders.begin(); It != m_Shaders.end(); ++It)
+		{
+			Shader_t &Shader = It->second;
+			Shader.Statics.clear();
+			Shader.flTotal = 0.0;
+			for (std::map<int64_t, float>::const_iterator Combo = Shader.Combos.begin(); Combo != Shader.Combos.end(); ++Combo)
+			{
+				Average_t &Static = Shader.Statics[Combo->first / Shader.nDynamicIndices];
+				Static.flTotal += Combo->second;
+				Static.nCount++;
+				Shader.flTotal += Combo->second;
+			}
+			m_flTotal += Shader.flTotal;
+			m_nTotal += (int64_t)Shader.Combos.size();
+		}
+	}
+
+	// Seconds. bKnown is whether this exact Combo has a History
+	float Predict(const std::string &Shader, int64_t nIndex, bool *pKnown = NULL) const
+	{
+		if (pKnown)
+			*pKnown = false;
+
+		std::map<std::string, Shader_t>::const_iterator It = m_Shaders.find(Shader);
+		if (It != m_Shaders.end())
+		{
+			const Shader_t &Times = It->second;
+			std::map<int64_t, float>::const_iterator Combo = Times.Combos.find(nIndex);
+			if (Combo != Times.Combos.end())
+			{
+				if (pKnown)
+					*pKnown = true;
+				return Combo->second;
+			}
+
+			std::map<int64_t, Average_t>::const_iterator Static = Times.Statics.find(nIndex / Times.nDynamicIndices);
+			if (Static != Times.Statics.end())
+				return (float)(Static->second.flTotal / Static->second.nCount);
+			if (!Times.Combos.empty())
+				return (float)(Times.flTotal / Times.Combos.size());
+		}
+		return m_nTotal ? (float)(m_flTotal / m_nTotal) : 1.0f;
+	}
+
+	int64_t NumCombos() const { return m_nTotal; }
+
+private:
+	struct Average_t
+	{
+		Average_t() : flTotal(0.0), nCount(0) {}
+		double flTotal;
+		int64_t nCount;
+	};
+
+	struct Shader_t
+	{
+		Shader_t() : nDynamicIndices(1), nLayout(0), flTotal(0.0) {}
+		std::map<int64_t, float> Combos;
+		std::map<int64_t, Average_t> Statics;
+		int64_t nDynamicIndices;
+		uint64_t nLayout;			// 0 if the File didn't say
+		double flTotal;
+	};
+
+	void Set(const std::string &Shader, int64_t nIndex, float flSeconds) { m_Shaders[Shader].Combos[nIndex] = flSeconds; }
+
+	std::map<std::string, Shader_t> m_Shaders;
+	double m_flTotal;
+	int64_t m_nTotal;
+};
+
+// Greedy List Scheduling : each Job in Order goes to the Worker that's free first. Returns the Makespan
+inline double LuxSimulateMakespan(const std::vector<float> &Seconds, int nWorkers)
+{
+	std::vector<double> Free(std::max(1, nWorkers), 0.0);
+	for (size_t n = 0; n < Seconds.size(); n++)
+	{
+		std::vector<double>::iterator First = std::min_element(Free.begin(), Free.end());
+		*First += Seconds[n];
+	}
+	return *std::max_element(Free.begin(), Free.end());
+}
+
+// No Schedule beats the average Load per Worker or the longest single Job
+inline double LuxIdealMakespan(const std::vector<float> &Seconds, int nWorkers)
+{
+	double flTotal = 0.0, flLongest = 0.0;
+	for (size_t n = 0; n < Seconds.size(); n++)
+	{
+		flTotal += Seconds[n];
+		flLongest = std::max(flLongest, (double)Seconds[n]);
+	}
+	return std::max(flTotal / std::max(1, nWorkers), flLongest);
+}
+
+#endif // LUXTOOLS_COMPILETIMES_H
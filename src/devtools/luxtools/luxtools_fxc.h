@@ -0,0 +1,929 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Shader Source Helpers for the LUX Tools
+//
+//	Combo Declarations ( // STATIC:, // DYNAMIC:, // SKIP: ) and a small Preprocessor,
+//	enough for what our .fxc Files and lux_common_*.h Headers do :
+//	#include, #define / #undef ( object-like Macros are expanded, function-like ones are kept but not expanded ),
+//	#if / #ifdef / #ifndef / #elif / #else / #endif with defined() and the C Operators, #error.
+//	It doesn't compile anything, it tells the Tools which Lines are live for a given Combo.
+//	SetCompilerView() gets the Lines the Way the Compiler sees them, for comparing Combos.
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_FXC_H
+#define LUXTOOLS_FXC_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "luxtools.h"
+
+#include <ctype.h>
+#include <map>
+#include <set>
+
+inline bool LuxIsIdentStart(char c) { return isalpha((unsigned char)c) || c == '_'; }
+inline bool LuxIsIdentChar(char c) { return isalnum((unsigned char)c) || c == '_'; }
+
+inline std::string LuxTrim(const std::string &Text)
+{
+	size_t nStart = 0, nEnd = Text.size();
+	while (nStart < nEnd && isspace((unsigned char)Text[nStart]))
+		nStart++;
+	while (nEnd > nStart && isspace((unsigned char)Text[nEnd - 1]))
+		nEnd--;
+	return Text.substr(nStart, nEnd - nStart);
+}
+
+// "a/b/c.h" -> "a/b/"
+inline std::string LuxDirectoryOf(const std::string &Path)
+{
+	size_t n = Path.find_last_of("/\\");
+	return n == std::string::npos ? std::string() : Path.substr(0, n + 1);
+}
+
+// "a/b/c.h" -> "c.h"
+inline std::string LuxFileNameOf(const std::string &Path)
+{
+	size_t n = Path.find_last_of("/\\");
+	return n == std::string::npos ? Path : Path.substr(n + 1);
+}
+
+//==========================================================================//
+// #if Expressions. Everything has to be expanded already, Identifiers left over are 0 like in C
+//==========================================================================//
+class CLuxExpression
+{
+public:
+	static bool Evaluate(const std::string &Text, int64_t &nResult)
+	{
+		CLuxExpression Expression(Text);
+		nResult = Expression.Ternary();
+		Expression.SkipSpace();
+		return Expression.m_bOk && Expression.m_nPos == Text.size();
+	}
+
+private:
+	CLuxExpression(const std::string &Text) : m_Text(Text), m_nPos(0), m_bOk(true) {}
+
+	void SkipSpace()
+	{
+		while (m_nPos < m_Text.size() && isspace((unsigned char)m_Text[m_nPos]))
+			m_nPos++;
+	}
+
+	bool Accept(const char *pOp)
+	{
+		SkipSpace();
+		size_t nLen = strlen(pOp);
+		if (m_Text.compare(m_nPos, nLen, pOp) != 0)
+			return false;
+
+		// Don't take '<' out of '<<' or '<=', '&' out of '&&' and so on
+		char cNext = m_nPos + nLen < m_Text.size() ? m_Text[m_nPos + nLen] : 0;
+		if (nLen == 1 && strchr("<>&|=", pOp[0]) && (cNext == pOp[0] || cNext == '='))
+			return false;
+		if (nLen == 1 && pOp[0] == '!' && cNext == '=')
+			return false;
+
+		m_nPos += nLen;
+		return true;
+	}
+
+	int64_t Ternary()
+	{
+		int64_t nCondition = Binary(0);
+		if (!Accept("?"))
+			return nCondition;
+
+		int64_t nTrue = Ternary();
+		if (!Accept(":"))
+			m_bOk = false;
+		int64_t nFalse = Ternary();
+		return nCondition ? nTrue : nFalse;
+	}
+
+	// Lowest Precedence first
+	int64_t Binary(int nLevel)
+	{
+		static const char *s_Ops[][4] =
+		{
+			{ "||", 0 }, { "&&", 0 }, { "|", 0 }, { "^", 0 }, { "&", 0 },
+			{ "==", "!=", 0 }, { "<=", ">=", "<", ">" }, { "<<", ">>", 0 },
+			{ "+", "-", 0 }, { "*", "/", "%", 0 },
+		};
+		static const int s_nLevels = sizeof(s_Ops) / sizeof(s_Ops[0]);
+		if (nLevel == s_nLevels)
+			return Unary();
+
+		int64_t nLeft = Binary(nLevel + 1);
+		for (;;)
+		{
+			const char *pOp = 0;
+			for (int n = 0; n < 4 && s_Ops[nLevel][n]; n++)
+			{
+				if (Accept(s_Ops[nLevel][n]))
+				{
+					pOp = s_Ops[nLevel][n];
+					break;
+				}
+			}
+			if (!pOp)
+				return nLeft;
+
+			int64_t nRight = Binary(nLevel + 1);
+			if (!strcmp(pOp, "||")) nLeft = nLeft || nRight;
+			else if (!strcmp(pOp, "&&")) nLeft = nLeft && nRight;
+			else if (!strcmp(pOp, "|")) nLeft = nLeft | nRight;
+			else if (!strcmp(pOp, "^")) nLeft = nLeft ^ nRight;
+			else if (!strcmp(pOp, "&")) nLeft = nLeft & nRight;
+			else if (!strcmp(pOp, "==")) nLeft = nLeft == nRight;
+			else if (!strcmp(pOp, "!=")) nLeft = nLeft != nRight;
+			else if (!strcmp(pOp, "<=")) nLeft = nLeft <= nRight;
+			else if (!strcmp(pOp, ">=")) nLeft = nLeft >= nRight;
+			else if (!strcmp(pOp, "<")) nLeft = nLeft < nRight;
+			else if (!strcmp(pOp, ">")) nLeft = nLeft > nRight;
+			else if (!strcmp(pOp, "<<")) nLeft = nLeft << nRight;
+			else if (!strcmp(pOp, ">>")) nLeft = nLeft >> nRight;
+			else if (!strcmp(pOp, "+")) nLeft = nLeft + nRight;
+			else if (!strcmp(pOp, "-")) nLeft = nLeft - nRight;
+			else if (!strcmp(pOp, "*")) nLeft = nLeft * nRight;
+			else if (nRight == 0) m_bOk = false;
+			else if (!strcmp(pOp, "/")) nLeft = nLeft / nRight;
+			else nLeft = nLeft % nRight;
+		}
+	}
+
+	int64_t Unary()
+	{
+		if (Accept("!")) return !Unary();
+		if (Accept("~")) return ~Unary();
+		if (Accept("-")) return -Unary();
+		if (Accept("+")) return Unary();
+		if (Accept("("))
+		{
+			int64_t nValue = Ternary();
+			if (!Accept(")"))
+				m_bOk = false;
+			return nValue;
+		}
+
+		SkipSpace();
+		if (m_nPos >= m_Text.size())
+		{
+			m_bOk = false;
+			return 0;
+		}
+
+		if (isdigit((unsigned char)m_Text[m_nPos]))
+		{
+			const char *pStart = m_Text.c_str() + m_nPos;
+			char *pEnd;
+			int64_t nValue = (int64_t)strtoll(pStart, &pEnd, 0);
+
+			// 1.0f and such from HLSL Defines. Truncated, good enough for Conditions
+			if (*pEnd == '.')
+				nValue = (int64_t)strtod(pStart, &pEnd);
+			while (*pEnd && (LuxIsIdentChar(*pEnd)))
+				pEnd++;
+			m_nPos += pEnd - pStart;
+			return nValue;
+		}
+
+		if (LuxIsIdentStart(m_Text[m_nPos]))
+		{
+			size_t nStart = m_nPos;
+			while (m_nPos < m_Text.size() && LuxIsIdentChar(m_Text[m_nPos]))
+				m_nPos++;
+			return m_Text.compare(nStart, m_nPos - nStart, "true") == 0 ? 1 : 0;
+		}
+
+		m_bOk = false;
+		return 0;
+	}
+
+	const std::string &m_Text;
+	size_t m_nPos;
+	bool m_bOk;
+};
+
+//==========================================================================//
+// Combos
+//==========================================================================//
+struct LuxCombo_t
+{
+	std::string Name;
+	int nMin;
+	int nMax;
+	bool bStatic;
+
+	int Count() const { return nMax - nMin + 1; }
+};
+
+// Same Order as the generated Headers : Dynamic Combos first, then Static ones,
+// the first declared of each varies fastest
+class CLuxComboSet
+{
+public:
+	// Reads the Declarations out of a Shader's Source. Returns false if there are none
+	bool Parse(const std::string &Source)
+	{
+		m_Static.clear();
+		m_Dynamic.clear();
+		m_Skips.clear();
+
+		size_t nPos = 0;
+		while (nPos < Source.size())
+		{
+			size_t nEnd = Source.find('\n', nPos);
+			if (nEnd == std::string::npos)
+				nEnd = Source.size();
+			ParseLine(Source.substr(nPos, nEnd - nPos));
+			nPos = nEnd + 1;
+		}
+		return !m_Static.empty() || !m_Dynamic.empty();
+	}
+
+	// For Headers without Declarations, or to pin a Combo the Tool shouldn't iterate
+	void Add(const std::string &Name, int nMin, int nMax, bool bStatic)
+	{
+		LuxCombo_t Combo;
+		Combo.Name = Name;
+		Combo.nMin = nMin;
+		Combo.nMax = nMax;
+		Combo.bStatic = bStatic;
+		(bStatic ? m_Static : m_Dynamic).push_back(Combo);
+	}
+
+	void AddSkip(const std::string &Expression) { m_Skips.push_back(Expression); }
+
+	int NumCombos() const { return (int)(m_Dynamic.size() + m_Static.size()); }
+	const LuxCombo_t &Combo(int n) const { return n < (int)m_Dynamic.size() ? m_Dynamic[n] : m_Static[n - m_Dynamic.size()]; }
+	const std::vector<LuxCombo_t> &Static() const { return m_Static; }
+	const std::vector<LuxCombo_t> &Dynamic() const { return m_Dynamic; }
+	const std::vector<std::string> &Skips() const { return m_Skips; }
+
+	int64_t NumDynamicIndices() const { return Product(m_Dynamic); }
+	int64_t NumStaticIndices() const { return Product(m_Static); }
+	int64_t NumIndices() const { return NumDynamicIndices() * NumStaticIndices(); }
+
+	// Changes whenever an Index would mean a different Combo. SKIPs don't move Indices, they aren't in it
+	uint64_t LayoutHash() const
+	{
+		std::string Layout;
+		char szRange[64];
+		for (int n = 0; n < NumCombos(); n++)
+		{
+			const LuxCombo_t &Combo = this->Combo(n);
+			snprintf(szRange, sizeof(szRange), " %d %d %d\n", Combo.nMin, Combo.nMax, Combo.bStatic ? 1 : 0);
+			Layout += Combo.Name + szRange;
+		}
+		return LuxHashBytes(Layout.data(), Layout.size());
+	}
+
+	// Index -> one Value per Combo, in Combo() Order
+	void Decode(int64_t nIndex, std::vector<int> &Values) const
+	{
+		Values.resize(NumCombos());
+		for (int n = 0; n < NumCombos(); n++)
+		{
+			const LuxCombo_t &Combo = this->Combo(n);
+			Values[n] = Combo.nMin + (int)(nIndex % Combo.Count());
+			nIndex /= Combo.Count();
+		}
+	}
+
+	int64_t Encode(const std::vector<int> &Values) const
+	{
+		int64_t nIndex = 0, nScale = 1;
+		for (int n = 0; n < NumCombos(); n++)
+		{
+			const LuxCombo_t &Combo = this->Combo(n);
+			nIndex += (Values[n] - Combo.nMin) * nScale;
+			nScale *= Combo.Count();
+		}
+		return nIndex;
+	}
+
+	// $NAME replaced by its Value, then evaluated. Broken Expressions don't skip
+	bool IsSkipped(const std::vector<int> &Values) const
+	{
+		for (size_t nSkip = 0; nSkip < m_Skips.size(); nSkip++)
+		{
+			int64_t nResult;
+			if (CLuxExpression::Evaluate(Substitute(m_Skips[nSkip], Values), nResult) && nResult)
+				return true;
+		}
+		return false;
+	}
+
+	// "BRUSH=0 NUM_LIGHTS=2 .."
+	std::string Describe(const std::vector<int> &Values) const
+	{
+		std::string Out;
+		char Buffer[32];
+		for (int n = 0; n < NumCombos(); n++)
+		{
+			snprintf(Buffer, sizeof(Buffer), "=%d", Values[n]);
+			Out += (n ? " " : "") + Combo(n).Name + Buffer;
+		}
+		return Out;
+	}
+
+	std::string Substitute(const std::string &Expression, const std::vector<int> &Values) const
+	{
+		std::string Out;
+		for (size_t n = 0; n < Expression.size(); n++)
+		{
+			if (Expression[n] != '$')
+			{
+				Out += Expression[n];
+				continue;
+			}
+
+			size_t nEnd = n + 1;
+			while (nEnd < Expression.size() && LuxIsIdentChar(Expression[nEnd]))
+				nEnd++;
+
+			std::string Name = Expression.substr(n + 1, nEnd - n - 1);
+			int nValue = 0;
+			for (int nCombo = 0; nCombo < NumCombos(); nCombo++)
+			{
+				if (Combo(nCombo).Name == Name)
+					nValue = Values[nCombo];
+			}
+
+			char Buffer[16];
+			snprintf(Buffer, sizeof(Buffer), "%d", nValue);
+			Out += Buffer;
+			n = nEnd - 1;
+		}
+		return Out;
+	}
+
+private:
+	static int64_t Product(const std::vector<LuxCombo_t> &Combos)
+	{
+		int64_t nCount = 1;
+		for (size_t n = 0; n < Combos.size(); n++)
+			nCount *= Combos[n].Count();
+		return nCount;
+	}
+
+	// Trailing [ps30] / [vs30] / [= ..] Annotations are ignored
+	void ParseLine(const std::string &Line)
+	{
+		size_t nComment = Line.find("//");
+		if (nComment == std::string::npos)
+			return;
+
+		std::string Text = LuxTrim(Line.substr(nComment + 2));
+		bool bStatic = !Text.compare(0, 7, "STATIC:");
+		bool bDynamic = !Text.compare(0, 8, "DYNAMIC:");
+		if (!Text.compare(0, 5, "SKIP:"))
+		{
+			std::string Expression = LuxTrim(Text.substr(5));
+			size_t nBracket = Expression.find('[');
+			if (nBracket != std::string::npos)
+				Expression = LuxTrim(Expression.substr(0, nBracket));
+			if (!Expression.empty())
+				m_Skips.push_back(Expression);
+			return;
+		}
+
+		if (!bStatic && !bDynamic)
+			return;
+
+		// "NAME" "min..max"
+		std::vector<std::string> Quoted;
+		size_t nPos = 0;
+		while (Quoted.size() < 2)
+		{
+			size_t nOpen = Text.find('"', nPos);
+			size_t nClose = nOpen == std::string::npos ? nOpen : Text.find('"', nOpen + 1);
+			if (nClose == std::string::npos)
+				return;
+			Quoted.push_back(Text.substr(nOpen + 1, nClose - nOpen - 1));
+			nPos = nClose + 1;
+		}
+
+		int nMin, nMax;
+		if (sscanf(Quoted[1].c_str(), "%d..%d", &nMin, &nMax) != 2 || nMax < nMin)
+			return;
+		Add(Quoted[0], nMin, nMax, bStatic);
+	}
+
+	std::vector<LuxCombo_t> m_Static;
+	std::vector<LuxCombo_t> m_Dynamic;
+	std::vector<std::string> m_Skips;
+};
+
+//==========================================================================//
+// Source Files with Comments stripped and Continuations joined, Line Numbers kept.
+// Loaded once, every Combo preprocesses the same Files
+//==========================================================================//
+struct LuxSourceLine_t
+{
+	std::string Text;
+	int nLine;			// 1-based, first physical Line of the logical one
+};
+
+class CLuxSourceCache
+{
+public:
+	// NULL if the File doesn't exist
+	const std::vector<LuxSourceLine_t> *Load(const std::string &Path)
+	{
+		std::map<std::string, std::vector<LuxSourceLine_t> >::iterator it = m_Files.find(Path);
+		if (it != m_Files.end())
+			return &it->second;
+
+		std::string Source;
+		if (!LuxReadFile(Path.c_str(), Source))
+			return NULL;
+
+		std::vector<LuxSourceLine_t> &Lines = m_Files[Path];
+		Split(Source, Lines);
+		return &Lines;
+	}
+
+	// Raw Text, for Combo Declarations that live in Comments
+	static void Split(const std::string &Source, std::vector<LuxSourceLine_t> &Lines)
+	{
+		bool bBlockComment = false;
+		LuxSourceLine_t Current;
+		Current.nLine = 1;
+		int nLine = 1;
+
+		for (size_t n = 0; n <= Source.size(); n++)
+		{
+			char c = n < Source.size() ? Source[n] : '\n';
+			if (c == '\r')
+				continue;
+
+			if (c == '\n')
+			{
+				nLine++;
+				// Continuation, the next physical Line belongs to this one
+				size_t nLen = Current.Text.size();
+				if (nLen && Current.Text[nLen - 1] == '\\')
+				{
+					Current.Text.erase(nLen - 1);
+					Current.Text += ' ';
+					continue;
+				}
+
+				Lines.push_back(Current);
+				Current.Text.clear();
+				Current.nLine = nLine;
+				continue;
+			}
+
+			if (bBlockComment)
+			{
+				if (c == '*' && n + 1 < Source.size() && Source[n + 1] == '/')
+				{
+					bBlockComment = false;
+					Current.Text += ' ';
+					n++;
+				}
+				continue;
+			}
+
+			if (c == '/' && n + 1 < Source.size() && Source[n + 1] == '/')
+			{
+				while (n + 1 < Source.size() && Source[n + 1] != '\n')
+					n++;
+				continue;
+			}
+
+			if (c == '/' && n + 1 < Source.size() && Source[n + 1] == '*')
+			{
+				bBlockComment = true;
+				n++;
+				continue;
+			}
+
+			if (c == '"')
+			{
+				size_t nEnd = n + 1;
+				while (nEnd < Source.size() && Source[nEnd] != '"' && Source[nEnd] != '\n')
+					nEnd += Source[nEnd] == '\\' ? 2 : 1;
+				nEnd = nEnd < Source.size() ? nEnd : Source.size() - 1;
+				Current.Text.append(Source, n, nEnd - n + 1);
+				n = nEnd;
+				continue;
+			}
+
+			Current.Text += c == '\t' ? ' ' : c;
+		}
+	}
+
+private:
+	std::map<std::string, std::vector<LuxSourceLine_t> > m_Files;
+};
+
+//==========================================================================//
+// Preprocessor
+//==========================================================================//
+struct LuxMacro_t
+{
+	std::string Body;
+	bool bFunction;		// Kept, but never expanded
+	int nFile;			// Index into CLuxPreprocessor::Files()
+	int nLine;
+};
+
+// An active Line that isn't a Directive
+struct LuxActiveLine_t
+{
+	std::string Text;
+	int nFile;
+	int nLine;
+};
+
+class CLuxPreprocessor
+{
+public:
+	CLuxPreprocessor(CLuxSourceCache *pCache = NULL) : m_pCache(pCache ? pCache : &m_OwnCache), m_bCompilerView(false) {}
+
+	// Lines get Object-like Macros expanded as they're read, so later #define / #undef don't change them,
+	// and #pragma, #error and any other Directive the Compiler acts on are kept as Lines. Call before Run()
+	void SetCompilerView(bool bCompilerView) { m_bCompilerView = bCompilerView; }
+
+	void AddIncludeDir(const std::string &Dir)
+	{
+		std::string Path = Dir;
+		if (!Path.empty() && Path[Path.size() - 1] != '/' && Path[Path.size() - 1] != '\\')
+			Path += '/';
+		m_IncludeDirs.push_back(Path);
+	}
+
+	void Define(const std::string &Name, const std::string &Body)
+	{
+		LuxMacro_t &Macro = m_Macros[Name];
+		Macro.Body = Body;
+		Macro.bFunction = false;
+		Macro.nFile = -1;
+		Macro.nLine = 0;
+	}
+
+	void Undef(const std::string &Name) { m_Macros.erase(Name); }
+	bool IsDefined(const std::string &Name) const { return m_Macros.count(Name) != 0; }
+
+	const LuxMacro_t *FindMacro(const std::string &Name) const
+	{
+		std::map<std::string, LuxMacro_t>::const_iterator it = m_Macros.find(Name);
+		return it == m_Macros.end() ? NULL : &it->second;
+	}
+
+	const std::map<std::string, LuxMacro_t> &Macros() const { return m_Macros; }
+
+	// Object-like Macros, recursively
+	std::string Expand(const std::string &Text) const
+	{
+		std::set<std::string> Active;
+		return Expand(Text, Active);
+	}
+
+	// #if Semantics. Returns false on a broken Expression
+	bool Evaluate(const std::string &Text, int64_t &nResult) const
+	{
+		return CLuxExpression::Evaluate(Expand(ReplaceDefined(Text)), nResult);
+	}
+
+	// Adds the File's active Lines. Can be called more than once, Macros carry over
+	bool Run(const std::string &Path)
+	{
+		if (!m_pCache->Load(Path))
+		{
+			m_Problems.push_back("Can't open " + Path);
+			return false;
+		}
+		Process(Path, 0, -1);
+		return true;
+	}
+
+	const std::vector<LuxActiveLine_t> &Lines() const { return m_Lines; }
+	const std::vector<std::string> &Files() const { return m_Files; }
+
+	// Per Files() Entry, the Index of the File that included it. -1 for what Run() was given
+	const std::vector<int> &Parents() const { return m_Parents; }
+
+	// #pragma, #error and any other Directive the Compiler acts on, in active Blocks. Lines() has them too in the Compiler View
+	const std::vector<LuxActiveLine_t> &Directives() const { return m_Directives; }
+
+	// Names #if / #ifdef / #ifndef / #elif asked about in an active Block, with the Files() Index that asked
+	const std::set<std::pair<std::string, int> > &Tested() const { return m_Tested; }
+
+	// Missing Includes, #error, broken Conditions. Tools decide whether that's fatal
+	const std::vector<std::string> &Problems() const { return m_Problems; }
+
+	// Includes that weren't found. Usually SDK Headers, which we don't need
+	const std::set<std::string> &Missing() const { return m_Missing; }
+
+private:
+	struct Condition_t
+	{
+		bool bParentActive;
+		bool bActive;
+		bool bTaken;
+	};
+
+	std::string Expand(const std::string &Text, std::set<std::string> &Active) const
+	{
+		std::string Out;
+		for (size_t n = 0; n < Text.size(); )
+		{
+			if (Text[n] == '"')
+			{
+				size_t nEnd = Text.find('"', n + 1);
+				nEnd = nEnd == std::string::npos ? Text.size() : nEnd + 1;
+				Out.append(Text, n, nEnd - n);
+				n = nEnd;
+				continue;
+			}
+
+			// Numbers like 1e5f aren't Identifiers
+			if (isdigit((unsigned char)Text[n]))
+			{
+				size_t nEnd = n;
+				while (nEnd < Text.size() && (LuxIsIdentChar(Text[nEnd]) || Text[nEnd] == '.'))
+					nEnd++;
+				Out.append(Text, n, nEnd - n);
+				n = nEnd;
+				continue;
+			}
+
+			if (!LuxIsIdentStart(Text[n]))
+			{
+				Out += Text[n++];
+				continue;
+			}
+
+			size_t nEnd = n;
+			while (nEnd < Text.size() && LuxIsIdentChar(Text[nEnd]))
+				nEnd++;
+
+			std::string Name = Text.substr(n, nEnd - n);
+			const LuxMacro_t *pMacro = FindMacro(Name);
+			if (pMacro && !pMacro->bFunction && !Active.count(Name))
+			{
+				Active.insert(Name);
+				Out += Expand(pMacro->Body, Active);
+				Active.erase(Name);
+			}
+			else
+				Out += Name;
+			n = nEnd;
+		}
+		return Out;
+	}
+
+	std::string ReplaceDefined(const std::string &Text) const
+	{
+		std::string Out;
+		for (size_t n = 0; n < Text.size(); )
+		{
+			if (!LuxIsIdentStart(Text[n]) || (n && LuxIsIdentChar(Text[n - 1])) || Text.compare(n, 7, "defined") || (n + 7 < Text.size() && LuxIsIdentChar(Text[n + 7])))
+			{
+				Out += Text[n++];
+				continue;
+			}
+
+			size_t nPos = n + 7;
+			while (nPos < Text.size() && isspace((unsigned char)Text[nPos]))
+				nPos++;
+			bool bParen = nPos < Text.size() && Text[nPos] == '(';
+			if (bParen)
+				nPos++;
+			while (nPos < Text.size() && isspace((unsigned char)Text[nPos]))
+				nPos++;
+
+			size_t nStart = nPos;
+			while (nPos < Text.size() && LuxIsIdentChar(Text[nPos]))
+				nPos++;
+			std::string Name = Text.substr(nStart, nPos - nStart);
+
+			if (bParen)
+			{
+				while (nPos < Text.size() && Text[nPos] != ')')
+					nPos++;
+				nPos++;
+			}
+
+			Out += IsDefined(Name) ? " 1 " : " 0 ";
+			n = nPos;
+		}
+		return Out;
+	}
+
+	std::string ResolveInclude(const std::string &Name, const std::string &From) const
+	{
+		std::string Path = LuxDirectoryOf(From) + Name;
+		if (m_pCache->Load(Path))
+			return Path;
+
+		for (size_t n = 0; n < m_IncludeDirs.size(); n++)
+		{
+			Path = m_IncludeDirs[n] + Name;
+			if (m_pCache->Load(Path))
+				return Path;
+		}
+		return std::string();
+	}
+
+	bool IsActive(const std::vector<Condition_t> &Stack) const { return Stack.empty() || Stack.back().bActive; }
+
+	void Process(const std::string &Path, int nDepth, int nParent)
+	{
+		if (nDepth > 64)
+		{
+			m_Problems.push_back("Include Depth exceeded in " + Path);
+			return;
+		}
+
+		const std::vector<LuxSourceLine_t> *pLines = m_pCache->Load(Path);
+		int nFile = (int)m_Files.size();
+		m_Files.push_back(Path);
+		m_Parents.push_back(nParent);
+
+		std::vector<Condition_t> Stack;
+		for (size_t nLine = 0; nLine < pLines->size(); nLine++)
+		{
+			const LuxSourceLine_t &Line = (*pLines)[nLine];
+			std::string Text = LuxTrim(Line.Text);
+			if (Text.empty())
+				continue;
+
+			if (Text[0] != '#')
+			{
+				if (IsActive(Stack))
+					AddLine(m_bCompilerView ? Expand(Text) : Text, nFile, Line.nLine);
+				continue;
+			}
+
+			size_t nPos = 1;
+			while (nPos < Text.size() && isspace((unsigned char)Text[nPos]))
+				nPos++;
+			size_t nEnd = nPos;
+			while (nEnd < Text.size() && LuxIsIdentChar(Text[nEnd]))
+				nEnd++;
+
+			std::string Directive = Text.substr(nPos, nEnd - nPos);
+			std::string Rest = LuxTrim(Text.substr(nEnd));
+
+			char Where[512];
+			snprintf(Where, sizeof(Where), "%s(%d)", Path.c_str(), Line.nLine);
+
+			if (Directive == "if" || Directive == "ifdef" || Directive == "ifndef")
+			{
+				Condition_t Condition;
+				Condition.bParentActive = IsActive(Stack);
+				Condition.bActive = false;
+				if (Condition.bParentActive)
+				{
+					NoteTested(Rest, nFile);
+					if (Directive == "if")
+						Condition.bActive = Test(Rest, Where);
+					else
+						Condition.bActive = IsDefined(FirstIdentifier(Rest)) == (Directive == "ifdef");
+				}
+				Condition.bTaken = Condition.bActive;
+				Stack.push_back(Condition);
+			}
+			else if (Directive == "elif")
+			{
+				if (Stack.empty())
+					continue;
+				Condition_t &Condition = Stack.back();
+				if (Condition.bParentActive && !Condition.bTaken)
+					NoteTested(Rest, nFile);
+				Condition.bActive = Condition.bParentActive && !Condition.bTaken && Test(Rest, Where);
+				Condition.bTaken |= Condition.bActive;
+			}
+			else if (Directive == "else")
+			{
+				if (Stack.empty())
+					continue;
+				Condition_t &Condition = Stack.back();
+				Condition.bActive = Condition.bParentActive && !Condition.bTaken;
+				Condition.bTaken = true;
+			}
+			else if (Directive == "endif")
+			{
+				if (!Stack.empty())
+					Stack.pop_back();
+			}
+			else if (!IsActive(Stack))
+				continue;
+			else if (Directive == "define")
+				ParseDefine(Rest, nFile, Line.nLine);
+			else if (Directive == "undef")
+				Undef(FirstIdentifier(Rest));
+			else if (Directive == "include")
+			{
+				std::string Name = Rest.size() > 2 ? Rest.substr(1, Rest.find_first_of("\">", 1) - 1) : std::string();
+				std::string IncludePath = ResolveInclude(Name, Path);
+				if (IncludePath.empty())
+					m_Missing.insert(Name);
+				else
+					Process(IncludePath, nDepth + 1, nFile);
+			}
+			else
+			{
+				if (Directive == "error")
+					m_Problems.push_back(std::string(Where) + ": #error " + Rest);
+				LuxActiveLine_t Kept;
+				Kept.Text = Text;
+				Kept.nFile = nFile;
+				Kept.nLine = Line.nLine;
+				m_Directives.push_back(Kept);
+				if (m_bCompilerView)
+					m_Lines.push_back(Kept);
+			}
+		}
+
+		if (!Stack.empty())
+			m_Problems.push_back("Unterminated #if in " + Path);
+	}
+
+	void NoteTested(const std::string &Expression, int nFile)
+	{
+		for (size_t n = 0; n < Expression.size(); )
+		{
+			if (!LuxIsIdentChar(Expression[n]))
+			{
+				n++;
+				continue;
+			}
+			size_t nEnd = n;
+			while (nEnd < Expression.size() && LuxIsIdentChar(Expression[nEnd]))
+				nEnd++;
+			// 0x10 and 1u aren't Names
+			if (LuxIsIdentStart(Expression[n]) && Expression.compare(n, nEnd - n, "defined"))
+				m_Tested.insert(std::make_pair(Expression.substr(n, nEnd - n), nFile));
+			n = nEnd;
+		}
+	}
+
+	void AddLine(const std::string &Text, int nFile, int nLine)
+	{
+		LuxActiveLine_t Active;
+		Active.Text = Text;
+		Active.nFile = nFile;
+		Active.nLine = nLine;
+		m_Lines.push_back(Active);
+	}
+
+	bool Test(const std::string &Expression, const char *pWhere)
+	{
+		int64_t nResult = 0;
+		if (!Evaluate(Expression, nResult))
+			m_Problems.push_back(std::string(pWhere) + ": can't evaluate #if " + Expression);
+		return nResult != 0;
+	}
+
+	static std::string FirstIdentifier(const std::string &Text)
+	{
+		size_t nEnd = 0;
+		while (nEnd < Text.size() && LuxIsIdentChar(Text[nEnd]))
+			nEnd++;
+		return Text.substr(0, nEnd);
+	}
+
+	void ParseDefine(const std::string &Text, int nFile, int nLine)
+	{
+		std::string Name = FirstIdentifier(Text);
+		if (Name.empty())
+			return;
+
+		LuxMacro_t &Macro = m_Macros[Name];
+		Macro.bFunction = Text.size() > Name.size() && Text[Name.size()] == '(';
+		Macro.Body = LuxTrim(Text.substr(Name.size()));
+		if (Macro.bFunction)
+			Macro.Body = LuxTrim(Macro.Body.substr(Macro.Body.find(')') + 1));
+		Macro.nFile = nFile;
+		Macro.nLine = nLine;
+	}
+
+	CLuxSourceCache m_OwnCache;
+	CLuxSourceCache *m_pCache;
+	std::vector<std::string> m_IncludeDirs;
+	std::map<std::string, LuxMacro_t> m_Macros;
+	std::vector<LuxActiveLine_t> m_Lines;
+	std::vector<std::string> m_Files;
+	std::vector<int> m_Parents;
+	std::vector<LuxActiveLine_t> m_Directives;
+	std::set<std::pair<std::string, int> > m_Tested;
+	std::vector<std::string> m_Problems;
+	std::set<std::string> m_Missing;
+	bool m_bCompilerView;
+};
+
+#endif // LUXTOOLS_FXC_H
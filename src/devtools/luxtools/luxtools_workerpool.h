@@ -0,0 +1,743 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Long-lived Compiler Worker Processes for the LUX Tools
+//
+//	A Worker is the Tool itself started with -worker. It loads its Compiler Backend once,
+//	says Hello and then takes Jobs over stdin, answering on stdout, until it gets a Quit or the Pipe closes.
+//	The Protocol is binary, a fixed 12 Byte Header and a Payload, all Integers little-endian :
+//
+//		Header			uint16 Type, uint16 Flags, uint32 Job, uint32 Payload Size
+//		LUXMSG_HELLO	Worker -> Tool	uint32 Status, then the Error Text if it isn't 0
+//		LUXMSG_SHADER	Tool -> Worker	uint32 Shader ID, Path\0 Target\0, uint32 Combos, Names\0 ..
+//		LUXMSG_JOB		Tool -> Worker	uint32 Shader ID, uint32 Combos, int32 Value per Combo in Shader Order
+//		LUXMSG_RESULT	Worker -> Tool	uint32 Status, uint32 Microseconds in the Backend, then the Bytecode,
+//										or the Error Text if Status isn't 0
+//		LUXMSG_QUIT		Tool -> Worker
+//
+//	Shaders are sent once per Worker, a Job is then a few Bytes. CLuxWorkerPool runs one Thread per Worker
+//	that keeps it busy, the Jobs are handed out through an atomic Index in the Order they're given.
+//	A Worker that dies is started again and gets the Shaders again, the Job it had goes back in the Queue.
+//	A Job that takes down LUX_WORKER_ATTEMPTS Workers fails as "Worker died".
+//
+//	Pipe Ends are close-on-exec ( not inheritable on Windows ), a Worker only holds its own Ends.
+//	Otherwise a Sibling started after it keeps them open and a dead Worker's Pipe never reads as closed.
+//
+//==========================================================================//
+
+#ifndef LUXTOOLS_WORKERPOOL_H
+#define LUXTOOLS_WORKERPOOL_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "luxtools.h"
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <map>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+
+// Workers a single Job may take down before it's given up on
+#define LUX_WORKER_ATTEMPTS 2
+
+enum LuxMessages_t
+{
+	LUXMSG_HELLO = 1,
+	LUXMSG_SHADER,
+	LUXMSG_JOB,
+	LUXMSG_RESULT,
+	LUXMSG_QUIT,
+};
+
+struct LuxMessageHeader_t
+{
+	uint16_t nType;
+	uint16_t nFlags;
+	uint32_t nJob;
+	uint32_t nSize;
+};
+
+// A Shader the Worker has been told about
+struct LuxWorkerShader_t
+{
+	std::string Path;
+	std::string Target;			// ps_3_0, vs_3_0
+	std::vector<std::string> Combos;
+};
+
+// Loaded once per Worker. Compile() is called for every Job, Out is the Bytecode or the Error Text
+class ILuxCompilerBackend
+{
+public:
+	virtual ~ILuxCompilerBackend() {}
+	virtual bool Load(std::string &Error) = 0;
+	virtual bool Compile(const LuxWorkerShader_t &Shader, const std::vector<int> &Values, std::string &Out) = 0;
+};
+
+//==========================================================================//
+// Payloads
+//==========================================================================//
+inline void LuxPut32(std::string &Out, uint32_t n)
+{
+	char Bytes[4] = { (char)(n & 0xFF), (char)((n >> 8) & 0xFF), (char)((n >> 16) & 0xFF), (char)(n >> 24) };
+	Out.append(Bytes, 4);
+}
+
+inline void LuxPutString(std::string &Out, const std::string &Text)
+{
+	Out += Text;
+	Out += '\0';
+}
+
+// Reads out of a Payload, anything past the End reads as 0 and sets m_bOverflow
+class CLuxPayloadReader
+{
+public:
+	CLuxPayloadReader(const std::string &Payload) : m_Payload(Payload), m_nPos(0), m_bOverflow(false) {}
+
+	uint32_t Get32()
+	{
+		if (m_nPos + 4 > m_Payload.size())
+		{
+			m_bOverflow = true;
+			return 0;
+		}
+		const unsigned char *p = (const unsigned char *)m_Payload.data() + m_nPos;
+		m_nPos += 4;
+		return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+	}
+
+	std::string GetString()
+	{
+		size_t nEnd = m_Payload.find('\0', m_nPos);
+		if (nEnd == std::string::npos)
+		{
+			m_bOverflow = true;
+			return std::string();
+		}
+		std::string Text = m_Payload.substr(m_nPos, nEnd - m_nPos);
+		m_nPos = nEnd + 1;
+		return Text;
+	}
+
+	std::string Rest() const { return m_nPos < m_Payload.size() ? m_Payload.substr(m_nPos) : std::string(); }
+	bool Overflowed() const { return m_bOverflow; }
+
+private:
+	const std::string &m_Payload;
+	size_t m_nPos;
+	bool m_bOverflow;
+};
+
+//==========================================================================//
+// Pipe Ends. Blocking, Reads and Writes loop until everything went through
+//==========================================================================//
+class CLuxPipe
+{
+public:
+#ifdef _WIN32
+	CLuxPipe(HANDLE hRead = INVALID_HANDLE_VALUE, HANDLE hWrite = INVALID_HANDLE_VALUE) : m_hRead(hRead), m_hWrite(hWrite) {}
+#else
+	CLuxPipe(int nRead = -1, int nWrite = -1) : m_nRead(nRead), m_nWrite(nWrite) {}
+#endif
+
+	bool Write(const void *pData, size_t nSize)
+	{
+		const char *p = (const char *)pData;
+		while (nSize)
+		{
+#ifdef _WIN32
+			DWORD nDone;
+			if (!WriteFile(m_hWrite, p, (DWORD)std::min(nSize, (size_t)1 << 20), &nDone, NULL) || !nDone)
+				return false;
+#else
+			ssize_t nDone = write(m_nWrite, p, nSize);
+			if (nDone <= 0)
+				return false;
+#endif
+			p += nDone;
+			nSize -= nDone;
+		}
+		return true;
+	}
+
+	bool Read(void *pData, size_t nSize)
+	{
+		char *p = (char *)pData;
+		while (nSize)
+		{
+#ifdef _WIN32
+			DWORD nDone;
+			if (!ReadFile(m_hRead, p, (DWORD)std::min(nSize, (size_t)1 << 20), &nDone, NULL) || !nDone)
+				return false;
+#else
+			ssize_t nDone = read(m_nRead, p, nSize);
+			if (nDone <= 0)
+				return false;
+#endif
+			p += nDone;
+			nSize -= nDone;
+		}
+		return true;
+	}
+
+	// Header and Payload in one Write, so small Messages are one Syscall
+	bool Send(uint16_t nType, uint32_t nJob, const std::string &Payload)
+	{
+		std::string Message;
+		Message.reserve(sizeof(LuxMessageHeader_t) + Payload.size());
+		Message += (char)(nType & 0xFF);
+		Message += (char)(nType >> 8);
+		Message.append(2, '\0');
+		LuxPut32(Message, nJob);
+		LuxPut32(Message, (uint32_t)Payload.size());
+		Message += Payload;
+		return Write(Message.data(), Message.size());
+	}
+
+	bool Receive(LuxMessageHeader_t &Header, std::string &Payload)
+	{
+		unsigned char Bytes[12];
+		if (!Read(Bytes, sizeof(Bytes)))
+			return false;
+		Header.nType = (uint16_t)(Bytes[0] | (Bytes[1] << 8));
+		Header.nFlags = (uint16_t)(Bytes[2] | (Bytes[3] << 8));
+		Header.nJob = Bytes[4] | (Bytes[5] << 8) | (Bytes[6] << 16) | ((uint32_t)Bytes[7] << 24);
+		Header.nSize = Bytes[8] | (Bytes[9] << 8) | (Bytes[10] << 16) | ((uint32_t)Bytes[11] << 24);
+		Payload.resize(Header.nSize);
+		return !Header.nSize || Read(&Payload[0], Header.nSize);
+	}
+
+	void Close()
+	{
+#ifdef _WIN32
+		if (m_hRead != INVALID_HANDLE_VALUE)
+			CloseHandle(m_hRead);
+		if (m_hWrite != INVALID_HANDLE_VALUE)
+			CloseHandle(m_hWrite);
+		m_hRead = m_hWrite = INVALID_HANDLE_VALUE;
+#else
+		if (m_nRead >= 0)
+			close(m_nRead);
+		if (m_nWrite >= 0)
+			close(m_nWrite);
+		m_nRead = m_nWrite = -1;
+#endif
+	}
+
+private:
+#ifdef _WIN32
+	HANDLE m_hRead;
+	HANDLE m_hWrite;
+#else
+	int m_nRead;
+	int m_nWrite;
+#endif
+};
+
+//==========================================================================//
+// Worker Side. Returns the Exit Code
+//==========================================================================//
+inline int LuxWorkerMain(ILuxCompilerBackend &Backend)
+{
+#ifdef _WIN32
+	_setmode(_fileno(stdin), _O_BINARY);
+	_setmode(_fileno(stdout), _O_BINARY);
+	CLuxPipe Pipe(GetStdHandle(STD_INPUT_HANDLE), GetStdHandle(STD_OUTPUT_HANDLE));
+#else
+	CLuxPipe Pipe(0, 1);
+#endif
+
+	std::string Error, Payload, Out;
+	bool bLoaded = Backend.Load(Error);
+	Payload.clear();
+	LuxPut32(Payload, bLoaded ? 0 : 1);
+	Payload += bLoaded ? "" : Error;
+	if (!Pipe.Send(LUXMSG_HELLO, 0, Payload) || !bLoaded)
+		return 1;
+
+	std::vector<LuxWorkerShader_t> Shaders;
+	std::vector<int> Values;
+	LuxMessageHeader_t Header;
+	while (Pipe.Receive(Header, Payload))
+	{
+		CLuxPayloadReader Reader(Payload);
+		if (Header.nType == LUXMSG_QUIT)
+			return 0;
+
+		if (Header.nType == LUXMSG_SHADER)
+		{
+			uint32_t nShader = Reader.Get32();
+			if (nShader > 4096)
+				return 1;
+			if (nShader >= Shaders.size())
+				Shaders.resize(nShader + 1);
+			LuxWorkerShader_t &Shader = Shaders[nShader];
+			Shader.Path = Reader.GetString();
+			Shader.Target = Reader.GetString();
+			Shader.Combos.resize(std::min(Reader.Get32(), (uint32_t)64));
+			for (size_t n = 0; n < Shader.Combos.size(); n++)
+				Shader.Combos[n] = Reader.GetString();
+			if (Reader.Overflowed())
+				return 1;
+			continue;
+		}
+
+		if (Header.nType != LUXMSG_JOB)
+			return 1;
+
+		uint32_t nShader = Reader.Get32();
+		Values.resize(std::min(Reader.Get32(), (uint32_t)64));
+		for (size_t n = 0; n < Values.size(); n++)
+			Values[n] = (int)Reader.Get32();
+
+		Out.clear();
+		bool bOk = false;
+		double flStart = LuxTimeSeconds();
+		if (Reader.Overflowed() || nShader >= Shaders.size() || Values.size() != Shaders[nShader].Combos.size())
+			Out = "Malformed Job";
+		else
+			bOk = Backend.Compile(Shaders[nShader], Values, Out);
+
+		Payload.clear();
+		LuxPut32(Payload, bOk ? 0 : 1);
+		LuxPut32(Payload, (uint32_t)((LuxTimeSeconds() - flStart) * 1e6));
+		Payload += Out;
+		if (!Pipe.Send(LUXMSG_RESULT, Header.nJob, Payload))
+			return 1;
+	}
+	return 0;
+}
+
+//==========================================================================//
+// Tool Side
+//==========================================================================//
+struct LuxWorkerJob_t
+{
+	LuxWorkerJob_t() : nShader(0), bOk(false), flSeconds(0.0f) {}
+
+	uint32_t nShader;
+	std::vector<int> Values;
+
+	// Filled in by the Pool
+	bool bOk;
+	std::string Out;
+	float flSeconds;			// In the Backend, without the Round Trip
+};
+
+// Held while a Child's Pipe Ends are inheritable, so no other Worker started meanwhile gets them too
+inline std::mutex &LuxSpawnMutex()
+{
+	static std::mutex s_Mutex;
+	return s_Mutex;
+}
+
+#ifndef _WIN32
+// Both Ends close-on-exec. dup2() onto stdin / stdout clears it again for the Child
+inline bool LuxPipeCloseOnExec(int nFds[2])
+{
+#ifdef __linux__
+	return pipe2(nFds, O_CLOEXEC) == 0;
+#else
+	if (pipe(nFds))
+		return false;
+	fcntl(nFds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(nFds[1], F_SETFD, FD_CLOEXEC);
+	return true;
+#endif
+}
+#endif
+
+// The running Executable, so Workers can be started from it
+inline std::string LuxExecutablePath(const char *pArgv0)
+{
+#ifdef _WIN32
+	char szPath[MAX_PATH];
+	DWORD nLength = GetModuleFileNameA(NULL, szPath, sizeof(szPath));
+	return nLength && nLength < sizeof(szPath) ? std::string(szPath) : std::string(pArgv0);
+#else
+	char szPath[4096];
+	ssize_t nLength = readlink("/proc/self/exe", szPath, sizeof(szPath) - 1);
+	return nLength > 0 ? std::string(szPath, nLength) : std::string(pArgv0);
+#endif
+}
+
+class CLuxWorkerProcess
+{
+public:
+	CLuxWorkerProcess() : m_bRunning(false)
+	{
+#ifdef _WIN32
+		m_hProcess = NULL;
+#else
+		m_nPid = -1;
+#endif
+	}
+
+	~CLuxWorkerProcess() { Stop(); }
+
+	// Starts Executable with Args and waits for its Hello
+	bool Start(const std::string &Executable, const std::vector<std::string> &Args, std::string &Error)
+	{
+#ifdef _WIN32
+		// CreateProcess() hands every inheritable Handle down, so only one Child's Ends are at a Time
+		std::unique_lock<std::mutex> Lock(LuxSpawnMutex());
+		SECURITY_ATTRIBUTES Attributes = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+		HANDLE hChildIn, hToChild, hFromChild, hChildOut;
+		if (!CreatePipe(&hChildIn, &hToChild, &Attributes, 0))
+		{
+			Error = "CreatePipe failed";
+			return false;
+		}
+		if (!CreatePipe(&hFromChild, &hChildOut, &Attributes, 0))
+		{
+			CloseHandle(hChildIn);
+			CloseHandle(hToChild);
+			Error = "CreatePipe failed";
+			return false;
+		}
+		SetHandleInformation(hToChild, HANDLE_FLAG_INHERIT, 0);
+		SetHandleInformation(hFromChild, HANDLE_FLAG_INHERIT, 0);
+
+		std::string CommandLine = "\"" + Executable + "\"";
+		for (size_t n = 0; n < Args.size(); n++)
+			CommandLine += " \"" + Args[n] + "\"";
+
+		STARTUPINFOA StartupInfo;
+		memset(&StartupInfo, 0, sizeof(StartupInfo));
+		StartupInfo.cb = sizeof(StartupInfo);
+		StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+		StartupInfo.hStdInput = hChildIn;
+		StartupInfo.hStdOutput = hChildOut;
+		StartupInfo.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+		PROCESS_INFORMATION ProcessInfo;
+		BOOL bCreated = CreateProcessA(NULL, &CommandLine[0], NULL, NULL, TRUE, 0, NULL, NULL, &StartupInfo, &ProcessInfo);
+		CloseHandle(hChildIn);
+		CloseHandle(hChildOut);
+		Lock.unlock();
+		if (!bCreated)
+		{
+			CloseHandle(hToChild);
+			CloseHandle(hFromChild);
+			Error = "Can't start " + Executable;
+			return false;
+		}
+		CloseHandle(ProcessInfo.hThread);
+		m_hProcess = ProcessInfo.hProcess;
+		m_Pipe = CLuxPipe(hFromChild, hToChild);
+#else
+		int nToChild[2], nFromChild[2];
+#ifndef __linux__
+		// fcntl() comes after pipe(), a fork() in between would leak the Ends
+		std::unique_lock<std::mutex> Lock(LuxSpawnMutex());
+#endif
+		if (!LuxPipeCloseOnExec(nToChild))
+		{
+			Error = "pipe() failed";
+			return false;
+		}
+		if (!LuxPipeCloseOnExec(nFromChild))
+		{
+			close(nToChild[0]);
+			close(nToChild[1]);
+			Error = "pipe() failed";
+			return false;
+		}
+
+		std::vector<char *> Argv;
+		Argv.push_back((char *)Executable.c_str());
+		for (size_t n = 0; n < Args.size(); n++)
+			Argv.push_back((char *)Args[n].c_str());
+		Argv.push_back(NULL);
+
+		m_nPid = fork();
+		if (m_nPid == 0)
+		{
+			dup2(nToChild[0], 0);
+			dup2(nFromChild[1], 1);
+			execv(Executable.c_str(), &Argv[0]);
+			_exit(127);
+		}
+#ifndef __linux__
+		Lock.unlock();
+#endif
+
+		close(nToChild[0]);
+		close(nFromChild[1]);
+		if (m_nPid < 0)
+		{
+			close(nToChild[1]);
+			close(nFromChild[0]);
+			Error = "fork() failed";
+			return false;
+		}
+		m_Pipe = CLuxPipe(nFromChild[0], nToChild[1]);
+#endif
+		m_bRunning = true;
+
+		LuxMessageHeader_t Header;
+		std::string Payload;
+		if (!m_Pipe.Receive(Header, Payload) || Header.nType != LUXMSG_HELLO)
+		{
+			Error = "No Hello from " + Executable;
+			Stop();
+			return false;
+		}
+
+		CLuxPayloadReader Reader(Payload);
+		if (Reader.Get32())
+		{
+			Error = Reader.Rest();
+			Stop();
+			return false;
+		}
+		return true;
+	}
+
+	bool SendShader(uint32_t nShader, const LuxWorkerShader_t &Shader)
+	{
+		std::string Payload;
+		LuxPut32(Payload, nShader);
+		LuxPutString(Payload, Shader.Path);
+		LuxPutString(Payload, Shader.Target);
+		LuxPut32(Payload, (uint32_t)Shader.Combos.size());
+		for (size_t n = 0; n < Shader.Combos.size(); n++)
+			LuxPutString(Payload, Shader.Combos[n]);
+		return m_Pipe.Send(LUXMSG_SHADER, 0, Payload);
+	}
+
+	// One Round Trip. False if the Worker is gone
+	bool Run(uint32_t nJob, LuxWorkerJob_t &Job)
+	{
+		std::string Payload;
+		LuxPut32(Payload, Job.nShader);
+		LuxPut32(Payload, (uint32_t)Job.Values.size());
+		for (size_t n = 0; n < Job.Values.size(); n++)
+			LuxPut32(Payload, (uint32_t)Job.Values[n]);
+
+		LuxMessageHeader_t Header;
+		if (!m_Pipe.Send(LUXMSG_JOB, nJob, Payload) || !m_Pipe.Receive(Header, Payload) || Header.nType != LUXMSG_RESULT || Header.nJob != nJob)
+			return false;
+
+		CLuxPayloadReader Reader(Payload);
+		Job.bOk = Reader.Get32() == 0;
+		Job.flSeconds = Reader.Get32() * 1e-6f;
+		Job.Out = Reader.Rest();
+		return true;
+	}
+
+	void Stop()
+	{
+		if (!m_bRunning)
+			return;
+		m_bRunning = false;
+
+		m_Pipe.Send(LUXMSG_QUIT, 0, std::string());
+		m_Pipe.Close();
+#ifdef _WIN32
+		WaitForSingleObject(m_hProcess, INFINITE);
+		CloseHandle(m_hProcess);
+		m_hProcess = NULL;
+#else
+		int nStatus;
+		waitpid(m_nPid, &nStatus, 0);
+		m_nPid = -1;
+#endif
+	}
+
+private:
+	CLuxPipe m_Pipe;
+	bool m_bRunning;
+#ifdef _WIN32
+	HANDLE m_hProcess;
+#else
+	pid_t m_nPid;
+#endif
+};
+
+class CLuxWorkerPool
+{
+public:
+	CLuxWorkerPool() : m_nRespawns(0) {}
+	~CLuxWorkerPool() { Stop(); }
+
+	// Workers are started in Parallel, their Backend Loads overlap
+	bool Start(int nWorkers, const std::string &Executable, const std::vector<std::string> &Args, std::string &Error)
+	{
+#ifndef _WIN32
+		// A Worker dying mid-Write shouldn't take the Tool with it
+		signal(SIGPIPE, SIG_IGN);
+#endif
+		Stop();
+		m_Executable = Executable;
+		m_Args = Args;
+		m_Workers.resize(nWorkers);
+		for (int n = 0; n < nWorkers; n++)
+			m_Workers[n] = new CLuxWorkerProcess;
+
+		std::vector<std::string> Errors(nWorkers);
+		std::vector<char> Started(nWorkers, 0);
+		std::vector<std::thread> Threads;
+		for (int n = 0; n < nWorkers; n++)
+			Threads.push_back(std::thread([&, n]() { Started[n] = m_Workers[n]->Start(Executable, Args, Errors[n]); }));
+		for (int n = 0; n < nWorkers; n++)
+			Threads[n].join();
+
+		for (int n = 0; n < nWorkers; n++)
+		{
+			if (!Started[n])
+			{
+				Error = Errors[n];
+				Stop();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	int NumWorkers() const { return (int)m_Workers.size(); }
+	int NumRespawns() const { return m_nRespawns; }
+
+	bool AddShader(uint32_t nShader, const LuxWorkerShader_t &Shader)
+	{
+		m_Shaders[nShader] = Shader;
+		for (size_t n = 0; n < m_Workers.size(); n++)
+		{
+			if (!m_Workers[n]->SendShader(nShader, Shader))
+				return false;
+		}
+		return true;
+	}
+
+	// Blocks until every Job has its Result. A dead Worker is started again and its Job requeued,
+	// false if a Job was given up on or a Worker couldn't be started again. Those Jobs have bOk false
+	bool Run(std::vector<LuxWorkerJob_t> &Jobs)
+	{
+		std::atomic<size_t> nNext(0);
+		std::atomic<bool> bLost(false);
+		std::mutex Mutex;
+		std::vector<size_t> Requeued;
+		std::vector<int> Attempts(Jobs.size(), 0);
+		std::vector<std::thread> Threads;
+		for (size_t n = 0; n < m_Workers.size(); n++)
+		{
+			CLuxWorkerProcess *pWorker = m_Workers[n];
+			Threads.push_back(std::thread([&, pWorker]()
+			{
+				// The Job a Worker died on goes to the Worker started in its Place first, a fresh Process
+				size_t nRetry = Jobs.size();
+				for (;;)
+				{
+					size_t nJob = nRetry;
+					nRetry = Jobs.size();
+					if (nJob == Jobs.size())
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						if (!Requeued.empty())
+						{
+							nJob = Requeued.back();
+							Requeued.pop_back();
+						}
+						else if ((nJob = nNext++) >= Jobs.size())
+							return;
+					}
+
+					if (pWorker->Run((uint32_t)nJob, Jobs[nJob]))
+						continue;
+
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						if (++Attempts[nJob] < LUX_WORKER_ATTEMPTS)
+							nRetry = nJob;
+						else
+						{
+							LostJob(Jobs[nJob]);
+							bLost = true;
+						}
+					}
+
+					// The others pick its Job up if it can't be started again
+					if (!Respawn(pWorker))
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						if (nRetry != Jobs.size())
+							Requeued.push_back(nRetry);
+						bLost = true;
+						return;
+					}
+				}
+			}));
+		}
+		for (size_t n = 0; n < Threads.size(); n++)
+			Threads[n].join();
+
+		// Whatever no Worker was left for
+		for (size_t n = 0; n < Requeued.size(); n++)
+			LostJob(Jobs[Requeued[n]]);
+		for (size_t nJob = nNext; nJob < Jobs.size(); nJob++)
+			LostJob(Jobs[nJob]);
+		return !bLost;
+	}
+
+	void Stop()
+	{
+		for (size_t n = 0; n < m_Workers.size(); n++)
+			delete m_Workers[n];
+		m_Workers.clear();
+		m_Shaders.clear();
+	}
+
+private:
+	static void LostJob(LuxWorkerJob_t &Job)
+	{
+		Job.bOk = false;
+		Job.Out = "Worker died";
+		Job.flSeconds = 0.0f;
+	}
+
+	// A new Process in the same Slot, told about every Shader the old one knew
+	bool Respawn(CLuxWorkerProcess *pWorker)
+	{
+		std::string Error;
+		m_nRespawns++;
+		pWorker->Stop();
+		if (!pWorker->Start(m_Executable, m_Args, Error))
+		{
+			fprintf(stderr, "Can't start a Worker again : %s\n", Error.c_str());
+			return false;
+		}
+		for (std::map<uint32_t, LuxWorkerShader_t>::const_iterator It = m_Shaders.begin(); It != m_Shaders.end(); ++It)
+		{
+			if (!pWorker->SendShader(It->first, It->second))
+				return false;
+		}
+		return true;
+	}
+
+	std::vector<CLuxWorkerProcess *> m_Workers;
+	std::string m_Executable;
+	std::vector<std::string> m_Args;
+	std::map<uint32_t, LuxWorkerShader_t> m_Shaders;
+	std::atomic<int> m_nRespawns;
+};
+
+#endif // LUXTOOLS_WORKERPOOL_H
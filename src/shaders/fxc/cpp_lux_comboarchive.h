@@ -0,0 +1,228 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	One File per Shader holding its compiled Combo Blobs, laid out for Startup
+//
+//	Blobs stored in Combo Index Order put the Combos a Level needs all over the File, so Startup reads
+//	Pages scattered across every Shader. devtools/luxtools/lux_comboarchive writes the Blobs in the Order
+//	a recorded Startup Trace first used them ( cpp_lux_combousage.h First Use ), the Rest after them in Index Order.
+//	The traced Combos are then one contiguous Span, Preload() reads it with a single sequential Read :
+/*
+	CLuxComboArchive Archive;
+	if (Archive.Open("shaders/fxc/lux_modelshadertest_ps30.luxarc"))
+		Archive.Preload();
+	..
+	std::vector<unsigned char> Blob;
+	const unsigned char *pBlob = Archive.Find(nCombo, nSize);	// Preloaded, no I/O
+	if (!pBlob && Archive.Read(nCombo, Blob))					// Everything else is read when first needed
+		..
+*/
+//	Layout, Little Endian :
+//		LuxComboArchiveHeader_t
+//		LuxComboArchiveEntry_t [ nCombos ], sorted by Combo Index
+//		Blobs, the first nPreloadCombos of them in Trace Order, nPreloadSize Bytes from nPreloadOffset
+//
+//	No SDK Dependencies.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_COMBOARCHIVE_H
+#define CPP_LUX_COMBOARCHIVE_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#define LUX_COMBOARCHIVE_MAGIC		0x4153584Cu		// "LXSA"
+#define LUX_COMBOARCHIVE_VERSION	1
+
+struct LuxComboArchiveHeader_t
+{
+	uint32_t nMagic;
+	uint32_t nVersion;
+	uint32_t nCombos;
+	uint32_t nPreloadCombos;
+	uint64_t nPreloadOffset;
+	uint64_t nPreloadSize;
+};
+
+struct LuxComboArchiveEntry_t
+{
+	uint32_t nCombo;
+	uint32_t nSize;
+	uint64_t nOffset;
+};
+
+// Large Files on every Platform
+inline int LuxComboArchive_Seek(FILE *pFile, uint64_t nOffset)
+{
+#ifdef _WIN32
+	return _fseeki64(pFile, (__int64)nOffset, SEEK_SET);
+#else
+	return fseeko(pFile, (off_t)nOffset, SEEK_SET);
+#endif
+}
+
+//==========================================================================//
+// Writing. Blobs go in the Order they're added, Preload ones first
+//==========================================================================//
+class CLuxComboArchiveWriter
+{
+public:
+	void Add(uint32_t nCombo, const void *pData, uint32_t nSize, bool bPreload)
+	{
+		Blob_t Blob;
+		Blob.nCombo = nCombo;
+		Blob.Data.assign((const unsigned char *)pData, (const unsigned char *)pData + nSize);
+		(bPreload ? m_Preload : m_Rest).push_back(Blob);
+	}
+
+	bool Write(const char *pPath) const
+	{
+		LuxComboArchiveHeader_t Header;
+		Header.nMagic = LUX_COMBOARCHIVE_MAGIC;
+		Header.nVersion = LUX_COMBOARCHIVE_VERSION;
+		Header.nCombos = (uint32_t)(m_Preload.size() + m_Rest.size());
+		Header.nPreloadCombos = (uint32_t)m_Preload.size();
+		Header.nPreloadOffset = sizeof(Header) + Header.nCombos * sizeof(LuxComboArchiveEntry_t);
+		Header.nPreloadSize = 0;
+
+		std::vector<LuxComboArchiveEntry_t> Entries;
+		uint64_t nOffset = Header.nPreloadOffset;
+		const std::vector<Blob_t> *pLists[2] = { &m_Preload, &m_Rest };
+		for (int nList = 0; nList < 2; nList++)
+		{
+			for (size_t n = 0; n < pLists[nList]->size(); n++)
+			{
+				const Blob_t &Blob = (*pLists[nList])[n];
+				LuxComboArchiveEntry_t Entry = { Blob.nCombo, (uint32_t)Blob.Data.size(), nOffset };
+				Entries.push_back(Entry);
+				nOffset += Blob.Data.size();
+			}
+			if (!nList)
+				Header.nPreloadSize = nOffset - Header.nPreloadOffset;
+		}
+		std::sort(Entries.begin(), Entries.end(), [](const LuxComboArchiveEntry_t &a, const LuxComboArchiveEntry_t &b) { return a.nCombo < b.nCombo; });
+
+		FILE *pFile = fopen(pPath, "wb");
+		if (!pFile)
+			return false;
+		bool bOk = fwrite(&Header, sizeof(Header), 1, pFile) == 1;
+		bOk &= Entries.empty() || fwrite(&Entries[0], sizeof(LuxComboArchiveEntry_t), Entries.size(), pFile) == Entries.size();
+		for (int nList = 0; nList < 2; nList++)
+		{
+			for (size_t n = 0; n < pLists[nList]->size() && bOk; n++)
+			{
+				const std::vector<unsigned char> &Data = (*pLists[nList])[n].Data;
+				bOk &= Data.empty() || fwrite(&Data[0], Data.size(), 1, pFile) == 1;
+			}
+		}
+		return fclose(pFile) == 0 && bOk;
+	}
+
+private:
+	struct Blob_t
+	{
+		uint32_t nCombo;
+		std::vector<unsigned char> Data;
+	};
+
+	std::vector<Blob_t> m_Preload;
+	std::vector<Blob_t> m_Rest;
+};
+
+//==========================================================================//
+// Reading
+//==========================================================================//
+class CLuxComboArchive
+{
+public:
+	CLuxComboArchive() : m_pFile(NULL) { memset(&m_Header, 0, sizeof(m_Header)); }
+	~CLuxComboArchive() { Close(); }
+
+	// Reads the Header and the Directory, no Blobs
+	bool Open(const char *pPath)
+	{
+		Close();
+		m_pFile = fopen(pPath, "rb");
+		if (!m_pFile)
+			return false;
+
+		if (fread(&m_Header, sizeof(m_Header), 1, m_pFile) != 1 || m_Header.nMagic != LUX_COMBOARCHIVE_MAGIC || m_Header.nVersion != LUX_COMBOARCHIVE_VERSION)
+		{
+			Close();
+			return false;
+		}
+		m_Entries.resize(m_Header.nCombos);
+		if (m_Header.nCombos && fread(&m_Entries[0], sizeof(LuxComboArchiveEntry_t), m_Entries.size(), m_pFile) != m_Entries.size())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void Close()
+	{
+		if (m_pFile)
+			fclose(m_pFile);
+		m_pFile = NULL;
+		m_Entries.clear();
+		m_Preloaded.clear();
+	}
+
+	// The traced Combos, one Read
+	bool Preload()
+	{
+		if (!m_pFile || !m_Header.nPreloadSize)
+			return m_pFile != NULL;
+		m_Preloaded.resize((size_t)m_Header.nPreloadSize);
+		return LuxComboArchive_Seek(m_pFile, m_Header.nPreloadOffset) == 0 && fread(&m_Preloaded[0], m_Preloaded.size(), 1, m_pFile) == 1;
+	}
+
+	// Preloaded Blobs only, NULL for anything that needs a Read
+	const unsigned char *Find(uint32_t nCombo, uint32_t &nSize) const
+	{
+		const LuxComboArchiveEntry_t *pEntry = FindEntry(nCombo);
+		if (!pEntry || m_Preloaded.empty() || pEntry->nOffset < m_Header.nPreloadOffset || pEntry->nOffset + pEntry->nSize > m_Header.nPreloadOffset + m_Preloaded.size())
+			return NULL;
+		nSize = pEntry->nSize;
+		return &m_Preloaded[(size_t)(pEntry->nOffset - m_Header.nPreloadOffset)];
+	}
+
+	bool Read(uint32_t nCombo, std::vector<unsigned char> &Blob)
+	{
+		const LuxComboArchiveEntry_t *pEntry = FindEntry(nCombo);
+		if (!pEntry || !m_pFile)
+			return false;
+		Blob.resize(pEntry->nSize);
+		return !pEntry->nSize || (LuxComboArchive_Seek(m_pFile, pEntry->nOffset) == 0 && fread(&Blob[0], pEntry->nSize, 1, m_pFile) == 1);
+	}
+
+	bool Has(uint32_t nCombo) const { return FindEntry(nCombo) != NULL; }
+	const LuxComboArchiveHeader_t &Header() const { return m_Header; }
+	const std::vector<LuxComboArchiveEntry_t> &Entries() const { return m_Entries; }
+
+private:
+	const LuxComboArchiveEntry_t *FindEntry(uint32_t nCombo) const
+	{
+		std::vector<LuxComboArchiveEntry_t>::const_iterator It = std::lower_bound(m_Entries.begin(), m_Entries.end(), nCombo,
+			[](const LuxComboArchiveEntry_t &Entry, uint32_t n) { return Entry.nCombo < n; });
+		return It != m_Entries.end() && It->nCombo == nCombo ? &*It : NULL;
+	}
+
+	FILE *m_pFile;
+	LuxComboArchiveHeader_t m_Header;
+	std::vector<LuxComboArchiveEntry_t> m_Entries;
+	std::vector<unsigned char> m_Preloaded;
+};
+
+#endif // CPP_LUX_COMBOARCHIVE_H
@@ -0,0 +1,79 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Packed Combo Keys, generated from a Shader's // STATIC: and // DYNAMIC: Lines
+//
+//	devtools/luxtools/lux_combokey_gen writes include/<shader>_combokey.h for every .fxc,
+//	one Key Struct for the Static and one for the Dynamic Combos. Each Combo gets a Bit Field :
+//
+//		lux_modelshadertest_ps30_StaticKey Key = lux_modelshadertest_ps30_StaticKey()
+//			.Set_BRUSH<0>()							// Compile-time Value, out of Range doesn't compile
+//			.Set_ENVMAPCOMBO(nEnvMapCombo)			// Runtime Value, out of Range asserts
+//			.Set_BUMPMAPPED(bHasBumpMap);
+//		pShaderShadow->SetPixelShader("lux_modelshadertest_ps30", Key.Index());
+//
+//	Key() is the packed Bits, for Caches and Hashes. Index() is the Combo Index the .inc would compute,
+//	the Static one already scaled by the Number of Dynamic Combos, same as the .inc.
+//	Every Key Struct carries its Layout as Enums ( <COMBO>_MIN / _MAX / _SHIFT / _SCALE ) for static_asserts.
+//
+//	lux_combokey_gen -check fails when a Header doesn't match its .fxc anymore.
+//
+//	No SDK Dependencies.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_COMBOKEY_H
+#define CPP_LUX_COMBOKEY_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdint.h>
+
+#if !defined(LUX_COMBOKEY_ASSERT)
+#include <assert.h>
+#define LUX_COMBOKEY_ASSERT(Expression) assert(Expression)
+#endif
+
+// Bits needed for nCount Values
+constexpr int LuxComboKey_Bits(int nCount)
+{
+	return nCount <= 1 ? 0 : 1 + LuxComboKey_Bits((nCount + 1) / 2);
+}
+
+constexpr uint32_t LuxComboKey_Mask(int nBits)
+{
+	return nBits >= 32 ? 0xFFFFFFFFu : (1u << nBits) - 1u;
+}
+
+//==========================================================================//
+// Key Struct Members, the generated Headers only list the Combos
+//==========================================================================//
+#define LUX_COMBOKEY_BEGIN(KeyName)\
+	uint32_t m_nKey;\
+	constexpr KeyName() : m_nKey(0) {}\
+	constexpr explicit KeyName(uint32_t nKey) : m_nKey(nKey) {}\
+	constexpr uint32_t Key() const { return m_nKey; }\
+	constexpr bool operator==(const KeyName &Other) const { return m_nKey == Other.m_nKey; }\
+	constexpr bool operator!=(const KeyName &Other) const { return m_nKey != Other.m_nKey; }
+
+// Values are stored minus nMin. Setting a Combo twice overwrites it
+#define LUX_COMBOKEY_FIELD(KeyName, ComboName, nMin, nMax, nShift, nScale)\
+	enum { ComboName##_MIN = nMin, ComboName##_MAX = nMax, ComboName##_SHIFT = nShift, ComboName##_BITS = LuxComboKey_Bits(nMax - nMin + 1), ComboName##_SCALE = nScale };\
+	template <int nValue>\
+	constexpr KeyName Set_##ComboName() const\
+	{\
+		static_assert(nValue >= nMin && nValue <= nMax, #ComboName " out of Range");\
+		return KeyName((m_nKey & ~(LuxComboKey_Mask(ComboName##_BITS) << nShift)) | ((uint32_t)(nValue - nMin) << nShift));\
+	}\
+	KeyName Set_##ComboName(int nValue) const\
+	{\
+		LUX_COMBOKEY_ASSERT(nValue >= nMin && nValue <= nMax);\
+		return KeyName((m_nKey & ~(LuxComboKey_Mask(ComboName##_BITS) << nShift)) | (((uint32_t)(nValue - nMin) & LuxComboKey_Mask(ComboName##_BITS)) << nShift));\
+	}\
+	constexpr int Get_##ComboName() const { return nMin + (int)((m_nKey >> nShift) & LuxComboKey_Mask(ComboName##_BITS)); }
+
+#endif // CPP_LUX_COMBOKEY_H
@@ -0,0 +1,354 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Records which Shader Combos are actually drawn, written to a Manifest on Exit
+//
+//	Only a Fraction of the compiled Combos is ever bound. With LUX_COMBOUSAGE defined ( lux_common_defines.h )
+//	each Draw counts its Shader, Static and Dynamic Combo, right after the Dynamic Index is set :
+/*
+	lux_modelshadertest_ps30_DynamicKey DynamicKey = ..;
+	pShaderAPI->SetPixelShaderIndex(DynamicKey.Index());
+	LUX_COMBOUSAGE_RECORD("lux_modelshadertest_ps30", StaticKey.Index(), DynamicKey.Index());
+*/
+//	Static Index is the .inc's, already scaled by the Number of Dynamic Combos ( cpp_lux_combokey.h Index() ),
+//	so the Sum is the Combo Index every LUX Tool uses. Without LUX_COMBOUSAGE the Macro is empty.
+//
+//	The Shader Name can be any String, Literal or not. Each Call Site remembers the last Shader it recorded
+//	and compares the Name against it, a different Name is looked up by Content in a small lock-free Table.
+//	Only the first Draw of a new Name takes a Lock.
+//	Recording is lock-free : a fixed open-addressed Table, one atomic Add for a Combo that was seen before.
+//	A full Table drops Combos and counts them, it never blocks a Draw or allocates.
+//	On Exit LUX_COMBOUSAGE_MANIFEST is written, merged with what's already there, so Playtests add up :
+//		// dropped : <draws the Table had no Room for, summed too>
+//		<shader> <combo index> <draws> <first use>
+//	most drawn first. First Use is the Order Combos were first drawn in, lux_comboarchive -startup cuts the Startup out of it.
+//	devtools/luxtools/lux_combousage merges and reports Manifests, lux_combo_whitelist -usage prunes by them.
+//
+//	Define LUX_COMBOUSAGE_CORE_ONLY for the Recorder without the Exit Hook, devtools/luxtools/lux_combousage -bench does.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_COMBOUSAGE_H
+#define CPP_LUX_COMBOUSAGE_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+// Power of two. 16 Bytes each, about four Times the Combos a Session draws
+#define LUX_COMBOUSAGE_SLOTS			(1 << 16)
+#define LUX_COMBOUSAGE_MAX_PROBES		64
+#define LUX_COMBOUSAGE_MAX_SHADERS		1024
+#define LUX_COMBOUSAGE_NAME_SLOTS		(LUX_COMBOUSAGE_MAX_SHADERS * 2)
+
+#if !defined(LUX_COMBOUSAGE_MANIFEST)
+#define LUX_COMBOUSAGE_MANIFEST			"lux_combousage.txt"
+#endif
+
+struct LuxComboUsage_t
+{
+	std::string Shader;
+	uint32_t nCombo;
+	uint64_t nDraws;
+	uint32_t nFirstUse;
+};
+
+static const char s_szLuxComboUsageDropped[] = "// dropped : ";
+
+// Appends a Manifest's Lines to Usage, the Tools read them the same Way. pDropped gets its Dropped Draws added
+inline bool LuxReadComboUsage(const char *pPath, std::vector<LuxComboUsage_t> &Usage, uint64_t *pDropped = NULL)
+{
+	FILE *pFile = fopen(pPath, "rb");
+	if (!pFile)
+		return false;
+
+	char szLine[512], szShader[256];
+	while (fgets(szLine, sizeof(szLine), pFile))
+	{
+		unsigned int nCombo, nFirstUse;
+		unsigned long long nDraws;
+		if (!strncmp(szLine, s_szLuxComboUsageDropped, sizeof(s_szLuxComboUsageDropped) - 1))
+		{
+			if (pDropped)
+				*pDropped += strtoull(szLine + sizeof(s_szLuxComboUsageDropped) - 1, NULL, 10);
+		}
+		else if (strncmp(szLine, "//", 2) && sscanf(szLine, "%255s %u %llu %u", szShader, &nCombo, &nDraws, &nFirstUse) == 4)
+		{
+			LuxComboUsage_t Combo;
+			Combo.Shader = szShader;
+			Combo.nCombo = nCombo;
+			Combo.nDraws = nDraws;
+			Combo.nFirstUse = nFirstUse;
+			Usage.push_back(Combo);
+		}
+	}
+	fclose(pFile);
+	return true;
+}
+
+// Sums Manifests into Usage, keyed by Shader and Combo
+inline void LuxMergeComboUsage(std::vector<LuxComboUsage_t> &Usage, const std::vector<LuxComboUsage_t> &Other)
+{
+	std::map<std::pair<std::string, uint32_t>, size_t> Index;
+	for (size_t n = 0; n < Usage.size(); n++)
+		Index[std::make_pair(Usage[n].Shader, Usage[n].nCombo)] = n;
+
+	for (size_t n = 0; n < Other.size(); n++)
+	{
+		std::pair<std::string, uint32_t> Key(Other[n].Shader, Other[n].nCombo);
+		std::map<std::pair<std::string, uint32_t>, size_t>::iterator It = Index.find(Key);
+		if (It == Index.end())
+		{
+			Index[Key] = Usage.size();
+			Usage.push_back(Other[n]);
+			continue;
+		}
+		LuxComboUsage_t &Combo = Usage[It->second];
+		Combo.nDraws += Other[n].nDraws;
+		Combo.nFirstUse = std::min(Combo.nFirstUse, Other[n].nFirstUse);
+	}
+}
+
+// Most drawn first, then First Use
+inline bool LuxWriteComboUsage(const char *pPath, std::vector<LuxComboUsage_t> &Usage, uint64_t nDropped = 0)
+{
+	std::sort(Usage.begin(), Usage.end(), [](const LuxComboUsage_t &a, const LuxComboUsage_t &b)
+	{
+		return a.nDraws != b.nDraws ? a.nDraws > b.nDraws : a.nFirstUse < b.nFirstUse;
+	});
+
+	FILE *pFile = fopen(pPath, "wb");
+	if (!pFile)
+		return false;
+	fprintf(pFile, "// lux_combousage Manifest : <shader> <combo index> <draws> <first use>, most drawn first\n");
+	fprintf(pFile, "%s%llu\n", s_szLuxComboUsageDropped, (unsigned long long)nDropped);
+	for (size_t n = 0; n < Usage.size(); n++)
+		fprintf(pFile, "%s %u %llu %u\n", Usage[n].Shader.c_str(), Usage[n].nCombo, (unsigned long long)Usage[n].nDraws, Usage[n].nFirstUse);
+	return fclose(pFile) == 0;
+}
+
+class CLuxComboUsage
+{
+public:
+	CLuxComboUsage() : m_nShaders(0), m_nNextUse(0), m_nDropped(0)
+	{
+		for (int n = 0; n < LUX_COMBOUSAGE_SLOTS; n++)
+		{
+			m_Slots[n].nKey.store(0, std::memory_order_relaxed);
+			m_Slots[n].nDraws.store(0, std::memory_order_relaxed);
+			m_Slots[n].nFirstUse.store(0, std::memory_order_relaxed);
+		}
+		for (int n = 0; n < LUX_COMBOUSAGE_NAME_SLOTS; n++)
+			m_NameSlots[n].store(0, std::memory_order_relaxed);
+	}
+
+	// Same Name, same ID. Takes the Lock, ShaderID() is the Way for every Draw. -1 when full
+	int RegisterShader(const char *pName)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		int nShader = -1;
+		for (int n = 0; n < m_nShaders && nShader < 0; n++)
+		{
+			if (m_ShaderNames[n] == pName)
+				nShader = n;
+		}
+		if (nShader < 0)
+		{
+			if (m_nShaders == LUX_COMBOUSAGE_MAX_SHADERS)
+				return -1;
+			m_ShaderNames[m_nShaders] = pName;
+			nShader = m_nShaders++;
+		}
+
+		// Publish for ShaderID(). Only ever written under the Lock, the Name is complete before the Slot is
+		uint32_t nHash = HashName(pName);
+		uint64_t nEntry = ((uint64_t)nHash << 32) | (uint32_t)(nShader + 1);
+		for (uint32_t nSlot = nHash & (LUX_COMBOUSAGE_NAME_SLOTS - 1);; nSlot = (nSlot + 1) & (LUX_COMBOUSAGE_NAME_SLOTS - 1))
+		{
+			uint64_t nOld = m_NameSlots[nSlot].load(std::memory_order_relaxed);
+			if (nOld == nEntry)
+				break;
+			if (!nOld)
+			{
+				m_NameSlots[nSlot].store(nEntry, std::memory_order_release);
+				break;
+			}
+		}
+		return nShader;
+	}
+
+	// Lock-free by Name, any Thread. Registers Names it hasn't seen yet
+	int ShaderID(const char *pName)
+	{
+		uint32_t nHash = HashName(pName);
+		for (uint32_t nSlot = nHash & (LUX_COMBOUSAGE_NAME_SLOTS - 1), nProbe = 0; nProbe < LUX_COMBOUSAGE_NAME_SLOTS;
+			nSlot = (nSlot + 1) & (LUX_COMBOUSAGE_NAME_SLOTS - 1), nProbe++)
+		{
+			uint64_t nEntry = m_NameSlots[nSlot].load(std::memory_order_acquire);
+			if (!nEntry)
+				break;
+			int nShader = (int)(uint32_t)nEntry - 1;
+			if ((uint32_t)(nEntry >> 32) == nHash && m_ShaderNames[nShader] == pName)
+				return nShader;
+		}
+		return RegisterShader(pName);
+	}
+
+	// Any Thread
+	void Record(int nShader, int nStaticIndex, int nDynamicIndex)
+	{
+		if (nShader < 0)
+			return;
+
+		// Shader + 1, so 0 stays the empty Slot
+		uint64_t nKey = ((uint64_t)(nShader + 1) << 32) | (uint32_t)(nStaticIndex + nDynamicIndex);
+		uint32_t nSlot = Hash(nKey) & (LUX_COMBOUSAGE_SLOTS - 1);
+		for (int nProbe = 0; nProbe < LUX_COMBOUSAGE_MAX_PROBES; nProbe++, nSlot = (nSlot + 1) & (LUX_COMBOUSAGE_SLOTS - 1))
+		{
+			Slot_t &Slot = m_Slots[nSlot];
+			uint64_t nOld = Slot.nKey.load(std::memory_order_relaxed);
+			if (nOld == 0)
+			{
+				if (Slot.nKey.compare_exchange_strong(nOld, nKey))
+				{
+					Slot.nFirstUse.store(m_nNextUse.fetch_add(1), std::memory_order_relaxed);
+					Slot.nDraws.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				// Someone else took it, nOld is theirs now
+			}
+			if (nOld == nKey)
+			{
+				Slot.nDraws.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		}
+		m_nDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// By Name. Cache is one per Call Site, -1 at first, it holds the last Shader and is checked against pName
+	void Record(std::atomic<int> &Cache, const char *pName, int nStaticIndex, int nDynamicIndex)
+	{
+		int nShader = Cache.load(std::memory_order_acquire);
+		if (nShader < 0 || strcmp(m_ShaderNames[nShader].c_str(), pName))
+		{
+			nShader = ShaderID(pName);
+			Cache.store(nShader, std::memory_order_release);
+		}
+		Record(nShader, nStaticIndex, nDynamicIndex);
+	}
+
+	// What was recorded so far, in First Use Order
+	void Get(std::vector<LuxComboUsage_t> &Usage) const
+	{
+		Usage.clear();
+		for (int n = 0; n < LUX_COMBOUSAGE_SLOTS; n++)
+		{
+			uint64_t nKey = m_Slots[n].nKey.load(std::memory_order_acquire);
+			if (!nKey)
+				continue;
+			LuxComboUsage_t Combo;
+			Combo.Shader = ShaderName((int)(nKey >> 32) - 1);
+			Combo.nCombo = (uint32_t)nKey;
+			Combo.nDraws = m_Slots[n].nDraws.load(std::memory_order_relaxed);
+			Combo.nFirstUse = m_Slots[n].nFirstUse.load(std::memory_order_relaxed);
+			Usage.push_back(Combo);
+		}
+		std::sort(Usage.begin(), Usage.end(), [](const LuxComboUsage_t &a, const LuxComboUsage_t &b) { return a.nFirstUse < b.nFirstUse; });
+	}
+
+	// Draws the Table had no Room for
+	uint64_t Dropped() const { return m_nDropped.load(std::memory_order_relaxed); }
+
+	std::string ShaderName(int nShader) const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return nShader >= 0 && nShader < m_nShaders ? m_ShaderNames[nShader] : std::string("?");
+	}
+
+	// Adds to an existing Manifest : Draws and Dropped are summed, the earlier First Use wins
+	bool WriteManifest(const char *pPath) const
+	{
+		std::vector<LuxComboUsage_t> Usage, Existing;
+		uint64_t nDropped = Dropped();
+		Get(Usage);
+		if (LuxReadComboUsage(pPath, Existing, &nDropped))
+			LuxMergeComboUsage(Usage, Existing);
+		return LuxWriteComboUsage(pPath, Usage, nDropped);
+	}
+
+private:
+	// FNV-1a
+	static uint32_t HashName(const char *pName)
+	{
+		uint32_t nHash = 2166136261U;
+		for (; *pName; pName++)
+			nHash = (nHash ^ (unsigned char)*pName) * 16777619U;
+		return nHash;
+	}
+
+	static uint32_t Hash(uint64_t nKey)
+	{
+		nKey ^= nKey >> 33;
+		nKey *= 0xff51afd7ed558ccdULL;
+		nKey ^= nKey >> 33;
+		return (uint32_t)nKey;
+	}
+
+	struct Slot_t
+	{
+		std::atomic<uint64_t> nKey;
+		std::atomic<uint32_t> nDraws;
+		std::atomic<uint32_t> nFirstUse;
+	};
+
+	Slot_t m_Slots[LUX_COMBOUSAGE_SLOTS];
+	std::atomic<uint64_t> m_NameSlots[LUX_COMBOUSAGE_NAME_SLOTS];	// Name Hash << 32 | Shader + 1, 0 is empty
+	std::string m_ShaderNames[LUX_COMBOUSAGE_MAX_SHADERS];
+	int m_nShaders;
+	mutable std::mutex m_Mutex;
+	std::atomic<uint32_t> m_nNextUse;
+	std::atomic<uint64_t> m_nDropped;
+};
+
+#if defined(LUX_COMBOUSAGE) && !defined(LUX_COMBOUSAGE_CORE_ONLY)
+
+// Writes the Manifest when the Shader DLL unloads
+class CLuxComboUsageManifest
+{
+public:
+	~CLuxComboUsageManifest() { m_Usage.WriteManifest(LUX_COMBOUSAGE_MANIFEST); }
+	CLuxComboUsage m_Usage;
+};
+
+inline CLuxComboUsage &LuxComboUsage()
+{
+	static CLuxComboUsageManifest s_Manifest;
+	return s_Manifest.m_Usage;
+}
+
+// The static only saves the Lookup, the Name is compared every Time. Any String works, not just Literals
+#define LUX_COMBOUSAGE_RECORD(pShaderName, nStaticIndex, nDynamicIndex)\
+	do\
+	{\
+		static std::atomic<int> s_nLuxComboUsageShader(-1);\
+		LuxComboUsage().Record(s_nLuxComboUsageShader, pShaderName, nStaticIndex, nDynamicIndex);\
+	} while (0)
+
+#else
+#define LUX_COMBOUSAGE_RECORD(pShaderName, nStaticIndex, nDynamicIndex) ((void)0)
+#endif
+
+#endif // CPP_LUX_COMBOUSAGE_H
@@ -0,0 +1,323 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Recording Shader State on Worker Threads, spliced back in Draw Order
+//
+//	The CommandBuilder ( cpp_lux_commandbuilder.h ) is filled on the Material Render Thread, one Draw after another.
+//	With Queued Rendering the Draw List is known up front, so the State Setup can be split :
+//
+//	1.	Each Worker owns a CLuxCommandRecorder and records a disjoint Set of Draws into it.
+//		BeginDraw(n) / EndDraw() around each, the Draw Index is the Position in the final Order.
+//		Recorders take Blocks from a shared CLuxFrameArena ( lock-free ), nothing else is shared.
+//	2.	CLuxCommandMerge::Splice() puts the Draws in Order. No Copy, each Draw's END is patched into a JUMP to the next.
+//	3.	LuxReplayCommands() walks the Result and calls the same Functions on the real CommandBuilder or IShaderDynamicAPI.
+//
+//	The Recorder has the CommandBuilder's Setter Names, so the templated Upload Code
+//	( CLuxConstantShadow::FlushPS(), CLuxMaterialConstantBlock::UploadPS() ) records into it unchanged.
+//
+//	No SDK Dependencies, devtools/luxtools/lux_commandrecord_bench stress-tests and times this.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_COMMANDRECORD_H
+#define CPP_LUX_COMMANDRECORD_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "cpp_lux_framearena.h"
+
+#include <vector>
+#include <algorithm>
+
+// Bytes a Recorder takes from the Arena at once
+#define LUX_COMMANDRECORD_BLOCK_SIZE	16384
+
+enum LuxCommands_t
+{
+	LUXCMD_END = 0,
+	LUXCMD_JUMP,						// Pointer
+	LUXCMD_SET_PIXEL_SHADER_FLOAT,		// First Register, Count, Count * 4 Floats
+	LUXCMD_SET_VERTEX_SHADER_FLOAT,
+	LUXCMD_SET_PIXEL_SHADER_BOOL,		// First Register, Count, Count Ints
+	LUXCMD_SET_VERTEX_SHADER_BOOL,
+	LUXCMD_SET_PIXEL_SHADER_INT,		// First Register, Count, Count * 4 Ints
+	LUXCMD_BIND_TEXTURE_HANDLE,			// Sampler, 64 Bit Handle
+	LUXCMD_SET_PIXEL_SHADER_INDEX,		// Index
+	LUXCMD_SET_VERTEX_SHADER_INDEX,
+
+	NUM_LUXCMDS
+};
+
+// END plus Room to patch it into a JUMP
+#define LUX_COMMANDRECORD_END_SIZE		(sizeof(uint32_t) + sizeof(void *))
+
+struct LuxRecordedDraw_t
+{
+	int nDraw;
+	uint8_t *pStart;
+	uint8_t *pEnd;		// The END, Splice() turns it into a JUMP
+};
+
+class CLuxCommandRecorder
+{
+public:
+	CLuxCommandRecorder(CLuxFrameArena &Arena) : m_Arena(Arena), m_pCursor(NULL), m_pLimit(NULL), m_nBytes(0), m_bInDraw(false), m_bOverflow(false) {}
+
+	// Per Frame, after the Arena's Reset()
+	void Reset()
+	{
+		m_Draws.clear();
+		m_pCursor = m_pLimit = NULL;
+		m_nBytes = 0;
+		m_bInDraw = false;
+		m_bOverflow = false;
+	}
+
+	// After an Overflow Draws are still listed but never get their END, so Splice() refuses the Frame
+	void BeginDraw(int nDraw)
+	{
+		LuxRecordedDraw_t Draw;
+		Draw.nDraw = nDraw;
+		Draw.pStart = Reserve(0) ? m_pCursor : NULL;
+		Draw.pEnd = NULL;
+		m_Draws.push_back(Draw);
+		m_bInDraw = true;
+	}
+
+	void EndDraw()
+	{
+		m_bInDraw = false;
+		if (!Reserve(0))
+			return;
+		m_Draws.back().pEnd = m_pCursor;
+		WriteUInt(LUXCMD_END);
+		m_pCursor += sizeof(void *);
+	}
+
+	//==========================================================================//
+	// CommandBuilder Setters
+	//==========================================================================//
+	void SetPixelShaderConstant(int nFirstRegister, const float *pData, int nRegisters) { WriteConstants(LUXCMD_SET_PIXEL_SHADER_FLOAT, nFirstRegister, pData, nRegisters * 4 * sizeof(float), nRegisters); }
+	void SetVertexShaderConstant(int nFirstRegister, const float *pData, int nRegisters) { WriteConstants(LUXCMD_SET_VERTEX_SHADER_FLOAT, nFirstRegister, pData, nRegisters * 4 * sizeof(float), nRegisters); }
+	void SetBooleanPixelShaderConstant(int nFirstRegister, const int *pData, int nRegisters) { WriteConstants(LUXCMD_SET_PIXEL_SHADER_BOOL, nFirstRegister, pData, nRegisters * sizeof(int), nRegisters); }
+	void SetBooleanVertexShaderConstant(int nFirstRegister, const int *pData, int nRegisters) { WriteConstants(LUXCMD_SET_VERTEX_SHADER_BOOL, nFirstRegister, pData, nRegisters * sizeof(int), nRegisters); }
+	void SetIntegerPixelShaderConstant(int nFirstRegister, const int *pData, int nRegisters) { WriteConstants(LUXCMD_SET_PIXEL_SHADER_INT, nFirstRegister, pData, nRegisters * 4 * sizeof(int), nRegisters); }
+
+	// ShaderAPITextureHandle_t is an Integer, 64 Bit holds it everywhere
+	void BindTextureHandle(int nSampler, uint64_t hTexture)
+	{
+		if (!Reserve(sizeof(uint32_t) * 2 + sizeof(uint64_t)))
+			return;
+		WriteUInt(LUXCMD_BIND_TEXTURE_HANDLE);
+		WriteUInt((uint32_t)nSampler);
+		memcpy(m_pCursor, &hTexture, sizeof(uint64_t));
+		m_pCursor += sizeof(uint64_t);
+	}
+
+	void SetPixelShaderIndex(int nIndex) { WriteIndex(LUXCMD_SET_PIXEL_SHADER_INDEX, nIndex); }
+	void SetVertexShaderIndex(int nIndex) { WriteIndex(LUXCMD_SET_VERTEX_SHADER_INDEX, nIndex); }
+
+	const std::vector<LuxRecordedDraw_t> &Draws() const { return m_Draws; }
+
+	// Arena Bytes taken, including Block Tails that were jumped over
+	size_t Bytes() const { return m_nBytes; }
+
+	// A Command bigger than a Block, or the Arena out of Memory. Nothing after it got recorded
+	bool Overflowed() const { return m_bOverflow; }
+
+private:
+	void WriteUInt(uint32_t n)
+	{
+		memcpy(m_pCursor, &n, sizeof(uint32_t));
+		m_pCursor += sizeof(uint32_t);
+	}
+
+	void WriteIndex(uint32_t nCommand, int nIndex)
+	{
+		if (!Reserve(sizeof(uint32_t) * 2))
+			return;
+		WriteUInt(nCommand);
+		WriteUInt((uint32_t)nIndex);
+	}
+
+	void WriteConstants(uint32_t nCommand, int nFirstRegister, const void *pData, size_t nDataBytes, int nRegisters)
+	{
+		if (!Reserve(sizeof(uint32_t) * 3 + nDataBytes))
+			return;
+
+		WriteUInt(nCommand);
+		WriteUInt((uint32_t)nFirstRegister);
+		WriteUInt((uint32_t)nRegisters);
+		memcpy(m_pCursor, pData, nDataBytes);
+		m_pCursor += nDataBytes;
+	}
+
+	// Room for nBytes and the END or JUMP after them. New Block if not, the old one JUMPs there
+	bool Reserve(size_t nBytes)
+	{
+		if (m_bOverflow)
+			return false;
+
+		size_t nNeeded = nBytes + LUX_COMMANDRECORD_END_SIZE;
+		if (m_pCursor && (size_t)(m_pLimit - m_pCursor) >= nNeeded)
+			return true;
+
+		if (nNeeded > LUX_COMMANDRECORD_BLOCK_SIZE)
+		{
+			m_bOverflow = true;
+			return false;
+		}
+
+		uint8_t *pBlock = (uint8_t *)m_Arena.Alloc(LUX_COMMANDRECORD_BLOCK_SIZE);
+		if (!pBlock)
+		{
+			m_bOverflow = true;
+			return false;
+		}
+		m_nBytes += LUX_COMMANDRECORD_BLOCK_SIZE;
+
+		// Only Commands inside a Draw need the Chain. Between Draws nothing reads the old Block's Tail
+		if (m_pCursor && m_bInDraw)
+		{
+			WriteUInt(LUXCMD_JUMP);
+			memcpy(m_pCursor, &pBlock, sizeof(void *));
+		}
+
+		m_pCursor = pBlock;
+		m_pLimit = pBlock + LUX_COMMANDRECORD_BLOCK_SIZE;
+		return true;
+	}
+
+	CLuxFrameArena &m_Arena;
+	std::vector<LuxRecordedDraw_t> m_Draws;
+	uint8_t *m_pCursor;
+	uint8_t *m_pLimit;
+	size_t m_nBytes;
+	bool m_bInDraw;
+	bool m_bOverflow;
+};
+
+//==========================================================================//
+// Puts every Recorder's Draws in Order and chains them. Main Thread, after all Workers are done
+//==========================================================================//
+class CLuxCommandMerge
+{
+public:
+	// Returns the first Command of the spliced Stream, NULL if nothing was recorded.
+	// Draw Indices have to be unique across Recorders, duplicates return NULL
+	const uint8_t *Splice(CLuxCommandRecorder *const *ppRecorders, int nRecorders)
+	{
+		m_Order.clear();
+		for (int n = 0; n < nRecorders; n++)
+			m_Order.insert(m_Order.end(), ppRecorders[n]->Draws().begin(), ppRecorders[n]->Draws().end());
+
+		if (m_Order.empty())
+			return NULL;
+
+		std::sort(m_Order.begin(), m_Order.end(), [](const LuxRecordedDraw_t &a, const LuxRecordedDraw_t &b) { return a.nDraw < b.nDraw; });
+
+		for (size_t n = 0; n + 1 < m_Order.size(); n++)
+		{
+			if (m_Order[n].nDraw == m_Order[n + 1].nDraw || !m_Order[n].pEnd)
+				return NULL;
+
+			uint32_t nJump = LUXCMD_JUMP;
+			memcpy(m_Order[n].pEnd, &nJump, sizeof(uint32_t));
+			memcpy(m_Order[n].pEnd + sizeof(uint32_t), &m_Order[n + 1].pStart, sizeof(void *));
+		}
+
+		// The last one keeps its END
+		return m_Order.back().pEnd ? m_Order.front().pStart : NULL;
+	}
+
+	int NumDraws() const { return (int)m_Order.size(); }
+
+private:
+	std::vector<LuxRecordedDraw_t> m_Order;
+};
+
+//==========================================================================//
+// Plays a Stream into T, the CommandBuilder, IShaderDynamicAPI or anything with the same Setters
+// BindTextureHandle() and the Shader Index Setters are the only Names T needs beyond the Upload ones.
+// Returns the Number of Commands, JUMPs not counted
+//==========================================================================//
+template <class T>
+inline int LuxReplayCommands(const uint8_t *pStream, T &Target)
+{
+	int nCommands = 0;
+	uint32_t nHeader[3];
+	while (pStream)
+	{
+		memcpy(nHeader, pStream, sizeof(uint32_t));
+		switch (nHeader[0])
+		{
+			case LUXCMD_END:
+				return nCommands;
+
+			case LUXCMD_JUMP:
+				memcpy(&pStream, pStream + sizeof(uint32_t), sizeof(void *));
+				continue;
+
+			case LUXCMD_SET_PIXEL_SHADER_FLOAT:
+			case LUXCMD_SET_VERTEX_SHADER_FLOAT:
+			case LUXCMD_SET_PIXEL_SHADER_BOOL:
+			case LUXCMD_SET_VERTEX_SHADER_BOOL:
+			case LUXCMD_SET_PIXEL_SHADER_INT:
+			{
+				memcpy(nHeader, pStream, sizeof(uint32_t) * 3);
+				const uint8_t *pData = pStream + sizeof(uint32_t) * 3;
+				int nFirst = (int)nHeader[1], nCount = (int)nHeader[2];
+
+				// Recorded with memcpy into 4 Byte aligned Slots, fine to read in Place
+				if (nHeader[0] == LUXCMD_SET_PIXEL_SHADER_FLOAT)
+					Target.SetPixelShaderConstant(nFirst, (const float *)pData, nCount);
+				else if (nHeader[0] == LUXCMD_SET_VERTEX_SHADER_FLOAT)
+					Target.SetVertexShaderConstant(nFirst, (const float *)pData, nCount);
+				else if (nHeader[0] == LUXCMD_SET_PIXEL_SHADER_BOOL)
+					Target.SetBooleanPixelShaderConstant(nFirst, (const int *)pData, nCount);
+				else if (nHeader[0] == LUXCMD_SET_VERTEX_SHADER_BOOL)
+					Target.SetBooleanVertexShaderConstant(nFirst, (const int *)pData, nCount);
+				else
+					Target.SetIntegerPixelShaderConstant(nFirst, (const int *)pData, nCount);
+
+				size_t nElements = (nHeader[0] == LUXCMD_SET_PIXEL_SHADER_BOOL || nHeader[0] == LUXCMD_SET_VERTEX_SHADER_BOOL) ? 1 : 4;
+				pStream = pData + nCount * nElements * 4;
+				break;
+			}
+
+			case LUXCMD_BIND_TEXTURE_HANDLE:
+			{
+				uint64_t hTexture;
+				memcpy(nHeader, pStream, sizeof(uint32_t) * 2);
+				memcpy(&hTexture, pStream + sizeof(uint32_t) * 2, sizeof(uint64_t));
+				Target.BindTextureHandle((int)nHeader[1], hTexture);
+				pStream += sizeof(uint32_t) * 2 + sizeof(uint64_t);
+				break;
+			}
+
+			case LUXCMD_SET_PIXEL_SHADER_INDEX:
+			case LUXCMD_SET_VERTEX_SHADER_INDEX:
+			{
+				memcpy(nHeader, pStream, sizeof(uint32_t) * 2);
+				if (nHeader[0] == LUXCMD_SET_PIXEL_SHADER_INDEX)
+					Target.SetPixelShaderIndex((int)nHeader[1]);
+				else
+					Target.SetVertexShaderIndex((int)nHeader[1]);
+				pStream += sizeof(uint32_t) * 2;
+				break;
+			}
+
+			default:
+				// Corrupt Stream, stop rather than read Garbage
+				return -1;
+		}
+		nCommands++;
+	}
+	return nCommands;
+}
+
+#endif // CPP_LUX_COMMANDRECORD_H
@@ -0,0 +1,301 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	CPU Shadow of the Constant Registers, uploads only what changed
+//
+//	Shaders set their Constants on every Draw, even when the previous Draw set the same Values.
+//	Set them on a CLuxConstantShadow instead, it compares against what was last uploaded and
+//	keeps a Dirty Bit per Register. Flush() then sends the dirty Registers to the CommandBuilder
+//	( or IShaderDynamicAPI ), coalesced into contiguous Runs.
+//
+//	One Shadow per Shader Stage, REGISTER_FLOAT_000..NUM_FLOATS and REGISTER_BOOL_00..15.
+//	Anything that writes Constants behind the Shadow's back ( Stock Code, a Device Reset )
+//	needs Invalidate(), or the Shadow will skip Uploads the GPU never got.
+//
+//	No SDK Dependencies, devtools/luxtools/lux_constantshadow_bench replays recorded Streams through this.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_CONSTANTSHADOW_H
+#define CPP_LUX_CONSTANTSHADOW_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Clean Registers between two dirty Runs that we upload anyway to save a Call.
+// 16 Bytes more in the Command Buffer are cheaper than another Command
+#define LUX_CONSTANTSHADOW_MAX_GAP		1
+
+// REGISTER_BOOL_MAX
+#define LUX_CONSTANTSHADOW_NUM_BOOLS	16
+
+// Flush() Statistics, accumulate until ResetStats()
+struct LuxConstantShadowStats_t
+{
+	LuxConstantShadowStats_t() { memset(this, 0, sizeof(LuxConstantShadowStats_t)); }
+
+	int64_t m_nFloatSets;		// Registers passed to SetFloat*()
+	int64_t m_nFloatUploads;	// Registers actually uploaded, including Gaps
+	int64_t m_nFloatRuns;		// Upload Calls for Floats
+	int64_t m_nBoolSets;
+	int64_t m_nBoolUploads;
+	int64_t m_nBoolRuns;
+	int64_t m_nFlushes;
+};
+
+template <int NUM_FLOATS>
+class CLuxConstantShadow
+{
+public:
+	CLuxConstantShadow() : m_nHash(0), m_pRecord(NULL)
+	{
+		memset(m_flFloats, 0, sizeof(m_flFloats));
+		memset(m_nBools, 0, sizeof(m_nBools));
+		Invalidate();
+	}
+
+	//==========================================================================//
+	// Setting. Same Arguments as the CommandBuilder, but nothing is uploaded yet
+	//==========================================================================//
+	void SetFloat4(int nRegister, float x, float y, float z, float w)
+	{
+		const float fl4[4] = { x, y, z, w };
+		SetFloats(nRegister, fl4, 1);
+	}
+
+	void SetFloats(int nFirstRegister, const float *pData, int nRegisters)
+	{
+		m_Stats.m_nFloatSets += nRegisters;
+		for (int n = 0; n < nRegisters; n++)
+		{
+			const int nRegister = nFirstRegister + n;
+			const float *pSrc = pData + n * 4;
+			if (m_pRecord)
+				fprintf(m_pRecord, "f %d %a %a %a %a\n", nRegister, pSrc[0], pSrc[1], pSrc[2], pSrc[3]);
+
+			// Bitwise, -0.0f and NaNs count as Changes. The GPU doesn't care and neither do we
+			float *pDst = m_flFloats[nRegister];
+			if (IsBitSet(m_nFloatKnown, nRegister) && !memcmp(pDst, pSrc, sizeof(float) * 4))
+				continue;
+
+			m_nHash ^= HashRegister(nRegister, pDst);
+			memcpy(pDst, pSrc, sizeof(float) * 4);
+			m_nHash ^= HashRegister(nRegister, pDst);
+
+			SetBit(m_nFloatKnown, nRegister);
+			SetBit(m_nFloatDirty, nRegister);
+		}
+	}
+
+	void SetBool(int nRegister, bool bValue)
+	{
+		int nValue = bValue ? 1 : 0;
+		SetBools(nRegister, &nValue, 1);
+	}
+
+	// Takes BOOL, which is an int
+	void SetBools(int nFirstRegister, const int *pData, int nRegisters)
+	{
+		m_Stats.m_nBoolSets += nRegisters;
+		for (int n = 0; n < nRegisters; n++)
+		{
+			const int nRegister = nFirstRegister + n;
+			const int nValue = pData[n] ? 1 : 0;
+			if (m_pRecord)
+				fprintf(m_pRecord, "b %d %d\n", nRegister, nValue);
+
+			if (IsBitSet(m_nBoolKnown, nRegister) && m_nBools[nRegister] == nValue)
+				continue;
+
+			m_nBools[nRegister] = nValue;
+			m_nBoolKnown |= 1u << nRegister;
+			m_nBoolDirty |= 1u << nRegister;
+		}
+	}
+
+	//==========================================================================//
+	// Uploading. T is the CommandBuilder or IShaderDynamicAPI
+	// Returns the Number of Upload Calls
+	//==========================================================================//
+	template <class T> int FlushPS(T &Builder) { return Flush<T, false>(Builder); }
+	template <class T> int FlushVS(T &Builder) { return Flush<T, true>(Builder); }
+
+	// Whatever we think the GPU has is wrong now. Next Set*() uploads, even for the same Value
+	void Invalidate()
+	{
+		memset(m_nFloatKnown, 0, sizeof(m_nFloatKnown));
+		memset(m_nFloatDirty, 0, sizeof(m_nFloatDirty));
+		m_nBoolKnown = 0;
+		m_nBoolDirty = 0;
+	}
+
+	//==========================================================================//
+	// Hash of every Register, updated on each Change. Same Values, same Hash, no matter the Order they were set in
+	// Registers that were never set count as Zero
+	//==========================================================================//
+	uint64_t GetHash() const
+	{
+		uint64_t nHash = m_nHash;
+		for (int n = 0; n < LUX_CONSTANTSHADOW_NUM_BOOLS; n++)
+			nHash ^= m_nBools[n] ? HashRegister(NUM_FLOATS + n, NULL) : 0;
+		return nHash;
+	}
+
+	const float *GetFloat4(int nRegister) const { return m_flFloats[nRegister]; }
+	bool GetBool(int nRegister) const { return m_nBools[nRegister] != 0; }
+
+	// Writes every Set*() and Flush to pFile, for lux_constantshadow_bench. NULL stops
+	void SetRecordFile(FILE *pFile) { m_pRecord = pFile; }
+
+	const LuxConstantShadowStats_t &GetStats() const { return m_Stats; }
+	void ResetStats() { m_Stats = LuxConstantShadowStats_t(); }
+
+private:
+	enum { NUM_WORDS = (NUM_FLOATS + 31) / 32 };
+
+	static bool IsBitSet(const uint32_t *pBits, int n) { return (pBits[n >> 5] & (1u << (n & 31))) != 0; }
+	static bool IsBitSet(uint32_t nBits, int n) { return (nBits & (1u << n)) != 0; }
+	static void SetBit(uint32_t *pBits, int n) { pBits[n >> 5] |= 1u << (n & 31); }
+
+	// FNV-1a of Register and Value. XOR'd together, so a Change only needs the old and the new Value
+	static uint64_t HashRegister(int nRegister, const float *pValue)
+	{
+		uint64_t nHash = 14695981039346656037ULL ^ (uint64_t)nRegister;
+		nHash *= 1099511628211ULL;
+		if (pValue)
+		{
+			const unsigned char *p = (const unsigned char *)pValue;
+			for (int n = 0; n < 16; n++)
+			{
+				nHash ^= p[n];
+				nHash *= 1099511628211ULL;
+			}
+		}
+		return nHash;
+	}
+
+	template <class T, bool bVertex>
+	int Flush(T &Builder)
+	{
+		int nCalls = 0;
+		m_Stats.m_nFlushes++;
+		if (m_pRecord)
+			fprintf(m_pRecord, "draw\n");
+
+		// Floats. Walk the dirty Runs, bridge small Gaps
+		int nRunStart = -1, nRunEnd = -1;
+		for (int nWord = 0; nWord < NUM_WORDS; nWord++)
+		{
+			uint32_t nBits = m_nFloatDirty[nWord];
+			if (!nBits)
+				continue;
+
+			m_nFloatDirty[nWord] = 0;
+			for (int nBit = 0; nBits; nBit++, nBits >>= 1)
+			{
+				if (!(nBits & 1))
+					continue;
+
+				int nRegister = nWord * 32 + nBit;
+				if (nRunStart != -1 && CanBridge(nRunEnd, nRegister))
+				{
+					nRunEnd = nRegister;
+					continue;
+				}
+
+				if (nRunStart != -1)
+					nCalls += UploadFloats<T, bVertex>(Builder, nRunStart, nRunEnd);
+				nRunStart = nRunEnd = nRegister;
+			}
+		}
+
+		if (nRunStart != -1)
+			nCalls += UploadFloats<T, bVertex>(Builder, nRunStart, nRunEnd);
+
+		// Bools. Only 16 of them, same Idea
+		uint32_t nBools = m_nBoolDirty;
+		m_nBoolDirty = 0;
+		for (int nBit = 0; nBools; )
+		{
+			if (!(nBools & 1))
+			{
+				nBit++;
+				nBools >>= 1;
+				continue;
+			}
+
+			int nCount = 0;
+			while (nBools & 1)
+			{
+				nCount++;
+				nBools >>= 1;
+			}
+
+			if (bVertex)
+				Builder.SetBooleanVertexShaderConstant(nBit, &m_nBools[nBit], nCount);
+			else
+				Builder.SetBooleanPixelShaderConstant(nBit, &m_nBools[nBit], nCount);
+
+			m_Stats.m_nBoolUploads += nCount;
+			m_Stats.m_nBoolRuns++;
+			nCalls++;
+			nBit += nCount;
+		}
+
+		return nCalls;
+	}
+
+	// Gap Registers are uploaded with the Shadow's Value, so it has to be the GPU's Value too
+	bool CanBridge(int nRunEnd, int nRegister) const
+	{
+		if (nRegister - nRunEnd - 1 > LUX_CONSTANTSHADOW_MAX_GAP)
+			return false;
+
+		for (int n = nRunEnd + 1; n < nRegister; n++)
+		{
+			if (!IsBitSet(m_nFloatKnown, n))
+				return false;
+		}
+		return true;
+	}
+
+	template <class T, bool bVertex>
+	int UploadFloats(T &Builder, int nFirst, int nLast)
+	{
+		int nCount = nLast - nFirst + 1;
+		if (bVertex)
+			Builder.SetVertexShaderConstant(nFirst, m_flFloats[nFirst], nCount);
+		else
+			Builder.SetPixelShaderConstant(nFirst, m_flFloats[nFirst], nCount);
+
+		m_Stats.m_nFloatUploads += nCount;
+		m_Stats.m_nFloatRuns++;
+		return 1;
+	}
+
+	float m_flFloats[NUM_FLOATS][4];
+	int m_nBools[LUX_CONSTANTSHADOW_NUM_BOOLS];
+
+	uint32_t m_nFloatKnown[NUM_WORDS];	// Register holds what the GPU has
+	uint32_t m_nFloatDirty[NUM_WORDS];	// Register changed since the last Flush
+	uint32_t m_nBoolKnown;
+	uint32_t m_nBoolDirty;
+
+	uint64_t m_nHash;
+	FILE *m_pRecord;
+	LuxConstantShadowStats_t m_Stats;
+};
+
+// SM3 Limits
+typedef CLuxConstantShadow<224> CLuxPixelConstantShadow;
+typedef CLuxConstantShadow<256> CLuxVertexConstantShadow;
+
+#endif // CPP_LUX_CONSTANTSHADOW_H
@@ -0,0 +1,191 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Once-per-Frame Snapshot of the ConVars Draws read
+//
+//	Draw Code reads mat_fullbright ( DEBUG_FULLBRIGHT2 ), mat_luxels ( DEBUG_LUXELS ) and the mat_ Toggles
+//	on every Draw, each one a Trip through the ConVar and its Parent. The Values change a few Times per Session.
+//	LuxConVars() copies all of them into a flat POD once per Frame and Draw Code reads that instead :
+/*
+	const LuxConVarSnapshot_t &ConVars = LuxConVars(pShaderAPI->GetCurrentFrameCounter());
+#if defined(DEBUG_FULLBRIGHT2)
+	if (ConVars.m_nFullbright == 2)
+		..
+#endif
+*/
+//	m_nVersion only goes up when a Value actually changed, so anything built from ConVars
+//	( a Material Block, a State Block Key ) can compare Versions instead of Values.
+//
+//	New ConVars go into LUX_CONVARSNAPSHOT_FIELDS, nothing else has to change. Fields for a Debug Feature
+//	only exist when lux_common_defines.h enables it, so there's no Read of a ConVar nothing uses.
+//	Define LUX_CONVARSNAPSHOT_CORE_ONLY for the Snapshot without the SDK, devtools/luxtools/lux_convarsnapshot_bench does.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_CONVARSNAPSHOT_H
+#define CPP_LUX_CONVARSNAPSHOT_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <string.h>
+#include <stdint.h>
+
+#if !defined(LUX_CONVARSNAPSHOT_CORE_ONLY)
+#include "lux_common_defines.h"
+#endif
+
+//==========================================================================//
+// Field( ID, Type, Member, ConVar Name, Default if the ConVar doesn't exist )
+// Type is int, float or bool
+//==========================================================================//
+// The Tools get every Field, they don't see lux_common_defines.h
+#if defined(DEBUG_FULLBRIGHT2) || defined(LUX_CONVARSNAPSHOT_CORE_ONLY)
+#define LUX_CONVARSNAPSHOT_FULLBRIGHT_FIELDS(Field)\
+	Field(FULLBRIGHT,		int,	m_nFullbright,		"mat_fullbright",		0)
+#else
+#define LUX_CONVARSNAPSHOT_FULLBRIGHT_FIELDS(Field)
+#endif
+
+#if defined(DEBUG_LUXELS) || defined(LUX_CONVARSNAPSHOT_CORE_ONLY)
+#define LUX_CONVARSNAPSHOT_LUXELS_FIELDS(Field)\
+	Field(LUXELS,			bool,	m_bLuxels,			"mat_luxels",			false)
+#else
+#define LUX_CONVARSNAPSHOT_LUXELS_FIELDS(Field)
+#endif
+
+#define LUX_CONVARSNAPSHOT_STOCK_FIELDS(Field)\
+	Field(SPECULAR,			bool,	m_bSpecular,		"mat_specular",			true)\
+	Field(BUMPMAP,			bool,	m_bBumpMap,			"mat_bumpmap",			true)\
+	Field(PHONG,			bool,	m_bPhong,			"mat_phong",			true)\
+	Field(DISABLE_LIGHTWARP,bool,	m_bDisableLightWarp,"mat_disable_lightwarp",false)\
+	Field(FLASHLIGHTDEPTHRES,int,	m_nFlashlightDepthRes,"r_flashlightdepthres",1024)
+
+// Empty on purpose. The LUX_DEBUGCONVARS are declared with the Shader C++, none of them is read per Draw yet.
+// One that is goes here, under #if defined(LUX_DEBUGCONVARS)
+#define LUX_CONVARSNAPSHOT_DEBUG_FIELDS(Field)
+
+#define LUX_CONVARSNAPSHOT_FIELDS(Field)\
+	LUX_CONVARSNAPSHOT_FULLBRIGHT_FIELDS(Field)\
+	LUX_CONVARSNAPSHOT_LUXELS_FIELDS(Field)\
+	LUX_CONVARSNAPSHOT_STOCK_FIELDS(Field)\
+	LUX_CONVARSNAPSHOT_DEBUG_FIELDS(Field)
+
+enum LuxConVars_t
+{
+#define LUX_CONVARSNAPSHOT_ENUM(ID, Type, Member, Name, Default) LUXCONVAR_##ID,
+	LUX_CONVARSNAPSHOT_FIELDS(LUX_CONVARSNAPSHOT_ENUM)
+#undef LUX_CONVARSNAPSHOT_ENUM
+
+	NUM_LUXCONVARS
+};
+
+struct LuxConVarSnapshot_t
+{
+	LuxConVarSnapshot_t()
+	{
+		memset(this, 0, sizeof(LuxConVarSnapshot_t));
+#define LUX_CONVARSNAPSHOT_DEFAULT(ID, Type, Member, Name, Default) Member = Default;
+		LUX_CONVARSNAPSHOT_FIELDS(LUX_CONVARSNAPSHOT_DEFAULT)
+#undef LUX_CONVARSNAPSHOT_DEFAULT
+	}
+
+	uint32_t m_nVersion;
+
+#define LUX_CONVARSNAPSHOT_MEMBER(ID, Type, Member, Name, Default) Type Member;
+	LUX_CONVARSNAPSHOT_FIELDS(LUX_CONVARSNAPSHOT_MEMBER)
+#undef LUX_CONVARSNAPSHOT_MEMBER
+};
+
+// Reads go through these, so the Reader only needs GetInt() and GetFloat()
+template <class T> inline void LuxConVar_Read(T &Reader, int nIndex, int &nOut) { nOut = Reader.GetInt(nIndex, nOut); }
+template <class T> inline void LuxConVar_Read(T &Reader, int nIndex, bool &bOut) { bOut = Reader.GetInt(nIndex, bOut ? 1 : 0) != 0; }
+template <class T> inline void LuxConVar_Read(T &Reader, int nIndex, float &flOut) { flOut = Reader.GetFloat(nIndex, flOut); }
+
+inline const char *LuxConVar_Name(int nIndex)
+{
+	static const char *s_pNames[] =
+	{
+#define LUX_CONVARSNAPSHOT_NAME(ID, Type, Member, Name, Default) Name,
+		LUX_CONVARSNAPSHOT_FIELDS(LUX_CONVARSNAPSHOT_NAME)
+#undef LUX_CONVARSNAPSHOT_NAME
+	};
+	return s_pNames[nIndex];
+}
+
+class CLuxConVarSnapshot
+{
+public:
+	CLuxConVarSnapshot() : m_nFrame(-1) {}
+
+	// T has GetInt(nIndex, nDefault) and GetFloat(nIndex, flDefault), nIndex being a LUXCONVAR_*.
+	// Reads once per nFrame, every other Call just returns the Snapshot
+	template <class T>
+	const LuxConVarSnapshot_t &Refresh(int nFrame, T &Reader)
+	{
+		if (nFrame == m_nFrame)
+			return m_Snapshot;
+		m_nFrame = nFrame;
+
+		bool bChanged = false;
+#define LUX_CONVARSNAPSHOT_REFRESH(ID, Type, Member, Name, Default)\
+		{\
+			Type Value = m_Snapshot.Member;\
+			LuxConVar_Read(Reader, LUXCONVAR_##ID, Value);\
+			bChanged |= Value != m_Snapshot.Member;\
+			m_Snapshot.Member = Value;\
+		}
+		LUX_CONVARSNAPSHOT_FIELDS(LUX_CONVARSNAPSHOT_REFRESH)
+#undef LUX_CONVARSNAPSHOT_REFRESH
+
+		if (bChanged)
+			m_Snapshot.m_nVersion++;
+		return m_Snapshot;
+	}
+
+	const LuxConVarSnapshot_t &Get() const { return m_Snapshot; }
+
+	// Next Refresh() reads again, even in the same Frame
+	void Invalidate() { m_nFrame = -1; }
+
+private:
+	LuxConVarSnapshot_t m_Snapshot;
+	int m_nFrame;
+};
+
+#if !defined(LUX_CONVARSNAPSHOT_CORE_ONLY)
+
+#include "icvar.h"
+#include "tier1/convar.h"
+
+// Finds every ConVar once, they live as long as the Engine does
+class CLuxConVarReader
+{
+public:
+	CLuxConVarReader()
+	{
+		for (int n = 0; n < NUM_LUXCONVARS; n++)
+			m_pConVars[n] = g_pCVar ? g_pCVar->FindVar(LuxConVar_Name(n)) : NULL;
+	}
+
+	int GetInt(int nIndex, int nDefault) const { return m_pConVars[nIndex] ? m_pConVars[nIndex]->GetInt() : nDefault; }
+	float GetFloat(int nIndex, float flDefault) const { return m_pConVars[nIndex] ? m_pConVars[nIndex]->GetFloat() : flDefault; }
+
+private:
+	ConVar *m_pConVars[NUM_LUXCONVARS];
+};
+
+// nFrame is pShaderAPI->GetCurrentFrameCounter(). Render Thread only
+inline const LuxConVarSnapshot_t &LuxConVars(int nFrame)
+{
+	static CLuxConVarReader s_Reader;
+	static CLuxConVarSnapshot s_Snapshot;
+	return s_Snapshot.Refresh(nFrame, s_Reader);
+}
+
+#endif // !LUX_CONVARSNAPSHOT_CORE_ONLY
+
+#endif // CPP_LUX_CONVARSNAPSHOT_H
@@ -0,0 +1,209 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Sorting a View's Draws by State before they are submitted
+//
+//	Draws come in the Order the Engine walks the World, so consecutive Draws switch Shaders,
+//	Combos and Textures all the Time, and the Constant Shadow ( cpp_lux_constantshadow.h ) can't skip much.
+//	CLuxDrawSorter collects a View's Draws with a 64 Bit Key, most significant first :
+//
+//		Shader ( 8 ) | Static Combo ( 20 ) | Texture Set ( 16 ) | Constant Block Hash ( 20 )
+//
+//	and radix-sorts them, so each Shader and Combo is set once and Draws with the same Textures and
+//	Constants end up next to each other. The Sort is stable, equal Keys keep their Submission Order.
+//	Values wider than their Field are folded, a Collision only costs a State Change, never a wrong Draw.
+//
+//	Only for Draws whose Order doesn't matter, Opaque and Alpha-tested. Translucent Draws are submitted as they come.
+//
+//	Sort() also counts the State Changes in Submission and in sorted Order, the Difference is what it saved.
+//	No SDK Dependencies, devtools/luxtools/lux_drawsort_replay replays captured Draw Lists through this.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_DRAWSORT_H
+#define CPP_LUX_DRAWSORT_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#define LUX_DRAWSORT_SHADER_BITS		8
+#define LUX_DRAWSORT_COMBO_BITS			20
+#define LUX_DRAWSORT_TEXTURES_BITS		16
+#define LUX_DRAWSORT_CONSTANTS_BITS		20
+
+// Full Values, the Key only holds folded ones
+struct LuxDrawState_t
+{
+	uint32_t m_nShader;
+	uint32_t m_nStaticCombo;		// cpp_lux_combokey.h Key() or Index()
+	uint32_t m_nTextureSet;			// Hash of the bound Textures
+	uint32_t m_nConstantHash;		// CLuxConstantShadow::GetHash() or the Material Block's
+	int m_nConstantRegisters;		// Uploaded when the Hash changes
+};
+
+// Before is Submission Order, After is sorted
+struct LuxDrawSortStats_t
+{
+	LuxDrawSortStats_t() { memset(this, 0, sizeof(LuxDrawSortStats_t)); }
+
+	int64_t m_nDraws;
+	int64_t m_nViews;
+	int64_t m_nShaderChanges[2];
+	int64_t m_nComboChanges[2];		// Shader or Combo
+	int64_t m_nTextureChanges[2];
+	int64_t m_nConstantUploads[2];	// Registers
+};
+
+// Keeps the low Bits of nValue, the high Bits XOR'd in
+inline uint64_t LuxDrawSort_Fold(uint32_t nValue, int nBits)
+{
+	uint32_t nMask = (1u << nBits) - 1u;
+	uint32_t nFolded = 0;
+	for (; nValue; nValue >>= nBits)
+		nFolded ^= nValue & nMask;
+	return nFolded;
+}
+
+inline uint64_t LuxDrawSortKey(const LuxDrawState_t &State)
+{
+	uint64_t nKey = LuxDrawSort_Fold(State.m_nShader, LUX_DRAWSORT_SHADER_BITS);
+	nKey = (nKey << LUX_DRAWSORT_COMBO_BITS) | LuxDrawSort_Fold(State.m_nStaticCombo, LUX_DRAWSORT_COMBO_BITS);
+	nKey = (nKey << LUX_DRAWSORT_TEXTURES_BITS) | LuxDrawSort_Fold(State.m_nTextureSet, LUX_DRAWSORT_TEXTURES_BITS);
+	nKey = (nKey << LUX_DRAWSORT_CONSTANTS_BITS) | LuxDrawSort_Fold(State.m_nConstantHash, LUX_DRAWSORT_CONSTANTS_BITS);
+	return nKey;
+}
+
+class CLuxDrawSorter
+{
+public:
+	// Per View
+	void BeginView()
+	{
+		m_Items.clear();
+		m_States.clear();
+		m_Order.clear();
+	}
+
+	// nDraw is handed back by Sort(), an Index into whatever the Caller keeps per Draw
+	void Add(const LuxDrawState_t &State, uint32_t nDraw)
+	{
+		Item_t Item;
+		Item.m_nKey = LuxDrawSortKey(State);
+		Item.m_nIndex = (uint32_t)m_States.size();
+		Item.m_nDraw = nDraw;
+		m_Items.push_back(Item);
+		m_States.push_back(State);
+	}
+
+	// Returns the nDraw Values in sorted Order, NumDraws() of them
+	const uint32_t *Sort()
+	{
+		m_Stats.m_nViews++;
+		m_Stats.m_nDraws += m_Items.size();
+		CountChanges(0);
+
+		RadixSort();
+
+		m_Order.resize(m_Items.size());
+		for (size_t n = 0; n < m_Items.size(); n++)
+			m_Order[n] = m_Items[n].m_nDraw;
+		CountChanges(1);
+
+		return m_Order.empty() ? NULL : &m_Order[0];
+	}
+
+	int NumDraws() const { return (int)m_Items.size(); }
+
+	// Only valid after Sort(), the Key of the n-th sorted Draw
+	uint64_t SortedKey(int n) const { return m_Items[n].m_nKey; }
+
+	const LuxDrawSortStats_t &GetStats() const { return m_Stats; }
+	void ResetStats() { m_Stats = LuxDrawSortStats_t(); }
+
+private:
+	struct Item_t
+	{
+		uint64_t m_nKey;
+		uint32_t m_nIndex;		// Into m_States
+		uint32_t m_nDraw;
+	};
+
+	// LSD, a Byte per Pass. Passes where every Key has the same Byte are skipped, with 8 Bit Shader IDs
+	// and few Combos per View that's most of the high ones
+	void RadixSort()
+	{
+		const size_t nItems = m_Items.size();
+		if (nItems < 2)
+			return;
+
+		m_Scratch.resize(nItems);
+		Item_t *pSrc = &m_Items[0];
+		Item_t *pDst = &m_Scratch[0];
+
+		size_t nCounts[8][256];
+		memset(nCounts, 0, sizeof(nCounts));
+		for (size_t n = 0; n < nItems; n++)
+		{
+			uint64_t nKey = pSrc[n].m_nKey;
+			for (int nPass = 0; nPass < 8; nPass++)
+				nCounts[nPass][(nKey >> (nPass * 8)) & 0xFF]++;
+		}
+
+		for (int nPass = 0; nPass < 8; nPass++)
+		{
+			size_t *pCounts = nCounts[nPass];
+			if (pCounts[(pSrc[0].m_nKey >> (nPass * 8)) & 0xFF] == nItems)
+				continue;
+
+			size_t nOffset = 0;
+			for (int n = 0; n < 256; n++)
+			{
+				size_t nCount = pCounts[n];
+				pCounts[n] = nOffset;
+				nOffset += nCount;
+			}
+
+			for (size_t n = 0; n < nItems; n++)
+				pDst[pCounts[(pSrc[n].m_nKey >> (nPass * 8)) & 0xFF]++] = pSrc[n];
+
+			Item_t *pSwap = pSrc;
+			pSrc = pDst;
+			pDst = pSwap;
+		}
+
+		if (pSrc != &m_Items[0])
+			m_Items.swap(m_Scratch);
+	}
+
+	// Against the Draw before, the first Draw of a View sets everything
+	void CountChanges(int nWhen)
+	{
+		const LuxDrawState_t *pPrevious = NULL;
+		for (size_t n = 0; n < m_Items.size(); n++)
+		{
+			const LuxDrawState_t &State = m_States[m_Items[n].m_nIndex];
+			bool bShader = !pPrevious || pPrevious->m_nShader != State.m_nShader;
+			m_Stats.m_nShaderChanges[nWhen] += bShader;
+			m_Stats.m_nComboChanges[nWhen] += bShader || pPrevious->m_nStaticCombo != State.m_nStaticCombo;
+			m_Stats.m_nTextureChanges[nWhen] += !pPrevious || pPrevious->m_nTextureSet != State.m_nTextureSet;
+			if (!pPrevious || pPrevious->m_nConstantHash != State.m_nConstantHash)
+				m_Stats.m_nConstantUploads[nWhen] += State.m_nConstantRegisters;
+			pPrevious = &State;
+		}
+	}
+
+	std::vector<Item_t> m_Items;
+	std::vector<Item_t> m_Scratch;
+	std::vector<LuxDrawState_t> m_States;
+	std::vector<uint32_t> m_Order;
+	LuxDrawSortStats_t m_Stats;
+};
+
+#endif // CPP_LUX_DRAWSORT_H
@@ -0,0 +1,249 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Lock-free per-Frame Memory
+//
+//	One big Allocation up front, handed out with an atomic Bump and given back all at once by Reset().
+//	Any Thread can Alloc() at the same Time, nothing is freed individually.
+//	When it runs full we fall back to the Heap, those Blocks sit on a lock-free List until Reset(),
+//	and OverflowBytes() tells you to make the Arena bigger. HighWater() is the most any Frame used.
+//
+//	Reset() only when no other Thread is allocating, i.e. at Frame End after the Workers are done.
+//
+//	CLuxFrameAllocator is the single-Thread Version for Shader Code. It takes Chunks from an Arena
+//	and bumps a Pointer inside them, no atomics. Use it for anything built per Draw and thrown away,
+//	Flashlight Matrices, packed Light Data, Ambient Cubes :
+//
+//		CLuxFrameAllocator &Frame = LuxFrameAllocator(pShaderAPI->GetCurrentFrameCounter());
+//		VMatrix *pWorldToTexture = Frame.Alloc<VMatrix>();
+//		MatrixTranspose(matWorldToTexture, *pWorldToTexture);
+//		pShaderAPI->SetPixelShaderConstant(LUX_PS_FLOAT_PROJTEX_MATRIX, pWorldToTexture->Base(), 4);
+//
+//	No SDK Dependencies, devtools/luxtools/lux_commandrecord_bench and lux_framearena_bench use this.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_FRAMEARENA_H
+#define CPP_LUX_FRAMEARENA_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+// Every Allocation starts on this. Cache Line, so Threads don't share Lines they write to
+#define LUX_FRAMEARENA_ALIGN		64
+
+// Bytes a CLuxFrameAllocator takes from its Arena at once
+#define LUX_FRAMEALLOCATOR_CHUNK	4096
+
+// Arena behind LuxFrameAllocator(). A Frame with a few hundred Flashlit Models stays well under this
+#define LUX_FRAMEARENA_SHADER_SIZE	(256 * 1024)
+
+class CLuxFrameArena
+{
+public:
+	CLuxFrameArena(size_t nBytes) : m_nCapacity(nBytes), m_nHighWater(0), m_nOffset(0), m_pOverflow(NULL), m_nOverflowBytes(0)
+	{
+		// Over-allocate so the Base can be aligned by Hand, aligned_alloc isn't everywhere
+		m_pMemory = (uint8_t *)malloc(nBytes + LUX_FRAMEARENA_ALIGN);
+		m_pBase = (uint8_t *)(((uintptr_t)m_pMemory + LUX_FRAMEARENA_ALIGN - 1) & ~(uintptr_t)(LUX_FRAMEARENA_ALIGN - 1));
+	}
+
+	~CLuxFrameArena()
+	{
+		FreeOverflow();
+		free(m_pMemory);
+	}
+
+	// Thread-safe, lock-free
+	void *Alloc(size_t nBytes)
+	{
+		size_t nSize = (nBytes + LUX_FRAMEARENA_ALIGN - 1) & ~(size_t)(LUX_FRAMEARENA_ALIGN - 1);
+		size_t nOffset = m_nOffset.fetch_add(nSize, std::memory_order_relaxed);
+		if (nOffset + nSize <= m_nCapacity)
+			return m_pBase + nOffset;
+
+		return AllocOverflow(nSize);
+	}
+
+	// Everything handed out is invalid afterwards. Not thread-safe
+	// O(1) unless the Frame overflowed, then the Heap Blocks are freed here
+	void Reset()
+	{
+		size_t nUsed = m_nOffset.load(std::memory_order_relaxed);
+		if (nUsed > m_nHighWater)
+			m_nHighWater = nUsed;
+
+		if (m_pOverflow.load(std::memory_order_relaxed))
+			FreeOverflow();
+		m_nOffset.store(0, std::memory_order_relaxed);
+	}
+
+	// Can be over the Capacity after an Overflow, that's the Size the Arena should have had
+	size_t Used() const { return m_nOffset.load(std::memory_order_relaxed); }
+	size_t Capacity() const { return m_nCapacity; }
+
+	// Most Bytes used by any Frame so far, the current one included
+	size_t HighWater() const { return Used() > m_nHighWater ? Used() : m_nHighWater; }
+	size_t OverflowBytes() const { return m_nOverflowBytes.load(std::memory_order_relaxed); }
+
+private:
+	struct Overflow_t
+	{
+		Overflow_t *pNext;
+	};
+
+	void *AllocOverflow(size_t nSize)
+	{
+		uint8_t *pMemory = (uint8_t *)malloc(nSize + LUX_FRAMEARENA_ALIGN * 2);
+		if (!pMemory)
+			return NULL;
+
+		// Header in the first aligned Slot, Data in the second
+		Overflow_t *pBlock = (Overflow_t *)pMemory;
+		uint8_t *pData = (uint8_t *)(((uintptr_t)pMemory + sizeof(Overflow_t) + LUX_FRAMEARENA_ALIGN - 1) & ~(uintptr_t)(LUX_FRAMEARENA_ALIGN - 1));
+
+		pBlock->pNext = m_pOverflow.load(std::memory_order_relaxed);
+		while (!m_pOverflow.compare_exchange_weak(pBlock->pNext, pBlock, std::memory_order_release, std::memory_order_relaxed))
+			;
+
+		m_nOverflowBytes.fetch_add(nSize, std::memory_order_relaxed);
+		return pData;
+	}
+
+	void FreeOverflow()
+	{
+		Overflow_t *pBlock = m_pOverflow.exchange(NULL, std::memory_order_acquire);
+		while (pBlock)
+		{
+			Overflow_t *pNext = pBlock->pNext;
+			free(pBlock);
+			pBlock = pNext;
+		}
+		m_nOverflowBytes.store(0, std::memory_order_relaxed);
+	}
+
+	uint8_t *m_pMemory;
+	uint8_t *m_pBase;
+	size_t m_nCapacity;
+	size_t m_nHighWater;
+	std::atomic<size_t> m_nOffset;
+	std::atomic<Overflow_t *> m_pOverflow;
+	std::atomic<size_t> m_nOverflowBytes;
+};
+
+//==========================================================================//
+// Single-Thread Bump Allocator on top of an Arena. One per Thread, or just the Render Thread's
+//==========================================================================//
+class CLuxFrameAllocator
+{
+public:
+	CLuxFrameAllocator(CLuxFrameArena &Arena) : m_Arena(Arena), m_pCursor(NULL), m_pLimit(NULL), m_nUsed(0), m_nHighWater(0), m_nAllocs(0) {}
+
+	// nAlign must be a Power of 2, up to LUX_FRAMEARENA_ALIGN
+	void *Alloc(size_t nBytes, size_t nAlign = 16)
+	{
+		uint8_t *p = (uint8_t *)(((uintptr_t)m_pCursor + nAlign - 1) & ~(uintptr_t)(nAlign - 1));
+		if (!m_pCursor || nBytes > (size_t)(m_pLimit - p))
+			return AllocChunk(nBytes);
+
+		m_nUsed += (p - m_pCursor) + nBytes;
+		m_nAllocs++;
+		m_pCursor = p + nBytes;
+		return p;
+	}
+
+	// Uninitialised, for PODs only. Nothing is destructed on Reset()
+	template <class T>
+	T *Alloc(int nCount = 1) { return (T *)Alloc(sizeof(T) * nCount, alignof(T) > 16 ? alignof(T) : 16); }
+
+	// nRegisters * 4 Floats, ready for SetPixelShaderConstant()
+	float *AllocFloat4(int nRegisters) { return (float *)Alloc(sizeof(float) * 4 * nRegisters, 16); }
+
+	// Call before the Arena's Reset(). Forgets the current Chunk, so this is O(1) too
+	void Reset()
+	{
+		if (m_nUsed > m_nHighWater)
+			m_nHighWater = m_nUsed;
+		m_pCursor = m_pLimit = NULL;
+		m_nUsed = 0;
+		m_nAllocs = 0;
+	}
+
+	// Bytes handed out this Frame, Alignment Padding included
+	size_t Used() const { return m_nUsed; }
+	size_t HighWater() const { return m_nUsed > m_nHighWater ? m_nUsed : m_nHighWater; }
+	int Allocs() const { return m_nAllocs; }
+
+private:
+	void *AllocChunk(size_t nBytes)
+	{
+		// Too big to be worth a Chunk, straight from the Arena and keep the current Chunk going
+		if (nBytes > LUX_FRAMEALLOCATOR_CHUNK / 4)
+		{
+			void *pLarge = m_Arena.Alloc(nBytes);
+			if (pLarge)
+			{
+				m_nUsed += nBytes;
+				m_nAllocs++;
+			}
+			return pLarge;
+		}
+
+		// Overflow malloc() failed. Drop the Chunk, so the next Alloc() asks the Arena again instead of bumping past NULL
+		m_pCursor = (uint8_t *)m_Arena.Alloc(LUX_FRAMEALLOCATOR_CHUNK);
+		if (!m_pCursor)
+		{
+			m_pLimit = NULL;
+			return NULL;
+		}
+		m_pLimit = m_pCursor + LUX_FRAMEALLOCATOR_CHUNK;
+		m_nUsed += nBytes;
+		m_nAllocs++;
+
+		// Chunks are Cache Line aligned, any nAlign is satisfied at the Start
+		void *p = m_pCursor;
+		m_pCursor += nBytes;
+		return p;
+	}
+
+	CLuxFrameArena &m_Arena;
+	uint8_t *m_pCursor;
+	uint8_t *m_pLimit;
+	size_t m_nUsed;
+	size_t m_nHighWater;
+	int m_nAllocs;
+};
+
+//==========================================================================//
+// The Allocator for C++ Shader Code. Everything from it is valid until the next Frame
+// nFrame is pShaderAPI->GetCurrentFrameCounter(), the first Call with a new one resets.
+// Dynamic State is set on one Thread ( the Material System Thread with Queued Rendering ), so no Locks
+//==========================================================================//
+inline CLuxFrameArena &LuxFrameArena()
+{
+	static CLuxFrameArena s_Arena(LUX_FRAMEARENA_SHADER_SIZE);
+	return s_Arena;
+}
+
+inline CLuxFrameAllocator &LuxFrameAllocator(int nFrame)
+{
+	static CLuxFrameAllocator s_Allocator(LuxFrameArena());
+	static int s_nFrame = -1;
+	if (nFrame != s_nFrame)
+	{
+		s_Allocator.Reset();
+		LuxFrameArena().Reset();
+		s_nFrame = nFrame;
+	}
+	return s_Allocator;
+}
+
+#endif // CPP_LUX_FRAMEARENA_H
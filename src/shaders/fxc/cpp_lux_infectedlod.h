@@ -0,0 +1,178 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	CPU Reference of the Infected Albedo and the INFECTED_FARLOD Bake
+//
+//	Close Infected do four Fetches for their Albedo ( lux_infected_ps30.h ) :
+//	$BaseTexture, $GradientTexture ( Row picked by g_f1RandomisationOffset1 ),
+//	$BurnDetailTexture and $WoundCutOutTexture.
+//	Far away nobody sees the Wounds and the Gradient Row is fixed per Variation,
+//	so devtools/luxtools/lux_infected_lodbake pre-combines them into one small Texture per Variation :
+//
+//	[RGB] $BaseTexture * $GradientTexture Row, sRGB
+//	[A]   $BurnDetailTexture Luminance, Linear. Times g_f2BurnLODTint and g_f1BurnStrength in the Shader
+//
+//	The INFECTED_FARLOD Combo binds that to s0 and skips the other three Samplers.
+//	The Math here is SDK-free so the Baker can measure the Error against the full Path.
+//	Define LUX_INFECTEDLOD_BAKE_ONLY to get just that.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_INFECTEDLOD_H
+#define CPP_LUX_INFECTEDLOD_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <math.h>
+
+// LOD Textures are this much smaller than $BaseTexture on each Axis
+#define LUX_INFECTEDLOD_DOWNSCALE		4
+
+// Infected smaller than this on Screen ( Pixels, Bounding Sphere Diameter ) use INFECTED_FARLOD
+// At a Downscale of 4 this is where the LOD Texture's Mip 0 is about Texel-to-Pixel
+#define LUX_INFECTEDLOD_MAX_PIXELS		96.0f
+
+// Most Gradient Textures have this many Rows
+#define LUX_INFECTEDLOD_VARIATIONS		8
+
+//==========================================================================//
+// Helpers
+//==========================================================================//
+inline float LuxInfectedLOD_SrgbToLinear(float f)
+{
+	return (f <= 0.04045f) ? f / 12.92f : powf((f + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float LuxInfectedLOD_LinearToSrgb(float f)
+{
+	f = f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f);
+	return (f <= 0.0031308f) ? f * 12.92f : 1.055f * powf(f, 1.0f / 2.4f) - 0.055f;
+}
+
+// Center of the Gradient Row for a Variation. The C++ uploads this as g_f1RandomisationOffset1
+inline float LuxInfectedLOD_VariationOffset(int nVariation, int nVariations)
+{
+	return (nVariation + 0.5f) / nVariations;
+}
+
+//==========================================================================//
+// Ports of lux_infected_ps30.h. Keep these 1:1
+//==========================================================================//
+
+// BurnFactor(), DetailBlendMode 5
+inline void LuxInfected_BurnFactor(const float f3Detail[3], float flBurnStrength, float f3Out[3])
+{
+	for (int n = 0; n < 3; n++)
+		f3Out[n] = f3Detail[n] * flBurnStrength;
+}
+
+// EdgeBlend()
+inline float LuxInfected_EdgeBlend(float u, float v, float flBorderWidth)
+{
+	float flDist = fminf(fminf(u, 1.0f - u), fminf(v, 1.0f - v));
+	float f = flDist / flBorderWidth;
+	f = f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f);
+	return powf(f, 5.0f);
+}
+
+// Wound clip(). 1.0f where the Texel survives, 0.0f where it's cut. flCutOut is the already projected Fetch
+inline float LuxInfected_WoundCoverage(float flCutOut, float flCutOutTextureBias)
+{
+	return (flCutOut - flCutOutTextureBias) < 0.0f ? 0.0f : 1.0f;
+}
+
+// Infected_GradientAlbedo(). Everything Linear, f3Gradient is the already sampled Row
+inline void LuxInfected_GradientAlbedo(const float f3Base[3], const float f3Gradient[3], float f3Out[3])
+{
+	for (int n = 0; n < 3; n++)
+		f3Out[n] = f3Base[n] * f3Gradient[n];
+}
+
+// What INFECTED_FARLOD stores per Texel. f3Albedo is Linear, the Caller encodes it
+inline void LuxInfectedLOD_BakeTexel(const float f3Albedo[3], const float f3BurnDetail[3], float f4Out[4])
+{
+	for (int n = 0; n < 3; n++)
+		f4Out[n] = f3Albedo[n];
+
+	// Rec. 709, the Default for g_f3LuminanceWeights. Baked offline, so the ConVar doesn't apply
+	f4Out[3] = f3BurnDetail[0] * 0.2126f + f3BurnDetail[1] * 0.7152f + f3BurnDetail[2] * 0.0722f;
+}
+
+// g_f2BurnLODTint back to a Colour with a Luminance of 1.0f
+inline void LuxInfectedLOD_BurnTint(const float f2Tint[2], float f3Out[3])
+{
+	f3Out[0] = f2Tint[0];
+	f3Out[2] = f2Tint[1];
+	f3Out[1] = (1.0f - f2Tint[0] * 0.2126f - f2Tint[1] * 0.0722f) / 0.7152f;
+}
+
+// Infected_FarLOD(). The Burn is a single Colour, lux_infected_lodbake measures what that costs
+inline void LuxInfectedLOD_Evaluate(const float f4LOD[4], const float f2BurnTint[2], float flBurnStrength, float f3Albedo[3], float f3Burn[3])
+{
+	float f3Tint[3];
+	LuxInfectedLOD_BurnTint(f2BurnTint, f3Tint);
+	for (int n = 0; n < 3; n++)
+	{
+		f3Albedo[n] = f4LOD[n];
+		f3Burn[n] = f4LOD[3] * f3Tint[n] * flBurnStrength;
+	}
+}
+
+// Bilinear, clamped. Gradient Lookups, pRGB is nWidth * nHeight * 3 Floats
+inline void LuxInfectedLOD_SampleClamped(const float *pRGB, int nWidth, int nHeight, float u, float v, float f3Out[3])
+{
+	float fx = u * nWidth - 0.5f;
+	float fy = v * nHeight - 0.5f;
+	fx = fx < 0.0f ? 0.0f : (fx > nWidth - 1 ? (float)(nWidth - 1) : fx);
+	fy = fy < 0.0f ? 0.0f : (fy > nHeight - 1 ? (float)(nHeight - 1) : fy);
+
+	int x0 = (int)fx, y0 = (int)fy;
+	int x1 = x0 + 1 < nWidth ? x0 + 1 : x0;
+	int y1 = y0 + 1 < nHeight ? y0 + 1 : y0;
+	float tx = fx - x0, ty = fy - y0;
+
+	for (int n = 0; n < 3; n++)
+	{
+		float a = pRGB[(y0 * nWidth + x0) * 3 + n], b = pRGB[(y0 * nWidth + x1) * 3 + n];
+		float c = pRGB[(y1 * nWidth + x0) * 3 + n], d = pRGB[(y1 * nWidth + x1) * 3 + n];
+		float ab = a + (b - a) * tx, cd = c + (d - c) * tx;
+		f3Out[n] = ab + (cd - ab) * ty;
+	}
+}
+
+// Screen Size of the Bounding Sphere in Pixels. flTanHalfFov is tan(FOV / 2) of the vertical FOV
+inline bool LuxInfectedLOD_UseFarLOD(float flRadius, float flDistance, float flScreenHeight, float flTanHalfFov)
+{
+	if (flDistance <= flRadius)
+		return false;
+
+	float flPixels = flRadius * flScreenHeight / (flDistance * flTanHalfFov);
+	return flPixels < LUX_INFECTEDLOD_MAX_PIXELS;
+}
+
+#if !defined(LUX_INFECTEDLOD_BAKE_ONLY)
+
+#include "tier1/strtools.h"
+
+//==========================================================================//
+// Baked Textures live next to $BaseTexture, lux_infected_lodbake writes them with the same Names
+//==========================================================================//
+inline void LuxInfectedLOD_TextureName(char *pOut, int nSize, const char *pBaseTexture, int nVariation)
+{
+	V_snprintf(pOut, nSize, "%s_lod%d", pBaseTexture, nVariation);
+}
+
+// Gradient Row back to the Variation, for Instances that only know their Randomisation Offset
+inline int LuxInfectedLOD_OffsetToVariation(float flOffset, int nVariations = LUX_INFECTEDLOD_VARIATIONS)
+{
+	int nVariation = (int)(flOffset * nVariations);
+	return nVariation < 0 ? 0 : (nVariation >= nVariations ? nVariations - 1 : nVariation);
+}
+
+#endif // !LUX_INFECTEDLOD_BAKE_ONLY
+
+#endif // CPP_LUX_INFECTEDLOD_H
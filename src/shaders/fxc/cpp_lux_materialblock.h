@@ -0,0 +1,272 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Precomputed per-Material Constant Registers
+//
+//	The Vars_*_t Structs only hold Parameter Indices, so every Draw reads the Parameters again
+//	and packs $EnvMapTint with $EnvMapLightScale, the Fresnel Ranges and so on into float4's.
+//	None of that changes unless the Material does. CLuxMaterialConstantBlock keeps the packed
+//	Registers in one contiguous Array, built once when the Material Vars change, and each Draw
+//	only streams it out, one Call per contiguous Run.
+//
+//	Storage is a CBasePerMaterialContextData, the Engine sets m_bMaterialVarsChanged for us.
+//
+//	Usage, in OnDrawElements() :
+/*
+	CLuxMaterialContext *pContext = LuxGetMaterialContext(pContextDataPtr);
+	if (pContext->m_bMaterialVarsChanged)
+	{
+		pContext->m_PixelBlock.Reset();
+		LuxBlock_Detail(pContext->m_PixelBlock, params, DetailVars);
+		LuxBlock_EnvMap(pContext->m_PixelBlock, params, EnvMapVars);
+		pContext->m_bMaterialVarsChanged = false;
+	}
+
+	// Dynamic State
+	pContext->m_PixelBlock.UploadPS(*pShaderAPI);
+*/
+//	Only put Registers in here that depend on nothing but Material Parameters.
+//	Anything Time, Instance or Lighting dependent still goes through the regular Path.
+//
+//	The Builders are Templates on the Parameter Type, IMaterialVar in the Shaders.
+//	Define LUX_MATERIALBLOCK_CORE_ONLY for the Block and Builders without the SDK, devtools/luxtools/lux_materialblock_check
+//	compares them against the per-Constant Path with it. The LUX_PS_FLOAT_ Registers have to be defined first.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_MATERIALBLOCK_H
+#define CPP_LUX_MATERIALBLOCK_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <string.h>
+#include <math.h>
+
+#if defined(LUX_MATERIALBLOCK_CORE_ONLY)
+#include <assert.h>
+#define LUX_MATERIALBLOCK_ASSERT(Expression) assert(Expression)
+#else
+#include "cpp_lux_shared.h"
+#define LUX_MATERIALBLOCK_ASSERT(Expression) Assert(Expression)
+#endif
+
+#include "cpp_lux_constantshadow.h"
+
+// Registers per Block. Every ps30 Material Register ( LUX_PS_FLOAT_COLOR_FACTORS .. PHONG_MINLIGHT_BOOST ) fits
+#define LUX_MATERIALBLOCK_MAX_REGISTERS		24
+
+class CLuxMaterialConstantBlock
+{
+public:
+	CLuxMaterialConstantBlock() { Reset(); }
+
+	void Reset()
+	{
+		m_nRegisters = 0;
+		m_nRuns = 0;
+	}
+
+	// Registers can come in any Order, the Block stays sorted. Setting the same Register twice overwrites it
+	void SetFloat4(int nRegister, float x, float y, float z, float w)
+	{
+		int nSlot = 0;
+		while (nSlot < m_nRegisters && m_nRegister[nSlot] < nRegister)
+			nSlot++;
+
+		if (nSlot == m_nRegisters || m_nRegister[nSlot] != nRegister)
+		{
+			LUX_MATERIALBLOCK_ASSERT(m_nRegisters < LUX_MATERIALBLOCK_MAX_REGISTERS);
+			if (m_nRegisters >= LUX_MATERIALBLOCK_MAX_REGISTERS)
+				return;
+
+			// Make Room
+			memmove(&m_flData[nSlot + 1], &m_flData[nSlot], (m_nRegisters - nSlot) * sizeof(m_flData[0]));
+			memmove(&m_nRegister[nSlot + 1], &m_nRegister[nSlot], (m_nRegisters - nSlot) * sizeof(m_nRegister[0]));
+			m_nRegister[nSlot] = (unsigned char)nRegister;
+			m_nRegisters++;
+		}
+
+		m_flData[nSlot][0] = x;
+		m_flData[nSlot][1] = y;
+		m_flData[nSlot][2] = z;
+		m_flData[nSlot][3] = w;
+		BuildRuns();
+	}
+
+	//==========================================================================//
+	// Per Draw. T is the CommandBuilder or IShaderDynamicAPI
+	//==========================================================================//
+	template <class T>
+	void UploadPS(T &Builder) const
+	{
+		for (int n = 0; n < m_nRuns; n++)
+			Builder.SetPixelShaderConstant(m_Runs[n].m_nFirstRegister, m_flData[m_Runs[n].m_nSlot], m_Runs[n].m_nCount);
+	}
+
+	template <class T>
+	void UploadVS(T &Builder) const
+	{
+		for (int n = 0; n < m_nRuns; n++)
+			Builder.SetVertexShaderConstant(m_Runs[n].m_nFirstRegister, m_flData[m_Runs[n].m_nSlot], m_Runs[n].m_nCount);
+	}
+
+	// Through cpp_lux_constantshadow.h instead, Materials that share Values then don't upload at all
+	template <int NUM_FLOATS>
+	void ApplyTo(CLuxConstantShadow<NUM_FLOATS> &Shadow) const
+	{
+		for (int n = 0; n < m_nRuns; n++)
+			Shadow.SetFloats(m_Runs[n].m_nFirstRegister, m_flData[m_Runs[n].m_nSlot], m_Runs[n].m_nCount);
+	}
+
+	int NumRegisters() const { return m_nRegisters; }
+	int NumRuns() const { return m_nRuns; }
+
+private:
+	void BuildRuns()
+	{
+		m_nRuns = 0;
+		for (int nSlot = 0; nSlot < m_nRegisters; nSlot++)
+		{
+			if (m_nRuns && m_Runs[m_nRuns - 1].m_nFirstRegister + m_Runs[m_nRuns - 1].m_nCount == m_nRegister[nSlot])
+			{
+				m_Runs[m_nRuns - 1].m_nCount++;
+				continue;
+			}
+
+			m_Runs[m_nRuns].m_nFirstRegister = m_nRegister[nSlot];
+			m_Runs[m_nRuns].m_nSlot = (unsigned char)nSlot;
+			m_Runs[m_nRuns].m_nCount = 1;
+			m_nRuns++;
+		}
+	}
+
+	struct Run_t
+	{
+		unsigned char m_nFirstRegister;
+		unsigned char m_nSlot;
+		unsigned char m_nCount;
+	};
+
+	// Packed, Register Order. Runs point into this
+	float m_flData[LUX_MATERIALBLOCK_MAX_REGISTERS][4];
+	unsigned char m_nRegister[LUX_MATERIALBLOCK_MAX_REGISTERS];
+	Run_t m_Runs[LUX_MATERIALBLOCK_MAX_REGISTERS];
+	int m_nRegisters;
+	int m_nRuns;
+};
+
+#if !defined(LUX_MATERIALBLOCK_CORE_ONLY)
+//==========================================================================//
+// Per-Material Context. Shaders that need more can inherit from this
+//==========================================================================//
+class CLuxMaterialContext : public CBasePerMaterialContextData
+{
+public:
+	CLuxMaterialConstantBlock m_PixelBlock;
+	CLuxMaterialConstantBlock m_VertexBlock;
+};
+
+template <class T>
+inline T *LuxGetMaterialContext(CBasePerMaterialContextData **pContextDataPtr)
+{
+	T *pContext = static_cast<T *>(*pContextDataPtr);
+	if (!pContext)
+	{
+		// m_bMaterialVarsChanged starts out true, so the first Draw builds the Block
+		pContext = new T;
+		*pContextDataPtr = pContext;
+	}
+	return pContext;
+}
+
+inline CLuxMaterialContext *LuxGetMaterialContext(CBasePerMaterialContextData **pContextDataPtr)
+{
+	return LuxGetMaterialContext<CLuxMaterialContext>(pContextDataPtr);
+}
+
+#endif // !LUX_MATERIALBLOCK_CORE_ONLY
+
+//==========================================================================//
+// Parameter Reads. A Shader without the Parameter ( -1 ) or a Material without the Value get the Default
+//==========================================================================//
+template <class T>
+inline float LuxBlock_Float(T **params, int nVar, float flDefault)
+{
+	return nVar != -1 && params[nVar]->IsDefined() ? params[nVar]->GetFloatValue() : flDefault;
+}
+
+template <class T>
+inline int LuxBlock_Int(T **params, int nVar, int nDefault)
+{
+	return nVar != -1 && params[nVar]->IsDefined() ? params[nVar]->GetIntValue() : nDefault;
+}
+
+template <class T>
+inline void LuxBlock_Vec3(T **params, int nVar, float f3Out[3], float x, float y, float z)
+{
+	f3Out[0] = x;
+	f3Out[1] = y;
+	f3Out[2] = z;
+	if (nVar != -1 && params[nVar]->IsDefined())
+		params[nVar]->GetVecValue(f3Out, 3);
+}
+
+// What SetPixelShaderConstantGammaToLinear() does to each Component, Overbright Values stay above 1
+inline float LuxBlock_GammaToLinear(float flGamma)
+{
+	return flGamma > 0.0f ? powf(flGamma, 2.2f) : 0.0f;
+}
+
+//==========================================================================//
+// Block Builders for the Vars Structs. Same Packing as the HLSL Headers
+//==========================================================================//
+
+// lux_common_detailtexture.h. The Detail Tint is uploaded as it is, like Stock
+template <class T, class TVars>
+inline void LuxBlock_Detail(CLuxMaterialConstantBlock &Block, T **params, const TVars &Vars)
+{
+	if (Vars.m_nDetail == -1 || !params[Vars.m_nDetail]->IsTexture())
+		return;
+
+	float f3Tint[3];
+	LuxBlock_Vec3(params, Vars.m_nDetailTint, f3Tint, 1.0f, 1.0f, 1.0f);
+	Block.SetFloat4(LUX_PS_FLOAT_DETAIL_FACTORS, f3Tint[0], f3Tint[1], f3Tint[2], LuxBlock_Float(params, Vars.m_nDetailBlendFactor, 1.0f));
+	Block.SetFloat4(LUX_PS_FLOAT_DETAIL_BLENDMODE, (float)LuxBlock_Int(params, Vars.m_nDetailBlendmode, 0), 0.0f, 0.0f, 0.0f);
+}
+
+// lux_common_envmap.h. LUX_PS_FLOAT_ENVMAP_CONTROLS has the EnvMapLerp Factor, that one stays dynamic
+template <class T, class TVars>
+inline void LuxBlock_EnvMap(CLuxMaterialConstantBlock &Block, T **params, const TVars &Vars)
+{
+	if (Vars.m_nEnvMap == -1 || !params[Vars.m_nEnvMap]->IsTexture())
+		return;
+
+	// $EnvMapTint is a Gamma Color, the Shader wants it linear
+	float f3Tint[3];
+	LuxBlock_Vec3(params, Vars.m_nEnvMapTint, f3Tint, 1.0f, 1.0f, 1.0f);
+	Block.SetFloat4(LUX_PS_FLOAT_ENVMAP_TINT, LuxBlock_GammaToLinear(f3Tint[0]), LuxBlock_GammaToLinear(f3Tint[1]), LuxBlock_GammaToLinear(f3Tint[2]),
+		LuxBlock_Float(params, Vars.m_nEnvMapLightScale, 0.0f));
+
+	float f3Saturation[3];
+	LuxBlock_Vec3(params, Vars.m_nEnvMapSaturation, f3Saturation, 1.0f, 1.0f, 1.0f);
+	Block.SetFloat4(LUX_PS_FLOAT_ENVMAP_FACTORS, f3Saturation[0], f3Saturation[1], f3Saturation[2], LuxBlock_Float(params, Vars.m_nEnvMapContrast, 0.0f));
+
+	// Scale, Bias, Exponent. Without $EnvMapFresnel Scale 0 and Bias 1 saturate EnvMapFresnel() to 1 for any NdotV,
+	// the Exponent is 1 so pow(0, Exponent) can't be a NaN. lux_materialblock_check runs the HLSL Math on it
+	float f3Fresnel[3] = { 0.0f, 1.0f, 1.0f };
+	if (LuxBlock_Float(params, Vars.m_nEnvMapFresnel, 0.0f) != 0.0f)
+	{
+		float f3MinMaxExp[3];
+		LuxBlock_Vec3(params, Vars.m_nEnvMapFresnelMinMaxExp, f3MinMaxExp, 0.0f, 1.0f, 2.0f);
+		f3Fresnel[0] = f3MinMaxExp[1] - f3MinMaxExp[0];
+		f3Fresnel[1] = f3MinMaxExp[0];
+		f3Fresnel[2] = f3MinMaxExp[2];
+	}
+	Block.SetFloat4(LUX_PS_FLOAT_ENVMAP_FRESNEL, f3Fresnel[0], f3Fresnel[1], f3Fresnel[2], 0.0f);
+}
+
+#endif // CPP_LUX_MATERIALBLOCK_H
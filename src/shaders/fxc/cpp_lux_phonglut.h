@@ -0,0 +1,256 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Bakes the Phong LUT used by the PHONG_LUT Combo
+//
+//	ComputeDirectSpecularLight() does a pow() per Light and per Pixel,
+//	SetupPhongFresnel() remaps the Fresnel with g_f3PhongFresnelRanges per Pixel.
+//	With PHONG_LUT both are a single tex2Dlod instead :
+//
+//	[R] pow(x, e) with u = (1 - x) * e / LUX_PHONGLUT_RANGE, v = 1 / e
+//		With s = (1 - x) * e, pow(x, e) = exp(-s - s^2 / 2e - ..) so indexing by s gives every Exponent
+//		nearly the same Curve and the Resolution goes where the Highlight is.
+//		What's left of the Exponent is almost linear in 1 / e, so bilinear Filtering between Rows is enough.
+//		v = 0 is an infinite Exponent, v = 1 is an Exponent of 1. Exponents below 1 are clamped.
+//	[G] Phong Fresnel with the Material's $PhongFresnelRanges, u = NdotV
+//	[B] RimLight Fresnel ( Fresnel^4 ), u = NdotV
+//	[A] Unused
+//
+//	The Math here is SDK-free so devtools/luxtools/lux_phonglut_bake can measure the Error.
+//	Define LUX_PHONGLUT_BAKE_ONLY to get just that.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_PHONGLUT_H
+#define CPP_LUX_PHONGLUT_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <math.h>
+
+// Must match lux_common_phong_data.h !
+#define LUX_PHONGLUT_WIDTH			256
+#define LUX_PHONGLUT_HEIGHT			64
+#define LUX_PHONGLUT_RANGE			10.0f	// pow(x, e) is below 0.00005f past this
+
+//==========================================================================//
+// The Functions being replaced. Same Math as lux_common_phong_data.h
+//==========================================================================//
+
+// f3Ranges is what goes into g_f3PhongFresnelRanges : ((mid-min)*2, mid, (max-mid)*2)
+inline float LuxPhongLUT_Fresnel(float flNdotV, const float flRanges[3])
+{
+	float flFresnel = 1.0f - flNdotV;
+	flFresnel = flFresnel < 0.0f ? 0.0f : (flFresnel > 1.0f ? 1.0f : flFresnel);
+
+	float flFresnelRanges = flFresnel * flFresnel - 0.5f;
+	return flRanges[1] + (flFresnelRanges >= 0.0f ? flRanges[2] : flRanges[0]) * flFresnelRanges;
+}
+
+inline float LuxPhongLUT_RimFresnel(float flNdotV)
+{
+	float flFresnel = 1.0f - flNdotV;
+	flFresnel = flFresnel < 0.0f ? 0.0f : (flFresnel > 1.0f ? 1.0f : flFresnel);
+	flFresnel *= flFresnel;
+	return flFresnel * flFresnel;
+}
+
+//==========================================================================//
+// Texels -> Function Inputs. The Shader uses the same Mapping backwards.
+// Both Axes are baked on Texel Edges ( x / (W - 1) ), so u = 0 and u = 1 are exact.
+// The Shader needs LUX_PHONGLUT_UV_SCALE and _BIAS to hit them.
+//==========================================================================//
+inline float LuxPhongLUT_TexelToRcpExponent(int y, int nHeight = LUX_PHONGLUT_HEIGHT)
+{
+	return (float)y / (nHeight - 1);
+}
+
+inline float LuxPhongLUT_TexelToPow(int x, float flRcpExponent, int nWidth = LUX_PHONGLUT_WIDTH)
+{
+	// u = (1 - RdotL) * e / RANGE  ->  s = u * RANGE = (1 - RdotL) * e
+	float s = (float)x / (nWidth - 1) * LUX_PHONGLUT_RANGE;
+
+	// Infinite Exponent
+	if (flRcpExponent <= 0.0f)
+		return expf(-s);
+
+	// RdotL = 1 - s / e
+	float flRdotL = 1.0f - s * flRcpExponent;
+	return flRdotL <= 0.0f ? 0.0f : powf(flRdotL, 1.0f / flRcpExponent);
+}
+
+// Fills nWidth * nHeight RGBA Texels, [0..1] Floats
+// The Fresnel Channels are the same on every Row.
+inline void LuxPhongLUT_Bake(float *pRGBA, const float flFresnelRanges[3], int nWidth = LUX_PHONGLUT_WIDTH, int nHeight = LUX_PHONGLUT_HEIGHT)
+{
+	for (int y = 0; y < nHeight; y++)
+	{
+		float flRcpExponent = LuxPhongLUT_TexelToRcpExponent(y, nHeight);
+
+		for (int x = 0; x < nWidth; x++)
+		{
+			float flNdotV = (float)x / (nWidth - 1);
+			float *pTexel = &pRGBA[(y * nWidth + x) * 4];
+
+			// Fresnel can go above 1 with odd Ranges, the Texture can't
+			float flFresnel = LuxPhongLUT_Fresnel(flNdotV, flFresnelRanges);
+			pTexel[0] = LuxPhongLUT_TexelToPow(x, flRcpExponent, nWidth);
+			pTexel[1] = flFresnel < 0.0f ? 0.0f : (flFresnel > 1.0f ? 1.0f : flFresnel);
+			pTexel[2] = LuxPhongLUT_RimFresnel(flNdotV);
+			pTexel[3] = 1.0f;
+		}
+	}
+}
+
+// Ranges are quantised to 1/1024 before Baking, nobody will see the Difference and we share a lot more Textures that way
+#define LUX_PHONGLUT_RANGE_STEPS	1024.0f
+
+inline void LuxPhongLUT_QuantiseRanges(const float flFresnelRanges[3], int nQuantised[3])
+{
+	for (int n = 0; n < 3; n++)
+		nQuantised[n] = (int)floorf(flFresnelRanges[n] * LUX_PHONGLUT_RANGE_STEPS + 0.5f);
+}
+
+inline void LuxPhongLUT_DequantiseRanges(const int nQuantised[3], float flFresnelRanges[3])
+{
+	for (int n = 0; n < 3; n++)
+		flFresnelRanges[n] = nQuantised[n] / LUX_PHONGLUT_RANGE_STEPS;
+}
+
+// The LUT clamps the Fresnel to [0..1], Ranges outside of that must use the regular Path
+// flMinMidMax is $PhongFresnelRanges as written in the VMT
+inline bool LuxPhongLUT_CanUse(const float flMinMidMax[3])
+{
+	for (int n = 0; n < 3; n++)
+	{
+		if (flMinMidMax[n] < 0.0f || flMinMidMax[n] > 1.0f)
+			return false;
+	}
+	return true;
+}
+
+// What the Shader does with the Texture, used for Error Measurement ( bilinear, clamped )
+inline float LuxPhongLUT_Sample(const float *pRGBA, int nChannel, float u, float v, int nWidth = LUX_PHONGLUT_WIDTH, int nHeight = LUX_PHONGLUT_HEIGHT)
+{
+	float fx = u * (nWidth - 1);
+	float fy = v * (nHeight - 1);
+	fx = fx < 0.0f ? 0.0f : (fx > nWidth - 1 ? (float)(nWidth - 1) : fx);
+	fy = fy < 0.0f ? 0.0f : (fy > nHeight - 1 ? (float)(nHeight - 1) : fy);
+
+	int x0 = (int)fx, y0 = (int)fy;
+	int x1 = x0 + 1 < nWidth ? x0 + 1 : x0;
+	int y1 = y0 + 1 < nHeight ? y0 + 1 : y0;
+	float tx = fx - x0, ty = fy - y0;
+
+	float a = pRGBA[(y0 * nWidth + x0) * 4 + nChannel], b = pRGBA[(y0 * nWidth + x1) * 4 + nChannel];
+	float c = pRGBA[(y1 * nWidth + x0) * 4 + nChannel], d = pRGBA[(y1 * nWidth + x1) * 4 + nChannel];
+	float ab = a + (b - a) * tx, cd = c + (d - c) * tx;
+	return ab + (cd - ab) * ty;
+}
+
+#if !defined(LUX_PHONGLUT_BAKE_ONLY)
+
+#include "materialsystem/itexture.h"
+#include "materialsystem/imaterialsystem.h"
+#include "vtf/vtf.h"
+#include "tier1/utlmap.h"
+#include "tier1/strtools.h"
+
+//==========================================================================//
+// Procedural Texture for a single Set of quantised Fresnel Ranges
+// Materials whose $PhongFresnelRanges quantise the same share the same Texture
+//==========================================================================//
+class CLuxPhongLUTRegenerator : public ITextureRegenerator
+{
+public:
+	// Baked from the quantised Ranges, so the Texture doesn't depend on which Material asked first
+	CLuxPhongLUTRegenerator(const int nQuantised[3])
+	{
+		LuxPhongLUT_DequantiseRanges(nQuantised, m_flFresnelRanges);
+	}
+
+	virtual void RegenerateTextureBits(ITexture *pTexture, IVTFTexture *pVTFTexture, Rect_t *pRect)
+	{
+		static float s_flTexels[LUX_PHONGLUT_WIDTH * LUX_PHONGLUT_HEIGHT * 4];
+		LuxPhongLUT_Bake(s_flTexels, m_flFresnelRanges);
+
+		// RGBA16161616, 8 Bits isn't enough for high Exponents ( see lux_phonglut_bake )
+		unsigned short *pDst = (unsigned short *)pVTFTexture->ImageData(0, 0, 0);
+		for (int n = 0; n < LUX_PHONGLUT_WIDTH * LUX_PHONGLUT_HEIGHT * 4; n++)
+			pDst[n] = (unsigned short)(s_flTexels[n] * 65535.0f + 0.5f);
+	}
+
+	virtual void Release() { delete this; }
+
+private:
+	float m_flFresnelRanges[3];
+};
+
+// The quantised Ranges themselves, a Hash of them could hand two Materials the same Texture
+struct LuxPhongLUTKey_t
+{
+	int m_nRanges[3];
+};
+
+inline bool LuxPhongLUTKeyLess(const LuxPhongLUTKey_t &a, const LuxPhongLUTKey_t &b)
+{
+	for (int n = 0; n < 3; n++)
+	{
+		if (a.m_nRanges[n] != b.m_nRanges[n])
+			return a.m_nRanges[n] < b.m_nRanges[n];
+	}
+	return false;
+}
+
+class CLuxPhongLUTCache
+{
+public:
+	CLuxPhongLUTCache() : m_Textures(LuxPhongLUTKeyLess) {}
+
+	// flFresnelRanges must be the encoded Ranges that are uploaded to LUX_PS_FLOAT_PHONG_FRESNEL
+	ITexture *GetTexture(const float flFresnelRanges[3])
+	{
+		LuxPhongLUTKey_t Key;
+		LuxPhongLUT_QuantiseRanges(flFresnelRanges, Key.m_nRanges);
+
+		unsigned short nIndex = m_Textures.Find(Key);
+		if (nIndex != m_Textures.InvalidIndex())
+			return m_Textures[nIndex];
+
+		char szName[64];
+		V_snprintf(szName, sizeof(szName), "_rt_LuxPhongLUT_%d_%d_%d", Key.m_nRanges[0], Key.m_nRanges[1], Key.m_nRanges[2]);
+
+		ITexture *pTexture = materials->CreateProceduralTexture(szName, TEXTURE_GROUP_OTHER,
+			LUX_PHONGLUT_WIDTH, LUX_PHONGLUT_HEIGHT, IMAGE_FORMAT_RGBA16161616,
+			TEXTUREFLAGS_CLAMPS | TEXTUREFLAGS_CLAMPT | TEXTUREFLAGS_NOMIP | TEXTUREFLAGS_NOLOD | TEXTUREFLAGS_SINGLECOPY);
+
+		pTexture->SetTextureRegenerator(new CLuxPhongLUTRegenerator(Key.m_nRanges));
+		pTexture->Download();
+
+		m_Textures.Insert(Key, pTexture);
+		return pTexture;
+	}
+
+	// On Shutdown or Material Reload
+	void Shutdown()
+	{
+		for (unsigned short n = m_Textures.FirstInorder(); n != m_Textures.InvalidIndex(); n = m_Textures.NextInorder(n))
+		{
+			m_Textures[n]->SetTextureRegenerator(NULL);
+			m_Textures[n]->DecrementReferenceCount();
+			m_Textures[n]->DeleteIfUnreferenced();
+		}
+		m_Textures.RemoveAll();
+	}
+
+private:
+	CUtlMap<LuxPhongLUTKey_t, ITexture *> m_Textures;
+};
+
+#endif // !LUX_PHONGLUT_BAKE_ONLY
+
+#endif // CPP_LUX_PHONGLUT_H
@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	20.01.2023 DMY
-//	Last Change :	31.07.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //	Every Shader should include this File!
 //
@@ -82,6 +82,46 @@ inline bool IsSelfIllumDetailMode(int nDetailBlendMode)
 	return (nDetailBlendMode == DETAILBLENDMODE_SELFILLUM_ADDITIVE || nDetailBlendMode == DETAILBLENDMODE_SELFILLUM_THRESHOLDFADE);			
 }
 
+//==========================================================================//
+// Available Triplanar Modes ( $Seamless_Mode )
+// Must match TRIPLANAR_MODE_ in lux_common_triplanar.h
+//==========================================================================//
+enum TriplanarModes_t
+{
+	TRIPLANARMODE_FULL = 0,		// 3 Samples
+	TRIPLANARMODE_EARLYOUT,		// 1 to 3 Samples, skips Projections with a low Weight
+	TRIPLANARMODE_BIPLANAR,		// 2 Samples
+
+	NUM_TRIPLANARMODES
+};
+
+//==========================================================================//
+// Where the SelfIllum Mask is read from
+// Must match SELFILLUM_MASK_ in lux_common_selfillum.h
+//==========================================================================//
+enum SelfIllumMaskSources_t
+{
+	SELFILLUMMASK_TEXTURE = 0,		// $SelfIllumMask, costs SAMPLER_SELFILLUM and a Fetch
+	SELFILLUMMASK_ENVMAPMASK_ALPHA,	// $SelfIllum_EnvMapMask_Alpha
+	SELFILLUMMASK_BASE_ALPHA,		// No $SelfIllumMask, Stock Behaviour
+
+	NUM_SELFILLUMMASKSOURCES
+};
+
+// Params are $SelfIllumMask and $SelfIllum_EnvMapMask_Alpha, -1 if the Shader doesn't have them
+// Materials packed with devtools/luxtools/lux_selfillum_pack never end up on SELFILLUMMASK_TEXTURE
+// Shaders with SELFILLUM_TEXTURE can only take the packed Sources, Sampler_SelfIllum is their $SelfIllumTexture
+inline int GetSelfIllumMaskSource(IMaterialVar **params, int nSelfIllumMask, int nEnvMapMaskAlpha)
+{
+	if (nEnvMapMaskAlpha != -1 && params[nEnvMapMaskAlpha]->GetIntValue() != 0)
+		return SELFILLUMMASK_ENVMAPMASK_ALPHA;
+
+	if (nSelfIllumMask != -1 && params[nSelfIllumMask]->IsTexture())
+		return SELFILLUMMASK_TEXTURE;
+
+	return SELFILLUMMASK_BASE_ALPHA;
+}
+
 //==========================================================================//
 // Sampler definitions for all shaders
 //==========================================================================//
@@ -114,6 +154,10 @@ const Sampler_t SAMPLER_ENVMAPTEXTURE	= SHADER_SAMPLER14; // Not rendered under
 // Use with Caution!
 const Sampler_t SAMPLER_SELFILLUM2 = SHADER_SAMPLER15; // Not rendered under the Flashlight
 
+// PHONG_LUT Combo ( cpp_lux_phonglut.h ). Shares the Sampler with $EnvMapMask2, only Brushes have one.
+// Not s12, Models with ENVMAPLERP bind the previous Cubemap there
+const Sampler_t SAMPLER_PHONGLUT		= SHADER_SAMPLER9;
+
 // For the Flashlight :
 const Sampler_t SAMPLER_FLASHLIGHTCOOKIE	= SHADER_SAMPLER13;
 const Sampler_t SAMPLER_SHADOWDEPTH			= SHADER_SAMPLER14;
@@ -326,17 +370,30 @@ struct Vars_Seamless_t
 	int m_nSeamless_BaseScale;
 	int m_nSeamless_Detail;
 	int m_nSeamless_DetailScale;
+	int m_nSeamless_Mode;
 
 // Instead of a Macro, just copy this.
 /*
-	InitVars(Seamless_Base, Seamless_Scale, Seamless_Detail, Seamless_DetailScale);
+	InitVars(Seamless_Base, Seamless_Scale, Seamless_Detail, Seamless_DetailScale, Seamless_Mode);
 */
-	void InitVars(int Base, int BaseScale, int Detail, int DetailScale)
+	// Mode is optional, Shaders without it always use TRIPLANARMODE_FULL
+	void InitVars(int Base, int BaseScale, int Detail, int DetailScale, int Mode = -1)
 	{
 		m_nSeamless_Base = Base;
 		m_nSeamless_BaseScale = BaseScale;
 		m_nSeamless_Detail = Detail;
 		m_nSeamless_DetailScale  = DetailScale;
+		m_nSeamless_Mode = Mode;
+	}
+
+	// Returns the Triplanar Mode for the Static Combo, clamped to the valid Range
+	int GetTriplanarMode(IMaterialVar **params) const
+	{
+		if (m_nSeamless_Mode == -1)
+			return TRIPLANARMODE_FULL;
+
+		int nMode = params[m_nSeamless_Mode]->GetIntValue();
+		return (nMode > TRIPLANARMODE_FULL && nMode < NUM_TRIPLANARMODES) ? nMode : TRIPLANARMODE_FULL;
 	}
 };
 
@@ -595,7 +652,8 @@ SHADER_PARAM(TreeSwayStaticValues,		SHADER_PARAM_TYPE_VEC2,		"",		"Sets the stat
 SHADER_PARAM(Seamless_Base,				SHADER_PARAM_TYPE_BOOL,		"", "Enables triplanar mapping.")\
 SHADER_PARAM(Seamless_Scale,			SHADER_PARAM_TYPE_FLOAT,	"", "Prevents Texture stretching issues on displacement surfaces.")\
 SHADER_PARAM(Seamless_Detail,			SHADER_PARAM_TYPE_BOOL,		"", "Enables the effect on Detail Textures with the VertexLitGeneric shader. Requires $seamless_scale to set the scale of the effect and only applies to the Detail Texture.")\
-SHADER_PARAM(Seamless_DetailScale,		SHADER_PARAM_TYPE_FLOAT,	"", "Prevents Detail Texture stretching issues on displacement surfaces.")
+SHADER_PARAM(Seamless_DetailScale,		SHADER_PARAM_TYPE_FLOAT,	"", "Prevents Detail Texture stretching issues on displacement surfaces.")\
+SHADER_PARAM(Seamless_Mode,				SHADER_PARAM_TYPE_INTEGER,	"0", "Modes: 0 = Triplanar ( 3 Samples ), 1 = Triplanar with Early-Out ( 1 to 3 Samples ), 2 = Biplanar ( 2 Samples ).")
 
 #define Declare_DepthBlendParameters()\
 SHADER_PARAM(DepthBlend,				SHADER_PARAM_TYPE_INTEGER,	"", "Fade Alpha when Geometry of the Material gets close to other Geometry ( Intersections ).")\
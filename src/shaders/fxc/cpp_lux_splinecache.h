@@ -0,0 +1,259 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	CPU Evaluation and Caching of Spline Ropes
+//
+//	SPLINEROPES ( lux_common_defines.h ) makes every Rope evaluate CatmullRomSpline
+//	and DCatmullRomSpline3 in the Vertex Shader, every Vertex, every Frame.
+//	Most Ropes in a Map never move, so we evaluate them once here ( four t's per SIMD Op ),
+//	keep the Positions and Tangents, and the Shader can use the Passthrough Path
+//	SplineRope_ExpandCached() from lux_common_spline.h instead.
+//
+//	Ropes that change their Control Points are evaluated every Frame as before,
+//	they only become static once their Control Points stayed the same for a few Frames.
+//
+//	Define LUX_SPLINECACHE_CORE_ONLY for LuxSpline_Evaluate() without the SDK, on plain SSE.
+//	devtools/luxtools/lux_splinecache_check compares it against the scalar Functions from lux_common_spline.h with it.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_SPLINECACHE_H
+#define CPP_LUX_SPLINECACHE_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#if defined(LUX_SPLINECACHE_CORE_ONLY)
+#include <xmmintrin.h>
+
+// The Part of mathlib/ssemath.h LuxSpline_Evaluate() uses
+typedef __m128 fltx4;
+
+#ifdef _MSC_VER
+#define ALIGN16 __declspec(align(16))
+#define ALIGN16_POST
+#else
+#define ALIGN16
+#define ALIGN16_POST __attribute__((aligned(16)))
+#endif
+
+inline fltx4 ReplicateX4(float flValue) { return _mm_set1_ps(flValue); }
+inline fltx4 LoadAlignedSIMD(const void *pData) { return _mm_load_ps((const float *)pData); }
+inline fltx4 AddSIMD(const fltx4 &a, const fltx4 &b) { return _mm_add_ps(a, b); }
+inline fltx4 MulSIMD(const fltx4 &a, const fltx4 &b) { return _mm_mul_ps(a, b); }
+inline fltx4 MaddSIMD(const fltx4 &a, const fltx4 &b, const fltx4 &c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline float SubFloat(const fltx4 &a, int nComponent) { return ((const float *)&a)[nComponent]; }
+#else
+#include "mathlib/ssemath.h"
+#include "tier1/utlvector.h"
+#include "tier1/utlmap.h"
+#endif
+
+// Control Points must be unchanged for this many Frames before a Rope is considered static
+#define LUX_SPLINECACHE_STABLE_FRAMES	3
+
+// Ropes that weren't drawn for this many Frames are removed from the Cache
+#define LUX_SPLINECACHE_MAX_AGE			300
+
+//==========================================================================//
+// One Control Point. Same Data the Spline VS receives, xyz = Position, w = Width
+//==========================================================================//
+struct LuxSplinePoint_t
+{
+	float m_fl[4];
+};
+
+//==========================================================================//
+// One tessellated Vertex
+//==========================================================================//
+struct LuxSplineVertex_t
+{
+	float m_flPos[4];		// xyz = Position, w = Width
+	float m_flTangent[4];	// xyz = unnormalised Tangent ( DCatmullRomSpline3 ), w = Spline t along the whole Rope
+};
+
+//==========================================================================//
+// Evaluates a Rope with nSubdivisions Vertices per Segment
+// Writes ( nPoints - 1 ) * nSubdivisions + 1 Vertices
+// The End Points are duplicated like the Stock Rope Code does it.
+//==========================================================================//
+inline int LuxSpline_NumVertices(int nPoints, int nSubdivisions)
+{
+	return (nPoints < 2) ? 0 : (nPoints - 1) * nSubdivisions + 1;
+}
+
+inline void LuxSpline_Evaluate(const LuxSplinePoint_t *pPoints, int nPoints, int nSubdivisions, LuxSplineVertex_t *pOut)
+{
+	if (nPoints < 2 || nSubdivisions < 1)
+		return;
+
+	const float flRcpSubdivisions = 1.0f / (float)nSubdivisions;
+	const float flRcpSegments = 1.0f / (float)(nPoints - 1);
+	const fltx4 f4Half = ReplicateX4(0.5f);
+	const fltx4 f4Two = ReplicateX4(2.0f);
+	const fltx4 f4Three = ReplicateX4(3.0f);
+	const fltx4 f4RcpSubdivisions = ReplicateX4(flRcpSubdivisions);
+
+	static const ALIGN16 float s_flLanes[4] ALIGN16_POST = { 0.0f, 1.0f, 2.0f, 3.0f };
+	const fltx4 f4Lanes = LoadAlignedSIMD(s_flLanes);
+
+	int nVertex = 0;
+	for (int nSegment = 0; nSegment < nPoints - 1; nSegment++)
+	{
+		const float *a = pPoints[nSegment > 0 ? nSegment - 1 : 0].m_fl;
+		const float *b = pPoints[nSegment].m_fl;
+		const float *c = pPoints[nSegment + 1].m_fl;
+		const float *d = pPoints[nSegment + 2 < nPoints ? nSegment + 2 : nPoints - 1].m_fl;
+
+		// Same Polynomial as CatmullRomSpline() in lux_common_spline.h, just expanded
+		// P(t)  = c0 + t * (c1 + t * (c2 + t * c3))
+		// P'(t) = c1 + t * (2 * c2 + t * 3 * c3)
+		fltx4 C0[4], C1[4], C2[4], C3[4];
+		for (int n = 0; n < 4; n++)
+		{
+			C0[n] = ReplicateX4(b[n]);
+			C1[n] = MulSIMD(f4Half, ReplicateX4(c[n] - a[n]));
+			C2[n] = MulSIMD(f4Half, ReplicateX4(2.0f * a[n] - 5.0f * b[n] + 4.0f * c[n] - d[n]));
+			C3[n] = MulSIMD(f4Half, ReplicateX4(-a[n] + 3.0f * b[n] - 3.0f * c[n] + d[n]));
+		}
+
+		// The last Segment also writes t = 1.0f, everything else stops right before it
+		int nSteps = (nSegment == nPoints - 2) ? nSubdivisions + 1 : nSubdivisions;
+
+		// Four t's at a time
+		for (int nStep = 0; nStep < nSteps; nStep += 4)
+		{
+			fltx4 t = MulSIMD(AddSIMD(ReplicateX4((float)nStep), f4Lanes), f4RcpSubdivisions);
+
+			fltx4 Pos[4], Tangent[4];
+			for (int n = 0; n < 4; n++)
+			{
+				Pos[n] = MaddSIMD(t, MaddSIMD(t, MaddSIMD(t, C3[n], C2[n]), C1[n]), C0[n]);
+				Tangent[n] = MaddSIMD(t, MaddSIMD(t, MulSIMD(f4Three, C3[n]), MulSIMD(f4Two, C2[n])), C1[n]);
+			}
+
+			int nLanes = nSteps - nStep < 4 ? nSteps - nStep : 4;
+			for (int nLane = 0; nLane < nLanes; nLane++)
+			{
+				LuxSplineVertex_t &Vertex = pOut[nVertex++];
+				for (int n = 0; n < 4; n++)
+					Vertex.m_flPos[n] = SubFloat(Pos[n], nLane);
+				for (int n = 0; n < 3; n++)
+					Vertex.m_flTangent[n] = SubFloat(Tangent[n], nLane);
+				Vertex.m_flTangent[3] = (nSegment + SubFloat(t, nLane)) * flRcpSegments;
+			}
+		}
+	}
+}
+
+#if !defined(LUX_SPLINECACHE_CORE_ONLY)
+//==========================================================================//
+// Persistent per-Rope Cache
+//==========================================================================//
+struct LuxSplineRope_t
+{
+	LuxSplineRope_t() : m_nHash(0), m_nStableFrames(0), m_nLastFrame(0), m_nSubdivisions(0), m_bStatic(false) {}
+
+	uint64 m_nHash;				// Hash of the Control Points and Subdivisions
+	int m_nStableFrames;		// Frames the Hash stayed the same
+	int m_nLastFrame;			// Last Frame this Rope was drawn
+	int m_nSubdivisions;
+	bool m_bStatic;				// m_Vertices is valid and can be drawn with the Passthrough Path
+	CUtlVector<LuxSplineVertex_t> m_Vertices;
+};
+
+class CLuxSplineRopeCache
+{
+public:
+	CLuxSplineRopeCache() : m_Ropes(DefLessFunc(uintp)), m_nEvaluations(0), m_nHits(0) {}
+
+	// Call this when drawing a Rope. nRopeID can be anything unique, like the Entity Pointer
+	// Returns the cached Vertices when the Rope is static, NULL if it has to use the Spline Path
+	// The Pointer points into m_Ropes : the next Update() can insert a Rope and move all of them, Purge() and
+	// RemoveAll() free them. Draw from it ( or copy ) right away, don't keep it until the next Rope
+	const LuxSplineRope_t *Update(uintp nRopeID, const LuxSplinePoint_t *pPoints, int nPoints, int nSubdivisions, int nFrame)
+	{
+		unsigned short nIndex = m_Ropes.Find(nRopeID);
+		if (nIndex == m_Ropes.InvalidIndex())
+			nIndex = m_Ropes.Insert(nRopeID);
+
+		LuxSplineRope_t &Rope = m_Ropes[nIndex];
+		Rope.m_nLastFrame = nFrame;
+
+		uint64 nHash = HashPoints(pPoints, nPoints, nSubdivisions);
+		if (nHash != Rope.m_nHash)
+		{
+			// Moved, back to the Spline Path
+			Rope.m_nHash = nHash;
+			Rope.m_nStableFrames = 0;
+			Rope.m_bStatic = false;
+			Rope.m_Vertices.Purge();
+			return NULL;
+		}
+
+		if (Rope.m_bStatic)
+		{
+			m_nHits++;
+			return &Rope;
+		}
+
+		if (++Rope.m_nStableFrames < LUX_SPLINECACHE_STABLE_FRAMES)
+			return NULL;
+
+		// Stayed in Place long enough, tessellate once and keep it
+		Rope.m_nSubdivisions = nSubdivisions;
+		Rope.m_Vertices.SetCount(LuxSpline_NumVertices(nPoints, nSubdivisions));
+		LuxSpline_Evaluate(pPoints, nPoints, nSubdivisions, Rope.m_Vertices.Base());
+		Rope.m_bStatic = true;
+		m_nEvaluations++;
+		return &Rope;
+	}
+
+	// Once per Frame. Drops Ropes that haven't been drawn in a while ( Map change, Entity removed, PVS )
+	void Purge(int nFrame, int nMaxAge = LUX_SPLINECACHE_MAX_AGE)
+	{
+		unsigned short nIndex = m_Ropes.FirstInorder();
+		while (nIndex != m_Ropes.InvalidIndex())
+		{
+			unsigned short nNext = m_Ropes.NextInorder(nIndex);
+			if (nFrame - m_Ropes[nIndex].m_nLastFrame > nMaxAge)
+				m_Ropes.RemoveAt(nIndex);
+			nIndex = nNext;
+		}
+	}
+
+	void RemoveAll() { m_Ropes.RemoveAll(); }
+
+	// Statistics for the lux_splinecache_stats ConCommand or similar
+	int NumRopes() const { return m_Ropes.Count(); }
+	int NumEvaluations() const { return m_nEvaluations; }
+	int NumHits() const { return m_nHits; }
+
+private:
+	static uint64 HashPoints(const LuxSplinePoint_t *pPoints, int nPoints, int nSubdivisions)
+	{
+		// FNV-1a over the raw Floats. Bitwise compare is what we want here, any Change means re-evaluate.
+		uint64 nHash = 14695981039346656037ULL;
+		const unsigned char *p = (const unsigned char *)pPoints;
+		for (int n = 0; n < nPoints * (int)sizeof(LuxSplinePoint_t); n++)
+		{
+			nHash ^= p[n];
+			nHash *= 1099511628211ULL;
+		}
+		nHash ^= (uint64)nSubdivisions;
+		nHash *= 1099511628211ULL;
+
+		// 0 is reserved for 'never seen'
+		return nHash ? nHash : 1;
+	}
+
+	CUtlMap<uintp, LuxSplineRope_t> m_Ropes;
+	int m_nEvaluations;
+	int m_nHits;
+};
+#endif // !LUX_SPLINECACHE_CORE_ONLY
+
+#endif // CPP_LUX_SPLINECACHE_H
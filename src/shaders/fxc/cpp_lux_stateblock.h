@@ -0,0 +1,351 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Initial D.	:	19.10.2026 DMY
+//	Last Change :	19.10.2026 DMY
+//
+//	Purpose of this File :	Shared, immutable Static State Blocks
+//
+//	Every Snapshot runs the whole SHADOW_STATE Block again : Sampler Enables and sRGB Reads for
+//	SAMPLER_BASETEXTURE .. SAMPLER_SELFILLUM2, Blending, Alpha Test, Vertex Format and the Static Combo Indices.
+//	With Thousands of Materials most of them end up with the same Result.
+//
+//	The Cache maps ( Shader, Static Combo Keys, Sampler Bindings, State Flags, Alpha Test Reference ) to a LuxStateBlock_t.
+//	The Key is cheap to build from the cpp_lux_combokey.h Keys, only a Miss fills a Block, and
+//	every Material with the same Key shares the same const Block afterwards.
+//	Anything else a Material's Parameters put into the Block has to go into the Key as well :
+/*
+	static const uint32_t s_nShader = LuxStateBlock_ShaderID("lux_modelshadertest");
+	LuxStateBlockKey_t Key = LuxStateBlockKey(s_nShader, PSKey.Key(), VSKey.Key(), nSamplers, nSRGBSamplers, nStateFlags, flAlphaRef);
+	const LuxStateBlock_t *pBlock = LuxStateBlockCache().Find(Key);
+	if (!pBlock)
+	{
+		LuxStateBlock_t Block;
+		// .. fill it
+		pBlock = LuxStateBlockCache().Insert(Key, Block);
+	}
+	LuxStateBlock_Apply(pShaderShadow, *pBlock);
+*/
+//	Blocks live until Clear(), call it on Shader DLL Shutdown. Materials re-snapshot on Reload anyway.
+//	Not thread-safe, Snapshots are taken on the Main Thread.
+//
+//	Define LUX_STATEBLOCK_CACHE_ONLY for the Cache without the SDK, devtools/luxtools/lux_stateblock_bench does.
+//
+//==========================================================================//
+
+#ifndef CPP_LUX_STATEBLOCK_H
+#define CPP_LUX_STATEBLOCK_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Blocks are allocated this many at a Time, so Pointers stay valid while the Cache grows
+#define LUX_STATEBLOCK_POOL_SIZE		64
+
+// VertexShaderVertexFormat() takes up to 8 TexCoords
+#define LUX_STATEBLOCK_MAX_TEXCOORDS	8
+
+//==========================================================================//
+// Everything SHADOW_STATE sets. Enums are stored as Integers so this stays SDK-free
+//==========================================================================//
+struct LuxStateBlock_t
+{
+	LuxStateBlock_t() { memset(this, 0, sizeof(LuxStateBlock_t)); }
+
+	uint16_t m_nSamplers;			// EnableTexture(), Bit per Sampler
+	uint16_t m_nSRGBSamplers;		// EnableSRGBRead()
+	bool m_bBlending;
+	bool m_bAlphaTest;
+	bool m_bDepthWrites;
+	bool m_bAlphaWrites;
+	bool m_bSRGBWrite;
+	bool m_bCulling;
+	uint8_t m_nBlendSrc;			// ShaderBlendFactor_t
+	uint8_t m_nBlendDst;
+	uint8_t m_nAlphaFunc;			// ShaderAlphaFunc_t
+	float m_flAlphaRef;
+
+	uint32_t m_nVertexFormat;		// VERTEX_POSITION | VERTEX_NORMAL ..
+	int m_nTexCoords;
+	int m_nTexCoordDims[LUX_STATEBLOCK_MAX_TEXCOORDS];
+	int m_nUserDataSize;
+
+	// Names are String Literals from the Shader, never copied
+	const char *m_pVertexShader;
+	const char *m_pPixelShader;
+	int m_nVertexShaderIndex;		// Static Combo Index, cpp_lux_combokey.h Index()
+	int m_nPixelShaderIndex;
+};
+
+//==========================================================================//
+// Cache Key. nStateFlags is whatever else the Shader decides on in SHADOW_STATE ( Translucent, Additive, NoCull .. )
+// flAlphaRef is $AlphaTestReference, 0.0f when the Material doesn't Alpha Test
+//==========================================================================//
+struct LuxStateBlockKey_t
+{
+	uint32_t m_nShader;				// LuxStateBlock_ShaderID()
+	uint32_t m_nPixelKey;			// Static Combo Keys
+	uint32_t m_nVertexKey;
+	uint32_t m_nSamplers;			// Enabled in the low 16 Bits, sRGB in the high 16
+	uint32_t m_nStateFlags;
+	uint32_t m_nAlphaRef;			// Bits of LuxStateBlock_t::m_flAlphaRef
+
+	bool operator==(const LuxStateBlockKey_t &Other) const { return !memcmp(this, &Other, sizeof(LuxStateBlockKey_t)); }
+};
+
+// A small ID per Shader Name, the same one for as long as the DLL is loaded. Not a Hash, two Shaders never share one.
+// Look it up once into a static, per Snapshot the strcmp()s cost more than the whole Lookup.
+// pName has to be a String Literal, it's kept. Main Thread, like the Cache
+inline uint32_t LuxStateBlock_ShaderID(const char *pName)
+{
+	static const char **s_ppNames = NULL;
+	static uint32_t s_nNames = 0;
+	for (uint32_t n = 0; n < s_nNames; n++)
+	{
+		if (!strcmp(s_ppNames[n], pName))
+			return n;
+	}
+
+	const char **ppNames = (const char **)realloc(s_ppNames, (s_nNames + 1) * sizeof(const char *));
+	if (!ppNames)
+		abort();
+	s_ppNames = ppNames;
+	s_ppNames[s_nNames] = pName;
+	return s_nNames++;
+}
+
+inline LuxStateBlockKey_t LuxStateBlockKey(uint32_t nShader, uint32_t nPixelKey, uint32_t nVertexKey, uint32_t nSamplers, uint32_t nSRGBSamplers, uint32_t nStateFlags, float flAlphaRef)
+{
+	LuxStateBlockKey_t Key;
+	Key.m_nShader = nShader;
+	Key.m_nPixelKey = nPixelKey;
+	Key.m_nVertexKey = nVertexKey;
+	Key.m_nSamplers = (nSamplers & 0xFFFF) | (nSRGBSamplers << 16);
+	Key.m_nStateFlags = nStateFlags;
+
+	// -0.0f and 0.0f are the same Reference
+	if (flAlphaRef == 0.0f)
+		flAlphaRef = 0.0f;
+	memcpy(&Key.m_nAlphaRef, &flAlphaRef, sizeof(uint32_t));
+	return Key;
+}
+
+struct LuxStateBlockStats_t
+{
+	LuxStateBlockStats_t() { memset(this, 0, sizeof(LuxStateBlockStats_t)); }
+
+	int64_t m_nLookups;
+	int64_t m_nHits;
+	int m_nBlocks;
+	size_t m_nBytes;				// Table and Pools
+	size_t m_nBytesUnshared;		// What one Block per Lookup would have taken
+
+	float HitRate() const { return m_nLookups ? (float)m_nHits / (float)m_nLookups : 0.0f; }
+};
+
+//==========================================================================//
+// Open Addressing, linear Probing. Grows at 3/4
+//==========================================================================//
+class CLuxStateBlockCache
+{
+public:
+	CLuxStateBlockCache() : m_pEntries(NULL), m_nCapacity(0), m_pPools(NULL), m_nPoolUsed(LUX_STATEBLOCK_POOL_SIZE) {}
+	~CLuxStateBlockCache() { Clear(); }
+
+	// NULL on a Miss, fill a Block and Insert() it
+	const LuxStateBlock_t *Find(const LuxStateBlockKey_t &Key)
+	{
+		m_Stats.m_nLookups++;
+		m_Stats.m_nBytesUnshared += sizeof(LuxStateBlock_t);
+		if (!m_nCapacity)
+			return NULL;
+
+		for (uint32_t n = Hash(Key) & (m_nCapacity - 1);; n = (n + 1) & (m_nCapacity - 1))
+		{
+			if (!m_pEntries[n].m_pBlock)
+				return NULL;
+			if (m_pEntries[n].m_Key == Key)
+			{
+				m_Stats.m_nHits++;
+				return m_pEntries[n].m_pBlock;
+			}
+		}
+	}
+
+	// Copies Block in. Inserting a Key twice returns the first Block
+	const LuxStateBlock_t *Insert(const LuxStateBlockKey_t &Key, const LuxStateBlock_t &Block)
+	{
+		if ((uint32_t)(m_Stats.m_nBlocks + 1) * 4 > m_nCapacity * 3)
+			Grow();
+
+		uint32_t n = Hash(Key) & (m_nCapacity - 1);
+		for (; m_pEntries[n].m_pBlock; n = (n + 1) & (m_nCapacity - 1))
+		{
+			if (m_pEntries[n].m_Key == Key)
+				return m_pEntries[n].m_pBlock;
+		}
+
+		LuxStateBlock_t *pBlock = AllocBlock();
+		*pBlock = Block;
+		m_pEntries[n].m_Key = Key;
+		m_pEntries[n].m_pBlock = pBlock;
+		m_Stats.m_nBlocks++;
+		return pBlock;
+	}
+
+	// Every Block handed out is gone
+	void Clear()
+	{
+		while (m_pPools)
+		{
+			Pool_t *pNext = m_pPools->m_pNext;
+			free(m_pPools);
+			m_pPools = pNext;
+		}
+		free(m_pEntries);
+		m_pEntries = NULL;
+		m_nCapacity = 0;
+		m_nPoolUsed = LUX_STATEBLOCK_POOL_SIZE;
+		m_Stats = LuxStateBlockStats_t();
+	}
+
+	const LuxStateBlockStats_t &GetStats() const { return m_Stats; }
+
+	// Keeps the Blocks, only the Counters start over
+	void ResetStats()
+	{
+		LuxStateBlockStats_t Stats;
+		Stats.m_nBlocks = m_Stats.m_nBlocks;
+		Stats.m_nBytes = m_Stats.m_nBytes;
+		m_Stats = Stats;
+	}
+
+private:
+	struct Entry_t
+	{
+		LuxStateBlockKey_t m_Key;
+		const LuxStateBlock_t *m_pBlock;	// NULL for empty Slots
+	};
+
+	struct Pool_t
+	{
+		Pool_t *m_pNext;
+		LuxStateBlock_t m_Blocks[LUX_STATEBLOCK_POOL_SIZE];
+	};
+
+	static uint32_t Hash(const LuxStateBlockKey_t &Key)
+	{
+		uint32_t nHash = Key.m_nShader;
+		const uint32_t nValues[5] = { Key.m_nPixelKey, Key.m_nVertexKey, Key.m_nSamplers, Key.m_nStateFlags, Key.m_nAlphaRef };
+		for (int n = 0; n < 5; n++)
+			nHash ^= nValues[n] + 0x9e3779b9U + (nHash << 6) + (nHash >> 2);
+		return nHash ^ (nHash >> 16);
+	}
+
+	LuxStateBlock_t *AllocBlock()
+	{
+		if (m_nPoolUsed == LUX_STATEBLOCK_POOL_SIZE)
+		{
+			Pool_t *pPool = (Pool_t *)malloc(sizeof(Pool_t));
+			pPool->m_pNext = m_pPools;
+			m_pPools = pPool;
+			m_nPoolUsed = 0;
+			m_Stats.m_nBytes += sizeof(Pool_t);
+		}
+		return &m_pPools->m_Blocks[m_nPoolUsed++];
+	}
+
+	void Grow()
+	{
+		Entry_t *pOld = m_pEntries;
+		uint32_t nOldCapacity = m_nCapacity;
+
+		m_nCapacity = m_nCapacity ? m_nCapacity * 2 : 256;
+		m_pEntries = (Entry_t *)calloc(m_nCapacity, sizeof(Entry_t));
+		m_Stats.m_nBytes += (m_nCapacity - nOldCapacity) * sizeof(Entry_t);
+
+		for (uint32_t n = 0; n < nOldCapacity; n++)
+		{
+			if (!pOld[n].m_pBlock)
+				continue;
+
+			uint32_t nSlot = Hash(pOld[n].m_Key) & (m_nCapacity - 1);
+			while (m_pEntries[nSlot].m_pBlock)
+				nSlot = (nSlot + 1) & (m_nCapacity - 1);
+			m_pEntries[nSlot] = pOld[n];
+		}
+		free(pOld);
+	}
+
+	Entry_t *m_pEntries;
+	uint32_t m_nCapacity;			// Power of 2
+	Pool_t *m_pPools;
+	int m_nPoolUsed;				// In the newest Pool
+	LuxStateBlockStats_t m_Stats;
+};
+
+// The one every Shader shares
+inline CLuxStateBlockCache &LuxStateBlockCache()
+{
+	static CLuxStateBlockCache s_Cache;
+	return s_Cache;
+}
+
+#if !defined(LUX_STATEBLOCK_CACHE_ONLY)
+
+#include "shaderapi/ishadershadow.h"
+#include "tier0/dbg.h"
+
+inline void LuxStateBlock_Apply(IShaderShadow *pShaderShadow, const LuxStateBlock_t &Block)
+{
+	for (int n = 0; n < 16; n++)
+	{
+		if (Block.m_nSamplers & (1 << n))
+		{
+			pShaderShadow->EnableTexture((Sampler_t)n, true);
+			pShaderShadow->EnableSRGBRead((Sampler_t)n, (Block.m_nSRGBSamplers & (1 << n)) != 0);
+		}
+	}
+
+	if (Block.m_bBlending)
+	{
+		pShaderShadow->EnableBlending(true);
+		pShaderShadow->BlendFunc((ShaderBlendFactor_t)Block.m_nBlendSrc, (ShaderBlendFactor_t)Block.m_nBlendDst);
+	}
+
+	if (Block.m_bAlphaTest)
+	{
+		pShaderShadow->EnableAlphaTest(true);
+		pShaderShadow->AlphaFunc((ShaderAlphaFunc_t)Block.m_nAlphaFunc, Block.m_flAlphaRef);
+	}
+
+	pShaderShadow->EnableDepthWrites(Block.m_bDepthWrites);
+	pShaderShadow->EnableAlphaWrites(Block.m_bAlphaWrites);
+	pShaderShadow->EnableSRGBWrite(Block.m_bSRGBWrite);
+	pShaderShadow->EnableCulling(Block.m_bCulling);
+
+	// The Interface wants a non-const Pointer, it doesn't write to it
+	int nTexCoordDims[LUX_STATEBLOCK_MAX_TEXCOORDS];
+	memcpy(nTexCoordDims, Block.m_nTexCoordDims, sizeof(nTexCoordDims));
+	pShaderShadow->VertexShaderVertexFormat(Block.m_nVertexFormat, Block.m_nTexCoords, nTexCoordDims, Block.m_nUserDataSize);
+
+	pShaderShadow->SetVertexShader(Block.m_pVertexShader, Block.m_nVertexShaderIndex);
+	pShaderShadow->SetPixelShader(Block.m_pPixelShader, Block.m_nPixelShaderIndex);
+}
+
+// For a ConCommand in the Shader DLL
+inline void LuxStateBlock_PrintStats()
+{
+	const LuxStateBlockStats_t &Stats = LuxStateBlockCache().GetStats();
+	ConMsg("LUX State Blocks : %d Blocks, %lld Lookups, %.1f%% Hits, %.1f KB ( %.1f KB unshared )\n",
+		Stats.m_nBlocks, (long long)Stats.m_nLookups, Stats.HitRate() * 100.0f,
+		Stats.m_nBytes / 1024.0f, Stats.m_nBytesUnshared / 1024.0f);
+}
+
+#endif // !LUX_STATEBLOCK_CACHE_ONLY
+
+#endif // CPP_LUX_STATEBLOCK_H
@@ -0,0 +1,55 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Generated by lux_combokey_gen from lux_modelshadertest_ps30.fxc, don't edit.
+//	Declarations Hash : 0xc8a4092c821f4f6c
+//
+//==========================================================================//
+
+#ifndef LUX_MODELSHADERTEST_PS30_COMBOKEY_H
+#define LUX_MODELSHADERTEST_PS30_COMBOKEY_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "../cpp_lux_combokey.h"
+
+struct lux_modelshadertest_ps30_StaticKey
+{
+	LUX_COMBOKEY_BEGIN(lux_modelshadertest_ps30_StaticKey)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, BRUSH, 0, 1, 0, 10)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, AMBIENTCUBES, 0, 1, 1, 20)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, LIGHTDATA, 0, 1, 2, 40)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, ENVMAPCOMBO, 0, 2, 3, 80)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, BUMPMAPPED, 0, 1, 5, 240)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_StaticKey, VERTEXCOLORS, 0, 1, 6, 480)
+
+	enum { KEY_BITS = 7, NUM_COMBOS = 96 };
+	constexpr int Index() const { return (int)((m_nKey >> 0) & 0x1) * 10 + (int)((m_nKey >> 1) & 0x1) * 20 + (int)((m_nKey >> 2) & 0x1) * 40 + (int)((m_nKey >> 3) & 0x3) * 80 + (int)((m_nKey >> 5) & 0x1) * 240 + (int)((m_nKey >> 6) & 0x1) * 480; }
+};
+
+static_assert(lux_modelshadertest_ps30_StaticKey::KEY_BITS <= 32, "lux_modelshadertest_ps30_StaticKey doesn't fit 32 Bits");
+
+struct lux_modelshadertest_ps30_DynamicKey
+{
+	LUX_COMBOKEY_BEGIN(lux_modelshadertest_ps30_DynamicKey)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_DynamicKey, NUM_LIGHTS, 0, 4, 0, 1)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_ps30_DynamicKey, LIGHTMAPPED_MODEL, 0, 1, 3, 5)
+
+	enum { KEY_BITS = 4, NUM_COMBOS = 10 };
+	constexpr int Index() const { return (int)((m_nKey >> 0) & 0x7) * 1 + (int)((m_nKey >> 3) & 0x1) * 5; }
+};
+
+static_assert(lux_modelshadertest_ps30_DynamicKey::KEY_BITS <= 32, "lux_modelshadertest_ps30_DynamicKey doesn't fit 32 Bits");
+
+// True for Combos the Shader Compiler skipped, there is no Shader for them
+constexpr bool lux_modelshadertest_ps30_IsSkipped(lux_modelshadertest_ps30_StaticKey Static, lux_modelshadertest_ps30_DynamicKey Dynamic)
+{
+	return (Static.Get_BRUSH() != 0 && Static.Get_AMBIENTCUBES() != 0) ||
+		(Static.Get_BRUSH() != 0 && Static.Get_LIGHTDATA() != 0) ||
+		(Static.Get_BRUSH() == 0 && Static.Get_ENVMAPCOMBO() == 2) ||
+		(Static.Get_BRUSH() != 0 && Dynamic.Get_NUM_LIGHTS() != 0) ||
+		(Static.Get_BRUSH() != 0 && Dynamic.Get_LIGHTMAPPED_MODEL() != 0);
+}
+
+#endif // LUX_MODELSHADERTEST_PS30_COMBOKEY_H
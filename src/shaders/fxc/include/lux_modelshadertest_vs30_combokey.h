@@ -0,0 +1,53 @@
+//===================== File of the LUX Shader Project =====================//
+//
+//	Generated by lux_combokey_gen from lux_modelshadertest_vs30.fxc, don't edit.
+//	Declarations Hash : 0xb7ee98114b90691d
+//
+//==========================================================================//
+
+#ifndef LUX_MODELSHADERTEST_VS30_COMBOKEY_H
+#define LUX_MODELSHADERTEST_VS30_COMBOKEY_H
+
+#ifdef _WIN32
+#pragma once
+#endif
+
+#include "../cpp_lux_combokey.h"
+
+struct lux_modelshadertest_vs30_StaticKey
+{
+	LUX_COMBOKEY_BEGIN(lux_modelshadertest_vs30_StaticKey)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_StaticKey, NORMALS, 0, 2, 0, 16)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_StaticKey, VERTEXCOLORS, 0, 1, 2, 48)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_StaticKey, BUMPMAPPED, 0, 2, 3, 96)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_StaticKey, PROJTEX, 0, 1, 5, 288)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_StaticKey, DECALMODE, 0, 2, 6, 576)
+
+	enum { KEY_BITS = 8, NUM_COMBOS = 108 };
+	constexpr int Index() const { return (int)((m_nKey >> 0) & 0x3) * 16 + (int)((m_nKey >> 2) & 0x1) * 48 + (int)((m_nKey >> 3) & 0x3) * 96 + (int)((m_nKey >> 5) & 0x1) * 288 + (int)((m_nKey >> 6) & 0x3) * 576; }
+};
+
+static_assert(lux_modelshadertest_vs30_StaticKey::KEY_BITS <= 32, "lux_modelshadertest_vs30_StaticKey doesn't fit 32 Bits");
+
+struct lux_modelshadertest_vs30_DynamicKey
+{
+	LUX_COMBOKEY_BEGIN(lux_modelshadertest_vs30_DynamicKey)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_DynamicKey, STATICPROPLIGHTING, 0, 1, 0, 1)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_DynamicKey, DYNAMICPROPLIGHTING, 0, 1, 1, 2)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_DynamicKey, COMPRESSION, 0, 1, 2, 4)
+	LUX_COMBOKEY_FIELD(lux_modelshadertest_vs30_DynamicKey, SKINNING, 0, 1, 3, 8)
+
+	enum { KEY_BITS = 4, NUM_COMBOS = 16 };
+	constexpr int Index() const { return (int)((m_nKey >> 0) & 0x1) * 1 + (int)((m_nKey >> 1) & 0x1) * 2 + (int)((m_nKey >> 2) & 0x1) * 4 + (int)((m_nKey >> 3) & 0x1) * 8; }
+};
+
+static_assert(lux_modelshadertest_vs30_DynamicKey::KEY_BITS <= 32, "lux_modelshadertest_vs30_DynamicKey doesn't fit 32 Bits");
+
+// True for Combos the Shader Compiler skipped, there is no Shader for them
+constexpr bool lux_modelshadertest_vs30_IsSkipped(lux_modelshadertest_vs30_StaticKey Static, lux_modelshadertest_vs30_DynamicKey Dynamic)
+{
+	return (Static.Get_PROJTEX() != 0 && Dynamic.Get_STATICPROPLIGHTING() == 1) ||
+		(Static.Get_PROJTEX() != 0 && Dynamic.Get_DYNAMICPROPLIGHTING() == 1);
+}
+
+#endif // LUX_MODELSHADERTEST_VS30_COMBOKEY_H
@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	20.01.2023 DMY
-//	Last Change :	10.06.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //	Purpose of this File :	Define what features should be used
 //							Define If we use sdk2013 MP or SP
@@ -31,6 +31,11 @@
 // Disable for release builds if possible.
 #define LUX_DEBUGCONVARS
 
+// Records every Shader Combo that is drawn and writes lux_combousage.txt on Exit ( cpp_lux_combousage.h )
+// For Playtests, devtools/luxtools/lux_combousage merges the Manifests for the Build
+// -- Changing this does NOT require a Shader recompile
+// #define LUX_COMBOUSAGE
+
 // Only for builds with PBR:
 #define PBR_ENABLE
 
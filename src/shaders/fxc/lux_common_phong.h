@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	21.02.2023 DMY
-//	Last Change :	30.09.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //==========================================================================//
 
@@ -25,7 +25,11 @@ float3 ComputeDirectSpecularLight(float f1NdL, float3 f3Reflect, float3 f3LightD
 {
 	// L.R
 	float f1RdL = saturate(dot(f3Reflect, -f3LightDir));
+#if PHONG_LUT
+	float f1Specular = PhongLUT_Pow(f1RdL, f1SpecularExponent);
+#else
 	float f1Specular = pow(f1RdL, f1SpecularExponent); // Raise to the Power of the Exponent
+#endif
 
 	// Copy it around a bunch of times so we get a float3
 	float3	f3Specular = float3(f1Specular, f1Specular, f1Specular);
@@ -50,7 +54,11 @@ float3 ComputeDirectSpecularLight(float f1NdL, float3 f3Reflect, float3 f3LightD
 #if (!defined(BRUSH_SPECULAR) && !PROJTEX)
 	if (g_bHasRimLight)
 	{
+	#if PHONG_LUT
+		float3 f3LocalRimLight = PhongLUT_Pow(f1RdL, g_f1RimLightExponent);
+	#else
 		float3 f3LocalRimLight = pow(f1RdL, g_f1RimLightExponent);	// Raise to rim exponent
+	#endif
 		f3LocalRimLight *= f1NdL;									// Mask with N.L
 		f3LocalRimLight *= f3LightColor;
 
@@ -66,7 +74,11 @@ float3 ComputeDirectBlinnSpecularLight(float3 f3NormalWS, float3 f3ViewDir, floa
 {
 	float3 f3HalfVector = normalize(f3LightDir + f3ViewDir);
 	float f1NdH = saturate(dot(-f3NormalWS, f3HalfVector));
+#if PHONG_LUT
+	float f1Specular = PhongLUT_Pow(f1NdH, f1SpecularExponent);
+#else
 	float f1Specular = pow(f1NdH, f1SpecularExponent); // Raise to the Power of the Exponent
+#endif
 
 	// Copy it around a bunch of times so we get a float3
 	float3 f3Specular = f1Specular;
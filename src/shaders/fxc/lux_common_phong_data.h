@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	25.08.2024 DMY
-//	Last Change :	30.09.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //==========================================================================//
 
@@ -11,6 +11,12 @@
 // Need this for Luminance Weights
 #include "lux_common_ps_fxc.h"
 
+// Static Combo, replaces pow() and the Fresnel Ranges with Lookups into a baked Table
+// See cpp_lux_phonglut.h for the Layout. Shaders that don't have the Combo get the regular Path.
+#if !defined(PHONG_LUT)
+#define PHONG_LUT 0
+#endif
+
 //==========================================================================//
 // PixelShader *Float* Constant Registers
 //==========================================================================//
@@ -65,6 +71,35 @@ sampler Sampler_PhongWarpTexture : register(s7);
 #if defined(PHONGEXPONENTTEXTURE)
 sampler Sampler_PhongExpTexture : register(s8);
 #endif
+
+// Shares s9 with $EnvMapMask2, that's Brushes only. s12 is $BlendModulateTexture or the ENVMAPLERP Cubemap on Models
+#if PHONG_LUT
+sampler Sampler_PhongLUT : register(s9);
+#endif
+#endif
+
+#if PHONG_LUT
+//==========================================================================//
+// Phong LUT. Must match cpp_lux_phonglut.h
+//==========================================================================//
+#define LUX_PHONGLUT_RANGE 10.0f
+
+// Table is baked on Texel Edges, this moves [0..1] onto the first and last Texel Center
+static const float2 f2PhongLUTScale = float2(255.0f / 256.0f, 63.0f / 64.0f);
+static const float2 f2PhongLUTBias = float2(0.5f / 256.0f, 0.5f / 64.0f);
+
+// Replaces pow(f1RdotL, f1Exponent)
+// The Compiler hoists the Exponent Math out of the unrolled Light Loop, so per Light this is add, mad_sat, mad and a Fetch
+float PhongLUT_Pow(float f1RdotL, float f1Exponent)
+{
+	float2 f2UV;
+	f2UV.x = saturate((1.0f - f1RdotL) * (f1Exponent * (1.0f / LUX_PHONGLUT_RANGE)));
+	f2UV.y = saturate(1.0f / f1Exponent);
+	f2UV = f2UV * f2PhongLUTScale + f2PhongLUTBias;
+
+	// Has to be lod, this is used within the Light Loop
+	return tex2Dlod(Sampler_PhongLUT, float4(f2UV, 0.0f, 0.0f)).x;
+}
 #endif
 
 //==========================================================================//
@@ -163,6 +198,14 @@ void SetupPhongData(inout Phong_Data_t ph, float3 f3BaseTexture)
 
 void SetupPhongFresnel(inout Phong_Data_t ph, float f1UnsaturatedNdotV)
 {
+#if PHONG_LUT
+	// .y is the remapped Fresnel, .z is Fresnel^4
+	// Only Rows differ on the Table, any v will do
+	float f1U = saturate(f1UnsaturatedNdotV) * f2PhongLUTScale.x + f2PhongLUTBias.x;
+	float2 f2Fresnel = tex2Dlod(Sampler_PhongLUT, float4(f1U, f2PhongLUTBias.y, 0.0f, 0.0f)).yz;
+	ph.f1PhongFresnel = f2Fresnel.x;
+	ph.f1RimFresnel = f2Fresnel.y;
+#else
 	// Stock-Consistency
 	float Fresnel = saturate(1.0f - f1UnsaturatedNdotV);
 
@@ -174,5 +217,6 @@ void SetupPhongFresnel(inout Phong_Data_t ph, float f1UnsaturatedNdotV)
 	float Fresnel4 = Fresnel * Fresnel;
 	Fresnel4 = Fresnel4 * Fresnel4;
 	ph.f1RimFresnel = Fresnel4;
+#endif
 }
 #endif // End of LUX_COMMON_PHONG_DATA
\ No newline at end of file
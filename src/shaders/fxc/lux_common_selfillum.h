@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	21.02.2023 DMY
-//	Last Change :	17.12.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //==========================================================================//
 
@@ -29,9 +29,36 @@
 	//	Samplers
 	//==========================================================================//
 
+	// Where the Mask comes from. Must match SelfIllumMaskSources_t in cpp_lux_shared.h
+	// devtools/luxtools/lux_selfillum_pack moves $SelfIllumMask into one of the Alpha Channels,
+	// that saves the Sampler and the Fetch
+	#define SELFILLUM_MASK_TEXTURE				0	// $SelfIllumMask, own Sampler
+	#define SELFILLUM_MASK_ENVMAPMASK_ALPHA		1	// $SelfIllum_EnvMapMask_Alpha
+	#define SELFILLUM_MASK_BASE_ALPHA			2	// Stock Behaviour without $SelfIllumMask
+
+	// Shaders that sample $SelfIllumTexture define this to 1. The Texture takes s13,
+	// so its Mask has to come out of one of the Alpha Channels
+	#if !defined(SELFILLUM_TEXTURE)
+		#define SELFILLUM_TEXTURE 0
+	#endif
+
+	#if !defined(SELFILLUM_MASKSOURCE)
+		#if SELFILLUM_ENVMAPMASK_ALPHA
+			#define SELFILLUM_MASKSOURCE SELFILLUM_MASK_ENVMAPMASK_ALPHA
+		#elif SELFILLUM_TEXTURE
+			#define SELFILLUM_MASKSOURCE SELFILLUM_MASK_BASE_ALPHA
+		#else
+			#define SELFILLUM_MASKSOURCE SELFILLUM_MASK_TEXTURE
+		#endif
+	#endif
+
+	#if SELFILLUM_TEXTURE && (SELFILLUM_MASKSOURCE == SELFILLUM_MASK_TEXTURE)
+		#error "$SelfIllumTexture and $SelfIllumMask both want Sampler_SelfIllum"
+	#endif
+
 	#if !defined(MOVED_SAMPLERS_SELFILLUM)
 		// $selfillummask or $selfillumtexture
-		#if !SELFILLUM_ENVMAPMASK_ALPHA
+		#if (SELFILLUM_MASKSOURCE == SELFILLUM_MASK_TEXTURE) || SELFILLUM_TEXTURE
 			sampler Sampler_SelfIllum		: register(s13);
 		#endif
 	#endif
@@ -55,6 +82,19 @@
 			return 1.0f;
 		#endif
 	}
+
+	// Returns the SelfIllum Mask from wherever SELFILLUM_MASKSOURCE says it is
+	// The packed Sources are a single Channel, $SelfIllumMask keeps its RGB
+	float3 GetSelfIllumMask(float4 f4BaseTexture, float4 f4EnvMapMask, float2 f2UV)
+	{
+		#if (SELFILLUM_MASKSOURCE == SELFILLUM_MASK_ENVMAPMASK_ALPHA)
+			return f4EnvMapMask.aaa;
+		#elif (SELFILLUM_MASKSOURCE == SELFILLUM_MASK_BASE_ALPHA)
+			return f4BaseTexture.aaa;
+		#else
+			return tex2D(Sampler_SelfIllum, f2UV).rgb;
+		#endif
+	}
 	#endif // Selfillum
 #endif // !PROJTEX
 
@@ -1,7 +1,7 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	08.12.2025 DMY
-//	Last Change :	08.12.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //==========================================================================//
 
@@ -26,4 +26,17 @@ float4 CatmullRomSpline( float4 a, float4 b, float4 c, float4 d, float t )
 	return b + 0.5f * t * ( c - a + t * ( 2.0f * a - 5.0f * b + 4.0f * c - d + t * ( -a + 3.0f * b - 3.0f * c + d ) ) );
 }
 
+// Passthrough Path for Ropes cached by cpp_lux_splinecache.h
+// The C++ already evaluated CatmullRomSpline and DCatmullRomSpline3 for every Vertex,
+// so all that's left is expanding the Ribbon towards the Camera.
+// f4PosWidth	: xyz = Position, w = Width ( LuxSplineVertex_t::m_flPos )
+// f3Tangent	: unnormalised Tangent ( LuxSplineVertex_t::m_flTangent.xyz )
+// f1Side		: -0.5f or +0.5f, which Side of the Ribbon this Vertex is on
+float3 SplineRope_ExpandCached(float4 f4PosWidth, float3 f3Tangent, float f1Side, float3 f3EyePos)
+{
+	float3 f3PosToEye = f3EyePos - f4PosWidth.xyz;
+	float3 f3SideVec = normalize(cross(f3PosToEye, f3Tangent));
+	return f4PosWidth.xyz + f3SideVec * (f4PosWidth.w * f1Side);
+}
+
 #endif // LUX_COMMON_SPLINE_H_
\ No newline at end of file
@@ -1,13 +1,26 @@
 //===================== File of the LUX Shader Project =====================//
 //
 //	Initial D.	:	27.03.2025 DMY
-//	Last Change :	30.09.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //==========================================================================//
 
 #ifndef LUX_COMMON_TRIPLANAR_H_
 #define LUX_COMMON_TRIPLANAR_H_
 
+// Available Modes. Must match TriplanarModes_t in cpp_lux_shared.h
+// The Shader selects one by defining TRIPLANAR_MODE ( usually through a Static Combo driven by $Seamless_Mode )
+#define TRIPLANAR_MODE_FULL			0 // Always 3 Samples
+#define TRIPLANAR_MODE_EARLYOUT		1 // 1 to 3 Samples, Projections below the Threshold are skipped
+#define TRIPLANAR_MODE_BIPLANAR		2 // Always 2 Samples, the weakest Projection is dropped
+
+// Weights below this are considered invisible for TRIPLANAR_MODE_EARLYOUT
+// 0.05f is where the Error stops being noticable on the Test Textures,
+// run lux_triplanar_ref from devtools/luxtools if you want to change it
+#if !defined(TRIPLANAR_WEIGHT_THRESHOLD)
+#define TRIPLANAR_WEIGHT_THRESHOLD 0.05f
+#endif
+
 // Weights must Range [0..1]
 //
 // Stock Shaders do
@@ -20,7 +33,7 @@ float3 Triplanar_ComputeWeights(float3 vNormal)
 	return vNormal * vNormal;
 }
 
-// uvw should be WorldPos * Triplanar_Scale + Triplanar_Offset 
+// uvw should be WorldPos * Triplanar_Scale + Triplanar_Offset
 float4 Triplanar_tex2D(sampler Sampler_Triplanar, float3 Weights, float3 uvw)
 {
 	// Only want the Fractions here
@@ -37,4 +50,92 @@ float4 Triplanar_tex2D(sampler Sampler_Triplanar, float3 Weights, float3 uvw)
 	// Weight and return
 	return (Color1 * Weights.xxxx) + (Color2 * Weights.yyyy) + (Color3 * Weights.zzzz);
 }
-#endif // LUX_COMMON_TRIPLANAR_H_
\ No newline at end of file
+
+// Same as above but Projections with a Weight below TRIPLANAR_WEIGHT_THRESHOLD are skipped.
+// When one Axis dominates ( Floors, Walls ) this is a single Sample, on Edges it's two.
+// The remaining Weights are renormalised so the Sum stays 1.
+float4 Triplanar_tex2D_EarlyOut(sampler Sampler_Triplanar, float3 Weights, float3 uvw)
+{
+	float2 TexCoord_wu = frac(uvw.zy);
+	float2 TexCoord_uw = frac(uvw.xz);
+	float2 TexCoord_uv = frac(uvw.xy);
+
+	// Gradients must be computed outside of the Branches ( see X4121 in lux_common_pragmas.h )
+	// Using the un-frac'd Coordinates here, otherwise we get a Seam on the Mip Selection where frac() wraps
+	float3 f3DDX = ddx(uvw);
+	float3 f3DDY = ddy(uvw);
+
+	// Drop the invisible Projections
+	float3 f3Weights = Weights * (Weights >= TRIPLANAR_WEIGHT_THRESHOLD);
+	f3Weights /= dot(f3Weights, 1.0f);
+
+	float4 f4Result = 0.0f;
+
+	[branch]
+	if (f3Weights.x > 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_wu, f3DDX.zy, f3DDY.zy) * f3Weights.x;
+
+	[branch]
+	if (f3Weights.y > 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_uw, f3DDX.xz, f3DDY.xz) * f3Weights.y;
+
+	[branch]
+	if (f3Weights.z > 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_uv, f3DDX.xy, f3DDY.xy) * f3Weights.z;
+
+	return f4Result;
+}
+
+// Biplanar Mapping. Always takes exactly two Samples.
+// The Weight of the weakest Projection is subtracted from the other two,
+// so the Transition stays continuous when the two weaker Axes swap.
+float4 Triplanar_tex2D_Biplanar(sampler Sampler_Triplanar, float3 Weights, float3 uvw)
+{
+	float2 TexCoord_wu = frac(uvw.zy);
+	float2 TexCoord_uw = frac(uvw.xz);
+	float2 TexCoord_uv = frac(uvw.xy);
+
+	float3 f3DDX = ddx(uvw);
+	float3 f3DDY = ddy(uvw);
+
+	// 1 on the weakest Axis, 0 on the others
+	float3 f3IsMin = (Weights.x <= Weights.y && Weights.x <= Weights.z) ? float3(1.0f, 0.0f, 0.0f) :
+					((Weights.y <= Weights.z) ? float3(0.0f, 1.0f, 0.0f) : float3(0.0f, 0.0f, 1.0f));
+
+	float f1Min = min(Weights.x, min(Weights.y, Weights.z));
+	float3 f3Weights = (Weights - f1Min) * (1.0f - f3IsMin);
+	float f1Sum = dot(f3Weights, 1.0f);
+
+	// All three Weights equal ( perfect Diagonal ), split evenly
+	f3Weights = (f1Sum > 0.00001f) ? (f3Weights / f1Sum) : ((1.0f - f3IsMin) * 0.5f);
+
+	float4 f4Result = 0.0f;
+
+	[branch]
+	if (f3IsMin.x == 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_wu, f3DDX.zy, f3DDY.zy) * f3Weights.x;
+
+	[branch]
+	if (f3IsMin.y == 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_uw, f3DDX.xz, f3DDY.xz) * f3Weights.y;
+
+	[branch]
+	if (f3IsMin.z == 0.0f)
+		f4Result += tex2Dgrad(Sampler_Triplanar, TexCoord_uv, f3DDX.xy, f3DDY.xy) * f3Weights.z;
+
+	return f4Result;
+}
+
+// Use this one in Shaders, it picks whatever TRIPLANAR_MODE is set to
+// Falls back to regular Triplanar Mapping if the Shader doesn't define it
+float4 Triplanar_Sample(sampler Sampler_Triplanar, float3 Weights, float3 uvw)
+{
+#if defined(TRIPLANAR_MODE) && (TRIPLANAR_MODE == TRIPLANAR_MODE_EARLYOUT)
+	return Triplanar_tex2D_EarlyOut(Sampler_Triplanar, Weights, uvw);
+#elif defined(TRIPLANAR_MODE) && (TRIPLANAR_MODE == TRIPLANAR_MODE_BIPLANAR)
+	return Triplanar_tex2D_Biplanar(Sampler_Triplanar, Weights, uvw);
+#else
+	return Triplanar_tex2D(Sampler_Triplanar, Weights, uvw);
+#endif
+}
+#endif // LUX_COMMON_TRIPLANAR_H_
@@ -2,7 +2,7 @@
 //
 //	Original D. :	24.05.2025 DMY
 //	Initial D.	:	06.09.2025 DMY
-//	Last Change :	06.09.2025 DMY
+//	Last Change :	19.10.2026 DMY
 //
 //	Purpose of this File :	Infected Shader Constants
 //
@@ -26,12 +26,22 @@
 // Samplers
 //==========================================================================//
 
-// s0 - $BaseTexture defined in lux_common_ps_fxc.h
+// Far away Infected use a pre-combined Texture on s0 instead of s0, s2, s3 and s5
+// See cpp_lux_infectedlod.h and devtools/luxtools/lux_infected_lodbake
+#if !defined(INFECTED_FARLOD)
+#define INFECTED_FARLOD 0
+#endif
+
+// s0 - $BaseTexture defined in lux_common_ps_fxc.h, the LOD Texture under INFECTED_FARLOD
 sampler Sampler_NormalMap			: register(s1); // Moved Sampler
+#if !INFECTED_FARLOD
 sampler Sampler_WoundCutOutTexture	: register(s2);
 sampler Sampler_GradientTexture		: register(s3);
+#endif
 sampler Sampler_DetailTexture		: register(s4);
+#if !INFECTED_FARLOD
 sampler Sampler_BurnDetailTexture	: register(s5);
+#endif
 
 //==========================================================================//
 // *Float* Constants
@@ -87,7 +97,8 @@ const float4	cCutOutControls2		: register(INFECTED_CUTOUTCONTROLS2);
 const float4	cCutOutControls3				: register(INFECTED_CUTOUTCONTROLS3);
 #define			g_f1Ellipsoid1_UVMappingScale	(cCutOutControls3.x)
 #define			g_f1Ellipsoid2_UVMappingScale	(cCutOutControls3.y)
-// .zw empty 
+// INFECTED_FARLOD only, Red and Blue of the Burn Tint. Green follows from Luminance 1.0f
+#define			g_f2BurnLODTint					(cCutOutControls3.zw)
 
 // Moved these Registers
 const float3 cAmbientCube[6]				: register(INFECTED_AMBIENTCUBE);
@@ -172,4 +183,27 @@ float EdgeBlend(float2 f2TexCoord, float f1BorderWidth)
 	return pow(saturate(f1Dist / f1BorderWidth), 5.0f);
 }
 
+#if !INFECTED_FARLOD
+// Per-Instance Colour Variation. The Base Alpha picks the Column, g_f1RandomisationOffset1 the Row
+// CPU Reference is LuxInfected_GradientAlbedo() in cpp_lux_infectedlod.h
+float3 Infected_GradientAlbedo(float4 f4BaseTexture)
+{
+	float3 f3Gradient = tex2D(Sampler_GradientTexture, float2(f4BaseTexture.a, g_f1RandomisationOffset1)).rgb;
+	return f4BaseTexture.rgb * f3Gradient;
+}
+#else
+// One Fetch for everything the close Path needs three Textures for
+// [RGB] Albedo with the Gradient applied, [A] BurnDetail Luminance. No Wounds this far away
+void Infected_FarLOD(float2 f2TexCoord, out float3 f3Albedo, out float3 f3Burn)
+{
+	float4 f4LOD = tex2D(Sampler_BaseTexture, f2TexCoord);
+	f3Albedo = f4LOD.rgb;
+
+	// Average Burn Colour from the Baker, normalised to a Luminance of 1.0f
+	float3 f3BurnTint = float3(g_f2BurnLODTint.x, 0.0f, g_f2BurnLODTint.y);
+	f3BurnTint.g = (1.0f - dot(f3BurnTint, float3(0.2126f, 0.0f, 0.0722f))) / 0.7152f;
+	f3Burn = f4LOD.a * f3BurnTint * g_f1BurnStrength;
+}
+#endif
+
 #endif
\ No newline at end of file